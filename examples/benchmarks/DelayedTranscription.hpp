@@ -0,0 +1,101 @@
+/**
+ * @file DelayedTranscription.hpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Implementation of the Delayed Transcription test case.
+ */
+
+/**
+ * @struct DelayedTranscription
+ * @brief Independent genes transcribed with a non-consuming delay,
+ * such that on average @f$ N k \tau @f$ delayed reactions are pending
+ * at any time.
+ */
+struct DelayedTranscription
+{
+  /**
+   * Generate the SBML model
+   *
+   * @return an @c SBMLDocument object representing the network
+   */
+  static LIBSBML_CPP_NAMESPACE::SBMLDocument * generateSBML(unsigned int unSpeciesNum)
+  {
+    // Create an SBML document and add a model
+    LIBSBML_CPP_NAMESPACE::SBMLDocument * ptrSBMLDocument = new LIBSBML_CPP_NAMESPACE::SBMLDocument(2, 4);
+
+    LIBSBML_CPP_NAMESPACE::Model * ptrSBMLModel =
+      ptrSBMLDocument->createModel();
+
+    ptrSBMLModel->setId("DelayedTranscription");
+
+    // Compartment identifier
+    const std::string compartmentName = "testVolume";
+    // Create a Compartment object
+    LIBSBML_CPP_NAMESPACE::Compartment* compartment =
+      ptrSBMLModel->createCompartment();
+    compartment->setId(compartmentName);
+    compartment->setSize(1);
+    compartment->setUnits("dimensionless");
+
+    // Species
+    boost::format fmtSpeciesName("M%d");
+    for(UINTEGER s = 0; s < unSpeciesNum; s++)
+    {
+      LIBSBML_CPP_NAMESPACE::Species * species =
+        ptrSBMLModel->createSpecies();
+      species->setCompartment(compartmentName);
+      species->setId((fmtSpeciesName % s).str());
+      species->setInitialAmount(0.0);
+      species->setSubstanceUnits("dimensionless");
+    }
+
+    // Reactions
+    boost::format fmtReactionName("R%d");
+    boost::format fmtReactionAnnotation("<annotation>\n<libpSSA:rate xmlns:libpSSA=\"uri\">\n"
+      "<libpSSA:forward libpSSA:value=\"%1.1f\"/>\n</libpSSA:rate>\n</annotation>");
+    boost::format fmtDelayedReactionAnnotation("<annotation>\n<libpSSA:rate xmlns:libpSSA=\"uri\">\n"
+      "<libpSSA:forward libpSSA:value=\"%1.1f\"/>\n</libpSSA:rate>\n"
+      "<libpSSA:delay xmlns:libpSSA=\"uri\" libpSSA:nonconsuming=\"true\" libpSSA:value=\"%1.1f\"/>\n</annotation>");
+    LIBSBML_CPP_NAMESPACE::Reaction * reaction = NULL;
+    LIBSBML_CPP_NAMESPACE::SpeciesReference* speciesReference = NULL;
+
+    UINTEGER r = 0;
+    for(UINTEGER s = 0; s < unSpeciesNum; s++)
+    {
+      // 0 --> M_s, completes after a delay
+      reaction = ptrSBMLModel->createReaction();
+      reaction->setId((fmtReactionName % r++).str());
+      reaction->setReversible(false);
+
+      // product
+      speciesReference = reaction->createProduct();
+      speciesReference->setSpecies((fmtSpeciesName % s).str());
+
+      // set reaction annotation
+      reaction->setAnnotation((fmtDelayedReactionAnnotation % 1.0 % 100.0).str());
+
+      // M_s --> 0
+      reaction = ptrSBMLModel->createReaction();
+      reaction->setId((fmtReactionName % r++).str());
+      reaction->setReversible(false);
+
+      // reactant
+      speciesReference = reaction->createReactant();
+      speciesReference->setSpecies((fmtSpeciesName % s).str());
+
+      // set reaction annotation
+      reaction->setAnnotation((fmtReactionAnnotation % 0.1).str());
+    }
+
+    return ptrSBMLDocument;
+  }
+};
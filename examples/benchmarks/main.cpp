@@ -27,6 +27,7 @@
 
 #include "CyclicLinearChain.hpp"
 #include "ColloidalAggregation.hpp"
+#include "DelayedTranscription.hpp"
 
 using namespace pssalib::program_options;
 
@@ -35,7 +36,8 @@ enum tagTestCases
 {
   tcCLC = 0x0001,
   tcCA  = 0x0002,
-  tcAll = 0x0003
+  tcDT  = 0x0004,
+  tcAll = 0x0007
 };
 
 class Benchmarks : public ProgramOptionsBase
@@ -101,6 +103,7 @@ protected:
                                                   default_value(CLIOptionCommaSeparatedList("all")),               "A comma-separated list of test case ids:" \
                                                                                       "\n0,clc - Cyclic Linear Chain Network" \
                                                                                       "\n1,ca  - Colloidal Dis-/Aggregation Network" \
+                                                                                      "\n2,dt  - Delayed Transcription Network" \
                                                                                       "\nall - all of the listed above")
         ("sizes,s",           prog_opt::value< CLIOptionCommaSeparatedList >()->
                                                   default_value(CLIOptionCommaSeparatedList("10,100")),            "A comma-separated list of species numbers in the network")
@@ -110,6 +113,8 @@ protected:
                                                                                       "\n1,pdm - Partial Propensity Direct Method" \
                                                                                       "\n2,pssacr - PSSA with Composition-Rejection Sampling" \
                                                                                       "\n3,spdm - Sorting Partial Propensity Direct Method" \
+                                                                                      "\n4,dmtree - Direct Method with a sum tree" \
+                                                                                      "\n5,nrm - Next Reaction Method" \
                                                                                       "\nall - all of the listed above")
         ("verbose,v",                                                                 "Output additional information about the simulation")
         ("quiet,q",                                                                   "Suppress any additional output")
@@ -178,6 +183,8 @@ public:
       mapping[STRING("clc")] = tcCLC;
       mapping[STRING("1")] = tcCA;
       mapping[STRING("ca")] = tcCA;
+      mapping[STRING("2")] = tcDT;
+      mapping[STRING("dt")] = tcDT;
       mapping[STRING("all")] = tcAll;
 
       CLIOptionCommaSeparatedList tests = vm["tests"].as< CLIOptionCommaSeparatedList >();
@@ -234,6 +241,10 @@ public:
       mapping[STRING("pssacr")] = pssalib::PSSA::M_PSSACR;
       mapping[STRING("3")] = pssalib::PSSA::M_SPDM;
       mapping[STRING("spdm")] = pssalib::PSSA::M_SPDM;
+      mapping[STRING("4")] = pssalib::PSSA::M_DMTree;
+      mapping[STRING("dmtree")] = pssalib::PSSA::M_DMTree;
+      mapping[STRING("5")] = pssalib::PSSA::M_NRM;
+      mapping[STRING("nrm")] = pssalib::PSSA::M_NRM;
       mapping[STRING("all")] = pssalib::PSSA::M_All;
 
       CLIOptionCommaSeparatedList methods = vm["methods"].as< CLIOptionCommaSeparatedList >();
@@ -455,6 +466,9 @@ int main(int argc, char** argv)
         case tcCA:
           pSBMLDoc.reset(ColloidalAggregation::generateSBML(benchmarks.getSizes()[k_s]));
         break;
+        case tcDT:
+          pSBMLDoc.reset(DelayedTranscription::generateSBML(benchmarks.getSizes()[k_s]));
+        break;
         default:
           PSSALIB_MPI_CERR_OR_NULL << "Error : unknown test case code "
               << t << std::endl;
@@ -24,6 +24,8 @@
 #define PSSALIB_PSSA_H_
 
 #include "typedefs.h"
+#include "util/Checkpoint.h"
+#include "util/ReactionEventStream.h"
 
 #ifndef PSSALIB_FILENAME_LOG
 #  ifdef HAVE_MPI
@@ -53,6 +55,18 @@
 #define PSSALIB_FILENAME_TRAJECTORY "trajectory_%i.dat"
 #endif
 
+#ifndef PSSALIB_FILENAME_BINARY_TRAJECTORY
+#define PSSALIB_FILENAME_BINARY_TRAJECTORY "trajectory_%i.bin"
+#endif
+
+#ifndef PSSALIB_FILENAME_AVERAGE_TRAJECTORY
+#define PSSALIB_FILENAME_AVERAGE_TRAJECTORY "average_trajectory.dat"
+#endif
+
+#ifndef PSSALIB_FILENAME_HISTOGRAMS
+#define PSSALIB_FILENAME_HISTOGRAMS "histograms.dat"
+#endif
+
 #ifndef PSSALIB_FILENAME_FINAL_TIME_POINT_POPULATIONS
 #define PSSALIB_FILENAME_FINAL_TIME_POINT_POPULATIONS "populations.dat"
 #endif
@@ -61,6 +75,14 @@
 #define PSSALIB_FILENAME_TIMING "timing.dat"
 #endif
 
+#ifndef PSSALIB_FILENAME_CHECKPOINT
+#define PSSALIB_FILENAME_CHECKPOINT "checkpoint.bin"
+#endif
+
+#ifndef PSSALIB_FILENAME_SAMPLE_MARKER
+#define PSSALIB_FILENAME_SAMPLE_MARKER "sample_%i.done"
+#endif
+
 ///////////////////////////////////
 // Forward declarations
 namespace pssalib
@@ -116,10 +138,33 @@ namespace pssalib
       M_PSSACR = 0x0004,
       //! Sorting Partial Propensity Direct Method
       M_SPDM = 0x0008,
+      //! Direct Method with logarithmic-time reaction selection
+      M_DMTree = 0x0010,
+      //! Gibson-Bruck Next Reaction Method
+      M_NRM = 0x0020,
       //! All methods
-      M_All  = 0x000F
+      M_All  = 0x003F
     } EMethod;
 
+  /////////////////////////////////
+  // Data Types
+  protected:
+    //! Timing information collected for each trial
+    typedef struct tagTimingInfo
+    {
+      REAL t;     //!< Time spent simulating the trial
+      UINTEGER n; //!< Number of reactions fired
+    } TimingInfo;
+
+    //! Context of a sampling thread (see PSSA.cpp)
+    struct tagSamplingThreadContext;
+
+    //! State of the sampling loop saved at checkpoints (see PSSA.cpp)
+    struct tagCheckpointState;
+
+    //! Step loop of a trial specialized for a method & configuration (see PSSA.cpp)
+    typedef bool (PSSA::*STEP_LOOP)(datamodel::SimulationInfo*, UINTEGER, UINTEGER &);
+
   /////////////////////////////////
   // Attributes
   protected:
@@ -133,6 +178,8 @@ namespace pssalib
 //     void*                         ptrErrCallbackUserData;
     //! Pointer to reaction callback user data
     void*                         ptrReactionCallbackUserData;
+    //! Batched stream of reaction events
+    util::ReactionEventStream     m_EventStream;
 
     //! Pointer to a corresponding data model object
     datamodel::DataModel*         ptrData;
@@ -145,6 +192,10 @@ namespace pssalib
 
     //! ID of the simulation method
     EMethod                       m_Method;
+    //! Step loop used to sample a trial
+    STEP_LOOP                     ptrStepLoop;
+    //! Checkpoints of the sampling loop, @c NULL if disabled
+    tagCheckpointState*           ptrCheckpoint;
 
   /////////////////////////////////
   // Constructors
@@ -178,6 +229,66 @@ namespace pssalib
     //! Simulation driver
     bool runSamplingLoop(datamodel::SimulationInfo* simInfo);
 
+    //! Select the step loop matching the method & the model
+    void setupStepLoop(datamodel::SimulationInfo* simInfo);
+
+    //! Select the step loop for given sampling & update modules
+    template<class TSampling, class TUpdate>
+    STEP_LOOP selectStepLoop(bool bSpatial, bool bDelays) const;
+
+    //! Step loop of a trial for a method & configuration known at compile time
+    template<class TSampling, class TUpdate, bool bSpatial, bool bDelays>
+    bool runStepLoop(datamodel::SimulationInfo* simInfo, UINTEGER sample,
+                     UINTEGER & unReactions);
+
+    //! Sample a single trial
+    bool sampleTrial(datamodel::SimulationInfo* simInfo, UINTEGER sample,
+                     REAL & tTrial, UINTEGER & unReactions);
+
+    //! Store results of a single trial in the respective sample slot
+    void storeTrialResults(datamodel::SimulationInfo* simInfo, UINTEGER slot,
+                           REAL tTrial, UINTEGER unReactions,
+                           TimingInfo * arTiming, UINTEGER * arFinalPops) const;
+
+    //! Describe the settings of the sampling loop in a checkpoint header
+    void setupCheckpointHeader(datamodel::SimulationInfo* simInfo,
+                               util::Checkpoint::Header & hdr) const;
+
+    //! Maximum number of values in the trajectory of a trial recorded along with the sample
+    std::size_t getTrialTrajectorySize(datamodel::SimulationInfo* simInfo) const;
+
+    //! Restore the results of the samples recorded by a previous run
+    bool loadSampleMarkers(datamodel::SimulationInfo* simInfo, TimingInfo * arTiming,
+                           UINTEGER * arFinalPops, std::vector<bool> & arCompleted);
+
+    //! Record the results of a completed sample in the output path
+    bool writeSampleMarker(datamodel::SimulationInfo* simInfo, UINTEGER sample,
+                           REAL tTrial, UINTEGER unReactions);
+
+    //! Enable checkpoints & restore the samples completed before the last one
+    bool setupCheckpoints(datamodel::SimulationInfo* simInfo, TimingInfo * arTiming,
+                          UINTEGER * arFinalPops, UINTEGER & sample);
+
+    //! Save the state of the sampling loop in the middle of a trial
+    bool saveCheckpoint(datamodel::SimulationInfo* simInfo, UINTEGER sample,
+                        UINTEGER unReactions);
+
+    //! Continue the trial saved at the checkpoint
+    bool restoreTrial(datamodel::SimulationInfo* simInfo, UINTEGER sample,
+                      UINTEGER & unReactions);
+
+    //! Disable checkpoints, optionally removing the checkpoint file
+    void freeCheckpoints(bool bRemoveFile);
+#ifdef HAVE_THREADS
+    //! Multi-threaded simulation driver
+    bool runSamplingThreads(datamodel::SimulationInfo* simInfo,
+                            TimingInfo * arTiming, UINTEGER * arFinalPops,
+                            const std::vector<bool> & arCompleted, bool bMarkers);
+
+    //! Worker routine of a sampling thread
+    static void sampleTrialsWorker(tagSamplingThreadContext * ptrContext);
+#endif
+
   //////////////////////////////
   // Methods
   public:
@@ -197,6 +308,12 @@ namespace pssalib
     void SetProgressCallback(FCN_REPORTPROGRESS_CALLBACK fcnProgress, void* user);
     //! Sets the reaction callback function and user data
     void SetReactionCallback(FCN_REACTION_CALLBACK fcnReaction, void* user);
+    //! Sets the sink receiving batches of reaction events and user data
+    void SetReactionEventsSink(FCN_REACTION_EVENTS_SINK fcnSink, void* user, UINTEGER batch = 1024);
+    //! Restricts the reaction events passed to the sink
+    void SetReactionEventsFilter(const std::vector<bool> & reactions, const std::vector<bool> & subvolumes);
+    //! Returns the seed of the random number generator used by the last simulation
+    ULINTEGER getRNGSeed() const;
 
     /**
      * Getters for modules
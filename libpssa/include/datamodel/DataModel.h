@@ -25,6 +25,8 @@
 #include "./detail/Subvolume.hpp"
 #include "./detail/ReactionWrapper.hpp"
 #include "./detail/VolumeDecomposition.hpp"
+#include "./detail/FiringTimes.hpp"
+#include "./detail/DelayQueue.hpp"
 
 namespace pssalib
 {
@@ -56,20 +58,24 @@ namespace datamodel
     {
       //! Reaction index
       UINTEGER index;
+      //! Subvolume index
+      UINTEGER subvolume;
       //! Time-point when it's scheduled to fire
       REAL     time;
 
       //! Default constructor
       tagDelayedReaction()
         : index(0)
+        , subvolume(0)
         , time(0.0)
       {
         // Do nothing
       }
 
       //! Constructor
-      tagDelayedReaction(UINTEGER i, REAL t)
+      tagDelayedReaction(UINTEGER i, UINTEGER sv, REAL t)
         : index(i)
+        , subvolume(sv)
         , time(t)
       {
         // Do nothing
@@ -142,42 +148,58 @@ namespace datamodel
     //
 
     /**
-     * Allocate a subvolume.
-     * 
-     * @return Pointer to the allocated object.
+     * Allocate a contiguous array of subvolume objects.
      */
-  virtual detail::Subvolume * allocateSubvolume()
+    template<class SV>
+    void internalAllocateSubvolumes()
     {
-      return new detail::Subvolume;
-      //internalAllocateSubvolumes(n);
+      SV * arSV = new SV[m_unSubvolumes];
+      m_arSubvolumes = new detail::Subvolume *[m_unSubvolumes];
+      for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
+        m_arSubvolumes[svi] = static_cast<detail::Subvolume *>(arSV + svi);
     };
 
     /**
-     * Free memory for a subvolume.
-     * 
-     * @param sv Pointer to the allocated object.
+     * Free a contiguous array of subvolume objects.
      */
-  virtual void freeSubvolume(detail::Subvolume * sv)
+    template<class SV>
+    void internalFreeSubvolumes()
     {
-      delete sv;
+      if(NULL != m_arSubvolumes)
+      {
+        delete [] static_cast<SV *>(m_arSubvolumes[0]);
+        delete [] m_arSubvolumes;
+        m_arSubvolumes = NULL;
+      }
     };
 
     /**
-     * Free the subvolume containers.
+     * Allocate the subvolume objects.
      */
-    void freeSubvolumes()
+  virtual void allocateSubvolumes()
     {
-      if(NULL != m_arSubvolumes)
-      {
-        for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
-          if(NULL != m_arSubvolumes[svi])
-            freeSubvolume(m_arSubvolumes[svi]);
-        delete [] m_arSubvolumes;
-      }
-      m_unSubvolumes = 0;
-      m_arSubvolumes = NULL;
+      internalAllocateSubvolumes<detail::Subvolume>();
     };
 
+    /**
+     * Free the subvolume objects.
+     */
+  virtual void freeSubvolumes()
+    {
+      internalFreeSubvolumes<detail::Subvolume>();
+    };
+
+    /**
+     * Allocate the tables holding the state of all subvolumes
+     * and attach every subvolume to its row.
+     */
+  virtual void allocateSubvolumesStorage();
+
+    /**
+     * Free the tables holding the state of all subvolumes.
+     */
+  virtual void freeSubvolumesStorage();
+
   /////////////////////////////////////
   // Methods
   public:
@@ -213,7 +235,8 @@ namespace datamodel
      */
   virtual void clearStructures()
     {
-      // Do nothing
+      ftVolumes.free();
+      bVolumesScheduled = false;
     };
 
     /**
@@ -226,9 +249,7 @@ namespace datamodel
       std::swap(m_arReactionWrappers, other.m_arReactionWrappers);
       std::swap(m_unReactionWrappers, other.m_unReactionWrappers);
 
-      std::swap(m_arSubvolumes, other.m_arSubvolumes);
-      std::swap(m_unSubvolumes, other.m_unSubvolumes);
-
+      // subvolumes are method specific and are rebuilt by setup()
       std::swap(m_arunDims, other.m_arunDims);
       std::swap(m_uDims, other.m_uDims);
 
@@ -249,9 +270,39 @@ namespace datamodel
 
   inline void setupPopulation(UINTEGER ** initAmounts)
     {
-      for(UINTEGER si = 0; si < m_unSpecies; ++si)
-          for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
-            getSubvolume(svi).arunPopulation[si] = initAmounts[svi][si];
+      for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
+        memcpy(m_arunPopulation + svi * m_unSpecies, initAmounts[svi], sizeof(UINTEGER)*m_unSpecies);
+    }
+
+    /**
+     * Get the populations of all species in all subvolumes.
+     *
+     * @return Pointer to the populations [subvolume x species].
+     */
+  inline const UINTEGER * getPopulation() const
+    {
+      return m_arunPopulation;
+    }
+
+    /**
+     * Store the current state of all subvolumes as the initial state.
+     */
+  inline void storeInitialState()
+    {
+      for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
+        getSubvolume(svi).store(m_unReactionWrappers, m_unSpecies);
+      m_dInitialTotalPropensity = dTotalPropensity;
+    }
+
+    /**
+     * Restore the state of all subvolumes from the initial state
+     * (see @link storeInitialState()).
+     */
+  inline void restoreInitialState()
+    {
+      for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
+        getSubvolume(svi).restore(m_unReactionWrappers, m_unSpecies);
+      dTotalPropensity = m_dInitialTotalPropensity;
     }
 
     // Reactions
@@ -397,10 +448,19 @@ namespace datamodel
     UINTEGER                        m_unSubvolumes;   //!< Number of subvolumes
     detail::Subvolume               **m_arSubvolumes; //!< Array of subvolumes
 
+    UINTEGER                        *m_arunPopulation,        //!< Species populations [subvolume x species]
+                                    *m_arunInitialPopulation, //!< Initial species populations [subvolume x species]
+                                    *m_arunNeighbours;        //!< Neighbouring subvolumes [subvolume x 2*dims]
+    REAL                            *m_ardTotalPropensity,        //!< Total propensity of each subvolume
+                                    *m_ardInitialTotalPropensity; //!< Initial total propensity of each subvolume
+
     // Spatial dimensions
     BYTE                            m_uDims;     //!< Number of spatial dimensions
     UINTEGER                        *m_arunDims; //!< Array of dimension lengths
 
+    // Initial state
+    REAL                            m_dInitialTotalPropensity; //!< Initial total propensity
+
   ////////////////////////////////
   // Attributes
   public:
@@ -419,6 +479,12 @@ namespace datamodel
     //! Information for sampling the next subvolume
     CompositionRejectionSamplerData crsdVolume;
 
+    //! Firing times of the subvolumes (Next Subvolume Method)
+    detail::FiringTimes             ftVolumes;
+
+    //! Flag indicating that the subvolume firing times are set for the current trial
+    bool                            bVolumesScheduled;
+
   /////////////////////////////////////
   // Sampling variables
   public:
@@ -432,7 +498,8 @@ namespace datamodel
     UINTEGER                        nu_D;
 
     //! Queued reactions (both D1 & D2 class reactions from (Cao et al, 2007))
-    std::vector<DelayedReaction>    vQueuedReactions;
+    detail::DelayQueue<DelayedReaction>
+                                    dqQueuedReactions;
   };
 
 }  } // close namespaces pssalib and datamodel
@@ -19,7 +19,10 @@
 #define PSSALIB_DATAMODEL_DATAMODEL_DM_H_
 
 #include "./DataModel.h"
+#include "./detail/JaggedMatrix.hpp"
 #include "./detail/Subvolume_DM.hpp"
+#include "./detail/ReactionWrapper.hpp"
+#include "../util/Combinations.h"
 
 namespace pssalib
 {
@@ -53,17 +56,73 @@ namespace datamodel
     //
 
     /**
-     * @copydoc DataModel::allocateSubvolume()
+     * @copydoc DataModel::allocateSubvolumes()
      */
-  virtual detail::Subvolume * allocateSubvolume()
+  virtual void allocateSubvolumes()
     {
-      return static_cast<detail::Subvolume *>(
-        new detail::Subvolume_DM);
+      internalAllocateSubvolumes<detail::Subvolume_DM>();
     };
 
+    /**
+     * @copydoc DataModel::freeSubvolumes()
+     */
+  virtual void freeSubvolumes()
+    {
+      internalFreeSubvolumes<detail::Subvolume_DM>();
+    };
+
+    /**
+     * @copydoc DataModel::allocateSubvolumesStorage()
+     */
+  virtual void allocateSubvolumesStorage();
+
+    /**
+     * @copydoc DataModel::freeSubvolumesStorage()
+     */
+  virtual void freeSubvolumesStorage();
+
   /////////////////////////////////////
   // Methods
   public:
+
+    /**
+     * Clear global data structures.
+     */
+  virtual void clearStructures()
+    {
+      arDependencies.free();
+
+      // call base class method
+      DataModel::clearStructures();
+    };
+
+    /**
+     * Compute the propensity of a reaction in a subvolume.
+     * 
+     * @param rwi Reaction wrapper index
+     * @param DMSubVol Subvolume
+     * @return Reaction propensity
+     */
+    REAL computePropensity(UINTEGER rwi, const detail::Subvolume_DM & DMSubVol) const
+    {
+      const detail::ReactionWrapper & rw = getReactionWrapper(rwi);
+
+      REAL temp = rw.getRate();
+      if(rw.isDiffusive())
+        temp *= (REAL)DMSubVol.population(rw.getSpecies()->getIndex()) * 2.0 * (REAL)getDimsCount();
+      else
+      {
+        for(UINTEGER ri = 0; ri < rw.getReactantsCount(); ++ri)
+        {
+          const detail::SpeciesReference * sr = rw.getReactantsListAt(ri);
+          if(!sr->isReservoir())
+            temp *= pssalib::util::getPartialCombinationsHeteroreactions(DMSubVol.population(sr->getIndex()), sr->getStoichiometryAbs());
+        }
+      }
+
+      return temp;
+    };
+
     // Subvolumes
     //
 
@@ -90,6 +149,19 @@ namespace datamodel
 
     //! Assignement operator
     DataModel_DM& operator= (const DataModel_DM&) = delete;
+
+  ////////////////////////////////
+  // Attributes
+  protected:
+    //! Propensities [subvolume x reaction]
+    REAL                           *m_ardPi,
+    //! Initial propensities [subvolume x reaction]
+                                   *m_ardInitialPi;
+
+  public:
+    //! Indices of the reactions whose propensities depend
+    //! on the population of a given species.
+    detail::JaggedMatrix<UINTEGER> arDependencies;
   };
 }  } // close namespaces pssalib and datamodel
 
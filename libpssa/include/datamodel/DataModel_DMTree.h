@@ -0,0 +1,103 @@
+/**
+ * @file DataModel_DMTree.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ * 
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Declares a container for all the data structures required by the 
+ * Direct Method with logarithmic-time reaction selection
+ */
+
+#ifndef PSSALIB_DATAMODEL_DATAMODEL_DMTREE_H_
+#define PSSALIB_DATAMODEL_DATAMODEL_DMTREE_H_
+
+#include "./DataModel_DM.h"
+#include "./detail/Subvolume_DMTree.hpp"
+
+namespace pssalib
+{
+namespace datamodel
+{
+  /**
+   * @class DataModel_DMTree
+   * @brief Defines the datastructures for the Direct Method with
+   * propensities stored in a binary sum tree.
+   *
+   * @copydoc DataModel
+   */
+  class DataModel_DMTree : public DataModel_DM
+  {
+  /////////////////////////////////////
+  // Constructors
+  public:
+    // Default constructor
+    DataModel_DMTree();
+
+    //! Copy constructor
+    DataModel_DMTree(DataModel &) = delete;
+
+    // Destructor
+  virtual ~DataModel_DMTree();
+
+  /////////////////////////////////////
+  // Methods
+  protected:
+    // Subvolumes
+    //
+
+    /**
+     * @copydoc DataModel::allocateSubvolumes()
+     */
+  virtual void allocateSubvolumes()
+    {
+      internalAllocateSubvolumes<detail::Subvolume_DMTree>();
+    };
+
+    /**
+     * @copydoc DataModel::freeSubvolumes()
+     */
+  virtual void freeSubvolumes()
+    {
+      internalFreeSubvolumes<detail::Subvolume_DMTree>();
+    };
+
+  /////////////////////////////////////
+  // Methods
+  public:
+    // Subvolumes
+    //
+
+    /**
+     * @copydoc DataModel::getSubvolume(UINTEGER)
+     */
+    const detail::Subvolume_DMTree & getSubvolume(UINTEGER unSubvolumeIdx) const
+    {
+      return const_cast<const detail::Subvolume_DMTree &>(
+        const_cast<DataModel_DMTree *>(this)->getSubvolume(unSubvolumeIdx));
+    };
+
+    /**
+     * @copydoc DataModel::getSubvolume(UINTEGER)
+     */
+    detail::Subvolume_DMTree & getSubvolume(UINTEGER unSubvolumeIdx)
+    {
+#ifndef PSSALIB_NO_BOUNDS_CHECKS
+      if(unSubvolumeIdx >= m_unSubvolumes)
+        throw std::runtime_error("DataModel_DMTree::getSubvolume() - invalid arguments.");
+#endif
+      return static_cast<detail::Subvolume_DMTree &>(*(m_arSubvolumes[unSubvolumeIdx]));
+    };
+
+    //! Assignement operator
+    DataModel_DMTree& operator= (const DataModel_DMTree&) = delete;
+  };
+}  } // close namespaces pssalib and datamodel
+
+#endif /* PSSALIB_DATAMODEL_DATAMODEL_DMTREE_H_ */
@@ -0,0 +1,83 @@
+/**
+ * @file DataModel_NRM.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Declares a container for all the data structures required by the
+ * Next Reaction Method
+ */
+
+#ifndef PSSALIB_DATAMODEL_DATAMODEL_NRM_H_
+#define PSSALIB_DATAMODEL_DATAMODEL_NRM_H_
+
+#include "./DataModel_DM.h"
+#include "./detail/FiringTimes.hpp"
+
+namespace pssalib
+{
+namespace datamodel
+{
+  /**
+   * @class DataModel_NRM
+   * @brief Defines the datastructures for the Next Reaction Method
+   * by Gibson and Bruck.
+   *
+   * @details Every reaction channel, i.e. every reaction in every subvolume,
+   * has a putative firing time stored in an indexed priority queue. Channel
+   * @a rwi of subvolume @a svi is the item @a svi*M+rwi of the queue, where
+   * @a M is the number of reaction wrappers.
+   *
+   * @copydoc DataModel
+   */
+  class DataModel_NRM : public DataModel_DM
+  {
+  /////////////////////////////////////
+  // Constructors
+  public:
+    // Default constructor
+    DataModel_NRM();
+
+    //! Copy constructor
+    DataModel_NRM(DataModel &) = delete;
+
+    // Destructor
+  virtual ~DataModel_NRM();
+
+  /////////////////////////////////////
+  // Methods
+  public:
+
+    /**
+     * Clear global data structures.
+     */
+  virtual void clearStructures()
+    {
+      ftReactions.free();
+      bScheduled = false;
+
+      // call base class method
+      DataModel_DM::clearStructures();
+    };
+
+    //! Assignement operator
+    DataModel_NRM& operator= (const DataModel_NRM&) = delete;
+
+  ////////////////////////////////
+  // Attributes
+  public:
+    //! Putative firing times of all reaction channels
+    detail::FiringTimes ftReactions;
+    //! Flag indicating that the firing times are set for the current trial
+    bool bScheduled;
+  };
+}  } // close namespaces pssalib and datamodel
+
+#endif /* PSSALIB_DATAMODEL_DATAMODEL_NRM_H_ */
@@ -20,6 +20,7 @@
 
 #include "./DataModel.h"
 #include "./detail/JaggedMatrix.hpp"
+#include "./detail/CSRMatrix.hpp"
 #include "./detail/Subvolume_PDM.hpp"
 #include "./detail/ReactionWrapper.hpp"
 
@@ -108,33 +109,65 @@ namespace datamodel
     //
 
     /**
-     * @copydoc DataModel::allocateSubvolume()
+     * @copydoc DataModel::allocateSubvolumes()
      */
-  virtual detail::Subvolume * allocateSubvolume()
+  virtual void allocateSubvolumes()
     {
-      return static_cast<detail::Subvolume *>(
-        new detail::Subvolume_PDM);
+      internalAllocateSubvolumes<detail::Subvolume_PDM>();
     };
 
     /**
-     * @copydoc DataModel::freeSubvolume()
+     * @copydoc DataModel::freeSubvolumes()
      */
-  virtual void freeSubvolume(detail::Subvolume * sv)
+  virtual void freeSubvolumes()
     {
-      delete static_cast<detail::Subvolume_PDM *>(sv);
+      internalFreeSubvolumes<detail::Subvolume_PDM>();
     };
 
+    /**
+     * @copydoc DataModel::allocateSubvolumesStorage()
+     */
+  virtual void allocateSubvolumesStorage();
+
+    /**
+     * @copydoc DataModel::freeSubvolumesStorage()
+     */
+  virtual void freeSubvolumesStorage();
+
+    /**
+     * Allocate the tables holding the partial propensities of all
+     * subvolumes and attach every subvolume to its row.
+     */
+  virtual void allocatePartialPropensities();
+
+    /**
+     * Free the tables holding the partial propensities of all subvolumes.
+     */
+  virtual void freePartialPropensities();
+
   /////////////////////////////////////
   // Methods
   public:
 
+    /**
+     * Store the partial propensity structures in contiguous arrays
+     * once their shape is final and allocate the partial propensities.
+     *
+     * @param U3 Indices of the propensities that need to be updated.
+     * @param L Look-up table from position in the partial propensity
+     * matrix to reaction wrapper.
+     */
+    void freeze(const detail::JaggedMatrix<PropensityIndex> & U3,
+                const detail::JaggedMatrix<detail::ReactionWrapper *> & L);
+
     /**
      * Clear global data structures.
      */
   virtual void clearStructures()
     {
-      arU3.clear();
-      aruL.clear();
+      freePartialPropensities();
+      arU3.free();
+      aruL.free();
 
       // call base class method
       DataModel::clearStructures();
@@ -169,14 +202,28 @@ namespace datamodel
 
   ////////////////////////////////
   // Attributes
+  protected:
+    //! Propensity of each group [subvolume x (species + 1)]
+    REAL                                   *m_ardLambda,
+    //! Total propensity of each group [subvolume x (species + 1)]
+                                           *m_ardSigma,
+    //! Initial propensity of each group [subvolume x (species + 1)]
+                                           *m_ardInitialLambda,
+    //! Initial total propensity of each group [subvolume x (species + 1)]
+                                           *m_ardInitialSigma,
+    //! Partial propensities [subvolume x reactions]
+                                           *m_ardPi,
+    //! Initial partial propensities [subvolume x reactions]
+                                           *m_ardInitialPi;
+
   public:
     //! Indices of the propensities that need to be updated after
     //! a given reaction has fired.
-    detail::JaggedMatrix<PropensityIndex>  arU3;
+    detail::CSRMatrix<PropensityIndex>     arU3;
 
     //! Look-up table to translate from position in the partial
     //! propensity matrix to reaction index.
-    detail::JaggedMatrix<detail::ReactionWrapper *> aruL;
+    detail::CSRMatrix<detail::ReactionWrapper *> aruL;
   };
 
 }  } // close namespaces pssalib and datamodel
@@ -56,20 +56,19 @@ namespace datamodel
     //
 
     /**
-     * @copydoc DataModel::allocateSubvolums
+     * @copydoc DataModel::allocateSubvolumes()
      */
-  virtual detail::Subvolume * allocateSubvolume()
+  virtual void allocateSubvolumes()
     {
-      return static_cast<detail::Subvolume *>(
-        new detail::Subvolume_PSSACR);
+      internalAllocateSubvolumes<detail::Subvolume_PSSACR>();
     };
 
     /**
-     * @copydoc DataModel::freeSubvolume()
+     * @copydoc DataModel::freeSubvolumes()
      */
-  virtual void freeSubvolume(detail::Subvolume * sv)
+  virtual void freeSubvolumes()
     {
-      delete static_cast<detail::Subvolume_PSSACR *>(sv);
+      internalFreeSubvolumes<detail::Subvolume_PSSACR>();
     };
 
   /////////////////////////////////////
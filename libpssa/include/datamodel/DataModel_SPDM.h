@@ -54,22 +54,41 @@ namespace datamodel
     //
 
     /**
-     * @copydoc DataModel::allocateSubvolume()
+     * @copydoc DataModel::allocateSubvolumes()
      */
-  virtual detail::Subvolume * allocateSubvolume()
+  virtual void allocateSubvolumes()
     {
-      return static_cast<detail::Subvolume *>(
-        new detail::Subvolume_SPDM);//internalAllocateSubvolumes<detail::Subvolume_SPDM>(n));
+      internalAllocateSubvolumes<detail::Subvolume_SPDM>();
     };
 
     /**
-     * @copydoc DataModel::freeSubvolume()
+     * @copydoc DataModel::freeSubvolumes()
      */
-  virtual void freeSubvolume(detail::Subvolume * sv)
+  virtual void freeSubvolumes()
     {
-      delete static_cast<detail::Subvolume_SPDM *>(sv);
+      internalFreeSubvolumes<detail::Subvolume_SPDM>();
     };
 
+    /**
+     * @copydoc DataModel::allocateSubvolumesStorage()
+     */
+  virtual void allocateSubvolumesStorage();
+
+    /**
+     * @copydoc DataModel::freeSubvolumesStorage()
+     */
+  virtual void freeSubvolumesStorage();
+
+    /**
+     * @copydoc DataModel_PDM::allocatePartialPropensities()
+     */
+  virtual void allocatePartialPropensities();
+
+    /**
+     * @copydoc DataModel_PDM::freePartialPropensities()
+     */
+  virtual void freePartialPropensities();
+
   /////////////////////////////////////
   // Methods
   public:
@@ -102,6 +121,12 @@ namespace datamodel
 
   ////////////////////////////////
   // Attributes
+  protected:
+    //! Sorted row order [subvolume x (species + 1)]
+    std::size_t *m_arunIndexerRows,
+    //! Sorted column order within each row [subvolume x reactions]
+                *m_arunIndexerCols;
+
   public:
     // Reactions
     //
@@ -22,6 +22,7 @@
 
 #include "../stdheaders.h"
 #include "../typedefs.h"
+#include "../util/Maths.h"
 
 namespace pssalib
 {
@@ -73,22 +74,23 @@ namespace datamodel
       void resize(UINTEGER n);
       // Clear the bin
       void clear();
+      // Empty the bin retaining its storage
+      void reset();
   };
 
   ////////////////////////////////
   //! \class PSSACR_Bins
   //! \brief Bins storage & mapping
+  //!
+  //! \details Bins are stored in a dense array indexed by the bin number,
+  //! i.e., the log2 exponent of the binned values. Non-empty bins are
+  //! marked in a bitmask, so that they can be traversed without touching
+  //! the empty ones.
   class PSSACR_Bins
   {
   ////////////////////////////////
   // Typedefs
   public:
-    typedef HASHMAP<UINTEGER, PSSACR_Bin> MAP_BINS;
-    typedef HASHMAP<UINTEGER, PSSACR_Bin>::iterator BINS_ITER;
-    typedef HASHMAP<UINTEGER, PSSACR_Bin>::const_iterator CONST_BINS_ITER;
-    typedef std::pair<BINS_ITER, BINS_ITER> PAIR_BINS_ITER;
-    typedef std::pair<CONST_BINS_ITER, CONST_BINS_ITER> CONST_PAIR_BINS_ITER;
-
     //! Structure for fast access to bins
     typedef struct tagBinsVals
     {
@@ -109,15 +111,18 @@ namespace datamodel
   ////////////////////////////////
   // Attributes
   protected:
-    MAP_BINS mapBins;
+    //! Bins indexed by their number, bin 0 is never used
+    std::vector<PSSACR_Bin> vBins;
+    //! Bitmask of non-empty bins
+    std::vector<UINTEGER> vunOccupied;
+    //! Sum of all binned values
+    REAL dTotal;
+    //! Number of binned values
+    UINTEGER unBinned;
+
     BinVals *binVals;
     UINTEGER unVals;
 
-    //! @internal Temporary variables
-    BINS_ITER it;
-    //! @internal Temporary variables
-    std::pair<BINS_ITER, bool> insRes;
-
   ////////////////////////////////
   // Constructors
   public:
@@ -127,26 +132,65 @@ namespace datamodel
     // Destructor
   virtual ~PSSACR_Bins();
 
-    ////////////////////////////////
-    // Methods
-    public:
+  ////////////////////////////////
+  // Methods
+  protected:
+    // Add a value to a bin
+    void insert(UINTEGER bin_no, UINTEGER idx, REAL val);
+
+    // Remove a value from its bin
+    void remove(UINTEGER idx);
+
+  public:
+    //! Get the number of bins, i.e. the largest bin number plus one
+  inline UINTEGER getBinsCount() const
+    {
+      return vBins.size();
+    }
+
+    //! Get the bin with number <i>bin_no</i>
+  inline const PSSACR_Bin & getBin(UINTEGER bin_no) const
+    {
+      return vBins[bin_no];
+    }
+
+    //! Get the sum of all binned values
+  inline REAL getTotal() const
+    {
+      return dTotal;
+    }
 
     /**
-     * Get a pair of iterators for iterating across all bins
+     * Find the largest number of a non-empty bin below a given one
      * 
-     * @param pit iterator pair
+     * @param bin_no bin number
+     * @return number of the non-empty bin or zero if there is none
      */
-  inline void getBins(CONST_PAIR_BINS_ITER &pit) const
+  inline UINTEGER getPrevOccupied(UINTEGER bin_no) const
     {
-      pit.first = mapBins.begin();
-      pit.second = mapBins.end();
+      if(0 == bin_no)
+        return 0;
+      --bin_no;
+
+      UINTEGER w = bin_no >> 5,
+               bits = vunOccupied[w] & (0xFFFFFFFFu >> (31 - (bin_no & 31)));
+      while(0 == bits)
+      {
+        if(0 == w)
+          return 0;
+        bits = vunOccupied[--w];
+      }
+
+      return (w << 5) + pssalib::maths::floor_log2(bits);
     }
 
     //! Clear bins
   inline void clear()
     {
-      if(mapBins.size() > 0)
-        mapBins.clear();
+      vBins.clear();
+      vunOccupied.clear();
+      dTotal = 0.0;
+      unBinned = 0;
       if(binVals != NULL)
       {
         delete [] binVals;
@@ -157,18 +201,27 @@ namespace datamodel
 
     /**
      * Resizes the bins to ensuring they have
-     * enough capacity to store N elements
+     * enough capacity to store N elements.
+     * If the capacity is unchanged, the bins are emptied
+     * without releasing the memory.
      * 
      * @param N new bin size
      */
     inline void resize(UINTEGER N)
     {
+      if((N == unVals)&&(NULL != binVals))
+      {
+        reset();
+        return;
+      }
       clear();
-      mapBins.rehash(N);
       binVals = new BinVals[N];
       unVals = N;
     }
 
+    // Empty all bins retaining the allocated memory
+    void reset();
+
     // Updates value in a bin
     void updateValue(UINTEGER bin_no_new, UINTEGER idx, REAL val);
 
@@ -21,6 +21,12 @@
 #include "./detail/VolumeDecomposition.hpp"
 #include "./../PSSA.h"
 #include "./../util/MPIWrapper.h"
+#include "./../util/EventTrace.h"
+#include "./../util/TrajectoryWriter.h"
+#include "./../util/EnsembleStatistics.h"
+#include "./../util/PopulationHistogram.h"
+
+#include <cstdint>
 
 namespace pssalib
 {
@@ -83,18 +89,35 @@ namespace datamodel
       ofTimePoints=0x0400, //!<Output time points
       ofTiming=0x0800,     //!<Output timing
       ofSpeciesIDs=0x1000, //!<Output species ids
-      ofMaskFile=0x1FF0,   //!<All file output flags
+      ofBinaryTrajectory=0x2000, //!<Output trajectories in binary format
+      ofAvgTrajectory=0x4000, //!<Output mean & variance of the trajectories
+      ofHistogram=0x8000,  //!<Output histograms of the final populations
+      ofMaskFile=0xFFF0,   //!<All file output flags
 
-      ofMaskAll=0x1FFF,    //!<All output flags
+      ofMaskAll=0xFFFF,    //!<All output flags
 
       // extended output flags
       eofModuleGrouping=0x10000,
       eofModuleSampling=0x20000,
       eofModuleUpdate=0x40000,
 
-      eofModuleAll=0x70000 //!<All modules
+      eofModuleAll=0x70000,//!<All modules
+
+      eofEvents=0x80000    //!<Structured trace of simulation events
     } OutputFlags;
 
+    //! Random number generators
+    typedef enum tagRNGType {
+      rngGSL=0,            //!<GSL generator (see GSL_RNG_TYPE), reseeded for each sample
+      rngPhilox            //!<Counter-based Philox4x32-10, reproducible for each sample
+    } RNGType;
+
+    //! Subvolume sampling schemes for spatial simulations
+    typedef enum tagVolumeSamplingType {
+      vsCompositionRejection=0, //!<Composition-rejection sampling of the subvolume propensities
+      vsNextSubvolume           //!<Next Subvolume Method, subvolume firing times in a priority queue
+    } VolumeSamplingType;
+
   /////////////////////////////////
   // Attributes
   protected:
@@ -119,15 +142,15 @@ namespace datamodel
     UINTEGER              *m_arunDims;
 
 #ifdef HAVE_MPI
-    //! Process block size [RESERVED]
+    //! Size of the chunk of samples currently processed by this process
     INTEGER               m_nBlockSize;
-    //! Process block offset [RESERVED]
+    //! First sample of the chunk currently processed by this process
     INTEGER               m_nBlockStart;
 #endif
 
     //! Internal & external output streams
-    FILESTREAMBUFFER      *m_arPtrFileBuffers[7];
-    STREAMBUFFER          *m_arPtrExternalBuffers[7];
+    FILESTREAMBUFFER      *m_arPtrFileBuffers[10];
+    STREAMBUFFER          *m_arPtrExternalBuffers[10];
 
     //! Array of species indices for output [RESERVED]
     std::vector<UINTEGER> m_arSpeciesIdx;
@@ -135,17 +158,35 @@ namespace datamodel
     //! Data structure describing the current model
     detail::Model         m_Model;
 
-    //! @internal Pointer to the output string buffer
-    STRING::pointer       m_ptrOutputLine;
-
     //! @internal Pointer to the current position in trajectory buffer
     UINTEGER              *m_ptrRawTrajectory,
                           *m_ptrCurrPopulation;
 
+    //! @internal Trajectory of the current trial kept for its completion record
+    UINTEGER              *m_arTrialTrajectory;
+
     //! @internal Current index in the output
     UINTEGER              m_unOutputIdx,
                           m_unOutputMax;
 
+    //! @internal Output stream bound to the requested stream buffer
+    OSTREAM               m_osOutput;
+
+    //! @internal Trajectory files are appended to instead of being truncated
+    bool                  m_bAppendOutput;
+
+    //! @internal Most recent simulation events of the current trial
+    util::EventTrace      m_etEvents;
+
+    //! @internal Writer of the text & binary trajectories
+    util::TrajectoryWriter m_twTrajectory;
+
+    //! @internal Mean & variance of the trajectories sampled by this instance
+    util::EnsembleStatistics m_esTrajectory;
+
+    //! @internal Histograms of the final populations sampled by this instance
+    util::PopulationHistogram m_phFinalPops;
+
   /////////////////////////////////
   // Attributes
   public:
@@ -168,6 +209,51 @@ namespace datamodel
     //! Number of samples the simulation [IN MANDATORY]
     UINTEGER             unSamplesTotal;
 
+    //! Number of threads used to sample the ensemble [IN OPTIONAL, default: 1]
+    //! @note Reaction callback, reaction events sink and population initializer may be called concurrently.
+    UINTEGER             unThreads;
+
+    //! Random number generator [IN OPTIONAL, default: rngGSL]
+    RNGType              eRNGType;
+
+    //! Seed of the random number generator [IN OPTIONAL, default: 0 - automatic]
+    //! @note An automatic seed is drawn anew for each run, the seed actually used is
+    //! reported in the log & returned by PSSA::getRNGSeed().
+    ULINTEGER            unRNGSeed;
+
+    //! Number of most recent events kept in the structured trace [IN OPTIONAL, default: 1024]
+    //! @note Only used if eofEvents is set & the library is built with trace messages.
+    UINTEGER             unEventTraceSize;
+
+    //! Number of output time points buffered for the trajectory writer thread [IN OPTIONAL, default: 16]
+    //! @note Trajectories are written by the sampling thread if set to 0, if they are
+    //! redirected to an external stream or if the library is built without threads.
+    UINTEGER             unOutputBuffers;
+
+    //! Number of bins in the histogram of each species in each subvolume [IN OPTIONAL, default: 256]
+    //! @note The bin width is doubled whenever a population exceeds the range of the bins.
+    UINTEGER             unHistogramBins;
+
+    //! Maximum number of distinct states in the joint histogram [IN OPTIONAL, default: 0 - disabled]
+    //! @note All states are counted while sampling, the most frequent ones are written.
+    UINTEGER             unHistogramStates;
+
+    //! Subvolume sampling scheme [IN OPTIONAL, default: vsCompositionRejection]
+    //! @note Ignored by the Next Reaction Method that schedules all reaction channels.
+    VolumeSamplingType   eVolumeSampling;
+
+    //! Wall-clock time between checkpoints of the sampling loop in seconds [IN OPTIONAL, default: 0 - disabled]
+    //! @note The checkpoint is saved to the output path & the sampling is resumed from it if it
+    //! exists, e.g. when the run is restarted after it was interrupted. It is removed once all
+    //! samples are done. Samples are drawn in a single thread while checkpoints are enabled.
+    UINTEGER             unCheckpointInterval;
+
+    //! Record each completed sample in the output path & skip the samples recorded by a previous
+    //! run [IN OPTIONAL, default: false]
+    //! @note Raising @ref unSamplesTotal extends an ensemble. Checkpoints are not saved while
+    //! completed samples are recorded.
+    bool                 bResumeEnsemble;
+
     // Simulation timing
     REAL dTimeCheckpoint, //!<last output time [RESERVED]
          dTimeStart,      //!<initial output time [IN OPTIONAL, default = 0.0]
@@ -324,10 +410,10 @@ namespace datamodel
     };
 
 #ifdef HAVE_MPI
-    //! Get the first index in the block
+    //! Get the first sample index in the current chunk
     INTEGER getBlockStart() const { return m_nBlockStart; }
 
-    //! Get block size
+    //! Get the size of the current chunk
     INTEGER getBlockSize() const { return m_nBlockSize; }
 #endif
 
@@ -395,15 +481,30 @@ namespace datamodel
       case ofSpeciesIDs:
         return 6;
         break;
-      case ofMaskFile:
+      case ofBinaryTrajectory:
         return 7;
         break;
+      case ofAvgTrajectory:
+        return 8;
+        break;
+      case ofHistogram:
+        return 9;
+        break;
+      case ofMaskFile:
+        return 10;
+        break;
       default:
         return std::numeric_limits<USHORT>::max();
       break;
       }
     }
 
+    //! Get the path of the file corresponding to a given type of output
+    bool getOutputFilePath(const OutputFlags of, STRING & strFilePath) const;
+
+    //! Get the path of the file corresponding to a given type of output of a sample
+    bool getOutputFilePath(const OutputFlags of, UINTEGER sample, STRING & strFilePath) const;
+
     //! Get the output stream corresponding to a given type of output
     OSTREAM & getOutputStream(const OutputFlags of);
 
@@ -432,7 +533,11 @@ namespace datamodel
     {
       if((of > ofMaskLog)&&(of < ofMaskFile))
       {
-        SHORT idx = outputFlagToStreamIndex(of);
+        USHORT idx = outputFlagToStreamIndex(of);
+
+        // raw output flags do not have a stream of their own
+        if(idx >= outputFlagToStreamIndex(ofMaskFile))
+          return;
 
         if(NULL != m_arPtrFileBuffers[idx])
         {
@@ -455,6 +560,12 @@ namespace datamodel
       return ((unOutputFlags & of) == of);
     }
 
+    //! Record the event that is about to be applied to the system state
+    void traceEvent();
+
+    //! Report the recorded events of the current trial via the output streams
+    void reportEvents();
+
     /////////////////////////////////
     // Timing
 
@@ -463,6 +574,12 @@ namespace datamodel
      */
     void setupTiming();
 
+    /**
+     * Allocate the output buffers once for all trials in the run.
+     * @return @true if successful, @false otherwise
+     */
+    bool setupTrialBuffers();
+
     /**
      * Begin timing of the trial.
      * @param sample Current sample number
@@ -475,6 +592,35 @@ namespace datamodel
      * @return time since last call to beginTrial in seconds
      */
     REAL_EXT endTrial();
+
+    /**
+     * Write the pending output of the trial & get the sizes of its
+     * trajectory files, e.g. to save the state of the trial.
+     * @param szText Size of the text trajectory file [OUT]
+     * @param szBinary Size of the binary trajectory file [OUT]
+     * @return @true if successful, @false otherwise
+     */
+    bool syncTrial(std::uint64_t & szText, std::uint64_t & szBinary);
+
+    /**
+     * Resume the timing & the output of a trial from a saved state, the
+     * trajectory files are truncated to the saved sizes & appended to.
+     * @param sample Current sample number
+     * @param outputIdx Saved output cursor
+     * @param timeSimulation Saved simulation time
+     * @param timeCheckpoint Saved next output time point
+     * @param szText Saved size of the text trajectory file
+     * @param szBinary Saved size of the binary trajectory file
+     */
+    bool resumeTrial(UINTEGER sample, UINTEGER outputIdx, REAL timeSimulation,
+                     REAL timeCheckpoint, std::uint64_t szText, std::uint64_t szBinary);
+
+    /**
+     * Get the trajectory of the current trial, if it is kept in memory.
+     * @param szValues Number of values output by the trial so far [OUT]
+     * @return Pointer to the output rows of the trial or @c NULL
+     */
+    const UINTEGER * getTrialTrajectory(std::size_t & szValues) const;
   };
 
 } } // close namespaces datamodel & pssalib
@@ -0,0 +1,275 @@
+/**
+ * @file CSRMatrix.hpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Declares a templatized matrix with variable row length stored
+ * in the compressed sparse row format
+ */
+
+#ifndef PSSALIB_DATAMODEL_DETAIL_CSRMATRIX_HPP_
+#define PSSALIB_DATAMODEL_DETAIL_CSRMATRIX_HPP_
+
+#include "../../typedefs.h"
+#include "JaggedMatrix.hpp"
+
+namespace pssalib
+{
+namespace datamodel
+{
+namespace detail
+{
+  /**
+   * @class CSRMatrix
+   * @brief A templetized matrix with variable but fixed row length.
+   *
+   * @details All elements are stored row after row in one contiguous
+   * array, row @a i occupies the positions @a offsets[i] to
+   * @a offsets[i+1]-1. The matrix is produced from a @ref JaggedMatrix
+   * by @ref freeze() once its shape is final. Several matrices of the same
+   * shape can share the row offsets of another one and the storage for
+   * their elements can be provided by the caller, see @ref bind().
+   */
+  template< typename A >
+  class CSRMatrix
+  {
+  ////////////////////////////////
+  // Attributes
+  protected:
+    std::size_t   uRows;   //!< number of rows in the matrix
+    std::size_t * uOffsets;//!< position of the first element of each row
+    A *           data;    //!< elements
+    bool          bOwner;  //!< @internal whether this instance owns the storage
+
+  /////////////////////////////////////
+  // Constructors
+  public:
+    //! Default constructor
+    CSRMatrix<A> () :
+      uRows(0),
+      uOffsets(NULL),
+      data(NULL),
+      bOwner(false)
+    {
+      // Do nothing
+    };
+
+    //! Copy constructor
+    CSRMatrix<A> (const CSRMatrix<A> &) = delete;
+
+    //! Destructor
+    ~CSRMatrix<A> ()
+    {
+      free();
+    }
+
+  /////////////////////////////////////
+  // Methods
+  public:
+    /**
+     * Copy a matrix with variable row length into the contiguous storage.
+     *
+     * @param other the matrix to copy from.
+     */
+    void freeze(const JaggedMatrix<A> & other)
+    {
+      free();
+
+      if(0 == other.get_rows())
+        return;
+
+      uRows = other.get_rows();
+      uOffsets = new std::size_t[uRows + 1];
+      uOffsets[0] = 0;
+      for(std::size_t i = 0; i < uRows; i++)
+        uOffsets[i + 1] = uOffsets[i] + other.get_cols(i);
+
+      data = new A[std::max(uOffsets[uRows], std::size_t(1))];
+      for(std::size_t i = 0; i < uRows; i++)
+        for(std::size_t j = 0; j < other.get_cols(i); j++)
+          data[uOffsets[i] + j] = other(i, j);
+
+      bOwner = true;
+    }
+
+    /**
+     * Make this matrix a view of an external storage, arranged
+     * in the same way as another matrix.
+     *
+     * @param shape matrix that provides the row offsets.
+     * @param values storage for @ref get_size() elements.
+     */
+    template< typename B >
+    void bind(const CSRMatrix<B> & shape, A * values)
+    {
+      free();
+
+      uRows = shape.get_rows();
+      uOffsets = shape.get_offsets();
+      data = values;
+    }
+
+    /**
+     * Copies the elements of another matrix of the same shape.
+     *
+     * @param other the matrix to copy from.
+     */
+    inline void assign(const CSRMatrix<A> & other)
+    {
+#ifndef PSSALIB_NO_BOUNDS_CHECKS
+      if(get_size() != other.get_size())
+        throw std::runtime_error("CSRMatrix<A>::assign() - invalid arguments.");
+#endif
+      std::copy(other.data, other.data + other.get_size(), data);
+    }
+
+    /**
+     * Get matrix element (const reference).
+     *
+     * @param i row index.
+     * @param j column index.
+     */
+    inline const A & operator()(std::size_t i, std::size_t j) const
+    {
+      return const_cast<const A &>(
+        const_cast<CSRMatrix<A> *>(this)->operator()(i,j));
+    };
+
+    /**
+     * Get matrix element.
+     *
+     * @param i row index.
+     * @param j column index.
+     */
+    inline A & operator()(std::size_t i, std::size_t j)
+    {
+#ifndef PSSALIB_NO_BOUNDS_CHECKS
+      if((i >= uRows)||(j >= uOffsets[i + 1] - uOffsets[i]))
+        throw std::runtime_error("CSRMatrix<A>::operator() - subscript out of range.");
+#endif
+      return data[uOffsets[i] + j];
+    };
+
+    /**
+     * Reset all elements, the shape is retained.
+     */
+    inline void clear()
+    {
+      std::fill_n(data, get_size(), A());
+    };
+
+    /**
+     * Free allocated resources.
+     */
+    inline void free()
+    {
+      if(bOwner)
+      {
+        delete [] uOffsets;
+        delete [] data;
+        bOwner = false;
+      }
+
+      uRows = 0;
+      uOffsets = NULL;
+      data = NULL;
+    }
+
+    /**
+     * Get number of rows.
+     *
+     * @return number of rows.
+     */
+    inline std::size_t get_rows() const
+    {
+      return uRows;
+    };
+
+    /**
+     * Get number of columns for a given row.
+     *
+     * @param row row index.
+     * @return number of columns for row @row .
+     */
+    inline std::size_t get_cols(std::size_t row) const
+    {
+#ifndef PSSALIB_NO_BOUNDS_CHECKS
+      if(row >= uRows)
+        throw std::runtime_error("CSRMatrix<A>::get_cols() - subscript out of range.");
+#endif
+      return uOffsets[row + 1] - uOffsets[row];
+    };
+
+    /**
+     * Get total number of elements.
+     *
+     * @return number of elements.
+     */
+    inline std::size_t get_size() const
+    {
+      return (0 == uRows) ? 0 : uOffsets[uRows];
+    };
+
+    /**
+     * Get row offsets.
+     *
+     * @return Vector containing position of the first element of each row.
+     */
+    inline std::size_t * get_offsets() const
+    {
+      return uOffsets;
+    };
+
+    /**
+     * Swap data within the same row
+     *
+     * @param i index of the row
+     * @param j1 index of the first column
+     * @param j2 index of the second column
+     */
+    inline void swap(std::size_t i, std::size_t j1, std::size_t j2)
+    {
+#ifndef PSSALIB_NO_BOUNDS_CHECKS
+      if((i >= uRows)||(std::max(j1,j2) >= uOffsets[i + 1] - uOffsets[i]))
+        throw std::runtime_error("CSRMatrix<A>::swap() - subscript out of range.");
+#endif
+      std::swap(data[uOffsets[i] + j1], data[uOffsets[i] + j2]);
+    }
+
+    //! Assignement operator
+    CSRMatrix<A> & operator= (const CSRMatrix<A> &) = delete;
+
+    /**
+     * Shift operator for console output
+     *
+     * @param output an instance of @link std::ostream
+     * @param M an instance of @link CSRMatrix<A>
+     */
+    friend std::ostream & operator<<(std::ostream & output,
+                                     const CSRMatrix<A> & M)
+    {
+      output << "Array [" << M.uRows << 'x'
+        << "*]" << std::endl << std::setprecision(7);
+      for(std::size_t i = 0; i < M.uRows; i++)
+      {
+        for(std::size_t j = 0; j < M.get_cols(i); j++)
+        {
+          output << std::setw(9) << M(i,j) << ' ';
+        }
+        output << std::endl;
+      }
+      return output;
+    };
+  };
+
+} } } // close namespaces detail, datamodel & pssalib
+
+#endif /* PSSALIB_DATAMODEL_DETAIL_CSRMATRIX_HPP_ */
@@ -0,0 +1,174 @@
+/**
+ * @file DelayQueue.hpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Declares a templatized priority queue of scheduled events
+ */
+
+#ifndef PSSALIB_DATAMODEL_DETAIL_DELAYQUEUE_HPP_
+#define PSSALIB_DATAMODEL_DETAIL_DELAYQUEUE_HPP_
+
+#include "../../typedefs.h"
+
+#include <algorithm>
+
+namespace pssalib
+{
+namespace datamodel
+{
+namespace detail
+{
+  /**
+   * @class DelayQueue
+   * @brief A templetized queue of scheduled events, e.g. delayed reactions,
+   * that are retrieved in the order of increasing time.
+   *
+   * @details Events are kept in a binary min-heap, so that an event
+   * is scheduled or removed in O(log N) operations, while the earliest
+   * event is available in O(1). The events are ordered by @c operator<
+   * of the template argument. The storage is retained when the queue is
+   * cleared, hence no memory is allocated once it has grown large enough.
+   */
+  template< typename T >
+  class DelayQueue
+  {
+  ////////////////////////////////
+  // Attributes
+  protected:
+    std::vector<T> vEvents; //!< scheduled events arranged in a heap
+
+    //! Heap ordering: earliest event on top
+    struct Later
+    {
+      inline bool operator()(const T & left, const T & right) const
+      {
+        return right < left;
+      }
+    };
+
+  /////////////////////////////////////
+  // Constructors
+  public:
+    //! Default constructor
+    DelayQueue<T> ()
+    {
+      // Do nothing
+    };
+
+    //! Copy constructor
+    DelayQueue<T> (const DelayQueue<T> &) = delete;
+
+    //! Destructor
+    ~DelayQueue<T> ()
+    {
+      // Do nothing
+    }
+
+  /////////////////////////////////////
+  // Methods
+  public:
+    /**
+     * Check whether there are any scheduled events.
+     *
+     * @return @true if the queue is empty, @false otherwise.
+     */
+    inline bool empty() const
+    {
+      return vEvents.empty();
+    }
+
+    /**
+     * Get number of scheduled events.
+     *
+     * @return number of events.
+     */
+    inline size_t size() const
+    {
+      return vEvents.size();
+    }
+
+    /**
+     * Remove all events, retaining the storage.
+     */
+    inline void clear()
+    {
+      vEvents.clear();
+    }
+
+    /**
+     * Schedule an event.
+     *
+     * @param e event.
+     */
+    inline void push(const T & e)
+    {
+      vEvents.push_back(e);
+      std::push_heap(vEvents.begin(), vEvents.end(), Later());
+    }
+
+    /**
+     * Get the earliest event.
+     *
+     * @return reference to the event on top of the queue.
+     */
+    inline const T & top() const
+    {
+#ifndef PSSALIB_NO_BOUNDS_CHECKS
+      if(vEvents.empty())
+        throw std::runtime_error("DelayQueue<T>::top() - queue is empty.");
+#endif
+      return vEvents.front();
+    }
+
+    /**
+     * Remove the earliest event.
+     */
+    inline void pop()
+    {
+#ifndef PSSALIB_NO_BOUNDS_CHECKS
+      if(vEvents.empty())
+        throw std::runtime_error("DelayQueue<T>::pop() - queue is empty.");
+#endif
+      std::pop_heap(vEvents.begin(), vEvents.end(), Later());
+      vEvents.pop_back();
+    }
+
+    /**
+     * Get the scheduled events in the order of the heap storage,
+     * e.g. to save the state of a trial.
+     *
+     * @return pointer to the first of @ref size() events.
+     */
+    inline const T * data() const
+    {
+      return vEvents.data();
+    }
+
+    /**
+     * Replace the scheduled events, e.g. when a trial is restored.
+     *
+     * @param arEvents events.
+     * @param n number of events.
+     */
+    inline void assign(const T * arEvents, size_t n)
+    {
+      vEvents.assign(arEvents, arEvents + n);
+      std::make_heap(vEvents.begin(), vEvents.end(), Later());
+    }
+
+    //! Assignement operator
+    DelayQueue<T> & operator= (const DelayQueue<T> &) = delete;
+  };
+
+} } } // close namespaces detail, datamodel & pssalib
+
+#endif /* PSSALIB_DATAMODEL_DETAIL_DELAYQUEUE_HPP_ */
@@ -0,0 +1,167 @@
+/**
+ * @file FiringTimes.hpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Declares a priority queue of putative firing times of independent
+ * exponential clocks
+ */
+
+#ifndef PSSALIB_DATAMODEL_DETAIL_FIRINGTIMES_HPP_
+#define PSSALIB_DATAMODEL_DETAIL_FIRINGTIMES_HPP_
+
+#include "../../typedefs.h"
+#include "IndexedHeap.hpp"
+
+namespace pssalib
+{
+namespace datamodel
+{
+namespace detail
+{
+  /**
+   * @class FiringTimes
+   * @brief Putative firing times of a set of exponential clocks,
+   * e.g. reaction channels or subvolumes, ordered in an indexed heap.
+   *
+   * @details When the rate of a clock changes, its firing time is rescaled
+   * as @f$ \tau' = t + (a/a')(\tau - t) @f$, hence only the clock that
+   * fired needs a new random number. A clock with zero rate keeps its
+   * remaining unit-rate waiting time until it is enabled again.
+   */
+  class FiringTimes : public IndexedHeap<REAL>
+  {
+  ////////////////////////////////
+  // Attributes
+  protected:
+    //! Remaining unit-rate waiting times of disabled clocks
+    REAL *ardDormant;
+
+  /////////////////////////////////////
+  // Constructors
+  public:
+    //! Default constructor
+    FiringTimes() :
+      IndexedHeap<REAL>(),
+      ardDormant(NULL)
+    {
+      // Do nothing
+    };
+
+    //! Copy constructor
+    FiringTimes(const FiringTimes &) = delete;
+
+    //! Destructor
+    ~FiringTimes()
+    {
+      free();
+    }
+
+  /////////////////////////////////////
+  // Methods
+  public:
+    /**
+     * Allocate memory for a given number of clocks.
+     * Storage is reused if the number of clocks does not change.
+     *
+     * @param uN number of clocks.
+     */
+    void allocate(UINTEGER uN)
+    {
+      if((uN == size())&&(NULL != ardDormant))
+        return;
+
+      free();
+
+      if(0 == uN)
+        return;
+
+      IndexedHeap<REAL>::allocate(uN);
+      ardDormant = new REAL[uN];
+      std::fill_n(ardDormant, uN, REAL(0.0));
+    }
+
+    /**
+     * Free allocated resources.
+     */
+    inline void free()
+    {
+      if(NULL != ardDormant)
+      {
+        delete [] ardDormant;
+        ardDormant = NULL;
+      }
+
+      IndexedHeap<REAL>::free();
+    }
+
+    /**
+     * Set the firing time of a clock without restoring the heap property,
+     * call @ref build() once all clocks are set.
+     *
+     * @param item Clock index
+     * @param a Rate
+     * @param e Unit-rate exponential waiting time
+     * @param t Current time
+     */
+    inline void set(UINTEGER item, REAL a, REAL e, REAL t)
+    {
+      if(a > 0.0)
+        key(item) = t + e / a;
+      else
+      {
+        ardDormant[item] = e;
+        key(item) = std::numeric_limits<REAL>::infinity();
+      }
+    }
+
+    /**
+     * Set the firing time of a clock.
+     *
+     * @param item Clock index
+     * @param a Rate
+     * @param e Unit-rate exponential waiting time
+     * @param t Current time
+     */
+    void schedule(UINTEGER item, REAL a, REAL e, REAL t)
+    {
+      if(a > 0.0)
+        update(item, t + e / a);
+      else
+      {
+        ardDormant[item] = e;
+        update(item, std::numeric_limits<REAL>::infinity());
+      }
+    }
+
+    /**
+     * Rescale the firing time of a clock after its rate has changed.
+     *
+     * @param item Clock index
+     * @param a Old rate
+     * @param a1 New rate
+     * @param t Current time
+     */
+    void reschedule(UINTEGER item, REAL a, REAL a1, REAL t)
+    {
+      if(a == a1)
+        return;
+
+      schedule(item, a1, (a > 0.0) ? a * (key(item) - t) : ardDormant[item], t);
+    }
+
+    //! Assignement operator
+    FiringTimes & operator= (const FiringTimes &) = delete;
+  };
+
+} } } // close namespaces detail, datamodel & pssalib
+
+#endif /* PSSALIB_DATAMODEL_DETAIL_FIRINGTIMES_HPP_ */
@@ -0,0 +1,277 @@
+/**
+ * @file IndexedHeap.hpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Declares a templatized indexed priority queue (binary min-heap)
+ */
+
+#ifndef PSSALIB_DATAMODEL_DETAIL_INDEXEDHEAP_HPP_
+#define PSSALIB_DATAMODEL_DETAIL_INDEXEDHEAP_HPP_
+
+#include "../../typedefs.h"
+
+namespace pssalib
+{
+namespace datamodel
+{
+namespace detail
+{
+  /**
+   * @class IndexedHeap
+   * @brief A templetized binary min-heap over a fixed set of items
+   * @a 0, ... , @a N-1, each associated with a key.
+   *
+   * @details The position of every item in the heap is tracked, so that
+   * the key of an arbitrary item can be changed in O(log N) operations,
+   * while the item with the smallest key is available in O(1).
+   */
+  template< typename K >
+  class IndexedHeap
+  {
+  ////////////////////////////////
+  // Attributes
+  protected:
+    UINTEGER unItems;  //!< number of items
+    K        *arKeys;  //!< key of each item
+    UINTEGER *arHeap,  //!< item at each heap node
+             *arNode;  //!< heap node of each item
+
+  /////////////////////////////////////
+  // Constructors
+  public:
+    //! Default constructor
+    IndexedHeap<K> () :
+      unItems(0),
+      arKeys(NULL),
+      arHeap(NULL),
+      arNode(NULL)
+    {
+      // Do nothing
+    };
+
+    //! Copy constructor
+    IndexedHeap<K> (const IndexedHeap<K> &) = delete;
+
+    //! Destructor
+    ~IndexedHeap<K> ()
+    {
+      free();
+    }
+
+  /////////////////////////////////////
+  // Methods
+  protected:
+    /**
+     * Place an item at a given heap node.
+     *
+     * @param n heap node.
+     * @param item item index.
+     */
+    inline void place(UINTEGER n, UINTEGER item)
+    {
+      arHeap[n] = item;
+      arNode[item] = n;
+    }
+
+    /**
+     * Move the item at a given node towards the root
+     * until the heap property is restored.
+     *
+     * @param n heap node.
+     */
+    void sift_up(UINTEGER n)
+    {
+      const UINTEGER item = arHeap[n];
+      while(n > 0)
+      {
+        UINTEGER p = (n - 1) >> 1;
+        if(!(arKeys[item] < arKeys[arHeap[p]]))
+          break;
+        place(n, arHeap[p]);
+        n = p;
+      }
+      place(n, item);
+    }
+
+    /**
+     * Move the item at a given node towards the leaves
+     * until the heap property is restored.
+     *
+     * @param n heap node.
+     */
+    void sift_down(UINTEGER n)
+    {
+      const UINTEGER item = arHeap[n];
+      for(UINTEGER c = 2*n + 1; c < unItems; c = 2*n + 1)
+      {
+        if((c + 1 < unItems)&&(arKeys[arHeap[c + 1]] < arKeys[arHeap[c]]))
+          ++c;
+        if(!(arKeys[arHeap[c]] < arKeys[item]))
+          break;
+        place(n, arHeap[c]);
+        n = c;
+      }
+      place(n, item);
+    }
+
+  public:
+    /**
+     * Allocate memory for a given number of items.
+     * Storage is reused if the number of items does not change.
+     *
+     * @param uN number of items.
+     */
+    void allocate(UINTEGER uN)
+    {
+      if((uN == unItems)&&(NULL != arKeys))
+        return;
+
+      free();
+
+      if(0 == uN)
+        return;
+
+      unItems = uN;
+      arKeys = new K[uN];
+      arHeap = new UINTEGER[uN];
+      arNode = new UINTEGER[uN];
+      for(UINTEGER i = 0; i < uN; ++i)
+      {
+        arKeys[i] = K();
+        place(i, i);
+      }
+    }
+
+    /**
+     * Free allocated resources.
+     */
+    inline void free()
+    {
+      if(NULL != arKeys)
+      {
+        delete [] arKeys;
+        arKeys = NULL;
+      }
+      if(NULL != arHeap)
+      {
+        delete [] arHeap;
+        arHeap = NULL;
+      }
+      if(NULL != arNode)
+      {
+        delete [] arNode;
+        arNode = NULL;
+      }
+      unItems = 0;
+    }
+
+    /**
+     * Get number of items.
+     *
+     * @return number of items.
+     */
+    inline UINTEGER size() const
+    {
+      return unItems;
+    }
+
+    /**
+     * Get the key of an item (const reference).
+     *
+     * @param item item index.
+     */
+    inline const K & key(UINTEGER item) const
+    {
+#ifndef PSSALIB_NO_BOUNDS_CHECKS
+      if(item >= unItems)
+        throw std::runtime_error("IndexedHeap<K>::key() - subscript out of range.");
+      else
+#endif
+        return arKeys[item];
+    }
+
+    /**
+     * Set the key of an item without restoring the heap property,
+     * e.g., before a call to @ref build() .
+     *
+     * @param item item index.
+     */
+    inline K & key(UINTEGER item)
+    {
+#ifndef PSSALIB_NO_BOUNDS_CHECKS
+      if(item >= unItems)
+        throw std::runtime_error("IndexedHeap<K>::key() - subscript out of range.");
+      else
+#endif
+        return arKeys[item];
+    }
+
+    /**
+     * Arrange all items according to their keys in O(N) operations.
+     */
+    void build()
+    {
+      for(UINTEGER n = unItems / 2; n > 0; --n)
+        sift_down(n - 1);
+    }
+
+    /**
+     * Change the key of an item and restore the heap property.
+     *
+     * @param item item index.
+     * @param k new key.
+     */
+    void update(UINTEGER item, const K & k)
+    {
+#ifndef PSSALIB_NO_BOUNDS_CHECKS
+      if(item >= unItems)
+        throw std::runtime_error("IndexedHeap<K>::update() - subscript out of range.");
+#endif
+      if(k < arKeys[item])
+      {
+        arKeys[item] = k;
+        sift_up(arNode[item]);
+      }
+      else
+      {
+        arKeys[item] = k;
+        sift_down(arNode[item]);
+      }
+    }
+
+    /**
+     * Get the item with the smallest key.
+     *
+     * @return item index.
+     */
+    inline UINTEGER top() const
+    {
+      return arHeap[0];
+    }
+
+    /**
+     * Get the smallest key.
+     *
+     * @return key of the item on top of the heap.
+     */
+    inline const K & top_key() const
+    {
+      return arKeys[arHeap[0]];
+    }
+
+    //! Assignement operator
+    IndexedHeap<K> & operator= (const IndexedHeap<K> &) = delete;
+  };
+
+} } } // close namespaces detail, datamodel & pssalib
+
+#endif /* PSSALIB_DATAMODEL_DETAIL_INDEXEDHEAP_HPP_ */
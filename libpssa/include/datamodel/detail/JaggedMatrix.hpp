@@ -240,6 +240,34 @@ namespace detail
       uInc = std::max(inc / uRows, std::size_t(1));
     }
 
+    /**
+     * Copies the elements of another class instance into this object.
+     * Storage is reused and only grown if necessary, hence repeated
+     * assignments of matrices of the same shape do not allocate memory.
+     * 
+     * @param other the class instance to copy from.
+     */
+    void assign(const JaggedMatrix<A> & other)
+    {
+      if(uRows != other.uRows)
+      {
+        free();
+        reserve(other.uRows, std::max(other.uInc, std::size_t(1)));
+      }
+
+      for(std::size_t i = 0; i < uRows; i++)
+      {
+        if(uCols_alloc[i] < other.uCols[i])
+        {
+          delete [] (data[i]);
+          data[i] = new A[other.uCols[i]];
+          uCols_alloc[i] = other.uCols[i];
+        }
+        std::copy(other.data[i], other.data[i] + other.uCols[i], data[i]);
+        uCols[i] = other.uCols[i];
+      }
+    }
+
     /**
      * Appends a new element at the end of a given row.
      * 
@@ -313,7 +313,7 @@ namespace detail
      * 
      * @return current value.
      */
-  inline UINTEGER getDelay() const
+  inline REAL getDelay() const
     {
       if(m_unFlags & rfDelayed)
         return m_dDelay;
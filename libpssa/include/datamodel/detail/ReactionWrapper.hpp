@@ -66,6 +66,9 @@ namespace detail
     //! flags
     UINTEGER unFlags;
 
+    //! rate constant scaled to the subvolume
+    REAL dRate;
+
   /////////////////////////////////////
   // Constructors
   public:
@@ -73,23 +76,26 @@ namespace detail
   explicit ReactionWrapper(UINTEGER serialNumber)
       : unSerialNumber(serialNumber)
       , unFlags(0)
+      , dRate(0.0)
     {
       // Do nothing
     };
 
     //! Constructor (ordinary reaction)
-    ReactionWrapper(Reaction * reaction, UINTEGER serialNumber, bool reverse = false)
+    ReactionWrapper(Reaction * reaction, UINTEGER serialNumber, REAL rate, bool reverse = false)
       : unSerialNumber(serialNumber)
       , unFlags(reverse ? rwfReverse : 0)
+      , dRate(rate)
     {
       // Do nothing
       component.ptrReaction = reaction;
     };
 
     //! Constructor (diffusion reaction)
-    ReactionWrapper(Species * species, UINTEGER serialNumber)
+    ReactionWrapper(Species * species, UINTEGER serialNumber, REAL rate)
       : unSerialNumber(serialNumber)
       , unFlags(rwfDiffusion)
+      , dRate(rate)
     {
       // Do nothing
       component.ptrSpecies = species;
@@ -99,6 +105,7 @@ namespace detail
     ReactionWrapper(const ReactionWrapper & right)
       : unSerialNumber(right.unSerialNumber)
       , unFlags(right.unFlags)
+      , dRate(right.dRate)
     {
       if(unFlags & rwfDiffusion)
         component.ptrSpecies = right.component.ptrSpecies;
@@ -159,18 +166,13 @@ namespace detail
     };
 
     /**
-     * Get the reaction rate.
+     * Get the reaction rate scaled to the subvolume.
      * 
      * @return current value.
      */
   inline REAL getRate() const
     {
-      if(unFlags & rwfDiffusion)
-        return component.ptrSpecies->getDiffusionConstant();
-      else if(unFlags & rwfReverse)
-        return component.ptrReaction->getReverseRate();
-      else
-        return component.ptrReaction->getForwardRate();
+      return dRate;
     };
 
     /**
@@ -324,7 +326,7 @@ namespace detail
     {
       if(unFlags & rwfDiffusion)
       {
-        os << component.ptrSpecies->toString() << " --" << component.ptrSpecies->getDiffusionConstant() << "--> " << component.ptrSpecies->toString();
+        os << component.ptrSpecies->toString() << " --" << getRate() << "--> " << component.ptrSpecies->toString();
       }
       else
       {
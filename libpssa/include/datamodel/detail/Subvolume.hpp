@@ -41,6 +41,11 @@ namespace detail
   /**
    * @class Subvolume
    * @brief Container defining a subreactor state
+   *
+   * @details The populations, total propensities and neighbour indices
+   * of all subvolumes are stored contiguously by the data model, see
+   * @ref pssalib::datamodel::DataModel. A Subvolume is a lightweight
+   * view of its row in these tables.
    */
   class Subvolume
   {
@@ -57,6 +62,8 @@ namespace detail
 
     //! Vector of current species population
     UINTEGER *arunPopulation;
+    //! Vector of initial species population
+    UINTEGER *arunInitialPopulation;
 
     // Subvolume
     //
@@ -64,34 +71,35 @@ namespace detail
     //! Indexes of the neighboring subvolumes
     UINTEGER *arNeighbouringSubvolumes;
 
+    // Reactions
+    //
+
+    //! Total propensity
+    REAL     *pdTotalPropensity;
+    //! Initial total propensity
+    REAL     *pdInitialTotalPropensity;
+
     // Debugging
 #ifndef PSSALIB_NO_BOUNDS_CHECKS
     UINTEGER unSpecies, unReactions;
     BYTE     uDims;
 #endif
 
-  ////////////////////////////////
-  // Attributes
-  public:
-    // Reactions
-    //
-
-    //! Total propensity
-    REAL     dTotalPropensity;
-
   ////////////////////////////////
   // Constructors
   public:
     //! Constructor
     Subvolume()
       : arunPopulation(NULL)
+      , arunInitialPopulation(NULL)
       , arNeighbouringSubvolumes(NULL)
+      , pdTotalPropensity(NULL)
+      , pdInitialTotalPropensity(NULL)
 #ifndef PSSALIB_NO_BOUNDS_CHECKS
       , unSpecies(0)
       , unReactions(0)
       , uDims(0)
 #endif
-      , dTotalPropensity(0.0)
     {
       // Do nothing
     }
@@ -111,26 +119,21 @@ namespace detail
      */
   virtual void free()
     {
-      if(NULL != arunPopulation)
-      {
-        delete [] arunPopulation;
-        arunPopulation = NULL;
-      }
-      if(NULL != arNeighbouringSubvolumes)
-      {
-        delete [] arNeighbouringSubvolumes;
-        arNeighbouringSubvolumes = NULL;
-      }
+      arunPopulation = NULL;
+      arunInitialPopulation = NULL;
+      arNeighbouringSubvolumes = NULL;
+      pdTotalPropensity = NULL;
+      pdInitialTotalPropensity = NULL;
 #ifndef PSSALIB_NO_BOUNDS_CHECKS
       unSpecies = 0;
       unReactions = 0;
       uDims = 0;
 #endif
-      dTotalPropensity = 0.0;
     };
 
     /**
-     * Allocate memory for subvolume data structures.
+     * Allocate memory for subvolume data structures that are not
+     * stored by the data model.
      * 
      * @param reactions number of reactions in the model.
      * @param species number of species in the model.
@@ -141,11 +144,6 @@ namespace detail
       // clean up
       free();
 
-      // allocate memory
-      arunPopulation = new UINTEGER[species];
-      if(0 != dims)
-        arNeighbouringSubvolumes = new UINTEGER[2*dims];
-
 #ifndef PSSALIB_NO_BOUNDS_CHECKS
       unReactions = reactions;
       unSpecies = species;
@@ -164,6 +162,30 @@ namespace detail
       memset(arunPopulation, (unsigned char)0, sizeof(UINTEGER)*species);
     };
 
+    /**
+     * Store the current simulation state as the initial state.
+     * 
+     * @param reactions number of reactions in the model.
+     * @param species number of species in the model.
+     */
+  virtual void store(UINTEGER reactions, UINTEGER species)
+    {
+      memcpy(arunInitialPopulation, arunPopulation, sizeof(UINTEGER)*species);
+      *pdInitialTotalPropensity = *pdTotalPropensity;
+    };
+
+    /**
+     * Restore the simulation state from the initial state.
+     * 
+     * @param reactions number of reactions in the model.
+     * @param species number of species in the model.
+     */
+  virtual void restore(UINTEGER reactions, UINTEGER species)
+    {
+      memcpy(arunPopulation, arunInitialPopulation, sizeof(UINTEGER)*species);
+      *pdTotalPropensity = *pdInitialTotalPropensity;
+    };
+
   ////////////////////////////////
   // Methods
   public:
@@ -218,6 +240,26 @@ namespace detail
       return arunPopulation[index];
     }
 
+    /**
+     * Get total propensity of the subvolume
+     * 
+     * @return Reference to the total propensity
+     */
+  inline REAL & totalPropensity()
+    {
+      return *pdTotalPropensity;
+    }
+
+    /**
+     * Get total propensity of the subvolume
+     * 
+     * @return Total propensity
+     */
+  inline REAL totalPropensity() const
+    {
+      return *pdTotalPropensity;
+    }
+
     /**
      * Get subvolume neightbour
      * 
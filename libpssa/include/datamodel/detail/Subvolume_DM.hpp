@@ -20,6 +20,12 @@
 
 #include "../../typedefs.h"
 
+/**
+ * Number of incremental propensity updates (at least the number of
+ * reactions) after which the total propensity of a subvolume is summed anew
+ */
+#define PSSALIB_DM_RESUM_INTERVAL 1024
+
 namespace pssalib
 {
 namespace datamodel
@@ -39,7 +45,7 @@ namespace detail
   ////////////////////////////////
   // Friends
   public:
-    friend class DataModel_DM;
+    friend class pssalib::datamodel::DataModel_DM;
 
   ////////////////////////////////
   // Attributes
@@ -49,6 +55,10 @@ namespace detail
 
     //! Propensities
     REAL *ardPi;
+    //! Initial propensities
+    REAL *ardInitialPi;
+    //! Incremental updates of the total propensity since it was last summed up
+    UINTEGER unUpdates;
 
   ////////////////////////////////
   // Constructors
@@ -56,6 +66,8 @@ namespace detail
     //! Constructor
     Subvolume_DM()
       : ardPi(NULL)
+      , ardInitialPi(NULL)
+      , unUpdates(0)
     {
       // Do nothing
     }
@@ -75,30 +87,34 @@ namespace detail
      */
   virtual void free() 
     {
-      if(NULL != ardPi)
-      {
-        delete [] ardPi;
-        ardPi = NULL;
-      }
+      ardPi = NULL;
+      ardInitialPi = NULL;
+      unUpdates = 0;
 
       Subvolume::free();
     };
 
     /**
-     * Allocate the subvolume datastructure
-     * 
-     * @param reactions number of reactions in the model
-     * @param species number of species in the model
-     * @param dims number of spatial dimensions
+     * @copydoc Subvolume::store(UINTEGER,UINTEGER)
      */
-  virtual void allocate(UINTEGER reactions, UINTEGER species, BYTE dims)
+  virtual void store(UINTEGER reactions, UINTEGER species)
     {
+      memcpy(ardInitialPi, ardPi, sizeof(REAL)*reactions);
+
       // call base class method
-      Subvolume::allocate(reactions, species, dims);
+      Subvolume::store(reactions, species);
+    };
 
-      // allocate memory
-      ardPi = new REAL[reactions];
-      std::fill_n(ardPi, reactions, REAL(0.0));
+    /**
+     * @copydoc Subvolume::restore(UINTEGER,UINTEGER)
+     */
+  virtual void restore(UINTEGER reactions, UINTEGER species)
+    {
+      memcpy(ardPi, ardInitialPi, sizeof(REAL)*reactions);
+      unUpdates = 0;
+
+      // call base class method
+      Subvolume::restore(reactions, species);
     };
 
   ////////////////////////////////
@@ -120,6 +136,43 @@ namespace detail
       return ardPi[index];
     }
 
+    /**
+     * Sum up the total propensity of the subvolume anew
+     * from the reaction propensities
+     */
+  inline void sumPropensities()
+    {
+      REAL total = 0.0;
+      for(UINTEGER i = 0; i < unReactions; ++i)
+        total += ardPi[i];
+
+      totalPropensity() = total;
+      unUpdates = 0;
+    }
+
+    /**
+     * Set reaction propensity and update the total propensity incrementally.
+     * The total is summed anew every once in a while and whenever it cancels
+     * down to the roundoff of the update, so that the error does not build up
+     * over long trials.
+     * 
+     * @param index Reaction index in the model
+     * @param value New reaction propensity
+     */
+  inline void updatePropensity(UINTEGER index, REAL value)
+    {
+      REAL & pi = propensity(index);
+      const REAL scale = std::max(pi, value);
+
+      totalPropensity() += value - pi;
+      pi = value;
+
+      if((++unUpdates >= std::max<UINTEGER>(unReactions, PSSALIB_DM_RESUM_INTERVAL))||
+        ((totalPropensity() != 0.0)&&
+         (totalPropensity() <= REAL(PSSALIB_DM_RESUM_INTERVAL)*std::numeric_limits<REAL>::epsilon()*scale)))
+        sumPropensities();
+    }
+
   };
 
 } } } // close namespaces detail, datamodel & pssalib
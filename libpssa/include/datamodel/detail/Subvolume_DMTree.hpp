@@ -0,0 +1,207 @@
+/**
+ * @file Subvolume_DMTree.hpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ * 
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Declares a container for subvolume variables used by the
+ * Direct Method with a binary sum tree of propensities
+ */
+
+#ifndef PSSALIB_DATAMODEL_DETAIL_SUBVOLUME_DMTREE_HPP_
+#define PSSALIB_DATAMODEL_DETAIL_SUBVOLUME_DMTREE_HPP_
+
+#include "../../typedefs.h"
+#include "Subvolume_DM.hpp"
+
+namespace pssalib
+{
+namespace datamodel
+{
+
+  // Forward declaration
+  class DataModel_DMTree;
+
+namespace detail
+{
+  /**
+   * @class Subvolume_DMTree
+   * @brief Container defining a subreactor state with reaction
+   * propensities stored in the leaves of a complete binary sum tree.
+   *
+   * @details Node @a i of the tree stores the sum of its children
+   * @a 2i and @a 2i+1, the root is node 1 and the leaves start at
+   * node @a unLeaves. Both updating a propensity and sampling a reaction
+   * take O(log M) operations.
+   */
+  class Subvolume_DMTree : public Subvolume_DM
+  {
+  ////////////////////////////////
+  // Friends
+  public:
+    friend class pssalib::datamodel::DataModel_DMTree;
+
+  ////////////////////////////////
+  // Attributes
+  protected:
+    //! Number of leaves (power of two)
+    UINTEGER unLeaves;
+    //! Sum tree
+    REAL *ardTree;
+    //! Initial sum tree
+    REAL *ardInitialTree;
+
+  ////////////////////////////////
+  // Constructors
+  public:
+    //! Constructor
+    Subvolume_DMTree()
+      : unLeaves(0)
+      , ardTree(NULL)
+      , ardInitialTree(NULL)
+    {
+      // Do nothing
+    }
+
+    //! Destructor
+  virtual ~Subvolume_DMTree()
+    {
+      // Clean-up
+      free();
+    }
+
+  ////////////////////////////////
+  // Methods
+  protected:
+    /**
+     * @copydoc Subvolume::free()
+     */
+  virtual void free() 
+    {
+      if(NULL != ardTree)
+      {
+        delete [] ardTree;
+        ardTree = NULL;
+      }
+      if(NULL != ardInitialTree)
+      {
+        delete [] ardInitialTree;
+        ardInitialTree = NULL;
+      }
+      unLeaves = 0;
+
+      Subvolume_DM::free();
+    };
+
+    /**
+     * @copydoc Subvolume::allocate(UINTEGER,UINTEGER,BYTE)
+     */
+  virtual void allocate(UINTEGER reactions, UINTEGER species, BYTE dims)
+    {
+      // call base class method
+      Subvolume_DM::allocate(reactions, species, dims);
+
+      // allocate memory
+      unLeaves = 1;
+      while(unLeaves < reactions)
+        unLeaves <<= 1;
+      ardTree = new REAL[2*unLeaves];
+      std::fill_n(ardTree, 2*unLeaves, REAL(0.0));
+      ardInitialTree = new REAL[2*unLeaves];
+      std::fill_n(ardInitialTree, 2*unLeaves, REAL(0.0));
+    };
+
+    /**
+     * @copydoc Subvolume::store(UINTEGER,UINTEGER)
+     */
+  virtual void store(UINTEGER reactions, UINTEGER species)
+    {
+      memcpy(ardInitialTree, ardTree, sizeof(REAL)*2*unLeaves);
+
+      // call base class method
+      Subvolume_DM::store(reactions, species);
+    };
+
+    /**
+     * @copydoc Subvolume::restore(UINTEGER,UINTEGER)
+     */
+  virtual void restore(UINTEGER reactions, UINTEGER species)
+    {
+      memcpy(ardTree, ardInitialTree, sizeof(REAL)*2*unLeaves);
+
+      // call base class method
+      Subvolume_DM::restore(reactions, species);
+    };
+
+  ////////////////////////////////
+  // Methods
+  public:
+
+    /**
+     * Build the sum tree from the propensities
+     * 
+     * @param reactions number of reactions in the model
+     */
+  inline void buildTree(UINTEGER reactions)
+    {
+      memcpy(ardTree + unLeaves, ardPi, sizeof(REAL)*reactions);
+      std::fill(ardTree + unLeaves + reactions, ardTree + 2*unLeaves, REAL(0.0));
+      for(UINTEGER i = unLeaves - 1; i > 0; --i)
+        ardTree[i] = ardTree[2*i] + ardTree[2*i+1];
+
+      totalPropensity() = ardTree[1];
+    }
+
+    /**
+     * Set reaction propensity and update the sums along the path to the root
+     * 
+     * @param index Reaction index in the model
+     * @param value New reaction propensity
+     */
+  inline void updatePropensity(UINTEGER index, REAL value)
+    {
+      propensity(index) = value;
+
+      UINTEGER i = unLeaves + index;
+      ardTree[i] = value;
+      for(i >>= 1; i > 0; i >>= 1)
+        ardTree[i] = ardTree[2*i] + ardTree[2*i+1];
+
+      totalPropensity() = ardTree[1];
+    }
+
+    /**
+     * Find the reaction whose cumulative propensity interval contains
+     * a given value
+     * 
+     * @param r Value in the range [0, totalPropensity())
+     * @return Reaction index in the model
+     */
+  inline UINTEGER sampleReaction(REAL r) const
+    {
+      UINTEGER i = 1;
+      while(i < unLeaves)
+      {
+        i <<= 1;
+        // never descend into a subtree with vanishing propensity
+        if((r >= ardTree[i])&&(ardTree[i+1] > 0.0))
+        {
+          r -= ardTree[i];
+          ++i;
+        }
+      }
+
+      return i - unLeaves;
+    }
+  };
+
+} } } // close namespaces detail, datamodel & pssalib
+
+#endif /* PSSALIB_DATAMODEL_DETAIL_SUBVOLUME_DMTREE_HPP_ */
@@ -20,7 +20,7 @@
 #define PSSALIB_DATAMODEL_DETAIL_SUBVOLUME_PDM_HPP_
 
 #include "../../stdheaders.h"
-#include "JaggedMatrix.hpp"
+#include "CSRMatrix.hpp"
 #include "Subvolume.hpp"
 
 namespace pssalib
@@ -41,7 +41,7 @@ namespace detail
   ////////////////////////////////
   // Friends
   public:
-    friend class DataModel_PDM;
+    friend class pssalib::datamodel::DataModel_PDM;
 
   ////////////////////////////////
   // Data structures
@@ -58,6 +58,13 @@ namespace detail
     //! Total propensity of each group
     REAL                       *m_ardSigma;
 
+    //! Initial propensity of each group
+    REAL                       *m_ardInitialLambda;
+    //! Initial total propensity of each group
+    REAL                       *m_ardInitialSigma;
+    //! Initial partial propensities
+    CSRMatrix<REAL>            m_arInitialPi;
+
   ////////////////////////////////
   // Attributes
   public:
@@ -65,7 +72,7 @@ namespace detail
     //
 
     //! Array of arrays of reaction partial propensities.
-    JaggedMatrix<REAL>         arPi;
+    CSRMatrix<REAL>            arPi;
 
   ////////////////////////////////
   // Constructors
@@ -74,6 +81,8 @@ namespace detail
     Subvolume_PDM()
       : m_ardLambda(NULL)
       , m_ardSigma(NULL)
+      , m_ardInitialLambda(NULL)
+      , m_ardInitialSigma(NULL)
     {
       // Do nothing
     }
@@ -94,16 +103,12 @@ namespace detail
      */
     void free_PDM() 
     {
-      if(NULL != m_ardLambda)
-      {
-        delete [] m_ardLambda;
-        m_ardLambda = NULL;
-      }
-      if(NULL != m_ardSigma)
-      {
-        delete [] m_ardSigma;
-        m_ardSigma = NULL;
-      }
+      m_ardLambda = NULL;
+      m_ardSigma = NULL;
+      m_ardInitialLambda = NULL;
+      m_ardInitialSigma = NULL;
+      arPi.free();
+      m_arInitialPi.free();
     };
 
   ////////////////////////////////
@@ -123,34 +128,45 @@ namespace detail
     };
 
     /**
-     * @copydoc Subvolume::allocate(UINTEGER,UINTEGER,BYTE)
+     * @copydoc Subvolume::clear(UINTEGER,UINTEGER)
      */
-  virtual void allocate(UINTEGER reactions, UINTEGER species, BYTE dims)
+  virtual void clear(UINTEGER reactions, UINTEGER species)
     {
+      const UINTEGER total_species = species + 1; // account for reservoir species
+      memset(m_ardLambda, (unsigned char)0, sizeof(REAL)*(total_species));
+      memset(m_ardSigma, (unsigned char)0, sizeof(REAL)*(total_species));
+      arPi.clear();
+
       // call base class method
-      Subvolume::allocate(reactions, species, dims);
+      Subvolume::clear(reactions, species);
+    };
 
-      // allocate memory
+    /**
+     * @copydoc Subvolume::store(UINTEGER,UINTEGER)
+     */
+  virtual void store(UINTEGER reactions, UINTEGER species)
+    {
       const UINTEGER total_species = species + 1; // account for reservoir species
-      m_ardLambda = new REAL[total_species];
-      memset(m_ardLambda, 0, sizeof(REAL)*(total_species));
-      m_ardSigma = new REAL[total_species];
-      memset(m_ardSigma, 0, sizeof(REAL)*(total_species));
-      arPi.reserve(total_species, std::max(reactions / species, (UINTEGER)1));
+      memcpy(m_ardInitialLambda, m_ardLambda, sizeof(REAL)*(total_species));
+      memcpy(m_ardInitialSigma, m_ardSigma, sizeof(REAL)*(total_species));
+      m_arInitialPi.assign(arPi);
+
+      // call base class method
+      Subvolume::store(reactions, species);
     };
 
     /**
-     * @copydoc Subvolume::clear(UINTEGER,UINTEGER)
+     * @copydoc Subvolume::restore(UINTEGER,UINTEGER)
      */
-  virtual void clear(UINTEGER reactions, UINTEGER species)
+  virtual void restore(UINTEGER reactions, UINTEGER species)
     {
       const UINTEGER total_species = species + 1; // account for reservoir species
-      memset(m_ardLambda, (unsigned char)0, sizeof(REAL)*(total_species));
-      memset(m_ardSigma, (unsigned char)0, sizeof(REAL)*(total_species));
-      arPi.clear();
+      memcpy(m_ardLambda, m_ardInitialLambda, sizeof(REAL)*(total_species));
+      memcpy(m_ardSigma, m_ardInitialSigma, sizeof(REAL)*(total_species));
+      arPi.assign(m_arInitialPi);
 
       // call base class method
-      Subvolume::clear(reactions, species);
+      Subvolume::restore(reactions, species);
     };
 
 
@@ -39,7 +39,7 @@ namespace detail
   ////////////////////////////////
   // Friends
   public:
-    friend class DataModel_PSSACR;
+    friend class pssalib::datamodel::DataModel_PSSACR;
 
   ////////////////////////////////
   // Attributes
@@ -19,7 +19,7 @@
 #define PSSALIB_DATAMODEL_DETAIL_SUBVOLUME_SPDM_HPP_
 
 #include "../../stdheaders.h"
-#include "JaggedMatrix.hpp"
+#include "CSRMatrix.hpp"
 #include "Subvolume_PDM.hpp"
 
 namespace pssalib
@@ -40,7 +40,7 @@ namespace detail
   ////////////////////////////////
   // Friends
   public:
-    friend class DataModel_SPDM;
+    friend class pssalib::datamodel::DataModel_SPDM;
 
   ////////////////////////////////
   // Data structures
@@ -70,7 +70,7 @@ namespace detail
 
     // Indexer variables
     std::size_t                 *m_IndexerRows;
-    JaggedMatrix< std::size_t > m_IndexerCols;
+    CSRMatrix< std::size_t >    m_IndexerCols;
 
   ////////////////////////////////
   // Constructors
@@ -98,11 +98,7 @@ namespace detail
      */
     void free_SPDM()
     {
-      if(NULL != m_IndexerRows)
-      {
-        delete [] m_IndexerRows;
-        m_IndexerRows = NULL;
-      }
+      m_IndexerRows = NULL;
       m_IndexerCols.free();
     };
 
@@ -121,21 +117,6 @@ namespace detail
       Subvolume_PDM::free();
     };
 
-    /**
-     * @copydoc Subvolume::allocate(UINTEGER,UINTEGER,BYTE)
-     */
-  virtual void allocate(UINTEGER reactions, UINTEGER species, BYTE dims)
-    {
-      // call base class method
-      Subvolume_PDM::allocate(reactions, species, dims);
-
-      // allocate memory
-      UINTEGER total_species = species + 1; // account for reservoir species
-      m_IndexerRows = new std::size_t[total_species];
-      memset(m_IndexerRows, (unsigned char)0, sizeof(std::size_t)*(total_species));
-      m_IndexerCols.reserve(total_species, std::max(reactions / species, (UINTEGER)1));
-    };
-
     /**
      * @copydoc Subvolume::clear(UINTEGER,UINTEGER)
      */
@@ -159,9 +140,8 @@ namespace detail
   inline void resetIndexing()
     {
       std::generate_n(m_IndexerRows, arPi.get_rows(), tagGenerateSequence());
-      m_IndexerCols.resize(arPi.get_rows(), arPi.get_cols());
-      for(std::size_t row = 0; row < arPi.get_rows(); ++row)
-        for(std::size_t col = 0; col < arPi.get_cols(row); ++col)
+      for(std::size_t row = 0; row < m_IndexerCols.get_rows(); ++row)
+        for(std::size_t col = 0; col < m_IndexerCols.get_cols(row); ++col)
           m_IndexerCols(row, col) = col;
     };
 
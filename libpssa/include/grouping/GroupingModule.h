@@ -57,6 +57,17 @@ namespace grouping
     //! Flag for successful loading of data
     bool bDataLoaded;
 
+    //! Flag for the initial population being the same in every trial
+    bool bFixedInitialPopulation;
+
+    //! Storage for the initial population (allocated once per run)
+    boost::scoped_array< UINTEGER > arPopulation;
+    //! Per-subvolume pointers into arPopulation
+    boost::scoped_array< UINTEGER * > arPtrPopulation;
+
+    //! @internal Population restored by restore(), NULL otherwise
+    const UINTEGER * ptrRestoredPopulation;
+
   ////////////////////////////////
   // Constructors
   public:
@@ -75,11 +86,21 @@ namespace grouping
     // Parse the SBML model
   virtual bool preinitialize(pssalib::datamodel::SimulationInfo *);
 
-    // Initialize simulation data structures (called before each trial)
+    // Build static data structures & the initial state (called once per run)
+  virtual bool compile(pssalib::datamodel::SimulationInfo *);
+
+    // Reset simulation data structures (called before each trial)
   virtual bool initialize(pssalib::datamodel::SimulationInfo *);
 
     // Initialize composition-rejection sampler for subvolumes
   virtual void postInitialize(pssalib::datamodel::SimulationInfo *);
+
+    // Rebuild the data structures of a trial for a given population
+    bool restore(pssalib::datamodel::SimulationInfo *, const UINTEGER *);
+
+  protected:
+    // Setup the initial population
+    bool setupPopulation(pssalib::datamodel::SimulationInfo *);
   };
 
 }  } // close namespaces pssalib and grouping
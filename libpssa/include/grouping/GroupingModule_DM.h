@@ -46,8 +46,15 @@ namespace grouping
   ////////////////////////////////
   // Methods
   public:
-    // Calculate total propensity
+    // Calculate propensities & the initial state (called once per run)
+virtual bool compile(pssalib::datamodel::SimulationInfo *);
+
+    // Reset propensities (called before each trial)
 virtual bool initialize(pssalib::datamodel::SimulationInfo *);
+
+  protected:
+    // Calculate propensities from the current population
+virtual void computePropensities(pssalib::datamodel::SimulationInfo *);
   };
 
 }  } // close namespaces pssalib and grouping
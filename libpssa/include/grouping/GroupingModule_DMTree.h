@@ -0,0 +1,56 @@
+/**
+ * @file GroupingModule_DMTree.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ * 
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Grouping module definition for the Direct Method with a sum tree
+ */
+
+#ifndef PSSALIB_GROUPING_GROUPINGMODULE_DMTREE_H_
+#define PSSALIB_GROUPING_GROUPINGMODULE_DMTREE_H_
+
+#include "./GroupingModule_DM.h"
+
+namespace pssalib
+{
+namespace grouping
+{
+  /**
+   * \class GroupingModule_DMTree
+   * \brief Fill in the datastructures for the Direct Method with
+   * propensities stored in a binary sum tree.
+   * 
+   * \copydetails GroupingModule
+   */
+  class GroupingModule_DMTree : public GroupingModule_DM
+  {
+  ////////////////////////////////
+  // Constructors
+  public:
+    // Default constructor
+    GroupingModule_DMTree();
+
+    // Copy constructor
+    GroupingModule_DMTree(GroupingModule &);
+
+    // Destructor
+    virtual ~GroupingModule_DMTree();
+
+  ////////////////////////////////
+  // Methods
+  protected:
+    // Calculate propensities from the current population & build the sum trees
+virtual void computePropensities(pssalib::datamodel::SimulationInfo *);
+  };
+
+}  } // close namespaces pssalib and grouping
+
+#endif /* PSSALIB_GROUPING_GROUPINGMODULE_DMTREE_H_ */
@@ -0,0 +1,58 @@
+/**
+ * @file GroupingModule_NRM.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ * 
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Grouping module definition for the Next Reaction Method
+ */
+
+#ifndef PSSALIB_GROUPING_GROUPINGMODULE_NRM_H_
+#define PSSALIB_GROUPING_GROUPINGMODULE_NRM_H_
+
+#include "./GroupingModule_DM.h"
+
+namespace pssalib
+{
+namespace grouping
+{
+  /**
+   * \class GroupingModule_NRM
+   * \brief Fill in the datastructures for the Next Reaction Method.
+   * 
+   * \copydetails GroupingModule
+   */
+  class GroupingModule_NRM : public GroupingModule_DM
+  {
+  ////////////////////////////////
+  // Constructors
+  public:
+    // Default constructor
+    GroupingModule_NRM();
+
+    // Copy constructor
+    GroupingModule_NRM(GroupingModule &);
+
+    // Destructor
+    virtual ~GroupingModule_NRM();
+
+  ////////////////////////////////
+  // Methods
+  public:
+    // Calculate propensities & allocate the firing times (called once per run)
+virtual bool compile(pssalib::datamodel::SimulationInfo *);
+
+    // Reset propensities & firing times (called before each trial)
+virtual bool initialize(pssalib::datamodel::SimulationInfo *);
+  };
+
+}  } // close namespaces pssalib and grouping
+
+#endif /* PSSALIB_GROUPING_GROUPINGMODULE_NRM_H_ */
@@ -47,8 +47,15 @@ namespace grouping
   ////////////////////////////////
   // Methods
   public:
-    // Initialize data structures (called before each trial)
+    // Build the partial propensity structures (called once per run)
+virtual bool compile(pssalib::datamodel::SimulationInfo *);
+
+    // Reset partial propensities (called before each trial)
 virtual bool initialize(pssalib::datamodel::SimulationInfo *);
+
+  protected:
+    // Calculate partial propensities from the current population
+    void computePropensities(pssalib::datamodel::SimulationInfo *);
   };
 
 }  } // close namespaces pssalib and grouping
@@ -47,7 +47,10 @@ namespace grouping
   ////////////////////////////////
   // Methods
   public:
-    // Initialize data structures (called before each trial)
+    // Calculate minimal partial propensities (called once per run)
+virtual bool compile(pssalib::datamodel::SimulationInfo *);
+
+    // Distribute partial propensities into bins (called before each trial)
 virtual bool initialize(pssalib::datamodel::SimulationInfo *);
   };
 
@@ -47,6 +47,9 @@ virtual ~GroupingModule_SPDM();
   ////////////////////////////////
   // Methods
   public:
+    // Build static data structures & size the indexing (called once per run)
+virtual bool compile(pssalib::datamodel::SimulationInfo *);
+
     // Initialize data structures (called before each trial)
 virtual bool initialize(pssalib::datamodel::SimulationInfo *);
   };
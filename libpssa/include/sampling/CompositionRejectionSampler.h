@@ -33,7 +33,7 @@ namespace sampling
   {
     public:
       bool Sample(const pssalib::datamodel::CompositionRejectionSamplerData* ptrData, 
-                  gsl_rng* ptrRNG, const REAL scale, UINTEGER& outI, REAL& outR);
+                  gsl_rng* ptrRNG, UINTEGER& outI, REAL& outR);
   };
 
 }  } // close namespaces pssalib and sampling
@@ -0,0 +1,56 @@
+/**
+ * @file CounterBasedRNG.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Counter-based pseudo-random number generator (Philox4x32-10) exposed
+ * as a GSL generator type. The output is a pure function of the key
+ * (global seed) and the counter (sample index, stream id & position),
+ * hence each stream can be entered at any point without generating
+ * the preceding numbers and without any shared state.
+ */
+
+#ifndef PSSALIB_SAMPLING_COUNTER_BASED_RNG_H_
+#define PSSALIB_SAMPLING_COUNTER_BASED_RNG_H_
+
+#include "../typedefs.h"
+
+namespace pssalib
+{
+namespace sampling
+{
+  //! Philox4x32-10 generator type for use with @c gsl_rng_alloc
+  extern const gsl_rng_type * gsl_rng_philox4x32;
+
+  /**
+   * Check whether a generator is counter-based.
+   *
+   * @param ptrRNG Pointer to a GSL generator
+   * @return @true if @p ptrRNG is a Philox4x32-10 generator, @false otherwise.
+   */
+  inline bool rng_is_counter_based(const gsl_rng * ptrRNG)
+  {
+    return (NULL != ptrRNG)&&(gsl_rng_philox4x32 == ptrRNG->type);
+  }
+
+  /**
+   * Position a counter-based generator at the beginning of a stream.
+   * The key set by @c gsl_rng_set is preserved.
+   *
+   * @param ptrRNG Pointer to a Philox4x32-10 generator
+   * @param sample Sample index
+   * @param stream Stream id
+   */
+  void rng_select_stream(gsl_rng * ptrRNG, UINTEGER sample, UINTEGER stream);
+
+}  } // close namespaces pssalib and sampling
+
+#endif /* PSSALIB_SAMPLING_COUNTER_BASED_RNG_H_ */
@@ -31,6 +31,11 @@ namespace pssalib
 namespace datamodel
 {
   class SimulationInfo;
+
+namespace detail
+{
+  class FiringTimes;
+} // close namespace detail
 } // close namespace datamodel
 
 namespace sampling
@@ -51,6 +56,8 @@ namespace sampling
   protected:
     //! Pseudo-Random numbers generator from GSL
     gsl_rng * m_ptrRNG;
+    //! Seed of the simulation, from which the streams of the samples are derived
+    ULINTEGER m_unRNGSeed;
     CompositionRejectionSampler crVolumeSampler;
 
   ////////////////////////////////
@@ -71,17 +78,147 @@ namespace sampling
     // Sample subvolume
     bool sampleVolume(pssalib::datamodel::SimulationInfo* ptrSimInfo);
 
+    // Draw the firing times of all subvolumes for the Next Subvolume Method
+    void scheduleVolumes(pssalib::datamodel::SimulationInfo* ptrSimInfo);
+
+    // Sample next reaction time & subvolume using the Next Subvolume Method
+    bool sampleNextSubvolume(pssalib::datamodel::SimulationInfo* ptrSimInfo);
+
+    // Fire delayed reactions that complete before the next scheduled firing
+    bool fireDelayedReactions(pssalib::datamodel::SimulationInfo* ptrSimInfo, const pssalib::datamodel::detail::FiringTimes & ftNext);
+
     //! Sample next reaction index
     virtual bool sampleReaction(pssalib::datamodel::SimulationInfo* ptrSimInfo) = 0;
 
+    // Sample destination subvolume of a diffusion event
+    void sampleDestination(pssalib::datamodel::SimulationInfo* ptrSimInfo);
+
+    /**
+     * Call @ref sampleReaction() of a given sampling module
+     * without virtual dispatch, unless it is the base class.
+     */
+    template<class TSampling>
+    inline bool callSampleReaction(pssalib::datamodel::SimulationInfo* ptrSimInfo)
+    {
+      return static_cast<TSampling *>(this)->TSampling::sampleReaction(ptrSimInfo);
+    }
+
   public:
     // Set the seed of the random number generator
-    void set_rng_seed(UINTEGER seed);
+    void set_rng_seed(ULINTEGER seed);
+
+    // Get the seed of the random number generator
+    inline ULINTEGER get_rng_seed() const { return m_unRNGSeed; }
+
+    // Draw a seed for another random number generator
+    UINTEGER draw_rng_seed();
+
+    // Set up the random number generator for a simulation
+    bool setup_rng(pssalib::datamodel::SimulationInfo* ptrSimInfo);
+
+    // Position the random number generator at the stream of a sample
+    void select_rng_stream(UINTEGER sample, UINTEGER stream = 0);
+
+    // Get the state of the random number generator
+    const void * get_rng_state(STRING & name, std::size_t & size) const;
+
+    // Restore a state of the random number generator
+    bool set_rng_state(const STRING & name, const void * state, std::size_t size);
 
     // Get next sample
+    virtual bool getSample(pssalib::datamodel::SimulationInfo* ptrSimInfo);
+
+    // Get next sample for a method & configuration known at compile time
+    template<class TSampling, bool bSpatial, bool bDelays>
     bool getSample(pssalib::datamodel::SimulationInfo* ptrSimInfo);
   };
 
+  template<>
+  inline bool SamplingModule::callSampleReaction<SamplingModule>(pssalib::datamodel::SimulationInfo* ptrSimInfo)
+  {
+    return sampleReaction(ptrSimInfo);
+  }
+
+}  } // close namespaces pssalib and sampling
+
+#include "../datamodel/DataModel.h"
+#include "../datamodel/SimulationInfo.h"
+
+namespace pssalib
+{
+namespace sampling
+{
+  /**
+   * Fill in the datastructure with random samples.
+   *
+   * @tparam TSampling Sampling module type, method-specific routines are
+   * called without virtual dispatch unless it is @ref SamplingModule.
+   * @tparam bSpatial @false if the model has no volume decomposition.
+   * @tparam bDelays @false if the model has no delayed reactions.
+   * @param ptrSimInfo Simulation information object
+   * @return @true on success, @false otherwise.
+   */
+  template<class TSampling, bool bSpatial, bool bDelays>
+  bool SamplingModule::getSample(pssalib::datamodel::SimulationInfo* ptrSimInfo)
+  {
+    pssalib::datamodel::DataModel* ptrData = ptrSimInfo->getDataModel();
+
+    if(bSpatial && (0 != ptrData->ftVolumes.size()))
+    {
+      if(!ptrData->bVolumesScheduled)
+        scheduleVolumes(ptrSimInfo);
+
+      // Fire all delayed reactions that complete before the next subvolume
+      if(bDelays && !fireDelayedReactions(ptrSimInfo, ptrData->ftVolumes))
+        return false;
+
+      // Sample time & volume using the Next Subvolume Method
+      if(!sampleNextSubvolume(ptrSimInfo))
+      {
+        PSSA_ERROR(ptrSimInfo, << "could not sample next reaction time & volume!\n");
+        return false;
+      }
+    }
+    else
+    {
+      // Sample time
+      if(!sampleTime(ptrSimInfo))
+      {
+        PSSA_ERROR(ptrSimInfo, << "could not sample next reaction time!\n");
+        return false;
+      }
+
+      // Sample volume
+      if(bSpatial && (0 != ptrData->getDimsCount()))
+      {
+        if(!sampleVolume(ptrSimInfo))
+        {
+          PSSA_ERROR(ptrSimInfo, << "could not sample next reaction volume!\n");
+          return false;
+        }
+      }
+    }
+
+    // Sample reaction
+    if(!callSampleReaction<TSampling>(ptrSimInfo))
+    {
+      PSSA_ERROR(ptrSimInfo, << "could not sample next reaction index!\n");
+      return false;
+    }
+    else
+    {
+      PSSA_TRACE(ptrSimInfo, << "sampled reaction #" << ptrData->mu 
+        << " : " << ptrData->getReactionWrapper(ptrData->mu).toString()
+        << std::endl);
+    }
+
+    // Sample diffusion destination if necessary.
+    if(bSpatial)
+      sampleDestination(ptrSimInfo);
+
+    return true;
+  }
+
 }  } // close namespaces pssalib and sampling
 
 #endif /* PSSALIB_SAMPLING_SAMPLINGMODULE_H_ */
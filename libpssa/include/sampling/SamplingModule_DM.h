@@ -31,6 +31,11 @@ namespace sampling
    */
   class SamplingModule_DM : public SamplingModule
   {
+  ////////////////////////////////
+  // Friends
+  public:
+    friend class SamplingModule;
+
   /////////////////////////////////////
   // Constructors
   public:
@@ -0,0 +1,57 @@
+/**
+ * @file SamplingModule_DMTree.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ * 
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Sampling module definition for the Direct Method with a sum tree
+ */
+
+#ifndef PSSALIB_SAMPLING_SAMPLINGMODULE_DMTREE_H_
+#define PSSALIB_SAMPLING_SAMPLINGMODULE_DMTREE_H_
+
+#include "./SamplingModule_DM.h"
+
+namespace pssalib
+{
+namespace sampling
+{
+  /**
+   * @class SamplingModule_DMTree
+   * @brief Provide random samples using the Direct Method with
+   * logarithmic-time reaction selection.
+   * 
+   * @copydetails SamplingModule
+   */
+  class SamplingModule_DMTree : public SamplingModule_DM
+  {
+  ////////////////////////////////
+  // Friends
+  public:
+    friend class SamplingModule;
+
+  /////////////////////////////////////
+  // Constructors
+  public:
+    // Default Constructor
+    SamplingModule_DMTree();
+    // Destructor
+  virtual ~SamplingModule_DMTree();
+
+  //////////////////////////////
+  // Methods
+  protected:
+    // Sample next reaction index
+    virtual bool sampleReaction(pssalib::datamodel::SimulationInfo* ptrSimInfo);
+  };
+
+}  } // close namespaces pssalib and sampling
+
+#endif /* PSSALIB_SAMPLING_SAMPLINGMODULE_DMTREE_H_ */
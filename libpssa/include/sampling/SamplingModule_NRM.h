@@ -0,0 +1,130 @@
+/**
+ * @file SamplingModule_NRM.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ * 
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Sampling module definition for the Next Reaction Method
+ */
+
+#ifndef PSSALIB_SAMPLING_SAMPLINGMODULE_NRM_H_
+#define PSSALIB_SAMPLING_SAMPLINGMODULE_NRM_H_
+
+#include "./SamplingModule.h"
+
+namespace pssalib
+{
+namespace sampling
+{
+  /**
+   * @class SamplingModule_NRM
+   * @brief Provide random samples using the Next Reaction Method.
+   *
+   * @details The next reaction channel is the one with the earliest
+   * putative firing time. Only the channel that fired draws a new
+   * random number, firing times of the other channels are rescaled
+   * by the update module whenever their propensities change.
+   * 
+   * @copydetails SamplingModule
+   */
+  class SamplingModule_NRM : public SamplingModule
+  {
+  ////////////////////////////////
+  // Friends
+  public:
+    friend class SamplingModule;
+
+  /////////////////////////////////////
+  // Constructors
+  public:
+    // Default Constructor
+    SamplingModule_NRM();
+    // Destructor
+  virtual ~SamplingModule_NRM();
+
+  //////////////////////////////
+  // Methods
+  protected:
+    // Draw the firing times of all reaction channels
+    void scheduleReactions(pssalib::datamodel::SimulationInfo* ptrSimInfo);
+
+    // Sample next reaction index
+    virtual bool sampleReaction(pssalib::datamodel::SimulationInfo* ptrSimInfo);
+
+  public:
+    // Get next sample
+    virtual bool getSample(pssalib::datamodel::SimulationInfo* ptrSimInfo);
+
+    // Get next sample for a method & configuration known at compile time
+    template<class TSampling, bool bSpatial, bool bDelays>
+    bool getSample(pssalib::datamodel::SimulationInfo* ptrSimInfo);
+  };
+
+}  } // close namespaces pssalib and sampling
+
+#include "../datamodel/DataModel_NRM.h"
+
+namespace pssalib
+{
+namespace sampling
+{
+  /**
+   * @copydoc SamplingModule::getSample(pssalib::datamodel::SimulationInfo*)
+   */
+  template<class TSampling, bool bSpatial, bool bDelays>
+  bool SamplingModule_NRM::getSample(pssalib::datamodel::SimulationInfo* ptrSimInfo)
+  {
+    // Cast the data model to a suitable type
+    pssalib::datamodel::DataModel_NRM * ptrNRMData = static_cast<pssalib::datamodel::DataModel_NRM*>(
+      ptrSimInfo->getDataModel());
+
+    if(!ptrNRMData->bScheduled)
+      scheduleReactions(ptrSimInfo);
+
+    // Fire all delayed reactions that complete before the next reaction
+    if(bDelays && !fireDelayedReactions(ptrSimInfo, ptrNRMData->ftReactions))
+      return false;
+
+    // check if we have reached an absorbing state
+    if(std::isinf(ptrNRMData->ftReactions.top_key()))
+    {
+      ptrSimInfo->dTimeSimulation = std::numeric_limits<REAL>::infinity();
+      PSSA_WARNING(ptrSimInfo, << "zero or negative propensity ==> simulation reached an absorbing state.\n");
+      return false; // We have reached an absorbing state - exit
+    }
+
+    // Sample time
+    ptrSimInfo->dTimeSimulation = ptrNRMData->ftReactions.top_key();
+    PSSA_TRACE(ptrSimInfo, << "sampled time = " << ptrSimInfo->dTimeSimulation << std::endl);
+
+    // Sample reaction
+    if(!callSampleReaction<TSampling>(ptrSimInfo))
+    {
+      PSSA_ERROR(ptrSimInfo, << "could not sample next reaction index!\n");
+      return false;
+    }
+    else
+    {
+      PSSA_TRACE(ptrSimInfo, << "sampled reaction #" << ptrNRMData->mu 
+        << " in subvolume #" << ptrNRMData->nu << " : "
+        << ptrNRMData->getReactionWrapper(ptrNRMData->mu).toString()
+        << std::endl);
+    }
+
+    // Sample diffusion destination if necessary.
+    if(bSpatial)
+      sampleDestination(ptrSimInfo);
+
+    return true;
+  }
+
+}  } // close namespaces pssalib and sampling
+
+#endif /* PSSALIB_SAMPLING_SAMPLINGMODULE_NRM_H_ */
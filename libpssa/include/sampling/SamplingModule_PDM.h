@@ -32,6 +32,11 @@ namespace sampling
    */
   class SamplingModule_PDM : public SamplingModule
   {
+  ////////////////////////////////
+  // Friends
+  public:
+    friend class SamplingModule;
+
   /////////////////////////////////
   // Constructors
   public:
@@ -34,6 +34,11 @@ namespace sampling
    */
   class SamplingModule_PSSACR : public SamplingModule_PDM
   {
+  ////////////////////////////////
+  // Friends
+  public:
+    friend class SamplingModule;
+
   ////////////////////////////////
   // Constructors
   public:
@@ -33,6 +33,11 @@ namespace sampling
    */
   class SamplingModule_SPDM : public SamplingModule_PDM
   {
+  ////////////////////////////////
+  // Friends
+  public:
+    friend class SamplingModule;
+
   /////////////////////////////////
   // Constructors
   public:
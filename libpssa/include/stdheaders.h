@@ -44,10 +44,11 @@
 #include <stdexcept>  // definition of std::exception
 #include <cerrno>     // C-style errno macro
 
-// definition of mkdir
+// definition of mkdir & truncate
 #if defined(__linux__) || defined(__MACH__)
   #include <sys/stat.h>
   #include <sys/types.h>
+  #include <unistd.h>
 #elif defined(_WIN32)
   #include <direct.h>
 #endif
@@ -69,6 +70,8 @@
 #include <atomic>         // STL atomic definitions
 #include <unordered_map>  // STL unordered map
 #include <iterator>       // STL iterators
+#include <type_traits>    // STL type traits
+#include <chrono>         // STL time utilities
 
 // libSBML
 #ifdef HAVE_LIBSBML
@@ -80,6 +83,13 @@
   #include <mpi.h>
 #endif
 
+// Threads
+#ifdef HAVE_THREADS
+  #include <thread>             // STL threads
+  #include <mutex>              // STL mutual exclusion primitives
+  #include <condition_variable> // STL condition variables
+#endif
+
 // Define hashmap type for PSSACR_Bins class
 //#define __USE_GOOGLE_HASH_MAP
 
@@ -19,6 +19,19 @@
 #ifndef PSSALIB_TYPEDEFS_H_
 #define PSSALIB_TYPEDEFS_H_
 
+///////////////////////////////////////////////////////////////
+// Log levels
+
+#define PSSALIB_LOG_LEVEL_ERROR   1
+#define PSSALIB_LOG_LEVEL_WARNING 2
+#define PSSALIB_LOG_LEVEL_INFO    3
+#define PSSALIB_LOG_LEVEL_TRACE   4
+
+// Maximum level of messages compiled into the library, see configure --with-log-level
+#ifndef PSSALIB_LOG_LEVEL
+#  define PSSALIB_LOG_LEVEL PSSALIB_LOG_LEVEL_TRACE
+#endif
+
 ///////////////////////////////////////////////////////////////
 // Common output macros
 
@@ -34,14 +47,47 @@
           };
 #endif
 
-#define PSSA_TRACE(si, args) \
+// Messages above the maximum level are still compiled, but never executed
+#define PSSALIB_INTERNAL_NOLOG(si, type, header, args) \
+          while(false) { \
+            (si)->report() << header args; break; \
+          };
+
+#if PSSALIB_LOG_LEVEL >= PSSALIB_LOG_LEVEL_TRACE
+#  define PSSA_TRACE(si, args) \
           PSSALIB_INTERNAL_LOG(si, pssalib::datamodel::SimulationInfo::ofTrace | PSSA_MODULE_LABEL, "(TRACE) : ", args)
+#  define PSSA_TRACE_ON(si) \
+          (si)->isLoggingOn(pssalib::datamodel::SimulationInfo::ofTrace | PSSA_MODULE_LABEL)
+#  define PSSA_TRACE_EVENT(si) \
+          while((si)->isLoggingOn(pssalib::datamodel::SimulationInfo::eofEvents)) { \
+            (si)->traceEvent(); break; \
+          };
+#else
+#  define PSSA_TRACE(si, args) \
+          PSSALIB_INTERNAL_NOLOG(si, pssalib::datamodel::SimulationInfo::ofTrace | PSSA_MODULE_LABEL, "(TRACE) : ", args)
+#  define PSSA_TRACE_ON(si) \
+          false
+#  define PSSA_TRACE_EVENT(si) \
+          while(false) { \
+            (si)->traceEvent(); break; \
+          };
+#endif
 
-#define PSSA_INFO(si, args) \
+#if PSSALIB_LOG_LEVEL >= PSSALIB_LOG_LEVEL_INFO
+#  define PSSA_INFO(si, args) \
           PSSALIB_INTERNAL_LOG(si, pssalib::datamodel::SimulationInfo::ofInfo, "(INFO) : ", args)
+#else
+#  define PSSA_INFO(si, args) \
+          PSSALIB_INTERNAL_NOLOG(si, pssalib::datamodel::SimulationInfo::ofInfo, "(INFO) : ", args)
+#endif
 
-#define PSSA_WARNING(si, args) \
+#if PSSALIB_LOG_LEVEL >= PSSALIB_LOG_LEVEL_WARNING
+#  define PSSA_WARNING(si, args) \
           PSSALIB_INTERNAL_LOG(si, pssalib::datamodel::SimulationInfo::ofWarning, "(WARNING) : ", args)
+#else
+#  define PSSA_WARNING(si, args) \
+          PSSALIB_INTERNAL_NOLOG(si, pssalib::datamodel::SimulationInfo::ofWarning, "(WARNING) : ", args)
+#endif
 
 #define PSSA_ERROR(si, args) \
           PSSALIB_INTERNAL_LOG(si, pssalib::datamodel::SimulationInfo::ofError, "(ERROR) : ", args)
@@ -163,6 +209,24 @@ namespace pssalib
    */
   typedef void (*FCN_REACTION_CALLBACK) (pssalib::datamodel::DataModel * ptrDM, REAL time, void * ptrUser);
 
+  //! Compact record of a reaction event
+  typedef struct tagReactionEvent
+  {
+    REAL     time; //!< Simulation time of the event
+    UINTEGER mu;   //!< Index of the reaction (wrapper)
+    UINTEGER nu;   //!< Subvolume where the event occured
+    UINTEGER nu_D; //!< Destination subvolume of a diffusion event, @a nu otherwise
+    bool     delayed; //!< @true if the event completes a delayed reaction fired earlier
+  } ReactionEvent;
+
+  /**
+   * @param sample Index of the sample the events belong to
+   * @param arEvents Array of reaction events in chronological order
+   * @param count Number of events in the array
+   * @param ptrUser Pointer to a data structure supplied by user
+   */
+  typedef void (*FCN_REACTION_EVENTS_SINK) (UINTEGER sample, const ReactionEvent * arEvents, UINTEGER count, void * ptrUser);
+
   /**
    * @param ptrDM Pointer to a \c DataModel object
    * @param arPop Array to be filled with initial species' amounts
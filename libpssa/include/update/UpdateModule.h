@@ -87,6 +87,10 @@ namespace update
     // Perform the update step
     bool doUpdate(pssalib::datamodel::SimulationInfo * ptrSimInfo);
 
+    // Perform the update step for a method & configuration known at compile time
+    template<class TUpdate, bool bSpatial, bool bDelays>
+    bool doUpdate(pssalib::datamodel::SimulationInfo * ptrSimInfo);
+
   protected:
     // Schedule a delayed reaction
   virtual bool scheduleDelayed(pssalib::datamodel::SimulationInfo * ptrSimInfo);
@@ -94,13 +98,196 @@ namespace update
     //! Update volume structures
     bool updateVolumeStructures(pssalib::datamodel::SimulationInfo * ptrSimInfo);
 
+    //! Rescale the subvolume firing times (Next Subvolume Method)
+    void updateVolumeTimes(pssalib::datamodel::SimulationInfo * ptrSimInfo,
+                           REAL dPropensitySrc, REAL dPropensityDst);
+
     // Update per species data structures after a chemical reaction
   virtual bool updateSpeciesStructuresReaction(pssalib::datamodel::SimulationInfo * ptrSimInfo) = 0;
 
     // Update per species data structures after a molecular diffusion event
   virtual bool updateSpeciesStructuresDiffusion(pssalib::datamodel::SimulationInfo * ptrSimInfo) = 0;
+
+    /**
+     * Call @ref updateSpeciesStructuresReaction() of a given update module
+     * without virtual dispatch, unless it is the base class.
+     */
+    template<class TUpdate>
+    inline bool callUpdateSpeciesStructuresReaction(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+    {
+      return static_cast<TUpdate *>(this)->TUpdate::updateSpeciesStructuresReaction(ptrSimInfo);
+    }
+
+    /**
+     * Call @ref updateSpeciesStructuresDiffusion() of a given update module
+     * without virtual dispatch, unless it is the base class.
+     */
+    template<class TUpdate>
+    inline bool callUpdateSpeciesStructuresDiffusion(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+    {
+      return static_cast<TUpdate *>(this)->TUpdate::updateSpeciesStructuresDiffusion(ptrSimInfo);
+    }
   };
 
+  template<>
+  inline bool UpdateModule::callUpdateSpeciesStructuresReaction<UpdateModule>(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    return updateSpeciesStructuresReaction(ptrSimInfo);
+  }
+
+  template<>
+  inline bool UpdateModule::callUpdateSpeciesStructuresDiffusion<UpdateModule>(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    return updateSpeciesStructuresDiffusion(ptrSimInfo);
+  }
+
+}  } // close namespaces pssalib and update
+
+#include "../datamodel/DataModel.h"
+#include "../datamodel/SimulationInfo.h"
+
+namespace pssalib
+{
+namespace update
+{
+  /**
+   * Determine update mode & perform update.
+   *
+   * @tparam TUpdate Update module type, method-specific routines are
+   * called without virtual dispatch unless it is @ref UpdateModule.
+   * @tparam bSpatial @false if the model has no volume decomposition.
+   * @tparam bDelays @false if the model has no delayed reactions.
+   * @param ptrSimInfo Simulation information object
+   * @return @true on success, @false otherwise.
+   */
+  template<class TUpdate, bool bSpatial, bool bDelays>
+  bool UpdateModule::doUpdate(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    // Cast the data model to a suitable type
+    pssalib::datamodel::DataModel * ptrData =
+      ptrSimInfo->getDataModel();
+    m_ptrReactionWrapper = &(ptrData->getReactionWrapper(ptrData->mu));
+    m_ptrSubvolumeSrc = &(ptrData->getSubvolume(ptrData->nu));
+
+    PSSA_TRACE_EVENT(ptrSimInfo);
+
+    const REAL dPropensitySrc = m_ptrSubvolumeSrc->totalPropensity();
+    REAL dPropensityDst = 0.0,
+         totalPropensityChange = dPropensitySrc;
+    bool bUpdateOK = true;
+
+    // Update species population
+    if(bSpatial && m_ptrReactionWrapper->isDiffusive())
+    {
+      m_ptrSubvolumeDst = &(ptrData->getSubvolume(ptrData->nu_D));
+
+      dPropensityDst = m_ptrSubvolumeDst->totalPropensity();
+      totalPropensityChange += dPropensityDst;
+
+      // update population
+      const UINTEGER index = m_ptrReactionWrapper->getSpecies()->getIndex();
+      m_ptrSubvolumeSrc->population_update(index, -1);
+      m_ptrSubvolumeDst->population_update(index,  1);
+
+      // update method data structures
+      bUpdateOK = callUpdateSpeciesStructuresDiffusion<TUpdate>(ptrSimInfo);
+
+      totalPropensityChange -= m_ptrSubvolumeSrc->totalPropensity() + m_ptrSubvolumeDst->totalPropensity();
+    }
+    else
+    {
+      m_sriReactants = m_ptrReactionWrapper->getReactantsCount();
+      m_sriBegin = 0;
+      m_sriEnd = m_ptrReactionWrapper->getSpeciesReferencesCount();
+
+      if(bDelays && m_ptrReactionWrapper->isSetDelay())
+      {
+        if(m_ptrReactionWrapper->isSetDelayConsuming())
+        {
+          if(ptrSimInfo->getDelayedUpdate())
+            m_sriBegin = m_ptrReactionWrapper->getReactantsCount();
+          else
+          {
+            m_sriEnd = m_ptrReactionWrapper->getReactantsCount();
+            scheduleDelayed(ptrSimInfo);
+          }
+        }
+        else if(!ptrSimInfo->getDelayedUpdate())
+          return scheduleDelayed(ptrSimInfo); // nothing to update
+      }
+
+      // update population
+      for(UINTEGER sri = m_sriBegin; sri < m_sriEnd; ++sri)
+      {
+        const pssalib::datamodel::detail::SpeciesReference * sr = 
+          m_ptrReactionWrapper->getSpeciesReferenceAt(sri);
+
+        if(sr->isConstant()) continue;
+        m_ptrSubvolumeSrc->population_update(sr, (sri >= m_sriReactants));
+      }
+
+      // update method data structures
+      bUpdateOK = callUpdateSpeciesStructuresReaction<TUpdate>(ptrSimInfo);
+
+      totalPropensityChange -= m_ptrSubvolumeSrc->totalPropensity();
+    }
+
+    // Update global propensity
+    ptrData->dTotalPropensity -= totalPropensityChange;
+
+    if(!bUpdateOK)
+    {
+      PSSA_ERROR(ptrSimInfo, << "update failed: could not update subvolume structures." << std::endl);
+      return false;
+    }
+    else
+    {
+      if(PSSA_TRACE_ON(ptrSimInfo))
+      {
+        STRINGSTREAM ssTemp;
+
+        ssTemp << "update: " << (m_ptrReactionWrapper->isDiffusive() ? "pop src :" : "pop :");
+        for(UINTEGER si = 0; si < ptrData->getSpeciesCount(); ++si)
+          ssTemp << " " << m_ptrSubvolumeSrc->population(si);
+        ssTemp << "\t";
+
+        // diffusion
+        if(m_ptrReactionWrapper->isDiffusive())
+        {
+
+          ssTemp << "pop dest :";
+          for(UINTEGER si = 0; si < ptrData->getSpeciesCount(); ++si)
+            ssTemp << " " << m_ptrSubvolumeDst->population(si);
+          ssTemp << "\t";
+        }
+
+        if(m_ptrReactionWrapper->isDiffusive())
+          ssTemp << "propensity : src=" << m_ptrSubvolumeSrc->totalPropensity()
+            << "; dest=" << m_ptrSubvolumeDst->totalPropensity() << ";  ";
+        ssTemp << "tot prop=" << ptrData->dTotalPropensity;
+
+        PSSA_TRACE(ptrSimInfo, << ssTemp.rdbuf() << std::endl);
+      }
+    }
+
+    // Update compartment data structures
+    if(bSpatial)
+    {
+      if(0 != ptrData->ftVolumes.size())
+        updateVolumeTimes(ptrSimInfo, dPropensitySrc, dPropensityDst);
+      else if(ptrData->getSubvolumesCount() > 1)
+      {
+        if(!updateVolumeStructures(ptrSimInfo))
+        {
+          PSSA_ERROR(ptrSimInfo, << "update failed: could not update compartment structures." << std::endl);
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
 }  } // close namespaces pssalib and update
 
 #endif /* PSSALIB_UPDATE_UPDATEMODULE_H_ */
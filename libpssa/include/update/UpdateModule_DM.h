@@ -43,6 +43,11 @@ namespace update
    */
   class UpdateModule_DM : public UpdateModule
   {
+  ////////////////////////////////
+  // Friends
+  public:
+    friend class UpdateModule;
+
   ////////////////////////////////
   // Constructors
   public:
@@ -61,12 +66,136 @@ virtual bool updateSpeciesStructuresReaction(pssalib::datamodel::SimulationInfo
     //! Update per species data structures after a molecular diffusion event
 virtual bool updateSpeciesStructuresDiffusion(pssalib::datamodel::SimulationInfo * ptrSimInfo);
 
-    //! Update data structures
-    bool updateSpeciesStructures(pssalib::datamodel::SimulationInfo * ptrSimInfo,
-                                 pssalib::datamodel::DataModel_DM * ptrDMData,
-                                 pssalib::datamodel::detail::Subvolume_DM & DMSubVol);
+  ////////////////////////////////
+  // Methods shared by the modules derived from the Direct Method
+  protected:
+    //! Data model type
+    typedef pssalib::datamodel::DataModel_DM data_type;
+    //! Subvolume type
+    typedef pssalib::datamodel::detail::Subvolume_DM subvolume_type;
+
+    /**
+     * Store the new propensity of a reaction in a subvolume.
+     * Derived modules hide this method to update their own structures.
+     *
+     * @param ptrSimInfo Simulation information object
+     * @param ptrData Data model
+     * @param SubVol Subvolume with index @a svi
+     * @param svi Subvolume index
+     * @param rwi Reaction index
+     * @param a New reaction propensity
+     */
+    inline void setPropensity(pssalib::datamodel::SimulationInfo * /* ptrSimInfo */,
+                              data_type * /* ptrData */, subvolume_type & SubVol,
+                              UINTEGER /* svi */, UINTEGER rwi, REAL a)
+    {
+      SubVol.updatePropensity(rwi, a);
+    }
+
+    //! Update propensities of the reactions that depend on species si in subvolume svi
+    template<class TUpdate>
+    void updateSpeciesStructures(pssalib::datamodel::SimulationInfo * ptrSimInfo,
+                                 typename TUpdate::data_type * ptrData,
+                                 UINTEGER svi, UINTEGER si);
+
+    //! Update propensities of the reactions affected by the fired reaction
+    template<class TUpdate>
+    bool updateReactionDependencies(pssalib::datamodel::SimulationInfo * ptrSimInfo);
+
+    //! Update propensities of the reactions affected by the diffusion event
+    template<class TUpdate>
+    bool updateDiffusionDependencies(pssalib::datamodel::SimulationInfo * ptrSimInfo);
   };
 
 }  } // close namespaces pssalib and update
 
+#include "../datamodel/SimulationInfo.h"
+
+namespace pssalib
+{
+namespace update
+{
+  /**
+   * Update propensities of the reactions that depend on a given species.
+   *
+   * @tparam TUpdate Update module type, defines the data model & subvolume
+   * types and the @ref UpdateModule_DM::setPropensity() hook.
+   * @param ptrSimInfo Simulation information object
+   * @param ptrData Data model
+   * @param svi Subvolume index
+   * @param si Species index
+   */
+  template<class TUpdate>
+  void UpdateModule_DM::updateSpeciesStructures(pssalib::datamodel::SimulationInfo * ptrSimInfo,
+                                                typename TUpdate::data_type * ptrData,
+                                                UINTEGER svi, UINTEGER si)
+  {
+    PSSA_TRACE(ptrSimInfo, << "updating reactions dependent on species index " << si << std::endl);
+
+    typename TUpdate::subvolume_type & SubVol = ptrData->getSubvolume(svi);
+
+    for(UINTEGER di = 0; di < ptrData->arDependencies.get_cols(si); ++di)
+    {
+      const UINTEGER rwi = ptrData->arDependencies(si, di);
+
+      PSSA_TRACE(ptrSimInfo,  << "updating reaction index " << rwi << std::endl);
+
+      // compute & store reaction propensity
+      static_cast<TUpdate *>(this)->TUpdate::setPropensity(ptrSimInfo, ptrData, SubVol,
+        svi, rwi, ptrData->computePropensity(rwi, SubVol));
+    }
+  }
+
+  /**
+   * Update propensities of the reactions that depend on
+   * the species changed by the fired reaction.
+   *
+   * @tparam TUpdate Update module type
+   * @param ptrSimInfo Simulation information object
+   * @return @true on success, @false otherwise.
+   */
+  template<class TUpdate>
+  bool UpdateModule_DM::updateReactionDependencies(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    typename TUpdate::data_type * ptrData =
+      static_cast<typename TUpdate::data_type *>
+        (ptrSimInfo->getDataModel());
+
+    // only the species updated by the fired reaction
+    for(UINTEGER sri = m_sriBegin; sri < m_sriEnd; ++sri)
+    {
+      const pssalib::datamodel::detail::SpeciesReference * sr =
+        m_ptrReactionWrapper->getSpeciesReferenceAt(sri);
+
+      if(sr->isConstant()) continue;
+      updateSpeciesStructures<TUpdate>(ptrSimInfo, ptrData, ptrData->nu, sr->getIndex());
+    }
+
+    return true;
+  }
+
+  /**
+   * Update propensities of the reactions that depend on the diffusing
+   * species in the source & destination subvolumes.
+   *
+   * @tparam TUpdate Update module type
+   * @param ptrSimInfo Simulation information object
+   * @return @true on success, @false otherwise.
+   */
+  template<class TUpdate>
+  bool UpdateModule_DM::updateDiffusionDependencies(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    typename TUpdate::data_type * ptrData =
+      static_cast<typename TUpdate::data_type *>
+        (ptrSimInfo->getDataModel());
+    const UINTEGER si = m_ptrReactionWrapper->getSpecies()->getIndex();
+
+    updateSpeciesStructures<TUpdate>(ptrSimInfo, ptrData, ptrData->nu, si);
+    updateSpeciesStructures<TUpdate>(ptrSimInfo, ptrData, ptrData->nu_D, si);
+
+    return true;
+  }
+
+}  } // close namespaces pssalib and update
+
 #endif /* PSSALIB_UPDATE_UPDATEMODULE_DM_H_ */
@@ -0,0 +1,79 @@
+/**
+ * @file UpdateModule_DMTree.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ * 
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Update module definition for the Direct Method with a sum tree
+ */
+
+#ifndef PSSALIB_UPDATE_UPDATEMODULE_DMTREE_H_
+#define PSSALIB_UPDATE_UPDATEMODULE_DMTREE_H_
+
+#include "./UpdateModule_DM.h"
+#include "../../include/datamodel/DataModel_DMTree.h"
+
+namespace pssalib
+{
+namespace update
+{
+  /**
+   * @class UpdateModule_DMTree
+   * @brief Update the datastructures for the Direct Method with a sum tree
+   * with changes due to the fired reaction.
+   *
+   * @copydetails UpdateModule
+   */
+  class UpdateModule_DMTree : public UpdateModule_DM
+  {
+  ////////////////////////////////
+  // Friends
+  public:
+    friend class UpdateModule;
+    friend class UpdateModule_DM;
+
+  ////////////////////////////////
+  // Constructors
+  public:
+    // Constructor
+    UpdateModule_DMTree();
+
+    // Destructor
+virtual ~UpdateModule_DMTree();
+
+  ////////////////////////////////
+  // Update module methods
+  protected:
+    //! Update per species data structures after a chemical reaction
+virtual bool updateSpeciesStructuresReaction(pssalib::datamodel::SimulationInfo * ptrSimInfo);
+
+    //! Update per species data structures after a molecular diffusion event
+virtual bool updateSpeciesStructuresDiffusion(pssalib::datamodel::SimulationInfo * ptrSimInfo);
+
+    //! Data model type
+    typedef pssalib::datamodel::DataModel_DMTree data_type;
+    //! Subvolume type
+    typedef pssalib::datamodel::detail::Subvolume_DMTree subvolume_type;
+
+    /**
+     * @copydoc UpdateModule_DM::setPropensity()
+     */
+    inline void setPropensity(pssalib::datamodel::SimulationInfo * /* ptrSimInfo */,
+                              data_type * /* ptrData */, subvolume_type & SubVol,
+                              UINTEGER /* svi */, UINTEGER rwi, REAL a)
+    {
+      // store propensity & update the partial sums
+      SubVol.updatePropensity(rwi, a);
+    }
+  };
+
+}  } // close namespaces pssalib and update
+
+#endif /* PSSALIB_UPDATE_UPDATEMODULE_DMTREE_H_ */
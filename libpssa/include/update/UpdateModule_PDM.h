@@ -42,6 +42,11 @@ namespace update
    */
   class UpdateModule_PDM : public UpdateModule
   {
+  ////////////////////////////////
+  // Friends
+  public:
+    friend class UpdateModule;
+
   ////////////////////////////////
   // Constructors
   public:
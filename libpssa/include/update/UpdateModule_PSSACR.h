@@ -44,6 +44,11 @@ namespace update
    */
   class UpdateModule_PSSACR : public UpdateModule_PDM
   {
+  ////////////////////////////////
+  // Friends
+  public:
+    friend class UpdateModule;
+
   ////////////////////////////////
   // Constructors
   public:
@@ -32,6 +32,11 @@ namespace update
    */
   class UpdateModule_SPDM : public UpdateModule_PDM
   {
+  ////////////////////////////////
+  // Friends
+  public:
+    friend class UpdateModule;
+
   ////////////////////////////////
   // Constructors
   public:
@@ -0,0 +1,56 @@
+/**
+ * @file AllocationCounter.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ * 
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Debug counter of heap allocations made by the calling thread.
+ * Only available when the library is built with engine checks.
+ */
+
+#ifndef PSSALIB_UTIL_ALLOCATION_COUNTER_H_
+#define PSSALIB_UTIL_ALLOCATION_COUNTER_H_
+
+#include "../typedefs.h"
+
+#ifdef PSSALIB_ENGINE_CHECK
+
+namespace pssalib
+{
+namespace util
+{
+  /**
+   * Number of heap allocations made by the calling thread
+   * outside of a paused region.
+   * 
+   * @return Allocations count
+   */
+  ULINTEGER getAllocationsCount();
+
+  /**
+   * @class AllocationsCountPause
+   * @brief Allocations made by the calling thread are not counted
+   * while an instance of this class is in scope (e.g. output, callbacks).
+   */
+  class AllocationsCountPause
+  {
+  public:
+    AllocationsCountPause();
+    ~AllocationsCountPause();
+
+  private:
+    AllocationsCountPause(const AllocationsCountPause &) = delete;
+    AllocationsCountPause & operator=(const AllocationsCountPause &) = delete;
+  };
+} } // close namespaces util and pssalib
+
+#endif /* PSSALIB_ENGINE_CHECK */
+
+#endif /* PSSALIB_UTIL_ALLOCATION_COUNTER_H_ */
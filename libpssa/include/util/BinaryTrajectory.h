@@ -0,0 +1,211 @@
+/**
+ * @file BinaryTrajectory.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Layout of the binary trajectory files
+ */
+
+#ifndef PSSALIB_UTIL_BINARY_TRAJECTORY_H_
+#define PSSALIB_UTIL_BINARY_TRAJECTORY_H_
+
+#include "../typedefs.h"
+
+#include <cstdint>
+
+//! Leading bytes of a binary trajectory file
+#define PSSALIB_BINARY_TRAJECTORY_MAGIC "PSSATRJ"
+//! Current version of the binary trajectory layout
+#define PSSALIB_BINARY_TRAJECTORY_VERSION 1
+
+namespace pssalib
+{
+namespace util
+{
+  /**
+   * @class BinaryTrajectory
+   * @brief Layout of a binary trajectory file.
+   *
+   * @details A file consists of a fixed-size header followed by the
+   * extents of the spatial dimensions (one @c uint32_t each) and the species
+   * identifiers (zero-terminated strings). The population array starts at
+   * @c dataOffset, which is aligned to 8 bytes, and holds the populations
+   * in row-major order (time point, subvolume, species) as unsigned
+   * integers of @c dtypeSize bytes in native byte order. The number of
+   * rows actually present may be less than @c timePoints if the trial
+   * was interrupted.
+   */
+  class BinaryTrajectory
+  {
+  ////////////////////////////////
+  // Data types
+  public:
+    //! Type of the population values
+    typedef enum tagDataType
+    {
+      dtUnsigned = 'U', //!< Unsigned integer
+      dtSigned   = 'I', //!< Signed integer
+      dtReal     = 'F'  //!< Floating point
+    } DataType;
+
+    //! Fixed-size file header
+    typedef struct tagHeader
+    {
+      char          magic[8];   //!< @ref PSSALIB_BINARY_TRAJECTORY_MAGIC
+      std::uint32_t version;    //!< @ref PSSALIB_BINARY_TRAJECTORY_VERSION
+      std::uint32_t dtype;      //!< Type of the population values, see @ref DataType
+      std::uint32_t dtypeSize;  //!< Size of a population value in bytes
+      std::uint32_t dims;       //!< Number of spatial dimensions (0 if homogeneous)
+      std::uint32_t species;    //!< Number of species in a row
+      std::uint32_t reserved;   //!< Padding, always 0
+      std::uint64_t subvolumes; //!< Number of subvolumes in a row
+      std::uint64_t timePoints; //!< Number of time points in the time grid
+      double        timeStart;  //!< Initial output time
+      double        timeStep;   //!< Time interval between subsequent outputs
+      double        timeEnd;    //!< End time of the simulation
+      std::uint64_t dataOffset; //!< Offset of the population array in bytes
+    } Header;
+
+  ////////////////////////////////
+  // Constructors
+  public:
+    //! Default constructor
+    BinaryTrajectory() = delete;
+
+  /////////////////////////////////////
+  // Methods
+  public:
+    /**
+     * Check the header of a binary trajectory.
+     *
+     * @param hdr Header to check.
+     * @return @true if the header is valid, @false otherwise.
+     */
+    static bool isValid(const Header & hdr)
+    {
+      return (0 == memcmp(hdr.magic, PSSALIB_BINARY_TRAJECTORY_MAGIC, sizeof(hdr.magic)))&&
+        (PSSALIB_BINARY_TRAJECTORY_VERSION == hdr.version)&&
+        (hdr.dataOffset >= sizeof(Header));
+    }
+
+    /**
+     * Compute the offset of the population array.
+     *
+     * @param dims Number of spatial dimensions.
+     * @param arIds Species identifiers.
+     * @return offset in bytes.
+     */
+    static std::uint64_t dataOffset(BYTE dims, const std::vector<STRING> & arIds)
+    {
+      std::uint64_t offset = sizeof(Header) + dims * sizeof(std::uint32_t);
+      for(std::vector<STRING>::const_iterator it = arIds.begin(); it != arIds.end(); ++it)
+        offset += (it->size() + 1) * sizeof(STRING::value_type);
+      return (offset + 7) & ~std::uint64_t(7);
+    }
+
+    /**
+     * Write the header, the dimensions & the species identifiers.
+     *
+     * @param os Output stream.
+     * @param dims Number of spatial dimensions.
+     * @param arDims Extents of spatial dimensions.
+     * @param subvolumes Number of subvolumes.
+     * @param arIds Species identifiers.
+     * @param timePoints Number of time points.
+     * @param timeStart Initial output time.
+     * @param timeStep Time interval between outputs.
+     * @param timeEnd End time of the simulation.
+     * @return @true if successful, @false otherwise.
+     */
+    static bool writeHeader(OSTREAM & os, BYTE dims, const UINTEGER * arDims,
+                            UINTEGER subvolumes, const std::vector<STRING> & arIds,
+                            UINTEGER timePoints, REAL timeStart, REAL timeStep, REAL timeEnd)
+    {
+      Header hdr;
+      memset(&hdr, 0, sizeof(Header));
+      memcpy(hdr.magic, PSSALIB_BINARY_TRAJECTORY_MAGIC, sizeof(hdr.magic));
+      hdr.version = PSSALIB_BINARY_TRAJECTORY_VERSION;
+      hdr.dtype = dtUnsigned;
+      hdr.dtypeSize = sizeof(UINTEGER);
+      hdr.dims = dims;
+      hdr.species = arIds.size();
+      hdr.subvolumes = subvolumes;
+      hdr.timePoints = timePoints;
+      hdr.timeStart = timeStart;
+      hdr.timeStep = timeStep;
+      hdr.timeEnd = timeEnd;
+      hdr.dataOffset = dataOffset(dims, arIds);
+
+      std::uint64_t offset = sizeof(Header);
+      os.write(reinterpret_cast<const char *>(&hdr), sizeof(Header));
+      for(BYTE d = 0; d < dims; ++d)
+      {
+        std::uint32_t dim = arDims[d];
+        os.write(reinterpret_cast<const char *>(&dim), sizeof(std::uint32_t));
+        offset += sizeof(std::uint32_t);
+      }
+      for(std::vector<STRING>::const_iterator it = arIds.begin(); it != arIds.end(); ++it)
+      {
+        os.write(it->c_str(), (it->size() + 1) * sizeof(STRING::value_type));
+        offset += (it->size() + 1) * sizeof(STRING::value_type);
+      }
+      for(; offset < hdr.dataOffset; ++offset)
+        os.put('\0');
+
+      return os.good();
+    }
+
+    /**
+     * Read the dimensions & the species identifiers that follow the header.
+     *
+     * @param ptr Pointer to the beginning of the file.
+     * @param size Size of the file in bytes.
+     * @param arDims Extents of spatial dimensions [OUT].
+     * @param arIds Species identifiers [OUT].
+     * @return @true if successful, @false otherwise.
+     */
+    static bool readIds(const char * ptr, std::uint64_t size,
+                        std::vector<UINTEGER> & arDims, std::vector<STRING> & arIds)
+    {
+      const Header & hdr = *reinterpret_cast<const Header *>(ptr);
+      if((size < sizeof(Header))||!isValid(hdr)||(hdr.dataOffset > size))
+        return false;
+
+      const char * ptrEnd = ptr + hdr.dataOffset;
+      ptr += sizeof(Header);
+
+      arDims.resize(hdr.dims);
+      for(std::uint32_t d = 0; d < hdr.dims; ++d, ptr += sizeof(std::uint32_t))
+      {
+        if(ptr + sizeof(std::uint32_t) > ptrEnd)
+          return false;
+        std::uint32_t dim;
+        memcpy(&dim, ptr, sizeof(std::uint32_t));
+        arDims[d] = dim;
+      }
+
+      arIds.resize(hdr.species);
+      for(std::uint32_t s = 0; s < hdr.species; ++s)
+      {
+        const char * ptrId = static_cast<const char *>(memchr(ptr, '\0', ptrEnd - ptr));
+        if(NULL == ptrId)
+          return false;
+        arIds[s].assign(ptr, ptrId);
+        ptr = ptrId + 1;
+      }
+
+      return true;
+    }
+  };
+
+} } // close namespaces util and pssalib
+
+#endif /* PSSALIB_UTIL_BINARY_TRAJECTORY_H_ */
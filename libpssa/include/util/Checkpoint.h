@@ -0,0 +1,327 @@
+/**
+ * @file Checkpoint.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Binary image of the sampling loop state that is saved & restored atomically
+ */
+
+#ifndef PSSALIB_UTIL_CHECKPOINT_H_
+#define PSSALIB_UTIL_CHECKPOINT_H_
+
+#include "../typedefs.h"
+
+#include <cstdint>
+
+//! Leading bytes of a checkpoint file
+#define PSSALIB_CHECKPOINT_MAGIC "PSSACKP"
+//! Current version of the checkpoint layout
+#define PSSALIB_CHECKPOINT_VERSION 2
+
+namespace pssalib
+{
+namespace util
+{
+  /**
+   * @class Checkpoint
+   * @brief Binary image of the state of the sampling loop.
+   *
+   * @details The image starts with a fixed-size header describing the
+   * simulation settings & the position in the trial being sampled,
+   * followed by the sections written by the simulation engine in a fixed
+   * order. Values are stored in native byte order, arrays are preceded by
+   * the number of elements. The storage is retained when the image is
+   * cleared, so that saving the state repeatedly does not allocate memory.
+   * A file is replaced atomically, hence a checkpoint is never left half
+   * written if the process is terminated.
+   */
+  class Checkpoint
+  {
+  ////////////////////////////////
+  // Data types
+  public:
+    //! Fixed-size header
+    typedef struct tagHeader
+    {
+      char          magic[8];       //!< @ref PSSALIB_CHECKPOINT_MAGIC
+      std::uint32_t version;        //!< @ref PSSALIB_CHECKPOINT_VERSION
+      std::uint32_t method;         //!< Simulation method
+      std::uint32_t outputFlags;    //!< Output flags affecting the results
+      std::uint32_t rngType;        //!< Random number generator
+      std::uint32_t volumeSampling; //!< Subvolume sampling scheme
+      std::uint32_t reserved;       //!< Padding, always 0
+      std::uint64_t rngSeed;        //!< Seed of the random number generator
+      std::uint64_t modelHash;      //!< Hash of the model parameters, see @ref hash
+      std::uint64_t subvolumes;     //!< Number of subvolumes
+      std::uint64_t species;        //!< Number of species
+      std::uint64_t reactions;      //!< Number of reaction wrappers
+      std::uint64_t outputSpecies;  //!< Number of species in the output
+      std::uint64_t samples;        //!< Total number of samples
+      double        timeStart;      //!< Initial output time
+      double        timeStep;       //!< Time interval between subsequent outputs
+      double        timeEnd;        //!< End time of the simulation
+      std::uint64_t sample;         //!< Trial in progress, preceding ones are completed
+      std::uint64_t firedReactions; //!< Number of reactions fired during the trial
+      double        trialTime;      //!< Wall-clock time spent on the trial
+      double        timeSimulation; //!< Simulation time of the trial
+      double        timeCheckpoint; //!< Next output time point of the trial
+      std::uint64_t outputIdx;      //!< Output cursor of the trial
+      std::uint64_t textSize;       //!< Size of the text trajectory file
+      std::uint64_t binarySize;     //!< Size of the binary trajectory file
+    } Header;
+
+  ////////////////////////////////
+  // Attributes
+  protected:
+    std::vector<char> arImage;  //!< serialized state
+    std::size_t       szOffset; //!< @internal read position
+
+  /////////////////////////////////////
+  // Constructors
+  public:
+    //! Default constructor
+    Checkpoint()
+      : szOffset(0)
+    {
+      // Do nothing
+    }
+
+    //! Copy constructor
+    Checkpoint(const Checkpoint &) = delete;
+
+    //! Destructor
+    ~Checkpoint()
+    {
+      // Do nothing
+    }
+
+  /////////////////////////////////////
+  // Methods
+  public:
+    /**
+     * Check the header of a checkpoint.
+     *
+     * @param hdr Header to check.
+     * @return @true if the header is valid, @false otherwise.
+     */
+    static bool isValid(const Header & hdr)
+    {
+      return (0 == memcmp(hdr.magic, PSSALIB_CHECKPOINT_MAGIC, sizeof(hdr.magic)))&&
+        (PSSALIB_CHECKPOINT_VERSION == hdr.version);
+    }
+
+    /**
+     * Check whether two headers describe the same simulation settings,
+     * the seed & the position in the sampling loop are not compared.
+     *
+     * @param a Header.
+     * @param b Header.
+     * @return @true if the settings match, @false otherwise.
+     */
+    static bool isCompatible(const Header & a, const Header & b)
+    {
+      return (a.method == b.method)&&(a.outputFlags == b.outputFlags)&&
+        (a.rngType == b.rngType)&&(a.volumeSampling == b.volumeSampling)&&
+        (a.subvolumes == b.subvolumes)&&(a.species == b.species)&&
+        (a.reactions == b.reactions)&&(a.outputSpecies == b.outputSpecies)&&
+        (a.samples == b.samples)&&(a.timeStart == b.timeStart)&&
+        (a.timeStep == b.timeStep)&&(a.timeEnd == b.timeEnd)&&
+        (a.modelHash == b.modelHash);
+    }
+
+    /**
+     * Combine a value with a hash (64-bit FNV-1a over the bytes of the value).
+     * Used to detect a change of the model parameters between runs, the
+     * result depends on the byte order & is not meant to be portable.
+     *
+     * @param h Hash of the preceding values, @c 0 to start a new one.
+     * @param v Value.
+     * @return Combined hash.
+     */
+    template<typename T>
+    static std::uint64_t hash(std::uint64_t h, const T & v)
+    {
+      static_assert(std::is_trivially_copyable<T>::value, "values must be trivially copyable");
+      if(0 == h)
+        h = 14695981039346656037ULL;
+      const unsigned char * ptr = reinterpret_cast<const unsigned char *>(&v);
+      for(std::size_t i = 0; i < sizeof(T); ++i)
+      {
+        h ^= ptr[i];
+        h *= 1099511628211ULL;
+      }
+      return h;
+    }
+
+    /**
+     * Initialize a header.
+     *
+     * @param hdr Header [OUT].
+     */
+    static void setup(Header & hdr)
+    {
+      memset(&hdr, 0, sizeof(Header));
+      memcpy(hdr.magic, PSSALIB_CHECKPOINT_MAGIC, sizeof(hdr.magic));
+      hdr.version = PSSALIB_CHECKPOINT_VERSION;
+    }
+
+    /**
+     * Empty the image retaining its storage.
+     */
+    inline void clear()
+    {
+      arImage.clear();
+      szOffset = 0;
+    }
+
+    /**
+     * Get the size of the image.
+     *
+     * @return size in bytes.
+     */
+    inline std::size_t size() const
+    {
+      return arImage.size();
+    }
+
+    /**
+     * Append a number of values to the image.
+     *
+     * @param ar Values.
+     * @param n Number of values.
+     */
+    template<typename T>
+    inline void put(const T * ar, std::size_t n)
+    {
+      static_assert(std::is_trivially_copyable<T>::value, "values must be trivially copyable");
+      const char * ptr = reinterpret_cast<const char *>(ar);
+      arImage.insert(arImage.end(), ptr, ptr + n * sizeof(T));
+    }
+
+    /**
+     * Append a value to the image.
+     *
+     * @param v Value.
+     */
+    template<typename T>
+    inline void put(const T & v)
+    {
+      put(&v, 1);
+    }
+
+    /**
+     * Append an array preceded by the number of its elements.
+     *
+     * @param ar Values.
+     * @param n Number of values.
+     */
+    template<typename T>
+    inline void putArray(const T * ar, std::size_t n)
+    {
+      put(std::uint64_t(n));
+      put(ar, n);
+    }
+
+    /**
+     * Read a number of values at the current position.
+     *
+     * @param ar Values [OUT].
+     * @param n Number of values.
+     * @return @true if successful, @false if the image is too short.
+     */
+    template<typename T>
+    inline bool get(T * ar, std::size_t n)
+    {
+      static_assert(std::is_trivially_copyable<T>::value, "values must be trivially copyable");
+      if(n * sizeof(T) > arImage.size() - szOffset)
+        return false;
+      if(n > 0)
+        memcpy(reinterpret_cast<char *>(ar), arImage.data() + szOffset, n * sizeof(T));
+      szOffset += n * sizeof(T);
+      return true;
+    }
+
+    /**
+     * Read a value at the current position.
+     *
+     * @param v Value [OUT].
+     * @return @true if successful, @false if the image is too short.
+     */
+    template<typename T>
+    inline bool get(T & v)
+    {
+      return get(&v, 1);
+    }
+
+    /**
+     * Read an array of a known number of elements at the current position.
+     *
+     * @param ar Values [OUT].
+     * @param n Expected number of values.
+     * @return @true if successful, @false if the number of values differs.
+     */
+    template<typename T>
+    inline bool getArray(T * ar, std::size_t n)
+    {
+      std::uint64_t count;
+      return get(count)&&(n == count)&&get(ar, n);
+    }
+
+    /**
+     * Read an array at the current position.
+     *
+     * @param ar Values [OUT].
+     * @return @true if successful, @false if the image is too short.
+     */
+    template<typename T>
+    inline bool getArray(std::vector<T> & ar)
+    {
+      std::uint64_t count;
+      if(!get(count)||(count > (arImage.size() - szOffset) / sizeof(T)))
+        return false;
+      ar.resize(count);
+      return get(ar.data(), count);
+    }
+
+    /**
+     * Check whether the whole image has been read.
+     *
+     * @return @true if the read position is at the end of the image.
+     */
+    inline bool eof() const
+    {
+      return (szOffset == arImage.size());
+    }
+
+    /**
+     * Write the image to a temporary file next to the target one, which
+     * is then replaced by the former.
+     *
+     * @param filePath Path of the checkpoint file.
+     * @return @true if successful, @false otherwise.
+     */
+    bool save(const STRING & filePath) const;
+
+    /**
+     * Read the image from a file & rewind the read position.
+     *
+     * @param filePath Path of the checkpoint file.
+     * @return @true if successful, @false otherwise.
+     */
+    bool load(const STRING & filePath);
+
+    //! Assignement operator
+    Checkpoint & operator= (const Checkpoint &) = delete;
+  };
+
+} } // close namespaces util and pssalib
+
+#endif /* PSSALIB_UTIL_CHECKPOINT_H_ */
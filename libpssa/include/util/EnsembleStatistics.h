@@ -0,0 +1,181 @@
+/**
+ * @file EnsembleStatistics.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Running mean & variance of the populations at each output time point
+ */
+
+#ifndef PSSALIB_UTIL_ENSEMBLE_STATISTICS_H_
+#define PSSALIB_UTIL_ENSEMBLE_STATISTICS_H_
+
+#include "../typedefs.h"
+
+namespace pssalib
+{
+namespace util
+{
+  /**
+   * @class EnsembleStatistics
+   * @brief Accumulates the mean & the sum of squared deviations (M2) of
+   * each species in each subvolume at each output time point while the
+   * trials are sampled (Welford's algorithm).
+   *
+   * @details Each row of the storage holds the number of samples that
+   * reached the time point followed by the means and the M2 values of
+   * the population. Accumulators of different threads or processes are
+   * combined using the pairwise update of Chan et al., so that the
+   * trajectories themselves do not need to be stored.
+   */
+  class EnsembleStatistics
+  {
+  ////////////////////////////////
+  // Attributes
+  protected:
+    std::size_t szPopulation;  //!< number of values in a population
+    UINTEGER    unSubvolumes;  //!< number of subvolumes in a population
+    UINTEGER    unRows;        //!< number of output time points
+    REAL        *arData;       //!< samples count, means & M2 of each time point
+    UINTEGER    unRow;         //!< @internal next time point of the current trial
+
+  /////////////////////////////////////
+  // Constructors
+  public:
+    //! Default constructor
+    EnsembleStatistics();
+
+    //! Copy constructor
+    EnsembleStatistics(const EnsembleStatistics &) = delete;
+
+    //! Destructor
+    ~EnsembleStatistics();
+
+  /////////////////////////////////////
+  // Methods
+  public:
+    /**
+     * Allocate & reset the storage.
+     *
+     * @param szPop Number of values in a population.
+     * @param subvolumes Number of subvolumes in a population.
+     * @param rows Number of output time points.
+     */
+    void allocate(std::size_t szPop, UINTEGER subvolumes, UINTEGER rows);
+
+    /**
+     * Free allocated resources.
+     */
+    void free();
+
+    /**
+     * Check whether the storage is allocated.
+     *
+     * @return @true if the storage is allocated, @false otherwise.
+     */
+    inline bool isAllocated() const
+    {
+      return (NULL != arData);
+    }
+
+    /**
+     * Begin the trajectory of a new trial.
+     */
+    inline void begin()
+    {
+      unRow = 0;
+    }
+
+    /**
+     * Continue the trajectory of a trial after a number of time points,
+     * e.g. when the trial is restored from a checkpoint.
+     *
+     * @param row Number of time points already added by the trial.
+     */
+    inline void resume(UINTEGER row)
+    {
+      unRow = row;
+    }
+
+    /**
+     * Add a population at a given number of subsequent time points.
+     *
+     * @param arPop Population.
+     * @param unLines Number of output time points.
+     */
+    void add(const UINTEGER * arPop, UINTEGER unLines);
+
+    /**
+     * Add a population given as real values, e.g. loaded from a data set,
+     * at a given number of subsequent time points.
+     *
+     * @param arPop Population.
+     * @param unLines Number of output time points.
+     */
+    void add(const REAL * arPop, UINTEGER unLines);
+
+    /**
+     * Combine the statistics of another accumulator with this one.
+     *
+     * @param other Accumulator of the same layout.
+     * @return @true if successful, @false if the layouts differ.
+     */
+    bool merge(const EnsembleStatistics & other);
+
+    /**
+     * Combine a number of rows with another one.
+     *
+     * @param arIn Rows to add.
+     * @param arInOut Rows to update.
+     * @param rows Number of rows.
+     * @param szPop Number of values in a population.
+     */
+    static void merge(const REAL * arIn, REAL * arInOut, UINTEGER rows, std::size_t szPop);
+
+    /**
+     * Write the means & the variances of all time points reached by at
+     * least one sample, one time point per line. For each subvolume the
+     * means of all species are followed by the respective variances.
+     *
+     * @param os Output stream.
+     * @return @true if successful, @false otherwise.
+     */
+    bool write(OSTREAM & os) const;
+
+    //! Get the number of values in a row
+    inline std::size_t getRowSize() const
+    {
+      return 1 + 2 * szPopulation;
+    }
+
+    //! Get the number of rows
+    inline UINTEGER getRows() const
+    {
+      return unRows;
+    }
+
+    //! Get the storage
+    inline REAL * getData()
+    {
+      return arData;
+    }
+
+    //! Assignement operator
+    EnsembleStatistics & operator= (const EnsembleStatistics &) = delete;
+
+  protected:
+    //! Add a population at a given number of subsequent time points
+    template<typename T>
+    void update(const T * arPop, UINTEGER unLines);
+  };
+
+} } // close namespaces util and pssalib
+
+#endif /* PSSALIB_UTIL_ENSEMBLE_STATISTICS_H_ */
@@ -0,0 +1,213 @@
+/**
+ * @file EventTrace.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Structured trace of the most recent simulation events
+ */
+
+#ifndef PSSALIB_UTIL_EVENT_TRACE_H_
+#define PSSALIB_UTIL_EVENT_TRACE_H_
+
+#include "../typedefs.h"
+
+namespace pssalib
+{
+namespace util
+{
+  /**
+   * @class EventTrace
+   * @brief Fixed-size ring buffer of simulation events.
+   *
+   * @details Events are stored as plain records and formatted only when
+   * the trace is written out, hence recording an event costs a few stores
+   * and never allocates. Once the buffer is full the oldest events are
+   * overwritten.
+   */
+  class EventTrace
+  {
+  ////////////////////////////////
+  // Data types
+  public:
+    //! Type of an event
+    typedef enum tagEventType
+    {
+      etReaction  = 'R', //!< Reaction
+      etDiffusion = 'D', //!< Diffusion event
+      etScheduled = 'S', //!< Delayed reaction initiated
+      etCompleted = 'C'  //!< Delayed reaction completed
+    } EventType;
+
+    //! Record of a single event
+    typedef struct tagEvent
+    {
+      ULINTEGER unIndex;         //!< Sequential number of the event within the trial
+      REAL      dTime;           //!< Simulation time
+      REAL      dTotalPropensity;//!< Total propensity before the event
+      UINTEGER  unReaction;      //!< Reaction index (mu)
+      UINTEGER  unSubvolume;     //!< Subvolume index (nu)
+      UINTEGER  unDestination;   //!< Destination subvolume of a diffusion event (nu_D)
+      char      cType;           //!< Event type, see @ref EventType
+    } Event;
+
+  ////////////////////////////////
+  // Attributes
+  protected:
+    Event *     arEvents;   //!< storage
+    std::size_t uCapacity;  //!< maximum number of events kept
+    ULINTEGER   unRecorded; //!< number of events recorded since last reset
+
+  /////////////////////////////////////
+  // Constructors
+  public:
+    //! Default constructor
+    EventTrace() :
+      arEvents(NULL),
+      uCapacity(0),
+      unRecorded(0)
+    {
+      // Do nothing
+    };
+
+    //! Copy constructor
+    EventTrace(const EventTrace &) = delete;
+
+    //! Destructor
+    ~EventTrace()
+    {
+      free();
+    }
+
+  /////////////////////////////////////
+  // Methods
+  public:
+    /**
+     * Allocate storage for a given number of events.
+     * Storage is reused if the capacity does not change.
+     *
+     * @param uN number of most recent events to keep.
+     */
+    void allocate(std::size_t uN)
+    {
+      if((uN == uCapacity)&&(NULL != arEvents))
+      {
+        clear();
+        return;
+      }
+
+      free();
+
+      if(0 == uN)
+        return;
+
+      arEvents = new Event[uN];
+      uCapacity = uN;
+    }
+
+    /**
+     * Free allocated resources.
+     */
+    inline void free()
+    {
+      if(NULL != arEvents)
+      {
+        delete [] arEvents;
+        arEvents = NULL;
+      }
+      uCapacity = 0;
+      unRecorded = 0;
+    }
+
+    /**
+     * Remove all events, retaining the storage.
+     */
+    inline void clear()
+    {
+      unRecorded = 0;
+    }
+
+    /**
+     * Check whether the storage is allocated.
+     *
+     * @return @true if events can be recorded, @false otherwise.
+     */
+    inline bool isAllocated() const
+    {
+      return (0 != uCapacity);
+    }
+
+    /**
+     * Record an event.
+     *
+     * @param type Event type.
+     * @param t Simulation time.
+     * @param a Total propensity.
+     * @param mu Reaction index.
+     * @param nu Subvolume index.
+     * @param nu_D Destination subvolume index.
+     */
+    inline void record(EventType type, REAL t, REAL a,
+                       UINTEGER mu, UINTEGER nu, UINTEGER nu_D)
+    {
+      if(0 == uCapacity)
+        return;
+
+      Event & e = arEvents[unRecorded % uCapacity];
+      e.unIndex = unRecorded++;
+      e.dTime = t;
+      e.dTotalPropensity = a;
+      e.unReaction = mu;
+      e.unSubvolume = nu;
+      e.unDestination = nu_D;
+      e.cType = (char)type;
+    }
+
+    /**
+     * Get number of events available.
+     *
+     * @return number of events.
+     */
+    inline std::size_t size() const
+    {
+      return (unRecorded < uCapacity) ? std::size_t(unRecorded) : uCapacity;
+    }
+
+    /**
+     * Write the events in chronological order, one per line:
+     * index, type, time, total propensity, reaction, subvolume
+     * and destination subvolume.
+     *
+     * @param os Output stream.
+     * @param prefix String prepended to each line.
+     */
+    void write(OSTREAM & os, const char * prefix) const
+    {
+      const ULINTEGER unFirst = unRecorded - size();
+      for(ULINTEGER i = unFirst; i < unRecorded; ++i)
+      {
+        const Event & e = arEvents[i % uCapacity];
+        os << prefix << e.unIndex << PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER
+          << e.cType << PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER
+          << e.dTime << PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER
+          << e.dTotalPropensity << PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER
+          << e.unReaction << PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER
+          << e.unSubvolume << PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER
+          << e.unDestination << '\n';
+      }
+    }
+
+    //! Assignement operator
+    EventTrace & operator= (const EventTrace &) = delete;
+  };
+
+} } // close namespaces util and pssalib
+
+#endif /* PSSALIB_UTIL_EVENT_TRACE_H_ */
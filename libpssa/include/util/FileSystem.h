@@ -20,6 +20,8 @@
 #include "../typedefs.h"
 #include "../stdheaders.h"
 
+#include <cstdint>
+
 namespace pssalib
 {
 namespace util
@@ -36,6 +38,15 @@ namespace util
   //! \internal A cross-platform file path constructor
   void makeFilePath(const STRING &, const STRING &, STRING &);
 
+  //! \internal A cross-platform file size query, @false if the file does not exist
+  bool getFileSize(const STRING &, std::uint64_t &);
+
+  //! \internal A cross-platform wrapper for truncate function
+  bool resizeFile(const STRING &, std::uint64_t);
+
+  //! \internal A cross-platform atomic replacement of a file by another one
+  bool replaceFile(const STRING &, const STRING &);
+
 } } // close namespaces util and pssalib
 
 #endif /* PSSALIB_UTIL_FILESYSTEM_H_ */
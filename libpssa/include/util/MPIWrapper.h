@@ -32,6 +32,11 @@ namespace pssalib
   {
     class SimulationInfo;
   }
+  namespace util
+  {
+    class EnsembleStatistics;
+    class PopulationHistogram;
+  }
 }
 
 namespace pssalib
@@ -50,6 +55,11 @@ namespace mpi
     //! Number of processors
     int  nPoolSize;
 
+    //! Window exposing the shared sample counter (owned by the master process)
+    MPI_Win  winSampleCounter;
+    //! Value of the shared sample counter after the last chunk was acquired
+    UINTEGER unSampleCounter;
+
   ////////////////////////////////
   // Attributes
   public:
@@ -107,50 +117,52 @@ namespace mpi
     INTEGER getDataChunkSize(INTEGER size);
 
     /**
-    * Prepare the process context for a parallel spread.
+    * Prepare the process context for a parallel spread (collective call).
+    * Samples are handed out dynamically in chunks of decreasing size
+    * taken from a counter shared by the process pool.
     *
     * @param ptrSimInfo Pointer to the @link SimulationInfo object associated with this run.
-    * @param size Total size of data to be processed.
-     * @return @true if context initialisation was successful, or @false otherwise.
+    * @return @true if context initialisation was successful, or @false otherwise.
     */
-    bool pre_spread(pssalib::datamodel::SimulationInfo * ptrSimInfo);//, INTEGER size);
+    bool pre_spread(pssalib::datamodel::SimulationInfo * ptrSimInfo);
 
     /**
      * Spread in a parallel for fashion.
      *
-     * @param counter circular counter (cycle length is set by \b MPIWrapper::pre_spread()) 
+     * @param counter index of the next sample to be processed by this process [OUT]
      * @return @true if there is still work to do, or @false otherwise
      */
     bool spread(pssalib::datamodel::SimulationInfo * ptrSimInfo, UINTEGER &counter);
 
     /**
-     * Allocate a block matching the current process context for a parallel spread.
+     * Stop handing out samples to all processes in the pool, e.g., after a failure.
      *
      * @param ptrSimInfo Pointer to the @link SimulationInfo object associated with this run.
-     * @param sizeType Data type size as returned by a call to <code>sizeof(<data_type>)</code>.
      */
-    void * spread_alloc(datamodel::SimulationInfo * ptrSimInfo, size_t sizeType) const;
+    void spread_abort(pssalib::datamodel::SimulationInfo * ptrSimInfo);
 
     /**
-    * Query whether this process has to wait for other processes due to
-    * uneven spreading. Useful if inter=process communication takes place
-    * within the parallel for loop.
+    * Release the process context of a parallel spread (collective call).
     *
     * @param ptrSimInfo Pointer to the @link SimulationInfo object associated with this run.
-    * @return @true if the process has to wait for other in the pool, @false othewise.
+    * @return @true if the context was released successfully, @false othewise.
     */
     bool post_spread(pssalib::datamodel::SimulationInfo * ptrSimInfo);
 
     /**
-     * Collect results from all processes into a buffer owned by the master process.
-     * Since block size can be different, MPI_Gather was not suitable for this.
+     * Collect results from all processes into a buffer owned by the master process
+     * (collective call). Since each process samples a varying number of trials,
+     * the results are gathered along with their sample indices and reordered.
      *
+     * @param arSamples Indices of the samples held by this process
+     * @param unSamples Number of samples held by this process
      * @param sbuf Buffer to be sent to the master process
      * @param rbuf Pointer to a pointer of the receiving buffer (the pointer itself must be NULL) [OUT]
      * @param sizeType Data type size as returned by a call to <code>sizeof(<data_type>)</code>.
      */
-    bool spread_collect(pssalib::datamodel::SimulationInfo * ptrSimInfo, void * sbuf,
-                        void ** rbuf, size_t sizeType);
+    bool spread_collect(pssalib::datamodel::SimulationInfo * ptrSimInfo,
+                        const UINTEGER * arSamples, UINTEGER unSamples,
+                        void * sbuf, void ** rbuf, size_t sizeType);
 
     /**
      * Sync the result of an operation in the process pool.
@@ -179,6 +191,28 @@ namespace mpi
      */
     bool allreduce(void * sbuf, void * rbuf, int size, MPI_Op op) const;
 
+    /**
+     * Combine the ensemble statistics of all processes in the statistics
+     * of the master process (collective call).
+     *
+     * @param ptrSimInfo Pointer to the @link SimulationInfo object associated with this run.
+     * @param es Ensemble statistics of this process, updated on the master process [IN/OUT]
+     * @return @true if successful, @false otherwise.
+     */
+    bool reduce_statistics(pssalib::datamodel::SimulationInfo * ptrSimInfo,
+                           pssalib::util::EnsembleStatistics & es) const;
+
+    /**
+     * Combine the histograms of all processes in the histograms
+     * of the master process (collective call).
+     *
+     * @param ptrSimInfo Pointer to the @link SimulationInfo object associated with this run.
+     * @param ph Histograms of this process, updated on the master process [IN/OUT]
+     * @return @true if successful, @false otherwise.
+     */
+    bool reduce_histograms(pssalib::datamodel::SimulationInfo * ptrSimInfo,
+                           pssalib::util::PopulationHistogram & ph) const;
+
     /**
      * Get the size of sent buffer.
      *
@@ -0,0 +1,207 @@
+/**
+ * @file PopulationHistogram.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Histograms of the populations at the final time point of each trial
+ */
+
+#ifndef PSSALIB_UTIL_POPULATION_HISTOGRAM_H_
+#define PSSALIB_UTIL_POPULATION_HISTOGRAM_H_
+
+#include "../typedefs.h"
+
+#include <map>
+
+namespace pssalib
+{
+namespace util
+{
+  /**
+   * @class PopulationHistogram
+   * @brief Accumulates the distribution of the populations at the final
+   * time point while the trials are sampled.
+   *
+   * @details For each species in each subvolume a marginal histogram with
+   * a fixed number of bins is kept. All bins are of equal width, which is
+   * a power of two: once a value falls beyond the last bin, adjacent bins
+   * are pairwise combined and the width is doubled, thus the memory use
+   * does not depend on the number of samples. Optionally, the number of
+   * samples in each distinct joint state is counted as well. Only a given
+   * number of the most frequent states is written, samples in the remaining
+   * states are written in total. The limit is applied to the combined
+   * counts, so that the result does not depend on how the samples were
+   * distributed among threads or processes. Histograms of different threads
+   * or processes are combined by adding the counts once the bins have been
+   * brought to the same width.
+   */
+  class PopulationHistogram
+  {
+  ////////////////////////////////
+  // Data types
+  public:
+    //! Number of samples in each joint state
+    typedef std::map<std::vector<UINTEGER>, ULINTEGER> StatesMap;
+
+  ////////////////////////////////
+  // Attributes
+  protected:
+    std::size_t           szPopulation;  //!< number of values in a population
+    UINTEGER              unSubvolumes;  //!< number of subvolumes in a population
+    UINTEGER              unBins;        //!< number of bins in a marginal histogram
+    ULINTEGER             *arMarginals;  //!< bin width exponent & bin counts of each value
+    UINTEGER              unStatesMax;   //!< maximum number of joint states written
+    StatesMap             mapStates;     //!< samples count of each joint state
+    std::vector<UINTEGER> arState;       //!< @internal population of the current trial
+
+  /////////////////////////////////////
+  // Constructors
+  public:
+    //! Default constructor
+    PopulationHistogram();
+
+    //! Copy constructor
+    PopulationHistogram(const PopulationHistogram &) = delete;
+
+    //! Destructor
+    ~PopulationHistogram();
+
+  /////////////////////////////////////
+  // Methods
+  public:
+    /**
+     * Allocate & reset the histograms.
+     *
+     * @param szPop Number of values in a population.
+     * @param subvolumes Number of subvolumes in a population.
+     * @param bins Number of bins in each marginal histogram (at least 2).
+     * @param states Maximum number of joint states written, @c 0 disables the joint histogram.
+     */
+    void allocate(std::size_t szPop, UINTEGER subvolumes, UINTEGER bins, UINTEGER states);
+
+    /**
+     * Free allocated resources.
+     */
+    void free();
+
+    /**
+     * Check whether the histograms are allocated.
+     *
+     * @return @true if the histograms are allocated, @false otherwise.
+     */
+    inline bool isAllocated() const
+    {
+      return (NULL != arMarginals);
+    }
+
+    /**
+     * Get the buffer to be filled with the population of a trial.
+     *
+     * @return Pointer to the buffer of @c szPopulation values.
+     */
+    inline UINTEGER * getStateBuffer()
+    {
+      return arState.data();
+    }
+
+    /**
+     * Add the population stored in the state buffer.
+     */
+    void add();
+
+    /**
+     * Combine the counts of another histogram with this one.
+     *
+     * @param other Histogram of the same layout.
+     * @return @true if successful, @false if the layouts differ.
+     */
+    bool merge(const PopulationHistogram & other);
+
+    /**
+     * Combine a number of marginal histograms with another one.
+     *
+     * @param arIn Histograms to add.
+     * @param arInOut Histograms to update.
+     * @param rows Number of histograms.
+     * @param bins Number of bins in a histogram.
+     */
+    static void merge(const ULINTEGER * arIn, ULINTEGER * arInOut, std::size_t rows, UINTEGER bins);
+
+    /**
+     * Store the joint states in a flat array: the population followed by
+     * the samples count of each state.
+     *
+     * @param arStates Flat array [OUT].
+     */
+    void serializeStates(std::vector<ULINTEGER> & arStates) const;
+
+    /**
+     * Add the joint states stored in a flat array.
+     *
+     * @param arStates Flat array as produced by @ref serializeStates.
+     * @param size Number of values in the array.
+     * @return @true if successful, @false if the array is malformed.
+     */
+    bool mergeStates(const ULINTEGER * arStates, std::size_t size);
+
+    /**
+     * Write the histograms. Each marginal histogram is written on a line of
+     * its own, in the order of the population values, as the bin width
+     * followed by the counts up to the last non-empty bin. If enabled, the
+     * marginal histograms are followed by an empty line & the most frequent
+     * joint states (the smaller state first if the counts are equal) in
+     * ascending order, each one as the samples count followed by the
+     * population. The last line holds the number of samples in the states
+     * beyond the limit.
+     *
+     * @param os Output stream.
+     * @return @true if successful, @false otherwise.
+     */
+    bool write(OSTREAM & os) const;
+
+    //! Get the number of values in a marginal histogram row
+    inline std::size_t getRowSize() const
+    {
+      return 1 + unBins;
+    }
+
+    //! Get the number of marginal histograms
+    inline std::size_t getRows() const
+    {
+      return szPopulation;
+    }
+
+    //! Get the marginal histograms
+    inline ULINTEGER * getMarginals()
+    {
+      return arMarginals;
+    }
+
+    //! Check whether the joint states are counted
+    inline bool isStatesOn() const
+    {
+      return (0 != unStatesMax);
+    }
+
+    //! Assignement operator
+    PopulationHistogram & operator= (const PopulationHistogram &) = delete;
+
+  protected:
+    //! Double the bin width of a marginal histogram
+    static void coarsen(ULINTEGER * arRow, UINTEGER bins);
+
+    //! Count samples in a joint state
+    void addState(const std::vector<UINTEGER> & state, ULINTEGER count);
+  };
+
+} } // close namespaces util and pssalib
+
+#endif /* PSSALIB_UTIL_POPULATION_HISTOGRAM_H_ */
@@ -0,0 +1,207 @@
+/**
+ * @file ReactionEventStream.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Buffered stream of reaction events passed to a user sink in batches
+ */
+
+#ifndef PSSALIB_UTIL_REACTION_EVENT_STREAM_H_
+#define PSSALIB_UTIL_REACTION_EVENT_STREAM_H_
+
+#include "../typedefs.h"
+
+namespace pssalib
+{
+namespace util
+{
+  /**
+   * @class ReactionEventStream
+   * @brief Collects reaction events of a trial in a fixed-size buffer
+   * and passes them to a user sink once the buffer is full or the trial
+   * has ended.
+   *
+   * @details Events can be filtered by reaction and by subvolume index,
+   * an empty mask accepts all events. Events with an index beyond the
+   * size of the respective mask are dropped.
+   */
+  class ReactionEventStream
+  {
+  ////////////////////////////////
+  // Attributes
+  protected:
+    FCN_REACTION_EVENTS_SINK ptrSink;       //!< sink of the events
+    void *                   ptrSinkUserData;//!< sink user data
+    UINTEGER                 unBatchSize;   //!< number of events passed at once
+    std::vector<bool>        arReactions;   //!< reactions filter
+    std::vector<bool>        arSubvolumes;  //!< subvolumes filter
+
+    ReactionEvent *          arEvents;      //!< @internal buffer
+    UINTEGER                 unEvents;      //!< @internal number of buffered events
+    UINTEGER                 unSample;      //!< @internal current sample
+
+  /////////////////////////////////////
+  // Constructors
+  public:
+    //! Default constructor
+    ReactionEventStream() :
+      ptrSink(NULL),
+      ptrSinkUserData(NULL),
+      unBatchSize(1024),
+      arEvents(NULL),
+      unEvents(0),
+      unSample(0)
+    {
+      // Do nothing
+    };
+
+    //! Copy constructor
+    ReactionEventStream(const ReactionEventStream &) = delete;
+
+    //! Destructor
+    ~ReactionEventStream()
+    {
+      free();
+    }
+
+  /////////////////////////////////////
+  // Methods
+  public:
+    /**
+     * Set the sink of the events.
+     *
+     * @param fcnSink Sink function, @c NULL disables the stream.
+     * @param user Pointer to user data passed on to the sink.
+     * @param batch Number of events passed to the sink at once.
+     */
+    void setSink(FCN_REACTION_EVENTS_SINK fcnSink, void * user, UINTEGER batch)
+    {
+      free();
+      ptrSink = fcnSink;
+      ptrSinkUserData = user;
+      unBatchSize = std::max(batch, UINTEGER(1));
+    }
+
+    /**
+     * Set the events filter.
+     *
+     * @param reactions Mask of accepted reaction indices.
+     * @param subvolumes Mask of accepted subvolume indices.
+     */
+    void setFilter(const std::vector<bool> & reactions,
+                   const std::vector<bool> & subvolumes)
+    {
+      arReactions = reactions;
+      arSubvolumes = subvolumes;
+    }
+
+    /**
+     * Copy the sink & the filter of another stream.
+     *
+     * @param other the stream to copy from.
+     */
+    void assign(const ReactionEventStream & other)
+    {
+      setSink(other.ptrSink, other.ptrSinkUserData, other.unBatchSize);
+      setFilter(other.arReactions, other.arSubvolumes);
+    }
+
+    /**
+     * Check whether the events are passed to a sink.
+     *
+     * @return @true if the stream is enabled, @false otherwise.
+     */
+    inline bool isEnabled() const
+    {
+      return (NULL != ptrSink);
+    }
+
+    /**
+     * Allocate the buffer, if the stream is enabled.
+     */
+    void allocate()
+    {
+      if(isEnabled() && (NULL == arEvents))
+        arEvents = new ReactionEvent[unBatchSize];
+      unEvents = 0;
+    }
+
+    /**
+     * Free allocated resources.
+     */
+    inline void free()
+    {
+      if(NULL != arEvents)
+      {
+        delete [] arEvents;
+        arEvents = NULL;
+      }
+      unEvents = 0;
+    }
+
+    /**
+     * Start the events of a new sample, the buffer
+     * must be flushed before.
+     *
+     * @param sample Index of the sample.
+     */
+    inline void begin(UINTEGER sample)
+    {
+      unSample = sample;
+      unEvents = 0;
+    }
+
+    /**
+     * Append an event unless it is filtered out.
+     *
+     * @param time Simulation time.
+     * @param mu Reaction index.
+     * @param nu Subvolume index.
+     * @param nu_D Destination subvolume index.
+     * @param delayed @true if the event completes a delayed reaction.
+     */
+    inline void push(REAL time, UINTEGER mu, UINTEGER nu, UINTEGER nu_D, bool delayed)
+    {
+      if(!arReactions.empty() && ((mu >= arReactions.size()) || !arReactions[mu]))
+        return;
+      if(!arSubvolumes.empty() && ((nu >= arSubvolumes.size()) || !arSubvolumes[nu]))
+        return;
+
+      ReactionEvent & e = arEvents[unEvents];
+      e.time = time;
+      e.mu = mu;
+      e.nu = nu;
+      e.nu_D = nu_D;
+      e.delayed = delayed;
+
+      if(++unEvents == unBatchSize)
+        flush();
+    }
+
+    /**
+     * Pass the buffered events to the sink.
+     */
+    inline void flush()
+    {
+      if(0 != unEvents)
+      {
+        ptrSink(unSample, arEvents, unEvents, ptrSinkUserData);
+        unEvents = 0;
+      }
+    }
+
+    //! Assignement operator
+    ReactionEventStream & operator= (const ReactionEventStream &) = delete;
+  };
+
+} } // close namespaces util and pssalib
+
+#endif /* PSSALIB_UTIL_REACTION_EVENT_STREAM_H_ */
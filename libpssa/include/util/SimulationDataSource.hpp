@@ -14,6 +14,7 @@
 
 #include "../typedefs.h"
 #include "MPIWrapper.h"
+#include "BinaryTrajectory.h"
 
 #ifndef PSSALIB_UTIL_SIMULATION_DATA_SOURCE_HPP_
 #define PSSALIB_UTIL_SIMULATION_DATA_SOURCE_HPP_
@@ -22,6 +23,13 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string.hpp>
 
+#if defined(__linux__) || defined(__MACH__)
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
 /**
  * @class OutputFormatter
  * @brief Interface for an output formatter
@@ -568,6 +576,9 @@ protected:
   //! Data
   REAL *m_arData;
 
+  //! Maximum number of threads used to parse a text data set, @c 0 uses all available
+  UINTEGER m_unThreads;
+
 ///////////////
 // Constructors
 public:
@@ -580,6 +591,7 @@ public:
     , m_unSpecies(cols)
     , m_unSubvolumes(vols)
     , m_arData(NULL)
+    , m_unThreads(0)
   {
     if(m_unTimePoints*m_unSpecies > 0)
     {
@@ -637,6 +649,287 @@ inline void free()
     m_arData = NULL;
   }
 
+  /**
+   * Check the ranges of a subset of the data set
+   * 
+   * @param rangeTime Initial and final time points to be processed
+   * @param rangeSubvolumes Pointer to an array containing subvolume indexes
+   * @param rangeSpecies Pointer to an array containing species indexes
+   * @return @c true if the ranges are valid, @c false otherwise
+   */
+static bool checkRanges(const std::pair< UINTEGER, UINTEGER > & rangeTime,
+                        const std::pair< const UINTEGER *, const UINTEGER * > & rangeSpecies,
+                        const std::pair< const UINTEGER *, const UINTEGER * > & rangeSubvolumes)
+  {
+    if(rangeTime.second < rangeTime.first)
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "Error : invalid temporal range (" << rangeTime.first << ", " << rangeTime.second << ")\n";
+      return false;
+    }
+
+    if(((NULL != rangeSpecies.first)&&(NULL == rangeSpecies.second))||
+       ((NULL == rangeSpecies.first)&&(NULL != rangeSpecies.second))||
+       ((NULL != rangeSpecies.first)&&(NULL != rangeSpecies.second)&&
+        (rangeSpecies.first == rangeSpecies.second))||
+       (rangeSpecies.first > rangeSpecies.second))
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "Error : invalid species range\n";
+      return false;
+    }
+    
+    if(((NULL != rangeSubvolumes.first)&&(NULL == rangeSubvolumes.second))||
+       ((NULL == rangeSubvolumes.first)&&(NULL != rangeSubvolumes.second))||
+       ((NULL != rangeSubvolumes.first)&&(NULL != rangeSubvolumes.second)&&
+        (rangeSubvolumes.first == rangeSubvolumes.second))||
+       (rangeSubvolumes.first > rangeSubvolumes.second))
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "Error : invalid subvolume range\n";
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Select the indices of the values to be loaded
+   * 
+   * @param range Pointer to an array containing the indexes
+   * @param available Number of values available
+   * @param count Number of values to be loaded, @c 0 loads all values [IN/OUT]
+   * @param arIdx Indices of the values to be loaded [OUT]
+   * @return @c true on success, @c false if not enough values are available
+   */
+static bool selectIndices(const std::pair< const UINTEGER *, const UINTEGER * > & range,
+                          std::uint64_t available, UINTEGER & count, std::vector<UINTEGER> & arIdx)
+  {
+    if((NULL != range.first)&&(NULL != range.second))
+    {
+      std::set<UINTEGER> setIdx(range.first, range.second);
+      if(*setIdx.rbegin() >= available)
+        return false;
+      arIdx.assign(setIdx.begin(), setIdx.end());
+      count = arIdx.size();
+    }
+    else
+    {
+      if(0 == count)
+        count = available;
+      else if(count > available)
+        return false;
+      arIdx.resize(count);
+      for(UINTEGER i = 0; i < count; ++i)
+        arIdx[i] = i;
+    }
+    return (count > 0);
+  }
+
+  /**
+   * Convert the selected values of a binary trajectory
+   * 
+   * @param ptrData Pointer to the first row to be loaded
+   * @param hdr Binary trajectory header
+   * @param arIdxSpecies Indices of the species to be loaded
+   * @param arIdxSubvolumes Indices of the subvolumes to be loaded
+   */
+template<typename T>
+  void convert(const char * ptrData, const pssalib::util::BinaryTrajectory::Header & hdr,
+               const std::vector<UINTEGER> & arIdxSpecies,
+               const std::vector<UINTEGER> & arIdxSubvolumes)
+  {
+    REAL * ptrOut = m_arData;
+    T value;
+    for(UINTEGER t = 0; t < m_unTimePoints; ++t)
+    {
+      for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
+      {
+        const char * ptrSubvolume = ptrData + arIdxSubvolumes[svi] * hdr.species * sizeof(T);
+        for(UINTEGER si = 0; si < m_unSpecies; ++si)
+        {
+          // the mapping is not necessarily aligned to sizeof(T)
+          memcpy(&value, ptrSubvolume + arIdxSpecies[si] * sizeof(T), sizeof(T));
+          *(ptrOut++) = REAL(value);
+        }
+      }
+      ptrData += hdr.subvolumes * hdr.species * sizeof(T);
+    }
+  }
+
+  /**
+   * Describes a line-aligned chunk of a text data set & the first error
+   * encountered while processing it
+   */
+  struct TextChunk
+  {
+    const char * ptrBegin, //!< First character of the chunk
+               * ptrEnd;   //!< Past the last character of the chunk
+    std::uint64_t unLines, //!< Number of lines in the chunk
+                  unFirst; //!< Index of the first line of the chunk
+    const char * strError; //!< Description of the first error
+    std::uint64_t unErrLine; //!< Line of the first error
+    UINTEGER unErrSubvolume, //!< Subvolume of the first error
+             unErrSpecies;   //!< Species of the first error
+
+    TextChunk()
+      : ptrBegin(NULL), ptrEnd(NULL), unLines(0), unFirst(0)
+      , strError(NULL), unErrLine(0), unErrSubvolume(0), unErrSpecies(0)
+    {
+      // Do nothing
+    }
+  };
+
+  /**
+   * Find the next non-empty token in a line
+   * 
+   * @param ptr Beginning of the token [IN/OUT]
+   * @param end End of the line
+   * @param delim Token delimiter
+   * @return past the last character of the token, equals @p ptr if no more tokens are found
+   */
+static inline const char * nextToken(const char * & ptr, const char * end, char delim)
+  {
+    while((ptr < end)&&(delim == *ptr)) ++ptr;
+    if(ptr >= end)
+      return end;
+    const char * tokEnd = static_cast<const char *>(memchr(ptr, delim, end - ptr));
+    return (NULL == tokEnd) ? end : tokEnd;
+  }
+
+  /**
+   * Count the non-empty tokens in a line
+   * 
+   * @param ptr Beginning of the line
+   * @param end End of the line
+   * @param delim Token delimiter
+   * @return number of tokens
+   */
+static std::uint64_t countTokens(const char * ptr, const char * end, char delim)
+  {
+    std::uint64_t count = 0;
+    for(const char * tokEnd = nextToken(ptr, end, delim); ptr < end; ptr = tokEnd, tokEnd = nextToken(ptr, end, delim))
+      ++count;
+    return count;
+  }
+
+  /**
+   * Convert a token to a number, population counts are converted
+   * without the overhead of a general-purpose floating point parser
+   * 
+   * @param ptr Beginning of the token
+   * @param end End of the token
+   * @param value Converted value [OUT]
+   * @return @c true on success, @c false if the token is not a number
+   */
+static bool parseValue(const char * ptr, const char * end, REAL & value)
+  {
+    const std::size_t len = end - ptr;
+    if((len > 0)&&(len <= std::numeric_limits<std::uint64_t>::digits10))
+    {
+      std::uint64_t number = 0;
+      const char * it = ptr;
+      for(; (it < end)&&(unsigned(*it - '0') < 10u); ++it)
+        number = number * 10 + unsigned(*it - '0');
+      if(it == end)
+      {
+        value = REAL(number);
+        return true;
+      }
+    }
+
+    // fall back for real numbers
+    char buf[64];
+    if((0 == len)||(len >= sizeof(buf)))
+      return false;
+    memcpy(buf, ptr, len);
+    buf[len] = '\0';
+
+    char * ptrParsed = NULL;
+    value = strtod(buf, &ptrParsed);
+    return (buf + len == ptrParsed);
+  }
+
+  /**
+   * Parse the lines of a chunk belonging to the selected time points
+   * directly into the data storage
+   * 
+   * @param chunk Chunk to be parsed [IN/OUT]
+   * @param unTimeFirst Index of the first line to be loaded
+   * @param arIdxSpecies Indices of the species to be loaded
+   * @param arIdxSubvolumes Indices of the subvolumes to be loaded
+   */
+  void parseChunk(TextChunk & chunk, std::uint64_t unTimeFirst,
+                  const std::vector<UINTEGER> & arIdxSpecies,
+                  const std::vector<UINTEGER> & arIdxSubvolumes)
+  {
+    const std::uint64_t unTimeEnd = unTimeFirst + m_unTimePoints;
+    const std::size_t szRow = std::size_t(m_unSubvolumes) * m_unSpecies;
+
+    const char * ptrLine = chunk.ptrBegin;
+    for(std::uint64_t line = chunk.unFirst; (ptrLine < chunk.ptrEnd)&&(line < unTimeEnd); ++line)
+    {
+      const char * ptrLineEnd = static_cast<const char *>(memchr(ptrLine, '\n', chunk.ptrEnd - ptrLine));
+      if(NULL == ptrLineEnd) ptrLineEnd = chunk.ptrEnd;
+      const char * ptr = ptrLine, * end = ptrLineEnd;
+      ptrLine = ptrLineEnd + 1;
+
+      // trim
+      while((ptr < end)&&isspace((unsigned char)*ptr)) ++ptr;
+      while((ptr < end)&&isspace((unsigned char)*(end - 1))) --end;
+
+      UINTEGER subVol = 0;
+      if(ptr == end)
+        chunk.strError = "file cannot contain blank lines";
+      else if(line >= unTimeFirst)
+      {
+        REAL * ptrOut = m_arData + (line - unTimeFirst) * szRow;
+
+        UINTEGER unCurrSubvolume = 0;
+        for(const char * svEnd = nextToken(ptr, end, PSSALIB_TEXTOUTPUT_SUBVOLUMES_DELIMITER[0]);
+            (ptr < end)&&(unCurrSubvolume < m_unSubvolumes)&&(NULL == chunk.strError);
+            ptr = svEnd, svEnd = nextToken(ptr, end, PSSALIB_TEXTOUTPUT_SUBVOLUMES_DELIMITER[0]), ++subVol)
+        {
+          if(subVol < arIdxSubvolumes[unCurrSubvolume])
+            continue;
+
+          UINTEGER unCurrSpecies = 0, species = 0;
+          for(const char * spEnd = nextToken(ptr, svEnd, PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER[0]);
+              (ptr < svEnd)&&(unCurrSpecies < m_unSpecies);
+              ptr = spEnd, spEnd = nextToken(ptr, svEnd, PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER[0]), ++species)
+          {
+            if(species < arIdxSpecies[unCurrSpecies])
+              continue;
+
+            if(!parseValue(ptr, spEnd, ptrOut[unCurrSubvolume * m_unSpecies + unCurrSpecies]))
+            {
+              chunk.strError = "invalid numeric value";
+              break;
+            }
+            ++unCurrSpecies;
+          }
+          if((NULL == chunk.strError)&&(unCurrSpecies < m_unSpecies))
+            chunk.strError = "not enought species";
+          if(NULL != chunk.strError)
+          {
+            chunk.unErrSubvolume = subVol;
+            chunk.unErrSpecies = species;
+          }
+
+          ++unCurrSubvolume;
+        }
+        if((NULL == chunk.strError)&&(unCurrSubvolume < m_unSubvolumes))
+        {
+          chunk.strError = "not enought subvolumes";
+          chunk.unErrSubvolume = subVol;
+        }
+      }
+
+      if(NULL != chunk.strError)
+      {
+        chunk.unErrLine = line;
+        return;
+      }
+    }
+  }
+
 ///////////////
 // Methods
 public:
@@ -649,6 +942,16 @@ public:
     free();
   }
 
+  /**
+   * Set the maximum number of threads used to parse a text data set
+   * 
+   * @param threads Number of threads, @c 0 uses all available
+   */
+  inline void setNumThreads(UINTEGER threads)
+  {
+    m_unThreads = threads;
+  }
+
   /**
    * Get number of time points
    */
@@ -717,7 +1020,47 @@ virtual bool load(const STRING & filePath,
     return false;
   }
 
+  if(isBinary(filePath))
+    return loadBinary(filePath, rangeTime, rangeSpecies, rangeSubvolumes);
+
   bool result = false;
+#if defined(__linux__) || defined(__MACH__)
+  int fd = open(filePath.c_str(), O_RDONLY);
+  if(-1 == fd)
+  {
+    PSSALIB_MPI_CERR_OR_NULL << "Error : could not open file '" << filePath << "'\n";
+    return false;
+  }
+
+  struct stat sb;
+  if(0 != fstat(fd, &sb))
+  {
+    PSSALIB_MPI_CERR_OR_NULL << "Error : could not determine size of file '" << filePath << "'\n";
+    close(fd);
+    return false;
+  }
+  if(0 == sb.st_size)
+  {
+    PSSALIB_MPI_CERR_OR_NULL << "Error : empty data set\n";
+    close(fd);
+    return false;
+  }
+
+  void * ptrData = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(MAP_FAILED == ptrData)
+  {
+    PSSALIB_MPI_CERR_OR_NULL << "Error : could not map file '" << filePath << "' into memory\n";
+    return false;
+  }
+#ifdef MADV_SEQUENTIAL
+  madvise(ptrData, sb.st_size, MADV_SEQUENTIAL);
+#endif
+
+  result = loadText(static_cast<const char *>(ptrData), sb.st_size, rangeTime, rangeSpecies, rangeSubvolumes);
+
+  munmap(ptrData, sb.st_size);
+#else
   FILESTREAMBUFFER fsbData;
   if(!fsbData.open(filePath.c_str(), std::ios_base::in))
   {
@@ -730,12 +1073,35 @@ virtual bool load(const STRING & filePath,
   }
 
   fsbData.close();
+#endif
 
   return result;
 }
 
   /**
-   * Load a simulation data set from a stream
+   * Check whether a file is a binary trajectory
+   * 
+   * @param filePath Path to data set file
+   * @return @c true if the file starts with the binary trajectory signature, @c false otherwise
+   */
+static bool isBinary(const STRING & filePath)
+{
+  FILESTREAMBUFFER fsbData;
+  if(!fsbData.open(filePath.c_str(), std::ios_base::in | std::ios_base::binary))
+    return false;
+
+  char magic[sizeof(PSSALIB_BINARY_TRAJECTORY_MAGIC)];
+  bool result = (sizeof(magic) == fsbData.sgetn(magic, sizeof(magic)))&&
+    (0 == memcmp(magic, PSSALIB_BINARY_TRAJECTORY_MAGIC, sizeof(magic)));
+
+  fsbData.close();
+
+  return result;
+}
+
+  /**
+   * Load a simulation data set from a binary trajectory file, the file
+   * is mapped into memory & only the requested values are converted
    * 
    * @param filePath Path to data set file
    * @param rangeTime Initial and final time points to be processed
@@ -743,45 +1109,366 @@ virtual bool load(const STRING & filePath,
    * @param rangeSpecies Pointer to an array containing species indexes
    * @return @c true on success, @c false otherwise
    */
-virtual bool load(ISTREAM & isData,
-                  const std::pair< UINTEGER, UINTEGER > & rangeTime = std::pair< UINTEGER, UINTEGER >(),
-                  const std::pair< const UINTEGER *, const UINTEGER * > & rangeSpecies = std::pair< const UINTEGER *, const UINTEGER * >(),
-                  const std::pair< const UINTEGER *, const UINTEGER * > & rangeSubvolumes = std::pair< const UINTEGER *, const UINTEGER * >()
-                 )
+virtual bool loadBinary(const STRING & filePath,
+                        const std::pair< UINTEGER, UINTEGER > & rangeTime = std::pair< UINTEGER, UINTEGER >(),
+                        const std::pair< const UINTEGER *, const UINTEGER * > & rangeSpecies = std::pair< const UINTEGER *, const UINTEGER * >(),
+                        const std::pair< const UINTEGER *, const UINTEGER * > & rangeSubvolumes = std::pair< const UINTEGER *, const UINTEGER * >()
+                       )
+{
+  // Argument checks
+  if(filePath.empty())
   {
+    PSSALIB_MPI_CERR_OR_NULL << "Error : an empty file path provided.\n";
+    return false;
+  }
+
+  bool result = false;
+#if defined(__linux__) || defined(__MACH__)
+  int fd = open(filePath.c_str(), O_RDONLY);
+  if(-1 == fd)
+  {
+    PSSALIB_MPI_CERR_OR_NULL << "Error : could not open file '" << filePath << "'\n";
+    return false;
+  }
+
+  struct stat sb;
+  if((0 != fstat(fd, &sb))||(0 == sb.st_size))
+  {
+    PSSALIB_MPI_CERR_OR_NULL << "Error : could not determine size of file '" << filePath << "'\n";
+    close(fd);
+    return false;
+  }
+
+  void * ptrData = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if(MAP_FAILED == ptrData)
+  {
+    PSSALIB_MPI_CERR_OR_NULL << "Error : could not map file '" << filePath << "' into memory\n";
+    return false;
+  }
+
+  result = loadBinary(static_cast<const char *>(ptrData), sb.st_size, rangeTime, rangeSpecies, rangeSubvolumes);
+
+  munmap(ptrData, sb.st_size);
+#else
+  FILESTREAMBUFFER fsbData;
+  if(!fsbData.open(filePath.c_str(), std::ios_base::in | std::ios_base::binary))
+  {
+    PSSALIB_MPI_CERR_OR_NULL << "Error : could not open file '" << filePath << "'\n";
+    return false;
+  }
+
+  std::vector<char> arData(std::istreambuf_iterator<char>(&fsbData), (std::istreambuf_iterator<char>()));
+  fsbData.close();
+
+  if(!arData.empty())
+    result = loadBinary(arData.data(), arData.size(), rangeTime, rangeSpecies, rangeSubvolumes);
+  else
+    PSSALIB_MPI_CERR_OR_NULL << "Error : empty data set\n";
+#endif
+
+  return result;
+}
+
+  /**
+   * Load a simulation data set from a binary trajectory in memory
+   * 
+   * @param ptrData Pointer to the beginning of the binary trajectory
+   * @param szData Size of the binary trajectory in bytes
+   * @param rangeTime Initial and final time points to be processed
+   * @param rangeSubvolumes Pointer to an array containing subvolume indexes
+   * @param rangeSpecies Pointer to an array containing species indexes
+   * @return @c true on success, @c false otherwise
+   */
+virtual bool loadBinary(const char * ptrData, std::size_t szData,
+                        const std::pair< UINTEGER, UINTEGER > & rangeTime = std::pair< UINTEGER, UINTEGER >(),
+                        const std::pair< const UINTEGER *, const UINTEGER * > & rangeSpecies = std::pair< const UINTEGER *, const UINTEGER * >(),
+                        const std::pair< const UINTEGER *, const UINTEGER * > & rangeSubvolumes = std::pair< const UINTEGER *, const UINTEGER * >()
+                       )
+  {
+    typedef pssalib::util::BinaryTrajectory BT;
+
     // Argument checks
-    if(!isData.good())
+    if(!checkRanges(rangeTime, rangeSpecies, rangeSubvolumes))
+      return false;
+
+    BT::Header hdr;
+    if((NULL == ptrData)||(szData < sizeof(BT::Header)))
     {
-      PSSALIB_MPI_CERR_OR_NULL << "Error : input stream is invalid\n";
+      PSSALIB_MPI_CERR_OR_NULL << "Error : binary trajectory is truncated\n";
       return false;
     }
-    
-    if(rangeTime.second < rangeTime.first)
+    memcpy(&hdr, ptrData, sizeof(BT::Header));
+    if(!BT::isValid(hdr)||(hdr.dataOffset > szData))
     {
-      PSSALIB_MPI_CERR_OR_NULL << "Error : invalid temporal range (" << rangeTime.first << ", " << rangeTime.second << ")\n";
+      PSSALIB_MPI_CERR_OR_NULL << "Error : invalid binary trajectory header\n";
+      return false;
+    }
+    if(!(((BT::dtUnsigned == hdr.dtype)&&((sizeof(std::uint32_t) == hdr.dtypeSize)||(sizeof(std::uint64_t) == hdr.dtypeSize)))||
+         ((BT::dtReal == hdr.dtype)&&(sizeof(double) == hdr.dtypeSize))))
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "Error : unsupported data type '" << (char)hdr.dtype
+        << "' of size " << hdr.dtypeSize << " in binary trajectory\n";
       return false;
     }
 
-    if(((NULL != rangeSpecies.first)&&(NULL == rangeSpecies.second))||
-       ((NULL == rangeSpecies.first)&&(NULL != rangeSpecies.second))||
-       ((NULL != rangeSpecies.first)&&(NULL != rangeSpecies.second)&&
-        (rangeSpecies.first == rangeSpecies.second))||
-       (rangeSpecies.first > rangeSpecies.second))
+    // number of rows actually written
+    const std::uint64_t szRow = hdr.subvolumes * hdr.species * hdr.dtypeSize;
+    const std::uint64_t unRows = (0 == szRow) ? 0 :
+      std::min(hdr.timePoints, (std::uint64_t(szData) - hdr.dataOffset) / szRow);
+
+    // Time
+    if(rangeTime.second > 0)
+      m_unTimePoints = rangeTime.second - rangeTime.first;
+    else if((0 == m_unTimePoints)&&(unRows > rangeTime.first))
+      m_unTimePoints = unRows - rangeTime.first;
+
+    if(0 == m_unTimePoints)
     {
-      PSSALIB_MPI_CERR_OR_NULL << "Error : invalid species range\n";
+      PSSALIB_MPI_CERR_OR_NULL << "Error : empty data set\n";
       return false;
     }
-    
-    if(((NULL != rangeSubvolumes.first)&&(NULL == rangeSubvolumes.second))||
-       ((NULL == rangeSubvolumes.first)&&(NULL != rangeSubvolumes.second))||
-       ((NULL != rangeSubvolumes.first)&&(NULL != rangeSubvolumes.second)&&
-        (rangeSubvolumes.first == rangeSubvolumes.second))||
-       (rangeSubvolumes.first > rangeSubvolumes.second))
+    if(rangeTime.first + m_unTimePoints > unRows)
     {
-      PSSALIB_MPI_CERR_OR_NULL << "Error : invalid subvolume range\n";
+      PSSALIB_MPI_CERR_OR_NULL << "Error : 'unexpected end of file' when processing binary trajectory, "
+        << unRows << " time points available, " << rangeTime.first + m_unTimePoints << " requested.\n";
+      return false;
+    }
+
+    // Subvolumes & species
+    std::vector<UINTEGER> arIdxSubvolumes, arIdxSpecies;
+    if(!selectIndices(rangeSubvolumes, hdr.subvolumes, m_unSubvolumes, arIdxSubvolumes))
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "Error : 'not enought subvolumes' when processing binary trajectory.\n";
+      return false;
+    }
+    if(!selectIndices(rangeSpecies, hdr.species, m_unSpecies, arIdxSpecies))
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "Error : 'not enought species' when processing binary trajectory.\n";
+      return false;
+    }
+
+    if((NULL == m_arData)&&!alloc())
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "Error : could not allocate memory\n";
+      return false;
+    }
+
+    ptrData += hdr.dataOffset + rangeTime.first * szRow;
+    switch(hdr.dtype)
+    {
+    case BT::dtUnsigned:
+      if(sizeof(std::uint32_t) == hdr.dtypeSize)
+        convert<std::uint32_t>(ptrData, hdr, arIdxSpecies, arIdxSubvolumes);
+      else
+        convert<std::uint64_t>(ptrData, hdr, arIdxSpecies, arIdxSubvolumes);
+      break;
+    case BT::dtReal:
+      convert<double>(ptrData, hdr, arIdxSpecies, arIdxSubvolumes);
+      break;
+    }
+
+    return true;
+  }
+
+  /**
+   * Load a simulation data set from a text trajectory in memory, the text
+   * is split into line-aligned chunks that are parsed in parallel
+   * 
+   * @param ptrData Pointer to the beginning of the text
+   * @param szData Size of the text in bytes
+   * @param rangeTime Initial and final time points to be processed
+   * @param rangeSubvolumes Pointer to an array containing subvolume indexes
+   * @param rangeSpecies Pointer to an array containing species indexes
+   * @return @c true on success, @c false otherwise
+   */
+virtual bool loadText(const char * ptrData, std::size_t szData,
+                      const std::pair< UINTEGER, UINTEGER > & rangeTime = std::pair< UINTEGER, UINTEGER >(),
+                      const std::pair< const UINTEGER *, const UINTEGER * > & rangeSpecies = std::pair< const UINTEGER *, const UINTEGER * >(),
+                      const std::pair< const UINTEGER *, const UINTEGER * > & rangeSubvolumes = std::pair< const UINTEGER *, const UINTEGER * >()
+                     )
+  {
+    // Argument checks
+    if(!checkRanges(rangeTime, rangeSpecies, rangeSubvolumes))
+      return false;
+
+    if((NULL == ptrData)||(0 == szData))
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "Error : empty data set\n";
+      return false;
+    }
+
+    // Split into chunks of at least 1MB each
+    std::size_t szChunks = 1;
+#ifdef HAVE_THREADS
+    szChunks = (0 != m_unThreads) ? m_unThreads : std::max(1u, std::thread::hardware_concurrency());
+    szChunks = std::max(std::size_t(1), std::min(szChunks, szData >> 20));
+#endif
+    std::vector<TextChunk> arChunks(szChunks);
+    const char * ptr = ptrData, * end = ptrData + szData;
+    for(std::size_t ci = 0; ci < szChunks; ++ci)
+    {
+      arChunks[ci].ptrBegin = ptr;
+      if(ci + 1 < szChunks)
+      {
+        ptr = std::max(ptr, ptrData + (szData / szChunks) * (ci + 1));
+        const char * ptrNewLine = static_cast<const char *>(memchr(ptr, '\n', end - ptr));
+        ptr = (NULL == ptrNewLine) ? end : ptrNewLine + 1;
+      }
+      else
+        ptr = end;
+      arChunks[ci].ptrEnd = ptr;
+
+      // very long lines may leave no data for the remaining chunks
+      if(end == ptr)
+      {
+        szChunks = ci + 1;
+        arChunks.resize(szChunks);
+      }
+    }
+
+    // Count the lines
+#ifdef HAVE_THREADS
+    std::vector<std::thread> arThreads;
+    arThreads.reserve(szChunks);
+    for(std::size_t ci = 1; ci < szChunks; ++ci)
+      arThreads.push_back(std::thread([&arChunks, ci]()
+        { arChunks[ci].unLines = std::count(arChunks[ci].ptrBegin, arChunks[ci].ptrEnd, '\n'); }));
+#endif
+    arChunks[0].unLines = std::count(arChunks[0].ptrBegin, arChunks[0].ptrEnd, '\n');
+#ifdef HAVE_THREADS
+    for(std::size_t ti = 0; ti < arThreads.size(); ++ti)
+      arThreads[ti].join();
+    arThreads.clear();
+#endif
+    // the last line is not necessarily terminated by a line break
+    if('\n' != *(end - 1))
+      ++arChunks.back().unLines;
+
+    std::uint64_t unLines = 0;
+    for(std::size_t ci = 0; ci < szChunks; ++ci)
+    {
+      arChunks[ci].unFirst = unLines;
+      unLines += arChunks[ci].unLines;
+    }
+
+    // Time
+    if(rangeTime.second > 0)
+      m_unTimePoints = rangeTime.second - rangeTime.first;
+    else if((0 == m_unTimePoints)&&(unLines > rangeTime.first))
+      m_unTimePoints = unLines - rangeTime.first;
+
+    if(0 == m_unTimePoints)
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "Error : empty data set\n";
+      return false;
+    }
+    if(rangeTime.first + m_unTimePoints > unLines)
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "Error : 'unexpected end of file' when processing input stream on line "
+        << unLines + 1 << " at subvolume 1 species 1.\n";
       return false;
     }
 
+    // Subvolumes & species are determined from the first line to be loaded
+    std::size_t ci = 0;
+    while(arChunks[ci].unFirst + arChunks[ci].unLines <= rangeTime.first) ++ci;
+    ptr = arChunks[ci].ptrBegin;
+    for(std::uint64_t line = arChunks[ci].unFirst; line < rangeTime.first; ++line)
+      ptr = static_cast<const char *>(memchr(ptr, '\n', end - ptr)) + 1;
+    const char * ptrLineEnd = static_cast<const char *>(memchr(ptr, '\n', end - ptr));
+    if(NULL == ptrLineEnd) ptrLineEnd = end;
+    while((ptr < ptrLineEnd)&&isspace((unsigned char)*ptr)) ++ptr;
+    while((ptr < ptrLineEnd)&&isspace((unsigned char)*(ptrLineEnd - 1))) --ptrLineEnd;
+    if(ptr == ptrLineEnd)
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "Error : 'file cannot contain blank lines' when processing input stream on line "
+        << rangeTime.first + 1 << " at subvolume 1 species 1.\n";
+      return false;
+    }
+
+    std::vector<UINTEGER> arIdxSubvolumes, arIdxSpecies;
+    if(!selectIndices(rangeSubvolumes, countTokens(ptr, ptrLineEnd, PSSALIB_TEXTOUTPUT_SUBVOLUMES_DELIMITER[0]),
+                      m_unSubvolumes, arIdxSubvolumes))
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "Error : 'not enought subvolumes' when processing input stream on line "
+        << rangeTime.first + 1 << ".\n";
+      return false;
+    }
+    const char * ptrTokEnd = nextToken(ptr, ptrLineEnd, PSSALIB_TEXTOUTPUT_SUBVOLUMES_DELIMITER[0]);
+    for(UINTEGER svi = 0; svi < arIdxSubvolumes[0]; ++svi)
+    {
+      ptr = ptrTokEnd;
+      ptrTokEnd = nextToken(ptr, ptrLineEnd, PSSALIB_TEXTOUTPUT_SUBVOLUMES_DELIMITER[0]);
+    }
+    if(!selectIndices(rangeSpecies, countTokens(ptr, ptrTokEnd, PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER[0]),
+                      m_unSpecies, arIdxSpecies))
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "Error : 'not enought species' when processing input stream on line "
+        << rangeTime.first + 1 << " at subvolume " << arIdxSubvolumes[0] + 1 << ".\n";
+      return false;
+    }
+
+    if((NULL == m_arData)&&!alloc())
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "Error : could not allocate memory\n";
+      return false;
+    }
+
+    // Parse
+#ifdef HAVE_THREADS
+    for(std::size_t ci = 1; ci < szChunks; ++ci)
+      arThreads.push_back(std::thread(&SimulationDataSource::parseChunk, this, std::ref(arChunks[ci]),
+        std::uint64_t(rangeTime.first), std::cref(arIdxSpecies), std::cref(arIdxSubvolumes)));
+#endif
+    parseChunk(arChunks[0], rangeTime.first, arIdxSpecies, arIdxSubvolumes);
+#ifdef HAVE_THREADS
+    for(std::size_t ti = 0; ti < arThreads.size(); ++ti)
+      arThreads[ti].join();
+#endif
+
+    // Report the first error
+    for(std::size_t ci = 0; ci < szChunks; ++ci)
+    {
+      const TextChunk & chunk = arChunks[ci];
+      if(NULL != chunk.strError)
+      {
+        PSSALIB_MPI_CERR_OR_NULL << "Error : '" << chunk.strError
+          << "' when processing input stream on line "
+          << chunk.unErrLine+1 << " at subvolume " << chunk.unErrSubvolume+1
+          << " species " << chunk.unErrSpecies+1 << ".\n";
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Load a simulation data set from a stream
+   * 
+   * @param filePath Path to data set file
+   * @param rangeTime Initial and final time points to be processed
+   * @param rangeSubvolumes Pointer to an array containing subvolume indexes
+   * @param rangeSpecies Pointer to an array containing species indexes
+   * @return @c true on success, @c false otherwise
+   */
+virtual bool load(ISTREAM & isData,
+                  const std::pair< UINTEGER, UINTEGER > & rangeTime = std::pair< UINTEGER, UINTEGER >(),
+                  const std::pair< const UINTEGER *, const UINTEGER * > & rangeSpecies = std::pair< const UINTEGER *, const UINTEGER * >(),
+                  const std::pair< const UINTEGER *, const UINTEGER * > & rangeSubvolumes = std::pair< const UINTEGER *, const UINTEGER * >()
+                 )
+  {
+    // Argument checks
+    if(!isData.good())
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "Error : input stream is invalid\n";
+      return false;
+    }
+
+    if(!checkRanges(rangeTime, rangeSpecies, rangeSubvolumes))
+      return false;
+
     // Time
     if(rangeTime.second > 0)
     {
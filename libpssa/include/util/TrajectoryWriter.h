@@ -0,0 +1,138 @@
+/**
+ * @file TrajectoryWriter.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Formats & writes the trajectory of a trial, optionally in a separate thread
+ */
+
+#ifndef PSSALIB_UTIL_TRAJECTORY_WRITER_H_
+#define PSSALIB_UTIL_TRAJECTORY_WRITER_H_
+
+#include "../typedefs.h"
+
+namespace pssalib
+{
+namespace util
+{
+  /**
+   * @class TrajectoryWriter
+   * @brief Writes the populations at the output time points to a text
+   * and/or a binary trajectory stream.
+   *
+   * @details If a number of buffers is given, the populations are copied
+   * into a ring of preallocated buffers and a dedicated thread formats &
+   * writes them, so that the sampling thread does not wait for the file
+   * system. The sampling thread blocks only if all buffers are in use.
+   * Without threads support the populations are written synchronously.
+   */
+  class TrajectoryWriter
+  {
+  ////////////////////////////////
+  // Attributes
+  protected:
+    std::size_t     szPopulation;  //!< number of values in a population
+    UINTEGER        unSubvolumes;  //!< number of subvolumes in a population
+    STRING::pointer ptrLine;       //!< text line buffer
+    STREAMBUFFER    *ptrText,      //!< text trajectory of the current trial
+                    *ptrBinary;    //!< binary trajectory of the current trial
+    bool            bFailed;       //!< a write failed during the current trial
+
+#ifdef HAVE_THREADS
+    UINTEGER        *arBuffers;    //!< ring of population buffers
+    UINTEGER        *arLines;      //!< number of output lines of each buffer
+    UINTEGER        unBuffers,     //!< number of buffers in the ring
+                    unHead,        //!< oldest buffer in use
+                    unCount;       //!< number of buffers in use
+    bool            bStop;         //!< writer thread shall exit once the ring is empty
+
+    std::mutex              mtx;        //!< guards the ring state
+    std::condition_variable cvNotEmpty; //!< wakes up the writer thread
+    std::condition_variable cvNotFull;  //!< wakes up the sampling thread
+    std::thread             thWriter;   //!< writer thread
+#endif
+
+  /////////////////////////////////////
+  // Constructors
+  public:
+    //! Default constructor
+    TrajectoryWriter();
+
+    //! Copy constructor
+    TrajectoryWriter(const TrajectoryWriter &) = delete;
+
+    //! Destructor
+    ~TrajectoryWriter();
+
+  /////////////////////////////////////
+  // Methods
+  public:
+    /**
+     * Allocate the buffers & start the writer thread.
+     *
+     * @param szPop Number of values in a population.
+     * @param subvolumes Number of subvolumes in a population.
+     * @param bText Allocate the text line buffer.
+     * @param buffers Number of buffers in the ring, @c 0 writes synchronously.
+     */
+    void allocate(std::size_t szPop, UINTEGER subvolumes, bool bText, UINTEGER buffers);
+
+    /**
+     * Stop the writer thread & free allocated resources.
+     */
+    void free();
+
+    /**
+     * Check whether the populations are written by a separate thread.
+     *
+     * @return @true if the writer thread is running, @false otherwise.
+     */
+    bool isAsync() const;
+
+    /**
+     * Begin the trajectory of a new trial, pending output is flushed before.
+     *
+     * @param sbText Text trajectory stream buffer or @c NULL.
+     * @param sbBinary Binary trajectory stream buffer or @c NULL.
+     */
+    void begin(STREAMBUFFER * sbText, STREAMBUFFER * sbBinary);
+
+    /**
+     * Write a population a given number of times.
+     *
+     * @param arPop Population.
+     * @param unLines Number of output time points.
+     */
+    void write(const UINTEGER * arPop, UINTEGER unLines);
+
+    /**
+     * Wait until the pending output is written.
+     *
+     * @return @true if all output of the trial was written, @false otherwise.
+     */
+    bool flush();
+
+    //! Assignement operator
+    TrajectoryWriter & operator= (const TrajectoryWriter &) = delete;
+
+  protected:
+    //! Format & write a population
+    void output(const UINTEGER * arPop, UINTEGER unLines);
+
+#ifdef HAVE_THREADS
+    //! Writer thread routine
+    void run();
+#endif
+  };
+
+} } // close namespaces util and pssalib
+
+#endif /* PSSALIB_UTIL_TRAJECTORY_WRITER_H_ */
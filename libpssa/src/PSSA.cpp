@@ -17,30 +17,40 @@
 #include "../include/PSSA.h"
 #include "../include/datamodel/DataModel.h"
 #include "../include/datamodel/DataModel_DM.h"
+#include "../include/datamodel/DataModel_DMTree.h"
+#include "../include/datamodel/DataModel_NRM.h"
 #include "../include/datamodel/DataModel_PDM.h"
 #include "../include/datamodel/DataModel_SPDM.h"
 #include "../include/datamodel/DataModel_PSSACR.h"
 
 #include "../include/grouping/GroupingModule.h"
 #include "../include/grouping/GroupingModule_DM.h"
+#include "../include/grouping/GroupingModule_DMTree.h"
+#include "../include/grouping/GroupingModule_NRM.h"
 #include "../include/grouping/GroupingModule_PDM.h"
 #include "../include/grouping/GroupingModule_SPDM.h"
 #include "../include/grouping/GroupingModule_PSSACR.h"
 
 #include "../include/sampling/SamplingModule.h"
 #include "../include/sampling/SamplingModule_DM.h"
+#include "../include/sampling/SamplingModule_DMTree.h"
+#include "../include/sampling/SamplingModule_NRM.h"
 #include "../include/sampling/SamplingModule_PDM.h"
 #include "../include/sampling/SamplingModule_SPDM.h"
 #include "../include/sampling/SamplingModule_PSSACR.h"
 
 #include "../include/update/UpdateModule.h"
 #include "../include/update/UpdateModule_DM.h"
+#include "../include/update/UpdateModule_DMTree.h"
+#include "../include/update/UpdateModule_NRM.h"
 #include "../include/update/UpdateModule_PDM.h"
 #include "../include/update/UpdateModule_SPDM.h"
 #include "../include/update/UpdateModule_PSSACR.h"
 
 #include "../include/datamodel/SimulationInfo.h"
 
+#include "../include/util/AllocationCounter.h"
+#include "../include/util/Checkpoint.h"
 #include "../include/util/FileSystem.h"
 #include "../include/util/Timing.h"
 
@@ -52,11 +62,85 @@
 
 namespace pssalib
 {
-  typedef struct tagTimingInfo
+  ///////////////////////////////
+  // Checkpoints
+
+  //! State of the serial sampling loop saved at checkpoints
+  struct PSSA::tagCheckpointState
+  {
+    typedef std::chrono::steady_clock Clock;
+
+    //! Number of reactions fired between subsequent reads of the clock
+    static const UINTEGER unClockStride = 1024;
+
+    STRING                   strPath;     //!< Path of the checkpoint file
+    util::Checkpoint         image;       //!< Serialized state, reused by all checkpoints
+    util::Checkpoint::Header hdrSettings; //!< Simulation settings the checkpoints must match
+    util::Checkpoint::Header hdrTrial;    //!< Header of the loaded checkpoint
+    Clock::duration          dtInterval;  //!< Wall-clock time between checkpoints
+    Clock::time_point        tpNext;      //!< Time the next checkpoint is due
+    Clock::time_point        tpTrial;     //!< Time the current trial was started or resumed
+    REAL                     dTrialTime;  //!< Time spent on the current trial before it was resumed
+    TimingInfo *             arTiming;    //!< Timing of the samples (may be @c NULL)
+    UINTEGER *               arFinalPops; //!< Final populations of the samples (may be @c NULL)
+    bool                     bResume;     //!< The next trial continues the loaded one
+  };
+
+  //! Output flags changing the sections of a checkpoint
+  static const UINTEGER unCheckpointOutputFlags =
+    datamodel::SimulationInfo::ofTrajectory | datamodel::SimulationInfo::ofRawTrajectory |
+    datamodel::SimulationInfo::ofFinalPops | datamodel::SimulationInfo::ofRawFinalPops |
+    datamodel::SimulationInfo::ofTiming | datamodel::SimulationInfo::ofBinaryTrajectory |
+    datamodel::SimulationInfo::ofAvgTrajectory | datamodel::SimulationInfo::ofHistogram;
+
+  //! Hash the parameters of a model that determine its trajectories
+  static std::uint64_t hashModel(const datamodel::detail::Model & model)
+  {
+    typedef util::Checkpoint C;
+    std::uint64_t h = C::hash(0, REAL(model.getCompartmentVolume()));
+    h = C::hash(h, UINTEGER(model.getCompartmentVolumeDimensions()));
+    h = C::hash(h, model.isDelaysSet());
+    for(UINTEGER i = 0; i < model.getSpeciesCount(); ++i)
+    {
+      const datamodel::detail::Species * species = model.getSpecies(i);
+      h = C::hash(h, species->getInitialAmount());
+      h = C::hash(h, species->getDiffusionConstant());
+      h = C::hash(h, species->isConstant());
+      h = C::hash(h, species->isBoundaryCondition());
+    }
+    for(UINTEGER i = 0; i < model.getReactionsCount(); ++i)
+    {
+      const datamodel::detail::Reaction * reaction = model.getReaction(i);
+      h = C::hash(h, reaction->getForwardRate());
+      h = C::hash(h, reaction->getReverseRate());
+      h = C::hash(h, reaction->getDelay());
+      h = C::hash(h, reaction->isSetDelayConsuming());
+      h = C::hash(h, reaction->getReactantsCount());
+      for(UINTEGER j = 0; j < reaction->getSpeciesReferencesCount(); ++j)
+      {
+        const datamodel::detail::SpeciesReference * ref = reaction->getSpeciesReferenceAt(j);
+        h = C::hash(h, ref->getIndex());
+        h = C::hash(h, ref->getStoichiometry());
+      }
+    }
+    return h;
+  }
+
+#ifdef HAVE_MPI
+  ///////////////////////////////
+  // Per-process storage of the samples
+
+  //! Reallocate an array of per-sample records retaining the stored ones
+  template<typename T>
+  static void resizeSampleSlots(boost::scoped_array<T> & ar, std::size_t szOld, std::size_t szNew)
   {
-    REAL t;     //!< Time spent simulating the trial
-    UINTEGER n; //!< Number of reactions fired
-  } TimingInfo;
+    if(NULL == ar.get())
+      return;
+    T * arNew = new T[szNew];
+    std::copy(ar.get(), ar.get() + std::min(szOld, szNew), arNew);
+    ar.reset(arNew);
+  }
+#endif
 
   ///////////////////////////////
   // Constructors
@@ -72,6 +156,8 @@ namespace pssalib
     , ptrSampling(NULL)
     , ptrUpdate(NULL)
     , m_Method(M_Invalid)
+    , ptrStepLoop(&PSSA::runStepLoop<sampling::SamplingModule, update::UpdateModule, true, true>)
+    , ptrCheckpoint(NULL)
   {
     // Do nothing
   }
@@ -79,6 +165,7 @@ namespace pssalib
   // Destructor
   PSSA::~PSSA()
   {
+    freeCheckpoints(false);
     setMethod(M_Invalid);
   }
 
@@ -98,6 +185,8 @@ namespace pssalib
       case M_PDM:    return STRING("PDM");
       case M_PSSACR: return STRING("PSSACR");
       case M_SPDM:   return STRING("SPDM");
+      case M_DMTree: return STRING("DMTree");
+      case M_NRM:    return STRING("NRM");
       default:       return STRING("Unknown method");
     }
     return STRING();
@@ -110,7 +199,12 @@ namespace pssalib
    */
   PSSA::EMethod PSSA::getMethodID(const STRING &s)
   {
-    if((0 == s.compare(0,2,"dm"))||
+    if((0 == s.compare(0,6,"dmtree"))||
+       (0 == s.compare(0,29,"direct method with a sum tree")))
+    {
+      return M_DMTree;
+    }
+    else if((0 == s.compare(0,2,"dm"))||
        (0 == s.compare(0,13,"direct method"))||
        (0 == s.compare(0,27,"gillespie's direct method")))
     {
@@ -131,6 +225,11 @@ namespace pssalib
     {
       return M_SPDM;
     }
+    else if((0 == s.compare(0,3,"nrm"))||
+            (0 == s.compare(0,20,"next reaction method")))
+    {
+      return M_NRM;
+    }
     else
     {
       return M_Invalid;
@@ -160,6 +259,45 @@ namespace pssalib
     ptrReactionCallback = fcnReaction;
     ptrReactionCallbackUserData = user;
   }
+
+  /**
+   * Sets the sink of reaction events. Events are collected in a buffer
+   * and passed to the sink once it is full and at the end of each trial.
+   * Unlike the reaction callback, the sink does not see the data model.
+   * The completion of a delayed reaction is passed as a separate event
+   * with the @a delayed flag set.
+   * @note If samples are drawn by several threads, each thread passes the
+   * events of its own trials, so the sink may be called concurrently and
+   * the batches of different samples may interleave.
+   * @param fcnSink     Pointer to a sink function that conforms with the
+   *                    FCN_REACTION_EVENTS_SINK prototype, @c NULL disables the events
+   * @param user        Pointer to user data passed on as a sink argument
+   * @param batch       Maximum number of events passed to the sink at once
+   */
+  void PSSA::SetReactionEventsSink(FCN_REACTION_EVENTS_SINK fcnSink, void* user, UINTEGER batch)
+  {
+    m_EventStream.setSink(fcnSink, user, batch);
+  }
+
+  /**
+   * Sets the filter of reaction events passed to the sink.
+   * @param reactions   Mask of reaction (wrapper) indices, empty to accept all reactions
+   * @param subvolumes  Mask of subvolume indices, empty to accept all subvolumes
+   */
+  void PSSA::SetReactionEventsFilter(const std::vector<bool> & reactions, const std::vector<bool> & subvolumes)
+  {
+    m_EventStream.setFilter(reactions, subvolumes);
+  }
+
+  /**
+   * Returns the seed of the random number generator used by the last
+   * simulation, e.g. to repeat a run whose seed was drawn automatically.
+   * @return Seed value, 0 if the engine is not set up
+   */
+  ULINTEGER PSSA::getRNGSeed() const
+  {
+    return (NULL != ptrSampling) ? ptrSampling->get_rng_seed() : 0;
+  }
  
   /**
    * Sets the simulation method
@@ -229,6 +367,20 @@ namespace pssalib
           tempSampling.reset(new sampling::SamplingModule_SPDM());
           tempUpdate.reset(new update::UpdateModule_SPDM());
           break;
+        // (Delayed) Direct Method with a sum tree
+        case M_DMTree:
+          tempData.reset(new datamodel::DataModel_DMTree());
+          tempGrouping.reset(new grouping::GroupingModule_DMTree());
+          tempSampling.reset(new sampling::SamplingModule_DMTree());
+          tempUpdate.reset(new update::UpdateModule_DMTree());
+          break;
+        // (Delayed) Next Reaction Method
+        case M_NRM:
+          tempData.reset(new datamodel::DataModel_NRM());
+          tempGrouping.reset(new grouping::GroupingModule_NRM());
+          tempSampling.reset(new sampling::SamplingModule_NRM());
+          tempUpdate.reset(new update::UpdateModule_NRM());
+          break;
         // Unset
         case M_Invalid:
         // Illegal parameter value
@@ -298,6 +450,14 @@ namespace pssalib
       PSSA_ERROR(ptrSimInfo, << "simulation parameters are invalid.\n");
       return false;
     }
+#if PSSALIB_LOG_LEVEL < PSSALIB_LOG_LEVEL_TRACE
+    if(ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofTrace)||
+       ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::eofEvents))
+    {
+      PSSA_WARNING(ptrSimInfo, << "trace output is requested, but the library "
+        "is built without trace messages (see configure --with-log-level).\n");
+    }
+#endif
 
     // Reset timers
     ptrSimInfo->dTimeCheckpoint = 0.0;
@@ -308,6 +468,9 @@ namespace pssalib
 
   bool PSSA::deinitSimulation(datamodel::SimulationInfo* ptrSimInfo)
   {
+    // Keep the checkpoint file of an incomplete run
+    freeCheckpoints(false);
+
     // Dettach SimulationInfo object from this instance
     ptrSimInfo->detachPSSA();
 
@@ -335,6 +498,18 @@ namespace pssalib
       return false;
     }
 
+    //////////////////////////////
+    // Build the static data structures & the initial state
+    if(!ptrGrouping->compile(ptrSimInfo))
+    {
+      PSSA_ERROR(ptrSimInfo, << "failed to compile data structures.\n");
+      return false;
+    }
+
+    //////////////////////////////
+    // Select the step loop for the compiled model
+    setupStepLoop(ptrSimInfo);
+
     //////////////////////////////
     // Process user settings
     if(!ptrSimInfo->processSettings())
@@ -343,16 +518,47 @@ namespace pssalib
       return false;
     }
 
+    //////////////////////////////
+    // Allocate the per-trial output buffers
+    if(!ptrSimInfo->setupTrialBuffers())
+    {
+      PSSA_ERROR(ptrSimInfo, << "failed to allocate output buffers.\n");
+      return false;
+    }
+
+    //////////////////////////////
+    // Initialize the random number generator
+    if(!ptrSampling->setup_rng(ptrSimInfo))
+    {
+      PSSA_ERROR(ptrSimInfo, << "failed to initialize the random number generator.\n");
+      return false;
+    }
+
+    //////////////////////////////
+    // Allocate the reaction events buffer
+    try
+    {
+      m_EventStream.allocate();
+    }
+    catch(std::bad_alloc & e)
+    {
+      PSSA_ERROR(ptrSimInfo, << e.what() << ": unable to allocate memory for reaction events.\n");
+      return false;
+    }
+
     return true;
   }
 
   bool PSSA::runSamplingLoop(datamodel::SimulationInfo* ptrSimInfo)
   {
-    static std::stringstream ssTemp;
-
     boost::scoped_array<TimingInfo> arTiming(NULL);
     boost::scoped_array<UINTEGER> arFinalPops(NULL);
-    UINTEGER *ptrarFinalPops;
+#ifdef HAVE_MPI
+    boost::scoped_array<UINTEGER> arSamples(NULL);
+#endif
+    UINTEGER *ptrarFinalPops = NULL;
+    // Number of samples the storage can hold
+    UINTEGER unSlots = ptrSimInfo->unSamplesTotal;
 
     PSSA_INFO(ptrSimInfo, << "# of species ids in simulation output "
       << ptrSimInfo->m_arSpeciesIdx.size() << ".\n");
@@ -449,7 +655,16 @@ namespace pssalib
 
     // Initialize the par-for loop
 #ifdef HAVE_MPI
-    getMPIWrapperInstance().pre_spread(ptrSimInfo);//, unSamples);
+    if(!getMPIWrapperInstance().pre_spread(ptrSimInfo))
+      return false;
+#endif
+
+    const std::size_t szPop = ptrData->getSubvolumesCount()*ptrSimInfo->m_arSpeciesIdx.size();
+#ifdef HAVE_MPI
+    // Samples are stored by the process drawing them & gathered by the master,
+    // hence the storage starts at a fair share & grows with the samples drawn
+    unSlots = std::max(getMPIWrapperInstance().getDataChunkSize(
+      (INTEGER)ptrSimInfo->unSamplesTotal), (INTEGER)1);
 #endif
 
     bool bAllOK = true;
@@ -458,31 +673,21 @@ namespace pssalib
       // Timing
       if (ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofTiming))
       {
-        arTiming.reset(
-#ifdef HAVE_MPI
-          (TimingInfo*)getMPIWrapperInstance().spread_alloc(ptrSimInfo, sizeof(TimingInfo))
-#else
-          new TimingInfo[ptrSimInfo->unSamplesTotal]
-#endif
-                );
+        arTiming.reset(new TimingInfo[unSlots]);
       }
 
       // Species populations at the final time point
       if (ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofFinalPops))
       {
-        arFinalPops.reset(
-#ifdef HAVE_MPI
-          (UINTEGER*)getMPIWrapperInstance().
-            spread_alloc(ptrSimInfo,
-                        sizeof(UINTEGER)*ptrData->getSubvolumesCount()*ptrSimInfo->m_arSpeciesIdx.size())
-#else
-          new UINTEGER[ptrSimInfo->unSamplesTotal*ptrData->getSubvolumesCount()*ptrSimInfo->m_arSpeciesIdx.size()]
-#endif
-                );
+        arFinalPops.reset(new UINTEGER[unSlots*szPop]);
         ptrarFinalPops = arFinalPops.get();
       } else if (ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofRawFinalPops)) {
         ptrarFinalPops = ptrSimInfo->ptrarRawPopulations;
       }
+#ifdef HAVE_MPI
+      // Indices of the samples drawn by this process
+      arSamples.reset(new UINTEGER[unSlots]);
+#endif
     }
     catch(std::bad_alloc & e)
     {
@@ -491,199 +696,175 @@ namespace pssalib
     }
 #ifdef HAVE_MPI
     bAllOK = getMPIWrapperInstance().sync_results(bAllOK);
+    if(!bAllOK)
+      getMPIWrapperInstance().post_spread(ptrSimInfo);
 #endif
     if(!bAllOK)
       return false;
 
 
+    // Check whether the trials may be sampled concurrently
+    bool bThreaded = false;
+    if(ptrSimInfo->unThreads > 1)
+    {
+#if defined(HAVE_THREADS) && !defined(HAVE_MPI)
+      if((ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofTrajectory)&&
+          (NULL != ptrSimInfo->m_arPtrExternalBuffers[datamodel::SimulationInfo::
+            outputFlagToStreamIndex(datamodel::SimulationInfo::ofTrajectory)]))||
+         (ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofBinaryTrajectory)&&
+          (NULL != ptrSimInfo->m_arPtrExternalBuffers[datamodel::SimulationInfo::
+            outputFlagToStreamIndex(datamodel::SimulationInfo::ofBinaryTrajectory)])))
+      {
+        PSSA_WARNING(ptrSimInfo, << "trajectories are redirected to an external stream, "
+          "sampling the ensemble in a single thread.\n");
+      }
+      else
+        bThreaded = true;
+#elif defined(HAVE_MPI)
+      PSSA_WARNING(ptrSimInfo, << "multi-threading is not supported together with MPI, "
+        "sampling the ensemble in a single thread per process.\n");
+#else
+      PSSA_WARNING(ptrSimInfo, << "multi-threading is not supported by this build, "
+        "sampling the ensemble in a single thread.\n");
+#endif
+    }
+
+    bool bResult = true;
     UINTEGER n = 0,  n_it = 0;
-#ifdef HAVE_MPI
-#error "disable building the version with MPI support. Just remove this to reenable"
-    while(getMPIWrapperInstance().spread(ptrSimInfo,n))
+
+    // Skip the samples recorded by a previous run
+    bool bMarkers = false;
+    std::vector<bool> arCompleted;
+    if(ptrSimInfo->bResumeEnsemble)
+    {
+#ifndef HAVE_MPI
+      bMarkers = !ptrSimInfo->strOutput.empty();
+      if(!bMarkers)
+      {
+        PSSA_WARNING(ptrSimInfo, << "output path is not set, completed samples are not recorded.\n");
+      }
+      else if(!loadSampleMarkers(ptrSimInfo, arTiming.get(), ptrarFinalPops, arCompleted))
+        return false;
+      if(bMarkers&&(0 != ptrSimInfo->unCheckpointInterval))
+      {
+        PSSA_WARNING(ptrSimInfo, << "checkpoints are not saved while completed samples "
+          "are recorded.\n");
+      }
 #else
-    for(; n < ptrSimInfo->unSamplesTotal; ++n)
+      PSSA_WARNING(ptrSimInfo, << "resuming ensembles is not supported together with MPI, "
+        "all samples are drawn.\n");
 #endif
+    }
+
+    // Save the state of the sampling loop at regular intervals
+    if((0 != ptrSimInfo->unCheckpointInterval)&&!bMarkers)
     {
-      // Clear streams
-      ssTemp.str(STRING());
+#ifndef HAVE_MPI
+      if(bThreaded)
+      {
+        PSSA_WARNING(ptrSimInfo, << "checkpoints are saved by the serial sampling loop, "
+          "sampling the ensemble in a single thread.\n");
+        bThreaded = false;
+      }
+      // Samples completed before the checkpoint are skipped
+      if(!setupCheckpoints(ptrSimInfo, arTiming.get(), ptrarFinalPops, n))
+        return false;
+      n_it = n;
+#else
+      PSSA_WARNING(ptrSimInfo, << "checkpoints are not supported together with MPI, "
+        "the state of the sampling loop is not saved.\n");
+#endif
+    }
 
-      // Initialize data structures
-      bool bResult = ptrGrouping->initialize(ptrSimInfo);
+#ifdef HAVE_THREADS
+    if(bThreaded)
+    {
+      if(!runSamplingThreads(ptrSimInfo, arTiming.get(), ptrarFinalPops, arCompleted, bMarkers))
+        return false;
+      n = n_it = ptrSimInfo->unSamplesTotal;
+    }
+    else
+#endif
 #ifdef HAVE_MPI
-      bResult = getMPIWrapperInstance().sync_results(bResult);
+    while(getMPIWrapperInstance().spread(ptrSimInfo,n))
+#else
+    for(; n < ptrSimInfo->unSamplesTotal; ++n)
 #endif
-      if(!bResult)
+    {
+      // Samples recorded by a previous run are already stored
+      if(!arCompleted.empty()&&arCompleted[n])
       {
-        // Failed, report & exit
-        PSSA_ERROR(ptrSimInfo, << "failed to initialize data structures.\n");
-        return false;
+        n_it++;
+        continue;
       }
-      // Optional post-initialisation step
-      ptrGrouping->postInitialize(ptrSimInfo);
 
       // Timing
       REAL tTrial = 0.0;
       UINTEGER unReactions = 0;
 
-      // Start timing
-      bResult = ptrSimInfo->beginTrial(n);
+      if(!sampleTrial(ptrSimInfo, n, tTrial, unReactions))
+      {
 #ifdef HAVE_MPI
-      bResult = getMPIWrapperInstance().sync_results(bResult);
+        // let the other processes run out of work
+        getMPIWrapperInstance().spread_abort(ptrSimInfo);
+        bResult = false;
+        break;
+#else
+        return false; // fail
 #endif
-      if(!bResult)
-      {
-        // Failed, report & exit
-        PSSA_ERROR(ptrSimInfo, << "failed to initialize timing.\n");
-        return false;
       }
 
-      /////////////////////////////////
-      // Run the internal loop
-      while(ptrSimInfo->isRunning())
+#ifdef HAVE_MPI
+      // Grow the storage of this process
+      if(n_it == unSlots)
       {
-        bool bSimResult = ptrSampling->getSample(ptrSimInfo);
-
-        ptrSimInfo->doOutput();
-
-        if(bSimResult)
-        {
-          bSimResult = ptrUpdate->doUpdate(ptrSimInfo);
-          ++unReactions;
-        }
-        else
-        {
-            PSSA_WARNING(ptrSimInfo, << "sampling step failed after "
-              << unReactions << " reactions.\n"
-              << "sample = " << n << "\nsimulation time = "
-              << ptrSimInfo->dTimeSimulation << "\ntotal propensity = "
-              << ptrData->dTotalPropensity << std::endl);
-            // is it an absorbing state?
-            if(isinf(ptrSimInfo->dTimeSimulation))
-              break; // exit the loop silently
-            else
-            {
-              bResult = false; // fail
-              break;
-            }
-        }
-
-        if(bSimResult)
-        {
-          if (NULL != ptrReactionCallback)
-          {
-            ptrReactionCallback(ptrData,
-              ptrSimInfo->dTimeSimulation,
-              ptrReactionCallbackUserData);
-          }
-        }
-        else // update failed
+        UINTEGER unSlotsNew = std::min(2 * unSlots, ptrSimInfo->unSamplesTotal);
+        try
         {
-          // is the simulation still running?
-          if(!ptrSimInfo->isRunning())
-            break; // exit the loop silently
-          else
-          {
-            bResult = false; // fail
-            break;
-          }
+          resizeSampleSlots(arTiming, unSlots, unSlotsNew);
+          resizeSampleSlots(arFinalPops, unSlots*szPop, unSlotsNew*szPop);
+          resizeSampleSlots(arSamples, unSlots, unSlotsNew);
         }
-        PSSA_TRACE(ptrSimInfo, << "reaction " << unReactions
-          << " simulation time = "
-          << ptrSimInfo->dTimeSimulation << "; total propensity = "
-          << ptrData->dTotalPropensity << std::endl);
-
-        // handle external interruption
-        if(ptrSimInfo->bInterruptRequested)
+        catch(std::bad_alloc & e)
         {
+          PSSA_ERROR(ptrSimInfo, << e.what() << ": unable to allocate memory.\n");
+          getMPIWrapperInstance().spread_abort(ptrSimInfo);
           bResult = false;
           break;
         }
+        unSlots = unSlotsNew;
+        if(NULL != arFinalPops.get())
+          ptrarFinalPops = arFinalPops.get();
       }
-
-      // End timing
-      if(bResult)
-        tTrial = ptrSimInfo->endTrial();
-      else
-        tTrial = 0.0;
-
-#ifdef HAVE_MPI
-      bResult = getMPIWrapperInstance().sync_results(bResult);
 #endif
-      if(!bResult)
-      {
-        PSSA_ERROR(ptrSimInfo, << "simulation terminated unexpectedly!\n" 
-          << "Sample : " << n << "\nSimulation time :"
-          << ptrSimInfo->dTimeSimulation << "\nTotal propensity: "
-          << ptrData->dTotalPropensity << "\nPrevious reaction : "
-          << ptrData->getReactionWrapper(ptrData->mu).toString() << std::endl);
-        return false; // fail
-      }
 
       ////////////////////////
       // Store simulation results
-
-      // Store the population at final time point
-      if(ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofFinalPops)||ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofRawFinalPops))
-      {
-        for(UINTEGER svi = 0; svi < ptrData->getSubvolumesCount(); svi++) {
-          datamodel::detail::Subvolume & subvol = ptrData->getSubvolume(svi);
-          for(UINTEGER i = 0; i < ptrSimInfo->m_arSpeciesIdx.size(); i++) {
-            ptrarFinalPops[(n_it*ptrData->getSubvolumesCount() + svi)*ptrSimInfo->m_arSpeciesIdx.size() + i] =
-              subvol.population(ptrSimInfo->m_arSpeciesIdx[i]);
-          }
-        }
-      }
-      else
-        PSSA_INFO(ptrSimInfo, << "final populations are not collected.\n");
-
-      // Store the timing information
-      if (ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofTiming))
-      {
-        PSSA_INFO(ptrSimInfo, << "timing info at iteration " << n_it
-                  << ": \ttime = " << tTrial << "; NumReactions = "
-                  << unReactions << std::endl);
-        arTiming[n_it].t = tTrial;
-        arTiming[n_it].n = unReactions;
-      }
-      else
-        PSSA_INFO(ptrSimInfo, << "timing information is not collected.\n");
+      storeTrialResults(ptrSimInfo, n_it, tTrial, unReactions,
+                        arTiming.get(), ptrarFinalPops);
+#ifdef HAVE_MPI
+      arSamples[n_it] = n;
+#endif
+      // Record the completed sample
+      if(bMarkers)
+        writeSampleMarker(ptrSimInfo, n, tTrial, unReactions);
 
       n_it++;
     }
 
-    bool bResult = true;
 #ifdef HAVE_MPI
-    if(getMPIWrapperInstance().post_spread(ptrSimInfo))
-    {
-      PSSA_TRACE(ptrSimInfo, << "Waiting for other processes to finish their task...\n");
-
-      // Initialize data structures
-      bResult = getMPIWrapperInstance().sync_results(bResult);
-      if(!bResult)
-        return false;
-
-      PSSA_TRACE(ptrSimInfo, << "sync after GroupingModule::initialize()\n");
-
-      // Start timing
-      bResult = getMPIWrapperInstance().sync_results(bResult);
-      if(!bResult)
-        return false;
-
-      PSSA_TRACE(ptrSimInfo, << "sync before the simulation loop\n");
-
-      // After the simulation loop
-      bResult = getMPIWrapperInstance().sync_results(bResult);
-      if(!bResult)
-        return false;
+    PSSA_TRACE(ptrSimInfo, << "Waiting for other processes to finish their task...\n");
 
-      PSSA_TRACE(ptrSimInfo, << "sync after the simulation loop\n");
-
-      PSSA_TRACE(ptrSimInfo, << "Other processes' tasks are finished!\n");
-    }
-    else
+    if(!getMPIWrapperInstance().post_spread(ptrSimInfo))
     {
       PSSA_TRACE(ptrSimInfo, << "post_spread returned false.\n");
+      bResult = false;
     }
+    bResult = getMPIWrapperInstance().sync_results(bResult);
+    if(!bResult)
+      return false;
+
+    PSSA_TRACE(ptrSimInfo, << "Other processes' tasks are finished!\n");
 #endif
 
     // Timing
@@ -693,7 +874,8 @@ namespace pssalib
       TimingInfo * arCumTiming = NULL;
 #ifdef HAVE_MPI
       bool bTimingOK = true;
-      if(getMPIWrapperInstance().spread_collect(ptrSimInfo, arTiming.get(), (void **)&arCumTiming, sizeof(TimingInfo)))
+      if(getMPIWrapperInstance().spread_collect(ptrSimInfo, arSamples.get(), n_it,
+        arTiming.get(), (void **)&arCumTiming, sizeof(TimingInfo)))
       {
         if(getMPIWrapperInstance().isMaster())
         {
@@ -741,7 +923,7 @@ namespace pssalib
       UINTEGER *arCumFinalPops = NULL;
 #ifdef HAVE_MPI
       bool bFinalPopsOK = true;
-      if(getMPIWrapperInstance().spread_collect(ptrSimInfo, ptrarFinalPops,
+      if(getMPIWrapperInstance().spread_collect(ptrSimInfo, arSamples.get(), n_it, ptrarFinalPops,
         (void **)&arCumFinalPops, sizeof(UINTEGER)*ptrData->getSubvolumesCount()*ptrSimInfo->m_arSpeciesIdx.size()))
       {
         if(getMPIWrapperInstance().isMaster())
@@ -794,6 +976,75 @@ namespace pssalib
 #endif
     }
 
+    // Mean & variance of the trajectories
+    if(ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofAvgTrajectory))
+    {
+      PSSA_INFO(ptrSimInfo, << "collecting ensemble statistics\n");
+#ifdef HAVE_MPI
+      bool bAvgTrajectoryOK = getMPIWrapperInstance().reduce_statistics(ptrSimInfo, ptrSimInfo->m_esTrajectory);
+      if(bAvgTrajectoryOK&&getMPIWrapperInstance().isMaster())
+      {
+#endif
+        std::ostream & osLocal = ptrSimInfo->getOutputStream(datamodel::SimulationInfo::ofAvgTrajectory);
+        if(!osLocal.good()||!ptrSimInfo->m_esTrajectory.write(osLocal))
+        {
+          PSSA_ERROR(ptrSimInfo, << "ensemble statistics stream is invalid!\n");
+          ptrSimInfo->resetOutputStream(datamodel::SimulationInfo::ofAvgTrajectory);
+#ifndef HAVE_MPI
+          return false;
+#else
+          bAvgTrajectoryOK = false;
+#endif
+        }
+        else
+        {
+          ptrSimInfo->resetOutputStream(datamodel::SimulationInfo::ofAvgTrajectory);
+          PSSA_INFO(ptrSimInfo, << "ensemble statistics written to stream.\n");
+        }
+#ifdef HAVE_MPI
+      }
+      bAvgTrajectoryOK = getMPIWrapperInstance().sync_results(bAvgTrajectoryOK);
+      if(!bAvgTrajectoryOK)
+        return false;
+#endif
+    }
+
+    // Histograms of final time point populations
+    if(ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofHistogram))
+    {
+      PSSA_INFO(ptrSimInfo, << "collecting histograms of final populations\n");
+#ifdef HAVE_MPI
+      bool bHistogramOK = getMPIWrapperInstance().reduce_histograms(ptrSimInfo, ptrSimInfo->m_phFinalPops);
+      if(bHistogramOK&&getMPIWrapperInstance().isMaster())
+      {
+#endif
+        std::ostream & osLocal = ptrSimInfo->getOutputStream(datamodel::SimulationInfo::ofHistogram);
+        if(!osLocal.good()||!ptrSimInfo->m_phFinalPops.write(osLocal))
+        {
+          PSSA_ERROR(ptrSimInfo, << "histograms stream is invalid!\n");
+          ptrSimInfo->resetOutputStream(datamodel::SimulationInfo::ofHistogram);
+#ifndef HAVE_MPI
+          return false;
+#else
+          bHistogramOK = false;
+#endif
+        }
+        else
+        {
+          ptrSimInfo->resetOutputStream(datamodel::SimulationInfo::ofHistogram);
+          PSSA_INFO(ptrSimInfo, << "histograms written to stream.\n");
+        }
+#ifdef HAVE_MPI
+      }
+      bHistogramOK = getMPIWrapperInstance().sync_results(bHistogramOK);
+      if(!bHistogramOK)
+        return false;
+#endif
+    }
+
+    // The checkpoint is obsolete once the results are written
+    freeCheckpoints(bResult);
+
     PSSA_INFO(ptrSimInfo, << "Sampling successfully completed, total iterations "
       << n_it << "; last sample #" << n << "; total samples "
       << ptrSimInfo->unSamplesTotal << std::endl);
@@ -802,35 +1053,1196 @@ namespace pssalib
   }
 
   /**
-   * This function samples \c ptrSimInfo->unSamplesTotal trajectories and outputs them to a series of files, 
-   * starting at \a time \c = \c ptrSimInfo->dTimeStart to \a time \c = \c ptrSimInfo->dTimeEnd seconds and saving 
-   * the output to \c ptrSimInfo->strOutput every \c ptrSimInfo->dTimeStep seconds.
-   *
-   * @param ptrSimInfo datamodel::SimulationInfo* Simulation information object associated with this run.
-   *
-   * @return logical \a "true" if all trials finished successfully,
-   * \a "false" otherwise.
+   * Select the step loop matching the simulation method and the model,
+   * i.e. whether it has a volume decomposition and delayed reactions.
    *
+   * @param ptrSimInfo Simulation information object associated with this engine.
    */
-  bool PSSA::run(datamodel::SimulationInfo *ptrSimInfo)
+  void PSSA::setupStepLoop(datamodel::SimulationInfo* ptrSimInfo)
   {
-    bool bResult = setupForSampling(ptrSimInfo);
-#ifdef HAVE_MPI
-    bResult = getMPIWrapperInstance().sync_results(bResult);
+    const bool bSpatial = (0 != ptrData->getDimsCount());
+    bool bDelays = false;
+    for(UINTEGER i = 0; (i < ptrData->getReactionsCount())&&!bDelays; ++i)
+      bDelays = ptrData->getReactionWrapper(i).isSetDelay();
+
+    switch(m_Method)
+    {
+    case M_DM:
+      ptrStepLoop = selectStepLoop<sampling::SamplingModule_DM, update::UpdateModule_DM>(bSpatial, bDelays);
+      break;
+    case M_PDM:
+      ptrStepLoop = selectStepLoop<sampling::SamplingModule_PDM, update::UpdateModule_PDM>(bSpatial, bDelays);
+      break;
+    case M_PSSACR:
+      ptrStepLoop = selectStepLoop<sampling::SamplingModule_PSSACR, update::UpdateModule_PSSACR>(bSpatial, bDelays);
+      break;
+    case M_SPDM:
+      ptrStepLoop = selectStepLoop<sampling::SamplingModule_SPDM, update::UpdateModule_SPDM>(bSpatial, bDelays);
+      break;
+    case M_DMTree:
+      ptrStepLoop = selectStepLoop<sampling::SamplingModule_DMTree, update::UpdateModule_DMTree>(bSpatial, bDelays);
+      break;
+    case M_NRM:
+      ptrStepLoop = selectStepLoop<sampling::SamplingModule_NRM, update::UpdateModule_NRM>(bSpatial, bDelays);
+      break;
+    default:
+      // generic loop, dispatched through the module interfaces
+      ptrStepLoop = &PSSA::runStepLoop<sampling::SamplingModule, update::UpdateModule, true, true>;
+    }
+
+    PSSA_INFO(ptrSimInfo, << "step loop for " << getMethodName(m_Method)
+      << (bSpatial ? ", spatial" : ", well-mixed")
+      << (bDelays ? ", delayed" : ", non-delayed") << " model.\n");
+  }
+
+  /**
+   * Get the step loop instantiated for given sampling & update modules
+   * and the runtime configuration of the model.
+   *
+   * @tparam TSampling Sampling module type.
+   * @tparam TUpdate Update module type.
+   * @param bSpatial Whether the model has a volume decomposition.
+   * @param bDelays Whether the model has delayed reactions.
+   * @return Pointer to the step loop.
+   */
+  template<class TSampling, class TUpdate>
+  PSSA::STEP_LOOP PSSA::selectStepLoop(bool bSpatial, bool bDelays) const
+  {
+    if(bSpatial)
+      return bDelays ? &PSSA::runStepLoop<TSampling, TUpdate, true,  true>
+                     : &PSSA::runStepLoop<TSampling, TUpdate, true,  false>;
+    else
+      return bDelays ? &PSSA::runStepLoop<TSampling, TUpdate, false, true>
+                     : &PSSA::runStepLoop<TSampling, TUpdate, false, false>;
+  }
+
+  /**
+   * Run the sampling & update steps of a trial until the simulation ends.
+   *
+   * @tparam TSampling Sampling module type, its routines are called without
+   * virtual dispatch unless it is @ref sampling::SamplingModule.
+   * @tparam TUpdate Update module type, its routines are called without
+   * virtual dispatch unless it is @ref update::UpdateModule.
+   * @tparam bSpatial @false if the model has no volume decomposition.
+   * @tparam bDelays @false if the model has no delayed reactions.
+   * @param ptrSimInfo Simulation information object associated with this engine.
+   * @param n Index of the sample.
+   * @param unReactions Number of reactions fired during the trial [OUT].
+   * @return @true if the trial was successfully sampled, @false otherwise.
+   */
+  template<class TSampling, class TUpdate, bool bSpatial, bool bDelays>
+  bool PSSA::runStepLoop(datamodel::SimulationInfo* ptrSimInfo, UINTEGER n,
+                         UINTEGER & unReactions)
+  {
+    TSampling * ptrS = static_cast<TSampling *>(ptrSampling);
+    TUpdate * ptrU = static_cast<TUpdate *>(ptrUpdate);
+    const FCN_REACTION_CALLBACK ptrCallback = ptrReactionCallback;
+    util::ReactionEventStream * ptrEvents =
+      m_EventStream.isEnabled() ? &m_EventStream : NULL;
+    bool bResult = true;
+
+    while(ptrSimInfo->isRunning())
+    {
+      bool bSimResult = std::is_same<TSampling, sampling::SamplingModule>::value ?
+        ptrS->getSample(ptrSimInfo) :
+        ptrS->template getSample<TSampling, bSpatial, bDelays>(ptrSimInfo);
+
+      {
+#ifdef PSSALIB_ENGINE_CHECK
+        util::AllocationsCountPause pause;
 #endif
+        ptrSimInfo->doOutput();
+      }
+
+      if(bSimResult)
+      {
+        bSimResult = ptrU->template doUpdate<TUpdate, bSpatial, bDelays>(ptrSimInfo);
+        ++unReactions;
+      }
+      else
+      {
+          PSSA_WARNING(ptrSimInfo, << "sampling step failed after "
+            << unReactions << " reactions.\n"
+            << "sample = " << n << "\nsimulation time = "
+            << ptrSimInfo->dTimeSimulation << "\ntotal propensity = "
+            << ptrData->dTotalPropensity << std::endl);
+          // is it an absorbing state?
+          if(isinf(ptrSimInfo->dTimeSimulation))
+            break; // exit the loop silently
+          else
+          {
+            bResult = false; // fail
+            break;
+          }
+      }
+
+      if(bSimResult)
+      {
+        if (NULL != ptrCallback)
+        {
+#ifdef PSSALIB_ENGINE_CHECK
+          util::AllocationsCountPause pause;
+#endif
+          ptrCallback(ptrData,
+            ptrSimInfo->dTimeSimulation,
+            ptrReactionCallbackUserData);
+        }
+        if (NULL != ptrEvents)
+        {
+#ifdef PSSALIB_ENGINE_CHECK
+          util::AllocationsCountPause pause;
+#endif
+          const UINTEGER nu_D = (bSpatial && ptrData->getReactionWrapper(ptrData->mu).isDiffusive()) ?
+            ptrData->nu_D : ptrData->nu;
+          ptrEvents->push(ptrSimInfo->dTimeSimulation, ptrData->mu, ptrData->nu, nu_D, false);
+        }
+      }
+      else // update failed
+      {
+        // is the simulation still running?
+        if(!ptrSimInfo->isRunning())
+          break; // exit the loop silently
+        else
+        {
+          bResult = false; // fail
+          break;
+        }
+      }
+      PSSA_TRACE(ptrSimInfo, << "reaction " << unReactions
+        << " simulation time = "
+        << ptrSimInfo->dTimeSimulation << "; total propensity = "
+        << ptrData->dTotalPropensity << std::endl);
+
+      // save the state of the trial once the checkpoint is due
+      if((NULL != ptrCheckpoint)&&
+         (0 == unReactions % tagCheckpointState::unClockStride)&&
+         (tagCheckpointState::Clock::now() >= ptrCheckpoint->tpNext))
+      {
+#ifdef PSSALIB_ENGINE_CHECK
+        util::AllocationsCountPause pause;
+#endif
+        saveCheckpoint(ptrSimInfo, n, unReactions);
+      }
+
+      // handle external interruption
+      if(ptrSimInfo->bInterruptRequested)
+      {
+        // the trial may be continued from here
+        if(NULL != ptrCheckpoint)
+        {
+#ifdef PSSALIB_ENGINE_CHECK
+          util::AllocationsCountPause pause;
+#endif
+          saveCheckpoint(ptrSimInfo, n, unReactions);
+        }
+        bResult = false;
+        break;
+      }
+    }
+
+    return bResult;
+  }
+
+  /**
+   * Sample a single trial using the data structures of this engine.
+   *
+   * @param ptrSimInfo Simulation information object associated with this engine.
+   * @param n Index of the sample.
+   * @param tTrial Time spent on the trial in seconds [OUT].
+   * @param unReactions Number of reactions fired during the trial [OUT].
+   * @return @true if the trial was successfully sampled, @false otherwise.
+   */
+  bool PSSA::sampleTrial(datamodel::SimulationInfo* ptrSimInfo, UINTEGER n,
+                         REAL & tTrial, UINTEGER & unReactions)
+  {
+    // Random numbers of this sample do not depend on other samples
+    ptrSampling->select_rng_stream(n);
+
+#ifdef PSSALIB_ENGINE_CHECK
+    // Messages allocate while being formatted, so only quiet trials are checked
+    const bool bCheckAllocations =
+      !ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofInfo) &&
+      !ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofTrace);
+    const ULINTEGER unAllocations = util::getAllocationsCount();
+#endif
+
+    // Timing
+    tTrial = 0.0;
+    unReactions = 0;
+
+    bool bResult;
+    if((NULL != ptrCheckpoint)&&ptrCheckpoint->bResume)
+    {
+#ifdef PSSALIB_ENGINE_CHECK
+      util::AllocationsCountPause pause;
+#endif
+      // Continue the trial saved at the checkpoint
+      bResult = restoreTrial(ptrSimInfo, n, unReactions);
+      if(!bResult)
+      {
+        // Failed, report & exit
+        PSSA_ERROR(ptrSimInfo, << "failed to restore the trial saved at the checkpoint.\n");
+        return false;
+      }
+    }
+    else
+    {
+      // Initialize data structures
+      bResult = ptrGrouping->initialize(ptrSimInfo);
+      if(!bResult)
+      {
+        // Failed, report & exit
+        PSSA_ERROR(ptrSimInfo, << "failed to initialize data structures.\n");
+        return false;
+      }
+      // Optional post-initialisation step
+      ptrGrouping->postInitialize(ptrSimInfo);
+
+      // Start timing
+      bResult = ptrSimInfo->beginTrial(n);
+      if(!bResult)
+      {
+        // Failed, report & exit
+        PSSA_ERROR(ptrSimInfo, << "failed to initialize timing.\n");
+        return false;
+      }
+
+      if(NULL != ptrCheckpoint)
+        ptrCheckpoint->dTrialTime = 0.0;
+    }
+    if(NULL != ptrCheckpoint)
+      ptrCheckpoint->tpTrial = tagCheckpointState::Clock::now();
+
+    /////////////////////////////////
+    // Run the internal loop
+    m_EventStream.begin(n);
+    bResult = (this->*ptrStepLoop)(ptrSimInfo, n, unReactions);
+
+#ifdef PSSALIB_ENGINE_CHECK
+    // Trial state is expected to be reset in place, without heap allocations
+    if(bCheckAllocations && (util::getAllocationsCount() != unAllocations))
+    {
+      PSSA_WARNING(ptrSimInfo, << (util::getAllocationsCount() - unAllocations)
+        << " heap allocations during trial #" << n << std::endl);
+    }
+#endif
+    // Pass the remaining reaction events to the sink
+    if(m_EventStream.isEnabled())
+      m_EventStream.flush();
+
+#if PSSALIB_LOG_LEVEL >= PSSALIB_LOG_LEVEL_TRACE
+    // Structured trace of the trial
+    if(ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::eofEvents))
+      ptrSimInfo->reportEvents();
+#endif
+
+    // End timing
+    if(bResult)
+      tTrial = ptrSimInfo->endTrial() +
+        ((NULL != ptrCheckpoint) ? ptrCheckpoint->dTrialTime : 0.0);
+    else
+      tTrial = 0.0;
+
     if(!bResult)
+    {
+      PSSA_ERROR(ptrSimInfo, << "simulation terminated unexpectedly!\n" 
+        << "Sample : " << n << "\nSimulation time :"
+        << ptrSimInfo->dTimeSimulation << "\nTotal propensity: "
+        << ptrData->dTotalPropensity << "\nPrevious reaction : "
+        << ptrData->getReactionWrapper(ptrData->mu).toString() << std::endl);
+    }
+
+    return bResult;
+  }
+
+  /**
+   * Store the results of a trial in the respective sample slot.
+   *
+   * @param ptrSimInfo Simulation information object associated with this engine.
+   * @param slot Index of the sample slot.
+   * @param tTrial Time spent on the trial in seconds.
+   * @param unReactions Number of reactions fired during the trial.
+   * @param arTiming Timing information storage (may be @c NULL).
+   * @param arFinalPops Final populations storage (may be @c NULL).
+   */
+  void PSSA::storeTrialResults(datamodel::SimulationInfo* ptrSimInfo, UINTEGER slot,
+                               REAL tTrial, UINTEGER unReactions,
+                               TimingInfo * arTiming, UINTEGER * arFinalPops) const
+  {
+    // Store the population at final time point
+    if(ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofFinalPops)||ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofRawFinalPops))
+    {
+      for(UINTEGER svi = 0; svi < ptrData->getSubvolumesCount(); svi++) {
+        datamodel::detail::Subvolume & subvol = ptrData->getSubvolume(svi);
+        for(UINTEGER i = 0; i < ptrSimInfo->m_arSpeciesIdx.size(); i++) {
+          arFinalPops[(slot*ptrData->getSubvolumesCount() + svi)*ptrSimInfo->m_arSpeciesIdx.size() + i] =
+            subvol.population(ptrSimInfo->m_arSpeciesIdx[i]);
+        }
+      }
+    }
+    else
+      PSSA_INFO(ptrSimInfo, << "final populations are not collected.\n");
+
+    // Add the population at final time point to the histograms
+    if(ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofHistogram))
+    {
+      UINTEGER * arState = ptrSimInfo->m_phFinalPops.getStateBuffer();
+      for(UINTEGER svi = 0; svi < ptrData->getSubvolumesCount(); svi++) {
+        datamodel::detail::Subvolume & subvol = ptrData->getSubvolume(svi);
+        for(UINTEGER i = 0; i < ptrSimInfo->m_arSpeciesIdx.size(); i++)
+          *(arState++) = subvol.population(ptrSimInfo->m_arSpeciesIdx[i]);
+      }
+      ptrSimInfo->m_phFinalPops.add();
+    }
+
+    // Store the timing information
+    if (ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofTiming))
+    {
+      PSSA_INFO(ptrSimInfo, << "timing info at iteration " << slot
+                << ": \ttime = " << tTrial << "; NumReactions = "
+                << unReactions << std::endl);
+      arTiming[slot].t = tTrial;
+      arTiming[slot].n = unReactions;
+    }
+    else
+      PSSA_INFO(ptrSimInfo, << "timing information is not collected.\n");
+  }
+
+  /**
+   * Describe the settings of the sampling loop, which determine the content
+   * of checkpoints & sample markers, in a header.
+   *
+   * @param ptrSimInfo Simulation information object associated with this engine.
+   * @param hdr Header [OUT].
+   */
+  void PSSA::setupCheckpointHeader(datamodel::SimulationInfo* ptrSimInfo,
+                                   util::Checkpoint::Header & hdr) const
+  {
+    util::Checkpoint::setup(hdr);
+    hdr.method         = m_Method;
+    hdr.outputFlags    = ptrSimInfo->unOutputFlags & unCheckpointOutputFlags;
+    hdr.rngType        = ptrSimInfo->eRNGType;
+    hdr.volumeSampling = ptrSimInfo->eVolumeSampling;
+    hdr.rngSeed        = ptrSampling->get_rng_seed();
+    hdr.modelHash      = hashModel(ptrSimInfo->getModel());
+    hdr.subvolumes     = ptrData->getSubvolumesCount();
+    hdr.species        = ptrData->getSpeciesCount();
+    hdr.reactions      = ptrData->getReactionWrappersCount();
+    hdr.outputSpecies  = ptrSimInfo->m_arSpeciesIdx.size();
+    hdr.samples        = ptrSimInfo->unSamplesTotal;
+    hdr.timeStart      = ptrSimInfo->dTimeStart;
+    hdr.timeStep       = ptrSimInfo->dTimeStep;
+    hdr.timeEnd        = ptrSimInfo->dTimeEnd;
+  }
+
+  /**
+   * Get the maximum number of values in the trajectory of a trial that is
+   * recorded along with the sample, i.e. that of a trial reaching the end time.
+   *
+   * @param ptrSimInfo Simulation information object associated with this engine.
+   * @return number of values, 0 if the trajectory is not recorded.
+   */
+  std::size_t PSSA::getTrialTrajectorySize(datamodel::SimulationInfo* ptrSimInfo) const
+  {
+    if(!ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofAvgTrajectory)&&
+       !ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofRawTrajectory))
+      return 0;
+    return timing::getNumTimePoints(ptrSimInfo->dTimeStart, ptrSimInfo->dTimeEnd, ptrSimInfo->dTimeStep) *
+      ptrSimInfo->m_arSpeciesIdx.size() * ptrData->getSubvolumesCount();
+  }
+
+  /**
+   * Restore the results of the samples recorded by a previous run with the
+   * same settings. A marker is accepted only if the trajectory files of its
+   * sample have the recorded sizes, otherwise the sample is drawn again.
+   * The random number generator is seeded as in the previous run, so that
+   * the remaining samples match a run from scratch.
+   *
+   * @param ptrSimInfo Simulation information object associated with this engine.
+   * @param arTiming Timing information storage (may be @c NULL).
+   * @param arFinalPops Final populations storage (may be @c NULL).
+   * @param arCompleted Flags of the restored samples [OUT].
+   * @return @true if successful, @false otherwise.
+   */
+  bool PSSA::loadSampleMarkers(datamodel::SimulationInfo* ptrSimInfo, TimingInfo * arTiming,
+                               UINTEGER * arFinalPops, std::vector<bool> & arCompleted)
+  {
+    // the number of samples may differ to extend an ensemble
+    util::Checkpoint::Header hdr;
+    setupCheckpointHeader(ptrSimInfo, hdr);
+    hdr.samples = 0;
+
+    const std::size_t szPop = hdr.subvolumes * hdr.outputSpecies;
+    util::EnsembleStatistics & esTrajectory = ptrSimInfo->m_esTrajectory;
+    util::PopulationHistogram & phFinalPops = ptrSimInfo->m_phFinalPops;
+    const std::size_t szRows = getTrialTrajectorySize(ptrSimInfo);
+
+    util::Checkpoint image;
+    std::vector<UINTEGER> arPop, arRows;
+    bool bSeed = false;
+    UINTEGER unCompleted = 0;
+    try
+    {
+      arCompleted.assign(ptrSimInfo->unSamplesTotal, false);
+      arPop.resize(szPop);
+      arRows.reserve(szRows);
+    }
+    catch(std::bad_alloc & e)
+    {
+      PSSA_ERROR(ptrSimInfo, << e.what() << ": unable to allocate memory for sample markers.\n");
       return false;
+    }
 
-    bResult = runSamplingLoop(ptrSimInfo);
+    for(UINTEGER n = 0; n < ptrSimInfo->unSamplesTotal; ++n)
+    {
+      STRING strPath;
+      util::makeFilePath(ptrSimInfo->strOutput,
+        (BOOSTFORMAT(PSSALIB_FILENAME_SAMPLE_MARKER) % n).str(), strPath);
+
+      std::uint64_t szFile;
+      if(!util::getFileSize(strPath, szFile))
+        continue;
+
+      // the marker must describe this sample & match the settings
+      util::Checkpoint::Header hdrSaved;
+      bool bValid = image.load(strPath)&&image.get(hdrSaved)&&
+        util::Checkpoint::isValid(hdrSaved)&&util::Checkpoint::isCompatible(hdr, hdrSaved)&&
+        (n == hdrSaved.sample)&&(!bSeed||(hdr.rngSeed == hdrSaved.rngSeed))&&
+        image.getArray(arPop.data(), szPop)&&image.getArray(arRows)&&image.eof()&&
+        (arRows.size() <= szRows)&&(0 == arRows.size() % szPop);
+
+      // the trajectories must be written completely
+      const datamodel::SimulationInfo::OutputFlags arFlags[] = {
+        datamodel::SimulationInfo::ofTrajectory, datamodel::SimulationInfo::ofBinaryTrajectory };
+      const std::uint64_t arSizes[] = { hdrSaved.textSize, hdrSaved.binarySize };
+      for(UINTEGER i = 0; bValid&&(i < 2); ++i)
+      {
+        STRING strFilePath;
+        if(ptrSimInfo->isLoggingOn(arFlags[i])&&
+           ptrSimInfo->getOutputFilePath(arFlags[i], n, strFilePath))
+          bValid = util::getFileSize(strFilePath, szFile)&&(szFile == arSizes[i]);
+      }
 
-    // Clean-up
-    deinitSimulation(ptrSimInfo);
+      if(!bValid)
+      {
+        PSSA_WARNING(ptrSimInfo, << "marker '" << strPath << "' does not match the simulation "
+          "settings or the output of the sample, it is drawn again.\n");
+        continue;
+      }
+
+      // samples are drawn from the same random number streams
+      if(!bSeed)
+      {
+        bSeed = true;
+        if(hdr.rngSeed != hdrSaved.rngSeed)
+        {
+          PSSA_INFO(ptrSimInfo, << "using seed " << hdrSaved.rngSeed
+            << " of the samples recorded by a previous run.\n");
+          ptrSampling->set_rng_seed(hdrSaved.rngSeed);
+          hdr.rngSeed = hdrSaved.rngSeed;
+        }
+      }
+
+      // Restore the results of the sample
+      if(NULL != arTiming)
+      {
+        arTiming[n].t = hdrSaved.trialTime;
+        arTiming[n].n = hdrSaved.firedReactions;
+      }
+      if(NULL != arFinalPops)
+        std::copy(arPop.begin(), arPop.end(), arFinalPops + n * szPop);
+      if(phFinalPops.isAllocated())
+      {
+        std::copy(arPop.begin(), arPop.end(), phFinalPops.getStateBuffer());
+        phFinalPops.add();
+      }
+      if(ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofRawTrajectory))
+        std::copy(arRows.begin(), arRows.end(), ptrSimInfo->ptrarRawPopulations + n * szRows);
+      if(esTrajectory.isAllocated())
+      {
+        esTrajectory.begin();
+        for(std::size_t r = 0; r < arRows.size(); r += szPop)
+          esTrajectory.add(arRows.data() + r, 1);
+      }
+
+      arCompleted[n] = true;
+      ++unCompleted;
+    }
+
+    if(unCompleted > 0)
+    {
+      PSSA_INFO(ptrSimInfo, << unCompleted << " of " << ptrSimInfo->unSamplesTotal
+        << " samples were recorded by a previous run.\n");
+    }
+
+    return true;
+  }
+
+  /**
+   * Record the results of a completed sample in a marker file, which is
+   * written atomically once the trajectory files of the sample are closed.
+   * The marker holds the final population, the timing & the sizes of the
+   * trajectory files, as well as the trajectory if the ensemble statistics
+   * are collected. A marker that could not be written is reported, but does
+   * not interrupt the sampling.
+   *
+   * @param ptrSimInfo Simulation information object associated with this engine.
+   * @param n Index of the sample.
+   * @param tTrial Time spent on the trial in seconds.
+   * @param unReactions Number of reactions fired during the trial.
+   * @return @true if the marker was written, @false otherwise.
+   */
+  bool PSSA::writeSampleMarker(datamodel::SimulationInfo* ptrSimInfo, UINTEGER n,
+                               REAL tTrial, UINTEGER unReactions)
+  {
+    util::Checkpoint::Header hdr;
+    setupCheckpointHeader(ptrSimInfo, hdr);
+    hdr.samples        = 0;
+    hdr.sample         = n;
+    hdr.firedReactions = unReactions;
+    hdr.trialTime      = tTrial;
+
+    const datamodel::SimulationInfo::OutputFlags arFlags[] = {
+      datamodel::SimulationInfo::ofTrajectory, datamodel::SimulationInfo::ofBinaryTrajectory };
+    std::uint64_t * arSizes[] = { &hdr.textSize, &hdr.binarySize };
+    for(UINTEGER i = 0; i < 2; ++i)
+    {
+      STRING strFilePath;
+      if(ptrSimInfo->isLoggingOn(arFlags[i])&&
+         ptrSimInfo->getOutputFilePath(arFlags[i], n, strFilePath)&&
+         !util::getFileSize(strFilePath, *arSizes[i]))
+      {
+        PSSA_WARNING(ptrSimInfo, << "file '" << strFilePath << "' is missing, sample #"
+          << n << " is not recorded.\n");
+        return false;
+      }
+    }
+
+    util::Checkpoint image;
+    image.put(hdr);
+
+    // Final population
+    const std::size_t szPop = ptrData->getSubvolumesCount() * ptrSimInfo->m_arSpeciesIdx.size();
+    image.put(std::uint64_t(szPop));
+    for(UINTEGER svi = 0; svi < ptrData->getSubvolumesCount(); svi++) {
+      datamodel::detail::Subvolume & subvol = ptrData->getSubvolume(svi);
+      for(UINTEGER i = 0; i < ptrSimInfo->m_arSpeciesIdx.size(); i++)
+        image.put(subvol.population(ptrSimInfo->m_arSpeciesIdx[i]));
+    }
+
+    // Trajectory
+    std::size_t szRows;
+    const UINTEGER * arRows = ptrSimInfo->getTrialTrajectory(szRows);
+    image.putArray(arRows, szRows);
+
+    STRING strPath;
+    util::makeFilePath(ptrSimInfo->strOutput,
+      (BOOSTFORMAT(PSSALIB_FILENAME_SAMPLE_MARKER) % n).str(), strPath);
+    if(!image.save(strPath))
+    {
+      PSSA_WARNING(ptrSimInfo, << "failed to write marker '" << strPath << "'.\n");
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Enable checkpoints of the serial sampling loop. If the output directory
+   * contains a checkpoint saved with the same settings, the results of the
+   * samples completed before it are restored & the next call to
+   * @ref sampleTrial continues the trial that was in progress.
+   *
+   * @param ptrSimInfo Simulation information object associated with this engine.
+   * @param arTiming Timing information storage (may be @c NULL).
+   * @param arFinalPops Final populations storage (may be @c NULL).
+   * @param n Index of the first sample to draw [OUT].
+   * @return @true if successful, @false if the checkpoint cannot be restored.
+   */
+  bool PSSA::setupCheckpoints(datamodel::SimulationInfo* ptrSimInfo, TimingInfo * arTiming,
+                              UINTEGER * arFinalPops, UINTEGER & n)
+  {
+    n = 0;
+    freeCheckpoints(false);
+
+    if(ptrSimInfo->strOutput.empty())
+    {
+      PSSA_WARNING(ptrSimInfo, << "output path is not set, checkpoints are not saved.\n");
+      return true;
+    }
+
+    try
+    {
+      ptrCheckpoint = new tagCheckpointState();
+    }
+    catch(std::bad_alloc & e)
+    {
+      PSSA_ERROR(ptrSimInfo, << e.what() << ": unable to allocate memory for checkpoints.\n");
+      return false;
+    }
+    tagCheckpointState & cs = *ptrCheckpoint;
+
+    util::makeFilePath(ptrSimInfo->strOutput, PSSALIB_FILENAME_CHECKPOINT, cs.strPath);
+    cs.dtInterval  = std::chrono::seconds(ptrSimInfo->unCheckpointInterval);
+    cs.tpNext      = tagCheckpointState::Clock::now() + cs.dtInterval;
+    cs.dTrialTime  = 0.0;
+    cs.arTiming    = arTiming;
+    cs.arFinalPops = arFinalPops;
+    cs.bResume     = false;
+
+    // Settings that determine the content of a checkpoint
+    util::Checkpoint::Header & hdr = cs.hdrSettings;
+    setupCheckpointHeader(ptrSimInfo, hdr);
+
+    std::uint64_t szFile;
+    if(!util::getFileSize(cs.strPath, szFile))
+    {
+      PSSA_INFO(ptrSimInfo, << "saving checkpoints to '" << cs.strPath << "' every "
+        << ptrSimInfo->unCheckpointInterval << " seconds.\n");
+      return true;
+    }
+
+    //////////////////////////////
+    // Restore the completed samples
+    util::Checkpoint & image = cs.image;
+    util::Checkpoint::Header & hdrSaved = cs.hdrTrial;
+    if(!image.load(cs.strPath)||!image.get(hdrSaved)||!util::Checkpoint::isValid(hdrSaved))
+    {
+      PSSA_ERROR(ptrSimInfo, << "checkpoint '" << cs.strPath << "' is malformed.\n");
+      return false;
+    }
+    if(!util::Checkpoint::isCompatible(hdr, hdrSaved)||(hdrSaved.sample >= hdrSaved.samples))
+    {
+      PSSA_ERROR(ptrSimInfo, << "checkpoint '" << cs.strPath << "' does not match "
+        "the simulation settings, remove it to start the simulation over.\n");
+      return false;
+    }
+
+    const UINTEGER unCompleted = hdrSaved.sample;
+    const std::size_t szPop = hdr.subvolumes * hdr.outputSpecies;
+    util::EnsembleStatistics & esTrajectory = ptrSimInfo->m_esTrajectory;
+    util::PopulationHistogram & phFinalPops = ptrSimInfo->m_phFinalPops;
+    std::vector<ULINTEGER> arStates;
+    bool bResult =
+      image.getArray(arTiming, (NULL != arTiming) ? unCompleted : 0)&&
+      image.getArray(arFinalPops, (NULL != arFinalPops) ? unCompleted * szPop : 0)&&
+      image.getArray(esTrajectory.getData(), esTrajectory.isAllocated() ?
+        esTrajectory.getRows() * esTrajectory.getRowSize() : 0)&&
+      image.getArray(phFinalPops.getMarginals(), phFinalPops.isAllocated() ?
+        phFinalPops.getRows() * phFinalPops.getRowSize() : 0)&&
+      image.getArray(arStates);
+    if(bResult)
+      bResult = phFinalPops.isStatesOn() ?
+        phFinalPops.mergeStates(arStates.data(), arStates.size()) : arStates.empty();
+    if(!bResult)
+    {
+      PSSA_ERROR(ptrSimInfo, << "checkpoint '" << cs.strPath << "' is malformed.\n");
+      return false;
+    }
+
+    // Remaining samples are drawn from the same random number streams
+    if(hdr.rngSeed != hdrSaved.rngSeed)
+    {
+      PSSA_INFO(ptrSimInfo, << "using seed " << hdrSaved.rngSeed << " of the checkpoint.\n");
+      ptrSampling->set_rng_seed(hdrSaved.rngSeed);
+      hdr.rngSeed = hdrSaved.rngSeed;
+    }
+
+    if(ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofRawTrajectory))
+    {
+      PSSA_WARNING(ptrSimInfo, << "raw trajectories written before the checkpoint "
+        "are not restored.\n");
+    }
+
+    PSSA_INFO(ptrSimInfo, << "resuming from checkpoint '" << cs.strPath << "' at sample #"
+      << unCompleted << ", " << hdrSaved.firedReactions << " reactions fired.\n");
+
+    // The trial in progress is restored by sampleTrial
+    cs.bResume = true;
+    n = unCompleted;
+
+    return true;
+  }
+
+  /**
+   * Save the state of the sampling loop: the results of the completed
+   * samples & the state of the current trial. The trajectory files are
+   * flushed first, so that the sizes recorded in the checkpoint are on disk.
+   * A checkpoint that could not be written is reported, but does not
+   * interrupt the sampling.
+   *
+   * @param ptrSimInfo Simulation information object associated with this engine.
+   * @param n Index of the current sample.
+   * @param unReactions Number of reactions fired during the trial.
+   * @return @true if the checkpoint was saved, @false otherwise.
+   */
+  bool PSSA::saveCheckpoint(datamodel::SimulationInfo* ptrSimInfo, UINTEGER n,
+                            UINTEGER unReactions)
+  {
+    tagCheckpointState & cs = *ptrCheckpoint;
+    const tagCheckpointState::Clock::time_point tpNow = tagCheckpointState::Clock::now();
+    cs.tpNext = tpNow + cs.dtInterval;
+
+    util::Checkpoint::Header hdr(cs.hdrSettings);
+    hdr.sample         = n;
+    hdr.firedReactions = unReactions;
+    hdr.trialTime      = cs.dTrialTime + std::chrono::duration<REAL>(tpNow - cs.tpTrial).count();
+    hdr.timeSimulation = ptrSimInfo->dTimeSimulation;
+    hdr.timeCheckpoint = ptrSimInfo->dTimeCheckpoint;
+    hdr.outputIdx      = ptrSimInfo->m_unOutputIdx;
+    if(!ptrSimInfo->syncTrial(hdr.textSize, hdr.binarySize))
+    {
+      PSSA_WARNING(ptrSimInfo, << "failed to flush the trajectories of sample #" << n
+        << ", checkpoint is not saved.\n");
+      return false;
+    }
+
+    util::Checkpoint & image = cs.image;
+    image.clear();
+    image.put(hdr);
+
+    // Completed samples
+    const std::size_t szPop = hdr.subvolumes * hdr.outputSpecies;
+    util::EnsembleStatistics & esTrajectory = ptrSimInfo->m_esTrajectory;
+    util::PopulationHistogram & phFinalPops = ptrSimInfo->m_phFinalPops;
+    image.putArray(cs.arTiming, (NULL != cs.arTiming) ? n : 0);
+    image.putArray(cs.arFinalPops, (NULL != cs.arFinalPops) ? n * szPop : 0);
+    image.putArray(esTrajectory.getData(), esTrajectory.isAllocated() ?
+      esTrajectory.getRows() * esTrajectory.getRowSize() : 0);
+    image.putArray(phFinalPops.getMarginals(), phFinalPops.isAllocated() ?
+      phFinalPops.getRows() * phFinalPops.getRowSize() : 0);
+    if(phFinalPops.isStatesOn())
+    {
+      std::vector<ULINTEGER> arStates;
+      phFinalPops.serializeStates(arStates);
+      image.putArray(arStates.data(), arStates.size());
+    }
+    else
+      image.putArray((const ULINTEGER *)NULL, 0);
+
+    // Current trial
+    image.putArray(ptrData->getPopulation(), ptrData->getSubvolumesCount() * ptrData->getSpeciesCount());
+
+    const datamodel::DataModel::DelayedReaction * arEvents = ptrData->dqQueuedReactions.data();
+    image.put(std::uint64_t(ptrData->dqQueuedReactions.size()));
+    for(std::size_t i = 0; i < ptrData->dqQueuedReactions.size(); ++i)
+    {
+      image.put(arEvents[i].index);
+      image.put(arEvents[i].subvolume);
+      image.put(arEvents[i].time);
+    }
+
+    STRING strRNG;
+    std::size_t szRNG;
+    const char * ptrRNG = static_cast<const char *>(ptrSampling->get_rng_state(strRNG, szRNG));
+    image.putArray(strRNG.data(), strRNG.size());
+    image.putArray(ptrRNG, szRNG);
+
+    if(!image.save(cs.strPath))
+    {
+      PSSA_WARNING(ptrSimInfo, << "failed to save checkpoint '" << cs.strPath << "'.\n");
+      return false;
+    }
+
+    PSSA_INFO(ptrSimInfo, << "checkpoint saved at sample #" << n << ", simulation time = "
+      << ptrSimInfo->dTimeSimulation << ".\n");
+
+    return true;
+  }
+
+  /**
+   * Continue the trial saved at the loaded checkpoint. The data structures
+   * are rebuilt from the saved population like for a user-defined initial
+   * population, the queue of delayed reactions, the state of the random
+   * number generator & the output cursor are restored. Firing times of the
+   * Next Reaction & Next Subvolume methods are drawn anew, which does not
+   * change the statistics of the trial, since they are memoryless.
+   *
+   * @param ptrSimInfo Simulation information object associated with this engine.
+   * @param n Index of the sample.
+   * @param unReactions Number of reactions fired before the checkpoint [OUT].
+   * @return @true if successful, @false otherwise.
+   */
+  bool PSSA::restoreTrial(datamodel::SimulationInfo* ptrSimInfo, UINTEGER n,
+                          UINTEGER & unReactions)
+  {
+    tagCheckpointState & cs = *ptrCheckpoint;
+    const util::Checkpoint::Header & hdr = cs.hdrTrial;
+    util::Checkpoint & image = cs.image;
+    cs.bResume = false;
+
+    std::vector<UINTEGER> arPopulation;
+    if(!image.getArray(arPopulation)||
+       (arPopulation.size() != ptrData->getSubvolumesCount() * ptrData->getSpeciesCount()))
+    {
+      PSSA_ERROR(ptrSimInfo, << "checkpoint does not contain a valid population.\n");
+      return false;
+    }
+
+    std::uint64_t unEvents;
+    std::vector<datamodel::DataModel::DelayedReaction> arEvents;
+    bool bResult = image.get(unEvents)&&(unEvents <= image.size());
+    if(bResult)
+    {
+      arEvents.resize(unEvents);
+      for(std::size_t i = 0; bResult&&(i < unEvents); ++i)
+        bResult = image.get(arEvents[i].index)&&image.get(arEvents[i].subvolume)&&
+          image.get(arEvents[i].time)&&
+          (arEvents[i].index < ptrData->getReactionWrappersCount())&&
+          (arEvents[i].subvolume < ptrData->getSubvolumesCount());
+    }
+
+    std::vector<char> arRNGName, arRNGState;
+    bResult = bResult&&image.getArray(arRNGName)&&image.getArray(arRNGState)&&image.eof();
+    if(!bResult)
+    {
+      PSSA_ERROR(ptrSimInfo, << "checkpoint does not contain a valid trial state.\n");
+      return false;
+    }
+
+    // Rebuild the data structures for the saved population
+    if(!ptrGrouping->restore(ptrSimInfo, arPopulation.data()))
+    {
+      PSSA_ERROR(ptrSimInfo, << "failed to initialize data structures.\n");
+      return false;
+    }
+    ptrGrouping->postInitialize(ptrSimInfo);
+    ptrData->dqQueuedReactions.assign(arEvents.data(), arEvents.size());
+
+    if(!ptrSampling->set_rng_state(STRING(arRNGName.begin(), arRNGName.end()),
+                                   arRNGState.data(), arRNGState.size()))
+    {
+      PSSA_ERROR(ptrSimInfo, << "checkpoint was saved with a different random number generator.\n");
+      return false;
+    }
+
+    if(!ptrSimInfo->resumeTrial(n, hdr.outputIdx, hdr.timeSimulation, hdr.timeCheckpoint,
+                                hdr.textSize, hdr.binarySize))
+    {
+      PSSA_ERROR(ptrSimInfo, << "failed to restore the output of sample #" << n << ".\n");
+      return false;
+    }
+
+    unReactions   = hdr.firedReactions;
+    cs.dTrialTime = hdr.trialTime;
+
+    return true;
+  }
+
+  /**
+   * Disable checkpoints & free the associated state.
+   *
+   * @param bRemoveFile @true if the sampling is completed and the checkpoint
+   * file is no longer needed.
+   */
+  void PSSA::freeCheckpoints(bool bRemoveFile)
+  {
+    if(NULL == ptrCheckpoint)
+      return;
+
+    if(bRemoveFile)
+      remove(ptrCheckpoint->strPath.c_str());
+
+    delete ptrCheckpoint;
+    ptrCheckpoint = NULL;
+  }
+
+#ifdef HAVE_THREADS
+  ///////////////////////////////
+  // Multi-threaded sampling
+
+  //! State shared by all sampling threads
+  typedef struct tagSamplingThreadsState
+  {
+    std::atomic<UINTEGER>   unNext;   //!< Next sample to be handed out
+    std::atomic<UINTEGER>   unDone;   //!< Number of completed samples
+    UINTEGER                unActive; //!< Number of running threads (guarded by mtx)
+    std::atomic<bool>       bAbort;   //!< Stop sampling as soon as possible
+    std::mutex              mtx;      //!< Guards the number of running threads
+    std::condition_variable cv;       //!< Wakes up the supervising thread
+    bool                    bMarkers; //!< Record the completed samples
+    //! Samples recorded by a previous run (may be empty)
+    const std::vector<bool> *ptrCompleted;
+
+    tagSamplingThreadsState()
+      : unNext(0)
+      , unDone(0)
+      , unActive(0)
+      , bAbort(false)
+      , bMarkers(false)
+      , ptrCompleted(NULL)
+    {
+      // Do nothing
+    }
+  } SamplingThreadsState;
+
+  //! Context of a sampling thread
+  struct PSSA::tagSamplingThreadContext
+  {
+    //! Simulation engine owned by the thread
+    PSSA                      *ptrEngine;
+    //! Simulation information object owned by the thread
+    datamodel::SimulationInfo *ptrSimInfo;
+    //! Log messages of the thread
+    std::basic_stringbuf< STRING::value_type > sbLog;
+
+    //! State shared by all threads
+    SamplingThreadsState      *ptrState;
+    //! Shared timing information storage
+    TimingInfo                *arTiming;
+    //! Shared final populations storage
+    UINTEGER                  *arFinalPops;
+
+    tagSamplingThreadContext()
+      : ptrEngine(NULL)
+      , ptrSimInfo(NULL)
+      , ptrState(NULL)
+      , arTiming(NULL)
+      , arFinalPops(NULL)
+    {
+      // Do nothing
+    }
+
+    ~tagSamplingThreadContext()
+    {
+      if(NULL != ptrSimInfo)
+        delete ptrSimInfo;
+      if(NULL != ptrEngine)
+        delete ptrEngine;
+    }
+  };
+
+  /**
+   * Worker routine of a sampling thread: fetch the next sample index
+   * until all samples are handed out and store the results in the
+   * respective slot, so that the output matches a serial run.
+   *
+   * @param ptrContext Context of the thread.
+   */
+  void PSSA::sampleTrialsWorker(PSSA::tagSamplingThreadContext * ptrContext)
+  {
+    SamplingThreadsState * ptrState = ptrContext->ptrState;
+    datamodel::SimulationInfo * ptrSimInfo = ptrContext->ptrSimInfo;
+
+    try
+    {
+      for(UINTEGER n = ptrState->unNext++;
+          (n < ptrSimInfo->unSamplesTotal)&&(!ptrState->bAbort);
+          n = ptrState->unNext++)
+      {
+        // samples recorded by a previous run are counted as done
+        if(!ptrState->ptrCompleted->empty()&&(*ptrState->ptrCompleted)[n])
+          continue;
+
+        REAL tTrial = 0.0;
+        UINTEGER unReactions = 0;
+
+        if(!ptrContext->ptrEngine->sampleTrial(ptrSimInfo, n, tTrial, unReactions))
+        {
+          ptrState->bAbort = true;
+          break;
+        }
+
+        ptrContext->ptrEngine->storeTrialResults(ptrSimInfo, n, tTrial, unReactions,
+                                                 ptrContext->arTiming, ptrContext->arFinalPops);
+        if(ptrState->bMarkers)
+          ptrContext->ptrEngine->writeSampleMarker(ptrSimInfo, n, tTrial, unReactions);
+
+        ++ptrState->unDone;
+        ptrState->cv.notify_one();
+      }
+    }
+    catch(std::exception & e)
+    {
+      PSSA_ERROR(ptrSimInfo, << e.what() << ": sampling thread terminated.\n");
+      ptrState->bAbort = true;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(ptrState->mtx);
+      --ptrState->unActive;
+    }
+    ptrState->cv.notify_one();
+  }
+
+  /**
+   * Sample the ensemble using multiple threads. Each thread owns a separate
+   * engine with its own data structures and random number generator, while
+   * the calling thread reports progress and forwards interruption requests.
+   *
+   * @param ptrSimInfo Simulation information object associated with this run.
+   * @param arTiming Timing information storage (may be @c NULL).
+   * @param arFinalPops Final populations storage (may be @c NULL).
+   * @param arCompleted Samples recorded by a previous run, which are skipped (may be empty).
+   * @param bMarkers @true if the completed samples are recorded.
+   * @return @true if all trials finished successfully, @false otherwise.
+   */
+  bool PSSA::runSamplingThreads(datamodel::SimulationInfo* ptrSimInfo,
+                                TimingInfo * arTiming, UINTEGER * arFinalPops,
+                                const std::vector<bool> & arCompleted, bool bMarkers)
+  {
+    UINTEGER unThreads = std::min(ptrSimInfo->unThreads, ptrSimInfo->unSamplesTotal);
+
+    SamplingThreadsState state;
+    state.unDone = std::count(arCompleted.begin(), arCompleted.end(), true);
+    state.ptrCompleted = &arCompleted;
+    state.bMarkers = bMarkers;
+    boost::scoped_array<tagSamplingThreadContext> arContext(NULL);
+    std::vector<std::thread> arThreads;
+
+    PSSA_INFO(ptrSimInfo, << "sampling the ensemble using " << unThreads << " threads.\n");
+
+    // Set up the engines sequentially, since the model is shared
+    bool bResult = true;
+    try
+    {
+      arContext.reset(new tagSamplingThreadContext[unThreads]);
+      for(UINTEGER ti = 0; (ti < unThreads)&&bResult; ++ti)
+      {
+        tagSamplingThreadContext & ctx = arContext[ti];
+        ctx.ptrState = &state;
+        ctx.arTiming = arTiming;
+        ctx.arFinalPops = arFinalPops;
+
+        ctx.ptrEngine = new PSSA();
+        if(!ctx.ptrEngine->setMethod(m_Method))
+        {
+          PSSA_ERROR(ptrSimInfo, << "failed to set up the engine for sampling thread #" << ti << ".\n");
+          bResult = false;
+          break;
+        }
+        ctx.ptrEngine->SetReactionCallback(ptrReactionCallback, ptrReactionCallbackUserData);
+        ctx.ptrEngine->m_EventStream.assign(m_EventStream);
+
+        ctx.ptrSimInfo = new datamodel::SimulationInfo(*ptrSimInfo);
+        ctx.ptrSimInfo->unThreads = 1;
+        // streams are selected by the sample index, hence all threads share the seed
+        ctx.ptrSimInfo->unRNGSeed = ptrSampling->get_rng_seed();
+        ctx.ptrSimInfo->unOutputFlags &= ~datamodel::SimulationInfo::ofStatus;
+        ctx.ptrSimInfo->setOutputStreamBuf(datamodel::SimulationInfo::ofLog, &ctx.sbLog);
+
+        if(!ctx.ptrEngine->setupForSampling(ctx.ptrSimInfo))
+        {
+          PSSA_ERROR(ptrSimInfo, << "failed to initialize sampling thread #" << ti << ".\n");
+          bResult = false;
+        }
+      }
+    }
+    catch(std::bad_alloc & e)
+    {
+      PSSA_ERROR(ptrSimInfo, << e.what() << ": unable to allocate memory.\n");
+      bResult = false;
+    }
+
+    // Launch the threads
+    if(bResult)
+    {
+      try
+      {
+        arThreads.reserve(unThreads);
+        for(UINTEGER ti = 0; ti < unThreads; ++ti)
+        {
+          {
+            std::lock_guard<std::mutex> lock(state.mtx);
+            ++state.unActive;
+          }
+          try
+          {
+            arThreads.push_back(std::thread(&PSSA::sampleTrialsWorker, &arContext[ti]));
+          }
+          catch(...)
+          {
+            std::lock_guard<std::mutex> lock(state.mtx);
+            --state.unActive;
+            throw;
+          }
+        }
+      }
+      catch(std::exception & e)
+      {
+        PSSA_ERROR(ptrSimInfo, << e.what() << ": unable to launch sampling threads.\n");
+        state.bAbort = true;
+        bResult = false;
+      }
+
+      // Supervise the threads
+      UINTEGER unReported = std::numeric_limits<UINTEGER>::max();
+      std::unique_lock<std::mutex> lock(state.mtx);
+      while(state.unActive > 0)
+      {
+        state.cv.wait_for(lock, std::chrono::milliseconds(100));
+
+        // forward interruption requests
+        if(ptrSimInfo->bInterruptRequested||state.bAbort)
+        {
+          state.bAbort = true;
+          for(UINTEGER ti = 0; ti < arThreads.size(); ++ti)
+            arContext[ti].ptrSimInfo->bInterruptRequested = true;
+        }
+
+        // report progress
+        UINTEGER unDone = state.unDone;
+        if((unDone != unReported)&&ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofStatus))
+        {
+          unReported = unDone;
+          SHORT percent = (SHORT)((100.0 * unDone) / ptrSimInfo->unSamplesTotal);
+          if(NULL != ptrProgrCallback)
+            (*ptrProgrCallback)(unDone, ptrSimInfo->unSamplesTotal, percent, ptrProgrCallbackUserData);
+          else
+          {
+            OSTREAM & osStatus = ptrSimInfo->getOutputStream(datamodel::SimulationInfo::ofStatus);
+            osStatus.seekp(0);
+            osStatus << "Progress : " << unDone << " of " << ptrSimInfo->unSamplesTotal
+              << " samples (" << percent << "%) done...\n";
+          }
+        }
+      }
+      lock.unlock();
+
+      for(UINTEGER ti = 0; ti < arThreads.size(); ++ti)
+        arThreads[ti].join();
+    }
+
+    // Collect log messages of the threads in order
+    for(UINTEGER ti = 0; (NULL != arContext.get())&&(ti < unThreads); ++ti)
+    {
+      if(NULL == arContext[ti].ptrSimInfo)
+        break;
+
+      // Combine the ensemble statistics of the threads
+      if(ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofAvgTrajectory)&&
+         !ptrSimInfo->m_esTrajectory.merge(arContext[ti].ptrSimInfo->m_esTrajectory))
+      {
+        PSSA_ERROR(ptrSimInfo, << "failed to combine the ensemble statistics of sampling thread #" << ti << ".\n");
+        bResult = false;
+      }
+      if(ptrSimInfo->isLoggingOn(datamodel::SimulationInfo::ofHistogram)&&
+         !ptrSimInfo->m_phFinalPops.merge(arContext[ti].ptrSimInfo->m_phFinalPops))
+      {
+        PSSA_ERROR(ptrSimInfo, << "failed to combine the histograms of sampling thread #" << ti << ".\n");
+        bResult = false;
+      }
+
+      arContext[ti].ptrEngine->deinitSimulation(arContext[ti].ptrSimInfo);
+
+      const STRING strLog = arContext[ti].sbLog.str();
+      if(!strLog.empty())
+        ptrSimInfo->report() << strLog << std::flush;
+    }
+
+    if(bResult&&(state.bAbort||(state.unDone != ptrSimInfo->unSamplesTotal)))
+    {
+      PSSA_ERROR(ptrSimInfo, << "sampling threads terminated after "
+        << state.unDone << " of " << ptrSimInfo->unSamplesTotal << " samples.\n");
+      bResult = false;
+    }
 
     return bResult;
   }
+#endif
 
   /**
-   * This function samples given number of trajectories (\c ptrSimInfo->arSamples[0]) and outputs them to a series of files, 
+   * This function samples \c ptrSimInfo->unSamplesTotal trajectories and outputs them to a series of files, 
    * starting at \a time \c = \c ptrSimInfo->dTimeStart to \a time \c = \c ptrSimInfo->dTimeEnd seconds and saving 
    * the output to \c ptrSimInfo->strOutput every \c ptrSimInfo->dTimeStep seconds.
    *
@@ -840,7 +2252,7 @@ namespace pssalib
    * \a "false" otherwise.
    *
    */
-  bool PSSA::run_avg(datamodel::SimulationInfo *ptrSimInfo)
+  bool PSSA::run(datamodel::SimulationInfo *ptrSimInfo)
   {
     bool bResult = setupForSampling(ptrSimInfo);
 #ifdef HAVE_MPI
@@ -849,18 +2261,53 @@ namespace pssalib
     if(!bResult)
       return false;
 
-    //////////////////////////////
-    // Run the simulation
+    bResult = runSamplingLoop(ptrSimInfo);
+
+    // Clean-up
+    deinitSimulation(ptrSimInfo);
+
+    return bResult;
+  }
+
+  /**
+   * This function samples given number of trajectories (\c ptrSimInfo->unSamplesTotal) and accumulates the mean and
+   * the variance of the populations starting at \a time \c = \c ptrSimInfo->dTimeStart to \a time \c = \c ptrSimInfo->dTimeEnd
+   * seconds every \c ptrSimInfo->dTimeStep seconds, while the trials are sampled. Only the aggregate is saved to
+   * \c ptrSimInfo->strOutput, the trajectories of the individual samples are not stored.
+   *
+   * @param ptrSimInfo datamodel::SimulationInfo* Simulation information object associated with this run.
+   *
+   * @return logical \a "true" if all trials finished successfully,
+   * \a "false" otherwise.
+   *
+   */
+  bool PSSA::run_avg(datamodel::SimulationInfo *ptrSimInfo)
+  {
+    // the accumulator is allocated along with the trial buffers
     UINTEGER prevOutputFalgs = ptrSimInfo->unOutputFlags;
 
     ptrSimInfo->unOutputFlags |= 
-      datamodel::SimulationInfo::ofTrajectory |
+      datamodel::SimulationInfo::ofAvgTrajectory |
       datamodel::SimulationInfo::ofTimePoints;
     ptrSimInfo->unOutputFlags &= ~(
+      datamodel::SimulationInfo::ofTrajectory |
+      datamodel::SimulationInfo::ofBinaryTrajectory |
       datamodel::SimulationInfo::ofFinalPops |
       datamodel::SimulationInfo::ofTiming
     );
 
+    bool bResult = setupForSampling(ptrSimInfo);
+#ifdef HAVE_MPI
+    bResult = getMPIWrapperInstance().sync_results(bResult);
+#endif
+    if(!bResult)
+    {
+      ptrSimInfo->unOutputFlags = prevOutputFalgs;
+      return false;
+    }
+
+    //////////////////////////////
+    // Run the simulation
     bResult = runSamplingLoop(ptrSimInfo);
 
     //
@@ -874,11 +2321,11 @@ namespace pssalib
   }
 
   /**
-   * This function simulates given in \c simInfo->arSamples number of trajectories and outputs the population at \a time \c = \c simInfo->dTimeEnd 
-   * to a file named \c "PSSA_final_values.txt". For each element in \c arTrials a separate output is produced and the data from previous trials (if any) is
-   * reused. At the same time it computes the amount of time spent one each run and the number of reactions fired and stores them to \c "PSSA_probability_timing.txt". 
-   * Depending on the value of \c simInfo->stStatistics, it can produce the one-dimensional histograms for each of the species (\a ST_SINGLE) or cumulative histogram 
-   * of all of the species (\a ST_MULTI). Only species in \c simInfo->pArSpeciesIds are considered.
+   * This function simulates \c simInfo->unSamplesTotal trials and accumulates the histograms of the populations at \a time \c = \c simInfo->dTimeEnd
+   * while the trials are sampled, so that the memory use does not depend on the number of samples. For each species in each subvolume a
+   * marginal histogram with \c simInfo->unHistogramBins bins is produced, if \c simInfo->unHistogramStates is not zero the samples in each
+   * distinct joint state are counted as well & at most as many of the most frequent states are written. Only species in
+   * \c simInfo->pArSpeciesIds are considered.
    *
    * @param simInfo datamodel::SimulationInfo* Simulation information object associated with this run.
    *
@@ -888,25 +2335,32 @@ namespace pssalib
    */
   bool PSSA::run_hist(pssalib::datamodel::SimulationInfo *ptrSimInfo)
   {
-    bool bResult = setupForSampling(ptrSimInfo);
-#ifdef HAVE_MPI
-    bResult = getMPIWrapperInstance().sync_results(bResult);
-#endif
-    if(!bResult)
-      return false;
-
-    //////////////////////////////
-    // Run the simulation
+    // the histograms are allocated along with the trial buffers
     UINTEGER prevOutputFalgs = ptrSimInfo->unOutputFlags;
 
     ptrSimInfo->unOutputFlags |= 
-      datamodel::SimulationInfo::ofFinalPops |
+      datamodel::SimulationInfo::ofHistogram |
       datamodel::SimulationInfo::ofTimePoints;
     ptrSimInfo->unOutputFlags &= ~(
       datamodel::SimulationInfo::ofTrajectory |
+      datamodel::SimulationInfo::ofBinaryTrajectory |
+      datamodel::SimulationInfo::ofAvgTrajectory |
+      datamodel::SimulationInfo::ofFinalPops |
       datamodel::SimulationInfo::ofTiming
     );
 
+    bool bResult = setupForSampling(ptrSimInfo);
+#ifdef HAVE_MPI
+    bResult = getMPIWrapperInstance().sync_results(bResult);
+#endif
+    if(!bResult)
+    {
+      ptrSimInfo->unOutputFlags = prevOutputFalgs;
+      return false;
+    }
+
+    //////////////////////////////
+    // Run the simulation
     bResult = runSamplingLoop(ptrSimInfo);
 
     //
@@ -20,6 +20,8 @@
 
 #include "../../include/datamodel/DataModel.h"
 #include "../../include/datamodel/DataModel_DM.h"
+#include "../../include/datamodel/DataModel_DMTree.h"
+#include "../../include/datamodel/DataModel_NRM.h"
 #include "../../include/datamodel/DataModel_PDM.h"
 #include "../../include/datamodel/DataModel_SPDM.h"
 #include "../../include/datamodel/DataModel_PSSACR.h"
@@ -37,9 +39,16 @@ namespace pssalib
       , m_arReactionWrappers(NULL)
       , m_unSubvolumes(0)
       , m_arSubvolumes(NULL)
+      , m_arunPopulation(NULL)
+      , m_arunInitialPopulation(NULL)
+      , m_arunNeighbours(NULL)
+      , m_ardTotalPropensity(NULL)
+      , m_ardInitialTotalPropensity(NULL)
       , m_uDims(0)
       , m_arunDims(0)
+      , m_dInitialTotalPropensity(0.0)
       , dTotalPropensity(0.0)
+      , bVolumesScheduled(false)
       , mu(0)
       , nu(0)
       , nu_D(0)
@@ -62,8 +71,8 @@ namespace pssalib
 
       if(NULL != m_arSubvolumes)
       {
+        freeSubvolumesStorage();
         freeSubvolumes();
-        m_arSubvolumes = NULL;
         m_unSubvolumes = 0;
       }
 
@@ -131,10 +140,17 @@ namespace pssalib
 
       // free previously allocated memory
       if(NULL != m_arSubvolumes)
+      {
+        freeSubvolumesStorage();
         freeSubvolumes();
+      }
       m_unSubvolumes = subvolumes;
-      m_arSubvolumes = new detail::Subvolume *[m_unSubvolumes];
-      memset(m_arSubvolumes, 0, sizeof(detail::Subvolume *)*m_unSubvolumes);
+
+      // allocate the subvolumes & the tables they refer to
+      allocateSubvolumes();
+      for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
+        m_arSubvolumes[svi]->allocate(m_unReactionWrappers, m_unSpecies, m_uDims);
+      allocateSubvolumesStorage();
 
       if(m_uDims > 0)
       {
@@ -160,9 +176,7 @@ namespace pssalib
 
         for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
         {
-          detail::Subvolume * pSV = allocateSubvolume();
-
-          pSV->allocate(m_unReactionWrappers, m_unSpecies, m_uDims);
+          UINTEGER * arunNeighbours = m_arunNeighbours + svi * 2 * m_uDims;
 
           util::ind2sub(m_uDims, m_arunDims, svi, arunSub.get());
 
@@ -171,23 +185,74 @@ namespace pssalib
             UINTEGER unCurrSub = arunSub[di];
 
             arunSub[di] = bcHelper.get()->prev(unCurrSub, m_arunDims[di]);
-            util::sub2ind(m_uDims, m_arunDims, arunSub.get(), pSV->arNeighbouringSubvolumes[2*di]);
+            util::sub2ind(m_uDims, m_arunDims, arunSub.get(), arunNeighbours[2*di]);
 
             arunSub[di] = bcHelper.get()->next(unCurrSub, m_arunDims[di]);
-            util::sub2ind(m_uDims, m_arunDims, arunSub.get(), pSV->arNeighbouringSubvolumes[2*di + 1]);
+            util::sub2ind(m_uDims, m_arunDims, arunSub.get(), arunNeighbours[2*di + 1]);
 
             arunSub[di] = unCurrSub;
           }
-
-          m_arSubvolumes[svi] = pSV;
         }
       }
-      else
+    }
+
+    /*
+     * Allocates the tables holding the state of all subvolumes
+     */
+    void DataModel::allocateSubvolumesStorage()
+    {
+      m_arunPopulation = new UINTEGER[m_unSubvolumes * m_unSpecies];
+      memset(m_arunPopulation, 0, sizeof(UINTEGER)*m_unSubvolumes*m_unSpecies);
+      m_arunInitialPopulation = new UINTEGER[m_unSubvolumes * m_unSpecies];
+      memset(m_arunInitialPopulation, 0, sizeof(UINTEGER)*m_unSubvolumes*m_unSpecies);
+      if(0 != m_uDims)
+        m_arunNeighbours = new UINTEGER[m_unSubvolumes * 2 * m_uDims];
+      m_ardTotalPropensity = new REAL[m_unSubvolumes];
+      std::fill_n(m_ardTotalPropensity, m_unSubvolumes, REAL(0.0));
+      m_ardInitialTotalPropensity = new REAL[m_unSubvolumes];
+      std::fill_n(m_ardInitialTotalPropensity, m_unSubvolumes, REAL(0.0));
+
+      for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
       {
-        detail::Subvolume * pSV = allocateSubvolume();
+        detail::Subvolume & sv = getSubvolume(svi);
+        sv.arunPopulation = m_arunPopulation + svi * m_unSpecies;
+        sv.arunInitialPopulation = m_arunInitialPopulation + svi * m_unSpecies;
+        if(0 != m_uDims)
+          sv.arNeighbouringSubvolumes = m_arunNeighbours + svi * 2 * m_uDims;
+        sv.pdTotalPropensity = m_ardTotalPropensity + svi;
+        sv.pdInitialTotalPropensity = m_ardInitialTotalPropensity + svi;
+      }
+    }
 
-        pSV->allocate(m_unReactionWrappers, m_unSpecies, 0);
-        m_arSubvolumes[0] = pSV;
+    /*
+     * Frees the tables holding the state of all subvolumes
+     */
+    void DataModel::freeSubvolumesStorage()
+    {
+      if(NULL != m_arunPopulation)
+      {
+        delete [] m_arunPopulation;
+        m_arunPopulation = NULL;
+      }
+      if(NULL != m_arunInitialPopulation)
+      {
+        delete [] m_arunInitialPopulation;
+        m_arunInitialPopulation = NULL;
+      }
+      if(NULL != m_arunNeighbours)
+      {
+        delete [] m_arunNeighbours;
+        m_arunNeighbours = NULL;
+      }
+      if(NULL != m_ardTotalPropensity)
+      {
+        delete [] m_ardTotalPropensity;
+        m_ardTotalPropensity = NULL;
+      }
+      if(NULL != m_ardInitialTotalPropensity)
+      {
+        delete [] m_ardInitialTotalPropensity;
+        m_ardInitialTotalPropensity = NULL;
       }
     }
 
@@ -206,6 +271,11 @@ namespace pssalib
       // Reset minimal propensity
       crsdVolume.minValue = std::numeric_limits<REAL>::max();
 
+      // Rate constants scaled to the subreactor volume (the user defined
+      // model is shared and must remain unchanged)
+      std::vector<REAL> arRates;
+      arRates.reserve(2 * getReactionsCount() + getSpeciesCount());
+
       // Chemical reactions
       for(UINTEGER ri = 0, pass = 0; ri < getReactionsCount(); ++ri)
       {
@@ -227,15 +297,10 @@ namespace pssalib
 
           REAL temp = pow(subreactorVolume, exponent+1) * ((REAL)factor);
           if(0 == pass)
-          {
             temp *= r->getForwardRate();
-            r->setForwardRate(temp);
-          }
           else
-          {
             temp *= r->getReverseRate();
-            r->setReverseRate(temp);
-          }
+          arRates.push_back(temp);
 
           temp /= ((REAL)factor);
           if((temp > 0.0)&&(temp < crsdVolume.minValue))
@@ -264,7 +329,7 @@ namespace pssalib
             REAL temp = s->getDiffusionConstant() * dH2inv;
             if (temp < crsdVolume.minValue)
               crsdVolume.minValue = temp;
-            s->setDiffusionConstant(temp);
+            arRates.push_back(temp);
             ++m_unReactionWrappers;
           }
         }
@@ -284,7 +349,7 @@ namespace pssalib
       {
         do
         {
-          new (m_arReactionWrappers + rwi) detail::ReactionWrapper(getReaction(ri), rwi, 1 == pass); ++rwi;
+          new (m_arReactionWrappers + rwi) detail::ReactionWrapper(getReaction(ri), rwi, arRates[rwi], 1 == pass); ++rwi;
           if(!(getReaction(ri)->isReversible()))
             break;
         }
@@ -299,7 +364,7 @@ namespace pssalib
         {
           if(getSpecies(si)->isSetDiffusionConstant())
           {
-            new (m_arReactionWrappers + rwi) detail::ReactionWrapper(getSpecies(si), rwi); ++rwi;
+            new (m_arReactionWrappers + rwi) detail::ReactionWrapper(getSpecies(si), rwi, arRates[rwi]); ++rwi;
           }
         }
       }
@@ -341,6 +406,8 @@ namespace pssalib
 
     //! Default constructor
     DataModel_DM::DataModel_DM()
+      : m_ardPi(NULL)
+      , m_ardInitialPi(NULL)
     {
       // Do nothing
     }
@@ -351,11 +418,89 @@ namespace pssalib
       free();
     }
 
+    /*
+     * Allocates the tables holding the state of all subvolumes
+     */
+    void DataModel_DM::allocateSubvolumesStorage()
+    {
+      // call base class method
+      DataModel::allocateSubvolumesStorage();
+
+      m_ardPi = new REAL[m_unSubvolumes * m_unReactionWrappers];
+      std::fill_n(m_ardPi, m_unSubvolumes * m_unReactionWrappers, REAL(0.0));
+      m_ardInitialPi = new REAL[m_unSubvolumes * m_unReactionWrappers];
+      std::fill_n(m_ardInitialPi, m_unSubvolumes * m_unReactionWrappers, REAL(0.0));
+
+      for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
+      {
+        detail::Subvolume_DM & sv = getSubvolume(svi);
+        sv.ardPi = m_ardPi + svi * m_unReactionWrappers;
+        sv.ardInitialPi = m_ardInitialPi + svi * m_unReactionWrappers;
+      }
+    }
+
+    /*
+     * Frees the tables holding the state of all subvolumes
+     */
+    void DataModel_DM::freeSubvolumesStorage()
+    {
+      if(NULL != m_ardPi)
+      {
+        delete [] m_ardPi;
+        m_ardPi = NULL;
+      }
+      if(NULL != m_ardInitialPi)
+      {
+        delete [] m_ardInitialPi;
+        m_ardInitialPi = NULL;
+      }
+
+      // call base class method
+      DataModel::freeSubvolumesStorage();
+    }
+
+    ////////////////////////////////////////
+    // DM-Tree data model class
+
+    //! Default constructor
+    DataModel_DMTree::DataModel_DMTree()
+    {
+      // Do nothing
+    }
+
+    //! Destructor
+    DataModel_DMTree::~DataModel_DMTree()
+    {
+      free();
+    }
+
+    ////////////////////////////////////////
+    // NRM data model class
+
+    //! Default constructor
+    DataModel_NRM::DataModel_NRM()
+      : bScheduled(false)
+    {
+      // Do nothing
+    }
+
+    //! Destructor
+    DataModel_NRM::~DataModel_NRM()
+    {
+      free();
+    }
+
     ////////////////////////////////////////
     // PDM data model class
 
     //! Default constructor
     DataModel_PDM::DataModel_PDM()
+      : m_ardLambda(NULL)
+      , m_ardSigma(NULL)
+      , m_ardInitialLambda(NULL)
+      , m_ardInitialSigma(NULL)
+      , m_ardPi(NULL)
+      , m_ardInitialPi(NULL)
     {
       // Do nothing
     }
@@ -366,12 +511,139 @@ namespace pssalib
       free();
     }
 
+    /*
+     * Allocates the tables holding the state of all subvolumes
+     */
+    void DataModel_PDM::allocateSubvolumesStorage()
+    {
+      // call base class method
+      DataModel::allocateSubvolumesStorage();
+
+      const UINTEGER total_species = m_unSpecies + 1; // account for reservoir species
+      const UINTEGER total = m_unSubvolumes * total_species;
+      m_ardLambda = new REAL[total];
+      std::fill_n(m_ardLambda, total, REAL(0.0));
+      m_ardSigma = new REAL[total];
+      std::fill_n(m_ardSigma, total, REAL(0.0));
+      m_ardInitialLambda = new REAL[total];
+      std::fill_n(m_ardInitialLambda, total, REAL(0.0));
+      m_ardInitialSigma = new REAL[total];
+      std::fill_n(m_ardInitialSigma, total, REAL(0.0));
+
+      for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
+      {
+        detail::Subvolume_PDM & sv = getSubvolume(svi);
+        sv.m_ardLambda = m_ardLambda + svi * total_species;
+        sv.m_ardSigma = m_ardSigma + svi * total_species;
+        sv.m_ardInitialLambda = m_ardInitialLambda + svi * total_species;
+        sv.m_ardInitialSigma = m_ardInitialSigma + svi * total_species;
+      }
+    }
+
+    /*
+     * Frees the tables holding the state of all subvolumes
+     */
+    void DataModel_PDM::freeSubvolumesStorage()
+    {
+      freePartialPropensities();
+
+      if(NULL != m_ardLambda)
+      {
+        delete [] m_ardLambda;
+        m_ardLambda = NULL;
+      }
+      if(NULL != m_ardSigma)
+      {
+        delete [] m_ardSigma;
+        m_ardSigma = NULL;
+      }
+      if(NULL != m_ardInitialLambda)
+      {
+        delete [] m_ardInitialLambda;
+        m_ardInitialLambda = NULL;
+      }
+      if(NULL != m_ardInitialSigma)
+      {
+        delete [] m_ardInitialSigma;
+        m_ardInitialSigma = NULL;
+      }
+
+      // call base class method
+      DataModel::freeSubvolumesStorage();
+    }
+
+    /*
+     * Allocates the tables holding the partial propensities of all subvolumes
+     */
+    void DataModel_PDM::allocatePartialPropensities()
+    {
+      const std::size_t total_pi = aruL.get_size();
+      if(0 == total_pi)
+        return;
+
+      const std::size_t total = m_unSubvolumes * total_pi;
+      m_ardPi = new REAL[total];
+      std::fill_n(m_ardPi, total, REAL(0.0));
+      m_ardInitialPi = new REAL[total];
+      std::fill_n(m_ardInitialPi, total, REAL(0.0));
+
+      for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
+      {
+        detail::Subvolume_PDM & sv = getSubvolume(svi);
+        sv.arPi.bind(aruL, m_ardPi + svi * total_pi);
+        sv.m_arInitialPi.bind(aruL, m_ardInitialPi + svi * total_pi);
+      }
+    }
+
+    /*
+     * Frees the tables holding the partial propensities of all subvolumes
+     */
+    void DataModel_PDM::freePartialPropensities()
+    {
+      if(NULL != m_arSubvolumes)
+      {
+        for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
+        {
+          detail::Subvolume_PDM & sv = getSubvolume(svi);
+          sv.arPi.free();
+          sv.m_arInitialPi.free();
+        }
+      }
+
+      if(NULL != m_ardPi)
+      {
+        delete [] m_ardPi;
+        m_ardPi = NULL;
+      }
+      if(NULL != m_ardInitialPi)
+      {
+        delete [] m_ardInitialPi;
+        m_ardInitialPi = NULL;
+      }
+    }
+
+    /*
+     * Stores the partial propensity structures in contiguous arrays
+     */
+    void DataModel_PDM::freeze(const detail::JaggedMatrix<PropensityIndex> & U3,
+                               const detail::JaggedMatrix<detail::ReactionWrapper *> & L)
+    {
+      freePartialPropensities();
+
+      arU3.freeze(U3);
+      aruL.freeze(L);
+
+      allocatePartialPropensities();
+    }
+
     ////////////////////////////////////////
     // SPDM data model class
 
     //! Default constructor
     DataModel_SPDM::DataModel_SPDM()
-      : rowIndex(0)
+      : m_arunIndexerRows(NULL)
+      , m_arunIndexerCols(NULL)
+      , rowIndex(0)
       , colIndex(0)
     {
       // Do nothing
@@ -383,6 +655,79 @@ namespace pssalib
       free();
     }
 
+    /*
+     * Allocates the tables holding the state of all subvolumes
+     */
+    void DataModel_SPDM::allocateSubvolumesStorage()
+    {
+      // call base class method
+      DataModel_PDM::allocateSubvolumesStorage();
+
+      const UINTEGER total_species = m_unSpecies + 1; // account for reservoir species
+      const UINTEGER total = m_unSubvolumes * total_species;
+      m_arunIndexerRows = new std::size_t[total];
+      std::fill_n(m_arunIndexerRows, total, std::size_t(0));
+
+      for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
+        getSubvolume(svi).m_IndexerRows = m_arunIndexerRows + svi * total_species;
+    }
+
+    /*
+     * Frees the tables holding the state of all subvolumes
+     */
+    void DataModel_SPDM::freeSubvolumesStorage()
+    {
+      if(NULL != m_arunIndexerRows)
+      {
+        delete [] m_arunIndexerRows;
+        m_arunIndexerRows = NULL;
+      }
+
+      // call base class method
+      DataModel_PDM::freeSubvolumesStorage();
+    }
+
+    /*
+     * Allocates the tables holding the partial propensities of all subvolumes
+     */
+    void DataModel_SPDM::allocatePartialPropensities()
+    {
+      // call base class method
+      DataModel_PDM::allocatePartialPropensities();
+
+      const std::size_t total_pi = aruL.get_size();
+      if(0 == total_pi)
+        return;
+
+      const std::size_t total = m_unSubvolumes * total_pi;
+      m_arunIndexerCols = new std::size_t[total];
+      std::fill_n(m_arunIndexerCols, total, std::size_t(0));
+
+      for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
+        getSubvolume(svi).m_IndexerCols.bind(aruL, m_arunIndexerCols + svi * total_pi);
+    }
+
+    /*
+     * Frees the tables holding the partial propensities of all subvolumes
+     */
+    void DataModel_SPDM::freePartialPropensities()
+    {
+      if(NULL != m_arSubvolumes)
+      {
+        for(UINTEGER svi = 0; svi < m_unSubvolumes; ++svi)
+          getSubvolume(svi).m_IndexerCols.free();
+      }
+
+      if(NULL != m_arunIndexerCols)
+      {
+        delete [] m_arunIndexerCols;
+        m_arunIndexerCols = NULL;
+      }
+
+      // call base class method
+      DataModel_PDM::freePartialPropensities();
+    }
+
     ////////////////////////////////////////
     // PSRD-CR data model class
 
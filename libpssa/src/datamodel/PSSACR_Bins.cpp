@@ -46,7 +46,7 @@ namespace datamodel
     {
       resize(b.unCapBinEl);
       unNumBinEl = b.unNumBinEl;
-      memcpy(b.arunBinEl, arunBinEl, unNumBinEl*sizeof(UINTEGER));
+      memcpy(arunBinEl, b.arunBinEl, unNumBinEl*sizeof(UINTEGER));
       dBinSum    = b.dBinSum;
     }
   }
@@ -82,6 +82,13 @@ namespace datamodel
     }
   }
 
+  //! Empty the bin retaining its storage
+  void PSSACR_Bin::reset()
+  {
+    unNumBinEl = 0;
+    dBinSum    = 0.0;
+  }
+
   /**
    * Add an index to the list
    * 
@@ -153,13 +160,12 @@ namespace datamodel
 
   //! Default constructor
   PSSACR_Bins::PSSACR_Bins()
-    : binVals (NULL)
+    : dTotal(0.0)
+    , unBinned(0)
+    , binVals (NULL)
     , unVals(0)
   {
-    // Goggle dense_hash_map specific
-#ifdef __USE_GOOGLE_HASH_MAP
-    mapBins.set_empty_key(0);
-#endif
+    // Do nothing
   }
 
   //! Destructor
@@ -168,6 +174,78 @@ namespace datamodel
     clear();
   }
 
+  //! Empty all bins retaining the allocated memory
+  void PSSACR_Bins::reset()
+  {
+    for(UINTEGER bin_no = 0; bin_no < vBins.size(); ++bin_no)
+      vBins[bin_no].reset();
+    std::fill(vunOccupied.begin(), vunOccupied.end(), 0u);
+    dTotal = 0.0;
+    unBinned = 0;
+    std::fill(binVals, binVals + unVals, BinVals());
+  }
+
+  /**
+   * @brief Add a value to a bin
+   *
+   * @param bin_no bin number.
+   * @param idx item index.
+   * @param val item value.
+   */
+  void PSSACR_Bins::insert(UINTEGER bin_no, UINTEGER idx, REAL val)
+  {
+    // bins are added once and retained
+    if(bin_no >= vBins.size())
+    {
+      vBins.resize(bin_no + 1);
+      vunOccupied.resize((bin_no >> 5) + 1, 0u);
+    }
+
+    PSSACR_Bin & bin = vBins[bin_no];
+    if(0 == bin.size())
+    {
+      if(0 == bin.unCapBinEl)
+        bin.resize(unVals);
+      vunOccupied[bin_no >> 5] |= (1u << (bin_no & 31));
+    }
+
+    bin.dBinSum += val;
+    dTotal += val;
+    ++unBinned;
+
+    binVals[idx].idx = bin.push_back(idx);
+    binVals[idx].bin_no = bin_no;
+    binVals[idx].val = val;
+  }
+
+  /**
+   * @brief Remove a value from its bin
+   *
+   * @param idx item index.
+   */
+  void PSSACR_Bins::remove(UINTEGER idx)
+  {
+    const UINTEGER bin_no = binVals[idx].bin_no;
+    PSSACR_Bin & bin = vBins[bin_no];
+
+    // remove at old position & update the index of swapped element
+    binVals[bin.remove_at(binVals[idx].idx)].idx = binVals[idx].idx;
+
+    // empty sums are reset to avoid accumulating round-off errors
+    if(0 == bin.size())
+    {
+      bin.dBinSum = 0.0;
+      vunOccupied[bin_no >> 5] &= ~(1u << (bin_no & 31));
+    }
+    else
+      bin.dBinSum -= binVals[idx].val;
+
+    if(0 == --unBinned)
+      dTotal = 0.0;
+    else
+      dTotal -= binVals[idx].val;
+  }
+
   /**
    * @brief Updates value in a bin
    *
@@ -182,101 +260,31 @@ namespace datamodel
       if(0 == binVals[idx].bin_no)
       {
         // insert
-        it = mapBins.find(bin_no_new);
-        if(mapBins.end() == it)
-        {
-          PSSACR_Bin bin;
-          insRes = mapBins.insert(MAP_BINS::value_type(bin_no_new, bin));
-
-          it = insRes.first;
-          it->second.dBinSum = val;
-          it->second.resize(unVals);
-
-          binVals[idx].idx = it->second.push_back(idx);
-          binVals[idx].bin_no = bin_no_new;
-          binVals[idx].val = val;
-        }
-        else
-        {
-          it->second.dBinSum += val;
-
-          binVals[idx].idx = it->second.push_back(idx);
-          binVals[idx].bin_no = bin_no_new;
-          binVals[idx].val = val;
-        }
+        insert(bin_no_new, idx, val);
       }
       else if(bin_no_new == binVals[idx].bin_no)
       {
         // update
-        it = mapBins.find(binVals[idx].bin_no);
-        if(mapBins.end() == it)
-        {
-          throw std::runtime_error("PSSACR_Bin::updateValue() - bin does not exist");
-          //std::cerr << "Bin does not exist!\nBin = " << binVals[idx].bin_no
-          //  << " : idx = " << idx << " : val = " << val << std::endl;
-        }
-        else
-        {
-          it->second.dBinSum +=  val - binVals[idx].val;
+        vBins[bin_no_new].dBinSum += val - binVals[idx].val;
+        dTotal += val - binVals[idx].val;
 
-          binVals[idx].val = val;
-        }
+        binVals[idx].val = val;
       }
       else
       {
         // update & move
-        it = mapBins.find(binVals[idx].bin_no);
-        if(mapBins.end() == it)
-        {
-          throw std::runtime_error("PSSACR_Bin::updateValue() - bin does not exist");
-          //std::cerr << "Bin does not exist!\nBin = " << binVals[idx].bin_no
-          //  << " : idx = " << idx << " : val = " << val << std::endl;
-        }
-        else
-        {
-          // remove at old position & update the index of swapped element
-          binVals[it->second.remove_at(binVals[idx].idx)].idx = binVals[idx].idx;
-
-          it->second.dBinSum -= binVals[idx].val;
-
-          it = mapBins.find(bin_no_new);
-          if(mapBins.end() == it)
-          {
-            // insert new bin
-            PSSACR_Bin bin;
-            insRes = mapBins.insert(MAP_BINS::value_type(bin_no_new, bin));
-
-            it = insRes.first;
-            it->second.dBinSum = val;
-            it->second.resize(unVals);
-
-            binVals[idx].idx = it->second.push_back(idx);
-          }
-          else
-          {
-            it->second.dBinSum +=  val;
-
-            binVals[idx].idx = it->second.push_back(idx);
-          }
-
-          binVals[idx].bin_no = bin_no_new;
-          binVals[idx].val = val;
-        }
+        remove(idx);
+        insert(bin_no_new, idx, val);
       }
     }
-    else
+    else if(0 != binVals[idx].bin_no)
     {
-      it = mapBins.find(binVals[idx].bin_no);
-      if(mapBins.end() != it)
-      {
-        // delete empty bin entry & update the index of swapped element
-        binVals[it->second.remove_at(binVals[idx].idx)].idx = binVals[idx].idx;
-        it->second.dBinSum -= binVals[idx].val;
+      // delete
+      remove(idx);
 
-        binVals[idx].bin_no = 0;
-        binVals[idx].val = 0.0;
-        binVals[idx].idx = -1;
-      }
+      binVals[idx].bin_no = 0;
+      binVals[idx].val = 0.0;
+      binVals[idx].idx = -1;
     }
   }
 }  } // close namespaces pssalib and datamodel
@@ -24,15 +24,16 @@
 #include "../../include/datamodel/SimulationInfo.h"
 
 #include "../../include/util/MPIWrapper.h"
+#include "../../include/util/AllocationCounter.h"
 #include "../../include/util/FileSystem.h"
 #include "../../include/util/Timing.h"
 #include "../../include/util/IO.hpp"
+#include "../../include/util/BinaryTrajectory.h"
 
 #ifdef HAVE_LIBSBML
 #include "../../include/datamodel/detail/SBMLHelper.hpp"
 #endif
 
-#include <boost/array.hpp>
 // #include <boost/math/special_functions/next.hpp>
 
 namespace pssalib
@@ -50,7 +51,10 @@ namespace datamodel
     STRING(PSSALIB_FILENAME_FINAL_TIME_POINT_POPULATIONS),
     STRING(PSSALIB_FILENAME_TIME_POINTS),
     STRING(PSSALIB_FILENAME_TIMING),
-    STRING(PSSALIB_FILENAME_SPECIES_IDS)
+    STRING(PSSALIB_FILENAME_SPECIES_IDS),
+    STRING(PSSALIB_FILENAME_BINARY_TRAJECTORY),
+    STRING(PSSALIB_FILENAME_AVERAGE_TRAJECTORY),
+    STRING(PSSALIB_FILENAME_HISTOGRAMS)
   };
 
   /////////////////////////////////
@@ -66,11 +70,13 @@ namespace datamodel
     , m_nBlockSize(0)
     , m_nBlockStart(0)
 #endif
-    , m_ptrOutputLine(NULL)
     , m_ptrRawTrajectory(NULL)
     , m_ptrCurrPopulation(NULL)
+    , m_arTrialTrajectory(NULL)
     , m_unOutputIdx(0)
     , m_unOutputMax(0)
+    , m_osOutput(NULL)
+    , m_bAppendOutput(false)
     , unFlags(0)
 #ifdef DEBUG
     , unOutputFlags(ofError|ofWarning|ofInfo|ofSpeciesIDs|ofStatus|ofLog)
@@ -79,6 +85,16 @@ namespace datamodel
 #endif
     , pArSpeciesIds(NULL)
     , unSamplesTotal(0)
+    , unThreads(1)
+    , eRNGType(rngGSL)
+    , unRNGSeed(0)
+    , unEventTraceSize(1024)
+    , unOutputBuffers(16)
+    , unHistogramBins(256)
+    , unHistogramStates(0)
+    , eVolumeSampling(vsCompositionRejection)
+    , unCheckpointInterval(0)
+    , bResumeEnsemble(false)
     , dTimeCheckpoint(0.0)
     , dTimeStart(0.0)
     , dTimeStep(0.0)
@@ -91,8 +107,8 @@ namespace datamodel
     , ptrarRawPopulations(NULL)
     , bInterruptRequested(false)
   {
-    memset(m_arPtrFileBuffers, 0, 7*sizeof(FILESTREAMBUFFER *));
-    memset(m_arPtrExternalBuffers, 0, 7*sizeof(STREAMBUFFER *));
+    memset(m_arPtrFileBuffers, 0, 10*sizeof(FILESTREAMBUFFER *));
+    memset(m_arPtrExternalBuffers, 0, 10*sizeof(STREAMBUFFER *));
   }
 
   //! Copy constructor
@@ -105,15 +121,30 @@ namespace datamodel
     , m_nBlockSize(right.m_nBlockSize)
     , m_nBlockStart(right.m_nBlockStart)
 #endif
-    , m_ptrOutputLine(right.m_ptrOutputLine)
-    , m_ptrRawTrajectory(right.m_ptrRawTrajectory)
-    , m_ptrCurrPopulation(right.m_ptrCurrPopulation)
+    , m_arSpeciesIdx(right.m_arSpeciesIdx)
+    , m_ptrRawTrajectory(NULL)
+    , m_ptrCurrPopulation(NULL)
+    , m_arTrialTrajectory(NULL)
     , m_unOutputIdx(right.m_unOutputIdx)
     , m_unOutputMax(right.m_unOutputMax)
+    , m_osOutput(NULL)
+    , m_bAppendOutput(false)
     , unFlags(right.unFlags)
     , unOutputFlags(right.unOutputFlags)
-    , pArSpeciesIds(right.pArSpeciesIds)
+    , strOutput(right.strOutput)
+    , pArSpeciesIds((NULL != right.pArSpeciesIds) ?
+        new std::vector<STRING>(*right.pArSpeciesIds) : NULL)
     , unSamplesTotal(right.unSamplesTotal)
+    , unThreads(right.unThreads)
+    , eRNGType(right.eRNGType)
+    , unRNGSeed(right.unRNGSeed)
+    , unEventTraceSize(right.unEventTraceSize)
+    , unOutputBuffers(right.unOutputBuffers)
+    , unHistogramBins(right.unHistogramBins)
+    , unHistogramStates(right.unHistogramStates)
+    , eVolumeSampling(right.eVolumeSampling)
+    , unCheckpointInterval(right.unCheckpointInterval)
+    , bResumeEnsemble(right.bResumeEnsemble)
     , dTimeCheckpoint(right.dTimeCheckpoint)
     , dTimeStart(right.dTimeStart)
     , dTimeStep(right.dTimeStep)
@@ -127,6 +158,8 @@ namespace datamodel
     , bInterruptRequested(right.bInterruptRequested.load())
   {
     setDims(right.m_uDims, right.m_arunDims);
+    // output buffers are owned by each instance, the model is shared
+    m_Model.copy(right.m_Model);
     memset(m_arPtrFileBuffers, 0, SimulationInfo::outputFlagToStreamIndex(ofMaskFile)*sizeof(FILESTREAMBUFFER *));
     memset(m_arPtrExternalBuffers, 0, SimulationInfo::outputFlagToStreamIndex(ofMaskFile)*sizeof(STREAMBUFFER *));
   }
@@ -140,16 +173,18 @@ namespace datamodel
       m_arunDims = NULL;
       m_uDims = 0;
     }
-    if(NULL != m_ptrOutputLine)
-    {
-      delete [] m_ptrOutputLine;
-      m_ptrOutputLine = NULL;
-    }
+    // stop the trajectory writer before the file buffers are freed
+    m_twTrajectory.free();
     if(NULL != m_ptrCurrPopulation)
     {
       delete [] m_ptrCurrPopulation;
       m_ptrCurrPopulation = NULL;
     }
+    if(NULL != m_arTrialTrajectory)
+    {
+      delete [] m_arTrialTrajectory;
+      m_arTrialTrajectory = NULL;
+    }
     if(NULL != pArSpeciesIds)
     {
       delete pArSpeciesIds;
@@ -350,19 +385,59 @@ namespace datamodel
   //! Reset internal output streams
   void SimulationInfo::resetOutput()
   {
-    for(SHORT of = ofMaskLog + 1; (of & ofMaskFile) > 0; of <<= 1 )
+    // output of a failed trial may be pending
+    m_twTrajectory.flush();
+
+    for(UINTEGER of = ofMaskLog + 1; (of & ofMaskFile) > 0; of <<= 1 )
       resetOutputStream((OutputFlags)of);
 
     memset(m_arPtrFileBuffers, 0, outputFlagToStreamIndex(ofMaskFile) * sizeof(FILESTREAMBUFFER *));
   }
 
+  //! Get the path of the file corresponding to an output type
+  bool SimulationInfo::getOutputFilePath(const OutputFlags of, STRING & strFilePath) const
+  {
+    return getOutputFilePath(of, m_unSampleCurrent, strFilePath);
+  }
+
+  //! Get the path of the file corresponding to a given type of output of a sample
+  bool SimulationInfo::getOutputFilePath(const OutputFlags of, UINTEGER sample, STRING & strFilePath) const
+  {
+    if((of <= ofMaskLog)||(of >= ofMaskFile)||strOutput.empty())
+      return false;
+
+    USHORT idx = outputFlagToStreamIndex(of);
+    if(idx >= outputFlagToStreamIndex(ofMaskFile))
+      return false;
+
+    STRING strFileName(arFileNames[idx]);
+    switch(of)
+    {
+    case ofTrajectory:
+    case ofBinaryTrajectory:
+      strFileName = (BOOSTFORMAT(strFileName) %
+        sample).str();
+    break;
+#ifdef HAVE_MPI
+    case ofStatus:
+    case ofLog:
+      strFileName = (BOOSTFORMAT(strFileName) %
+        getMPIWrapperInstance().getRank()).str();
+    break;
+#endif
+    default: // avoid compiler warnings
+    break;
+    }
+
+    util::makeFilePath(strOutput, strFileName, strFilePath);
+    return true;
+  }
+
   //! Get an output stream corresponding for an output type
   OSTREAM & SimulationInfo::getOutputStream(const OutputFlags of)
   {
     // Null stream buffer
     static NULLSTREAMBUFFER nullBuffer;
-    // Output stream
-    static OSTREAM os(&nullBuffer);
 
     STREAMBUFFER * buffer = &nullBuffer;
 
@@ -378,30 +453,21 @@ namespace datamodel
         // file stream buffer not yet allocated
         if(NULL == m_arPtrFileBuffers[idx])
         {
-          STRING strFileName(arFileNames[idx]), strFilePath;
-          switch(of)
-          {
-          case ofTrajectory:
-            strFileName = (BOOSTFORMAT(strFileName) %
-              m_unSampleCurrent).str();
-          break;
-#ifdef HAVE_MPI
-          case ofStatus:
-          case ofLog:
-            strFileName = (BOOSTFORMAT(strFileName) %
-              getMPIWrapperInstance().getRank()).str();
-          break;
-#endif
-          default: // avoid compiler warnings
-          break;
-          }
+          STRING strFilePath;
+          getOutputFilePath(of, strFilePath);
 
-          util::makeFilePath(strOutput, strFileName, strFilePath);
+          // a resumed trial continues its trajectory files
+          std::ios_base::openmode mode = std::ios_base::out;
+          if(m_bAppendOutput&&((ofTrajectory == of)||(ofBinaryTrajectory == of)))
+            mode |= std::ios_base::app;
+          else
+            mode |= std::ios_base::trunc;
+          if(ofBinaryTrajectory == of)
+            mode |= std::ios_base::binary;
 
           m_arPtrFileBuffers[idx] = new FILESTREAMBUFFER();
           if((NULL != m_arPtrFileBuffers[idx])&&
-             (NULL != m_arPtrFileBuffers[idx]->open(strFilePath.c_str(),
-                                                  std::ios_base::out | std::ios_base::trunc)))
+             (NULL != m_arPtrFileBuffers[idx]->open(strFilePath.c_str(), mode)))
           {
             PSSA_INFO(this, << "file '" << strFilePath << "' was successfully created." << std::endl);
             buffer = m_arPtrFileBuffers[idx];
@@ -420,9 +486,9 @@ namespace datamodel
 
     }
 
-    os.rdbuf(buffer);
+    m_osOutput.rdbuf(buffer);
 
-    return os;
+    return m_osOutput;
   }
 
   //! Initialize timing variables
@@ -440,19 +506,11 @@ namespace datamodel
 #endif
   }
 
-  //! Initializes timing variables
-  bool SimulationInfo::beginTrial(UINTEGER sample)
+  //! Allocates the output buffers reused by every trial
+  bool SimulationInfo::setupTrialBuffers()
   {
-    // store sampling info
-    m_unSampleCurrent = sample;
-#ifdef HAVE_MPI
-    PSSA_INFO(this, << "Commencing block sample " << m_unSampleCurrent - m_nBlockStart + 1 << " of " 
-      << m_nBlockSize << " (trial " << m_unSampleCurrent + 1 << " of " << unSamplesTotal << ")" << std::endl);
-#else
-    PSSA_INFO(this, << "Commencing trial " << m_unSampleCurrent + 1 << " of " << unSamplesTotal << std::endl);
-#endif
-    // Allocate memory for output
-    if(isLoggingOn(ofTrajectory)||isLoggingOn(ofRawTrajectory))
+    if(isLoggingOn(ofTrajectory)||isLoggingOn(ofRawTrajectory)||isLoggingOn(ofBinaryTrajectory)||
+       isLoggingOn(ofAvgTrajectory))
     {
       if(NULL != m_ptrCurrPopulation) delete [] m_ptrCurrPopulation;
 
@@ -473,18 +531,78 @@ namespace datamodel
       if(NULL != m_ptrCurrPopulation) delete [] m_ptrCurrPopulation;
       m_ptrCurrPopulation = NULL;
     }
-    if(isLoggingOn(ofTrajectory))
+    if(isLoggingOn(ofTrajectory)||isLoggingOn(ofBinaryTrajectory))
     {
-      if(NULL != m_ptrOutputLine) delete [] m_ptrOutputLine;
+      // external stream buffers may be shared with other outputs
+      UINTEGER unBuffers = unOutputBuffers;
+      if((isLoggingOn(ofTrajectory)&&
+          (NULL != m_arPtrExternalBuffers[outputFlagToStreamIndex(ofTrajectory)]))||
+         (isLoggingOn(ofBinaryTrajectory)&&
+          (NULL != m_arPtrExternalBuffers[outputFlagToStreamIndex(ofBinaryTrajectory)])))
+        unBuffers = 0;
+
+      PSSA_INFO(this, << "Allocating " << unBuffers << " buffers for trajectory output.\n");
+      try
+      {
+        m_twTrajectory.allocate(m_arSpeciesIdx.size() * m_ptrPSSA->ptrData->getSubvolumesCount(),
+          m_ptrPSSA->ptrData->getSubvolumesCount(), isLoggingOn(ofTrajectory), unBuffers);
+      }
+      catch (std::bad_alloc & e)
+      {
+        PSSA_ERROR(this, << "Error: " << e.what() << std::endl);
+        return false;
+      }
 
-      std::size_t sz = (STRING(PSSALIB_TEXTOUTPUT_SUBVOLUMES_DELIMITER).size() +
-                        (STRING(PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER).size() +
-                        boost::lexical_cast<STRING>(std::numeric_limits<UINTEGER>::max()).size()) * 
-                        m_arSpeciesIdx.size()) * m_ptrPSSA->ptrData->getSubvolumesCount();
-      PSSA_INFO(this, << "Allocating " << sz << " bytes for output line buffer.\n");
+      if(m_twTrajectory.isAsync())
+        PSSA_INFO(this, << "trajectories are written by a separate thread.\n");
+    }
+    else
+      m_twTrajectory.free();
+    if(isLoggingOn(ofAvgTrajectory))
+    {
+      UINTEGER unTimePoints = timing::getNumTimePoints(dTimeStart, dTimeEnd, dTimeStep);
+      PSSA_INFO(this, << "Allocating " << unTimePoints << " time points for the ensemble statistics.\n");
+      try
+      {
+        m_esTrajectory.allocate(m_arSpeciesIdx.size() * m_ptrPSSA->ptrData->getSubvolumesCount(),
+          m_ptrPSSA->ptrData->getSubvolumesCount(), unTimePoints);
+      }
+      catch (std::bad_alloc & e)
+      {
+        PSSA_ERROR(this, << "Error: " << e.what() << std::endl);
+        return false;
+      }
+    }
+    else
+      m_esTrajectory.free();
+    if(NULL != m_arTrialTrajectory)
+    {
+      delete [] m_arTrialTrajectory;
+      m_arTrialTrajectory = NULL;
+    }
+    if(bResumeEnsemble&&isLoggingOn(ofAvgTrajectory)&&!isLoggingOn(ofRawTrajectory))
+    {
+      // rows of a trial are recorded along with the sample
+      std::size_t sz = timing::getNumTimePoints(dTimeStart, dTimeEnd, dTimeStep) *
+        m_arSpeciesIdx.size() * m_ptrPSSA->ptrData->getSubvolumesCount();
+      PSSA_INFO(this, << "Allocating " << sz << " values for the trajectory of a trial.\n");
+      try
+      {
+        m_arTrialTrajectory = new UINTEGER[sz];
+      }
+      catch (std::bad_alloc & e)
+      {
+        PSSA_ERROR(this, << "Error: " << e.what() << std::endl);
+        return false;
+      }
+    }
+    if(isLoggingOn(ofHistogram))
+    {
+      PSSA_INFO(this, << "Allocating " << unHistogramBins << " bins for the histograms of final populations.\n");
       try
       {
-        m_ptrOutputLine = new typename STRING::value_type[sz];
+        m_phFinalPops.allocate(m_arSpeciesIdx.size() * m_ptrPSSA->ptrData->getSubvolumesCount(),
+          m_ptrPSSA->ptrData->getSubvolumesCount(), unHistogramBins, unHistogramStates);
       }
       catch (std::bad_alloc & e)
       {
@@ -493,17 +611,105 @@ namespace datamodel
       }
     }
     else
+      m_phFinalPops.free();
+#if PSSALIB_LOG_LEVEL >= PSSALIB_LOG_LEVEL_TRACE
+    if(isLoggingOn(eofEvents))
     {
-      if(NULL != m_ptrOutputLine) delete [] m_ptrOutputLine;
-      m_ptrOutputLine = NULL;
+      PSSA_INFO(this, << "Allocating " << unEventTraceSize << " records for the event trace.\n");
+      try
+      {
+        m_etEvents.allocate(unEventTraceSize);
+      }
+      catch (std::bad_alloc & e)
+      {
+        PSSA_ERROR(this, << "Error: " << e.what() << std::endl);
+        return false;
+      }
     }
+    else
+#endif
+      m_etEvents.free();
+
+    return true;
+  }
+
+  /**
+   * Record the event described by the data model, i.e. reaction @a mu
+   * in subvolume @a nu, before the system state is updated.
+   */
+  void SimulationInfo::traceEvent()
+  {
+    const DataModel * ptrData = getDataModel();
+    const detail::ReactionWrapper & rw = ptrData->getReactionWrapper(ptrData->mu);
+
+    util::EventTrace::EventType type = util::EventTrace::etReaction;
+    if(rw.isDiffusive())
+      type = util::EventTrace::etDiffusion;
+    else if(rw.isSetDelay())
+      type = getDelayedUpdate() ? util::EventTrace::etCompleted : util::EventTrace::etScheduled;
+
+    m_etEvents.record(type, dTimeSimulation, ptrData->dTotalPropensity,
+      ptrData->mu, ptrData->nu, rw.isDiffusive() ? ptrData->nu_D : ptrData->nu);
+  }
+
+  /**
+   * Write the recorded events of the current trial to the log,
+   * the most recent ones are kept if the trace overflowed.
+   */
+  void SimulationInfo::reportEvents()
+  {
+    if(!m_etEvents.isAllocated())
+      return;
+
+    report() << "(TRACE) : last " << m_etEvents.size() << " events of trial #"
+      << m_unSampleCurrent << " (index,type,time,total propensity,mu,nu,nu_D):\n";
+    m_etEvents.write(report(), "(TRACE) : ");
+    report().flush();
+  }
+
+  //! Initializes timing variables
+  bool SimulationInfo::beginTrial(UINTEGER sample)
+  {
+    // store sampling info
+    m_unSampleCurrent = sample;
+#ifdef HAVE_MPI
+    PSSA_INFO(this, << "Commencing block sample " << m_unSampleCurrent - m_nBlockStart + 1 << " of " 
+      << m_nBlockSize << " (trial " << m_unSampleCurrent + 1 << " of " << unSamplesTotal << ")" << std::endl);
+#else
+    PSSA_INFO(this, << "Commencing trial " << m_unSampleCurrent + 1 << " of " << unSamplesTotal << std::endl);
+#endif
     m_unOutputIdx = 0;
     m_unOutputMax = timing::getNumTimePoints(dTimeStart, dTimeEnd, dTimeStep);
+    m_etEvents.clear();
+    m_esTrajectory.begin();
+
+    // output of a failed trial may be pending
+    m_twTrajectory.flush();
 
     if(isLoggingOn(ofRawTrajectory))
       m_ptrRawTrajectory = ptrarRawPopulations + m_unSampleCurrent * m_unOutputMax * m_arSpeciesIdx.size() * m_ptrPSSA->ptrData->getSubvolumesCount();
     else
-      m_ptrRawTrajectory = NULL;
+      m_ptrRawTrajectory = m_arTrialTrajectory;
+
+    if(isLoggingOn(ofBinaryTrajectory))
+    {
+      const DataModel * ptrData = getDataModel();
+      std::vector<STRING> arIds(m_arSpeciesIdx.size());
+      for(UINTEGER i = 0; i < m_arSpeciesIdx.size(); ++i)
+        arIds[i] = ptrData->getSpecies(m_arSpeciesIdx[i])->getId();
+
+      if(!util::BinaryTrajectory::writeHeader(getOutputStream(ofBinaryTrajectory),
+          ptrData->getDimsCount(), ptrData->getDims(), ptrData->getSubvolumesCount(),
+          arIds, m_unOutputMax, dTimeStart, dTimeStep, dTimeEnd))
+      {
+        PSSA_ERROR(this, << "could not write the binary trajectory header of trial #" << m_unSampleCurrent << std::endl);
+        return false;
+      }
+    }
+
+    m_twTrajectory.begin(
+      isLoggingOn(ofTrajectory) ? getOutputStream(ofTrajectory).rdbuf() : NULL,
+      isLoggingOn(ofBinaryTrajectory) ? getOutputStream(ofBinaryTrajectory).rdbuf() : NULL);
 
     // do not include intial time point
     if(m_unOutputMax > 0) --m_unOutputMax;
@@ -561,13 +767,10 @@ namespace datamodel
 #else
     PSSA_INFO(this, << "Concluding trial " << m_unSampleCurrent + 1 << " of " << unSamplesTotal << std::endl);
 #endif
+    if(!m_twTrajectory.flush())
+      PSSA_ERROR(this, << "failed to write the trajectory of trial #" << m_unSampleCurrent << std::endl);
     resetOutputStream(ofTrajectory);
-
-    if(NULL != m_ptrOutputLine)
-    {
-      delete [] m_ptrOutputLine;
-      m_ptrOutputLine = NULL;
-    }
+    resetOutputStream(ofBinaryTrajectory);
 
 #ifdef __linux__
     // Output in seconds
@@ -584,6 +787,127 @@ namespace datamodel
 #endif
   }
 
+  //! Writes the pending output of the trial & gets the sizes of its trajectory files
+  bool SimulationInfo::syncTrial(std::uint64_t & szText, std::uint64_t & szBinary)
+  {
+    szText = szBinary = 0;
+
+    // wait for the writer thread
+    if(!m_twTrajectory.flush())
+      return false;
+
+    const OutputFlags arFlags[] = { ofTrajectory, ofBinaryTrajectory };
+    std::uint64_t * arSizes[] = { &szText, &szBinary };
+    for(UINTEGER i = 0; i < 2; ++i)
+    {
+      FILESTREAMBUFFER * ptrBuffer = m_arPtrFileBuffers[outputFlagToStreamIndex(arFlags[i])];
+      if(!isLoggingOn(arFlags[i])||(NULL == ptrBuffer))
+        continue;
+
+      if(0 != ptrBuffer->pubsync())
+        return false;
+      std::streamoff pos = ptrBuffer->pubseekoff(0, std::ios_base::cur, std::ios_base::out);
+      if(pos < 0)
+        return false;
+      *arSizes[i] = pos;
+    }
+
+    return true;
+  }
+
+  //! Resumes the timing & the output of a trial from a saved state
+  bool SimulationInfo::resumeTrial(UINTEGER sample, UINTEGER outputIdx, REAL timeSimulation,
+                                   REAL timeCheckpoint, std::uint64_t szText, std::uint64_t szBinary)
+  {
+    // store sampling info
+    m_unSampleCurrent = sample;
+    PSSA_INFO(this, << "Resuming trial " << m_unSampleCurrent + 1 << " of " << unSamplesTotal
+      << " at simulation time " << timeSimulation << std::endl);
+
+    m_unOutputMax = timing::getNumTimePoints(dTimeStart, dTimeEnd, dTimeStep);
+    m_etEvents.clear();
+
+    // output of a failed trial may be pending
+    m_twTrajectory.flush();
+
+    // the first output writes the initial time point on top of the cursor
+    UINTEGER unLines = (timeCheckpoint != dTimeStart) ? (outputIdx + 1) : 0;
+    m_esTrajectory.resume(unLines);
+
+    if(isLoggingOn(ofRawTrajectory))
+      m_ptrRawTrajectory = ptrarRawPopulations + (m_unSampleCurrent * m_unOutputMax + unLines) *
+        m_arSpeciesIdx.size() * m_ptrPSSA->ptrData->getSubvolumesCount();
+    else if(NULL != m_arTrialTrajectory)
+      m_ptrRawTrajectory = m_arTrialTrajectory + unLines *
+        m_arSpeciesIdx.size() * m_ptrPSSA->ptrData->getSubvolumesCount();
+    else
+      m_ptrRawTrajectory = NULL;
+
+    // drop the output written after the state was saved
+    const OutputFlags arFlags[] = { ofTrajectory, ofBinaryTrajectory };
+    const std::uint64_t arSizes[] = { szText, szBinary };
+    for(UINTEGER i = 0; i < 2; ++i)
+    {
+      STRING strFilePath;
+      std::uint64_t szFile = 0;
+      if(!isLoggingOn(arFlags[i])||
+         (NULL != m_arPtrExternalBuffers[outputFlagToStreamIndex(arFlags[i])])||
+         !getOutputFilePath(arFlags[i], strFilePath))
+        continue;
+
+      resetOutputStream(arFlags[i]);
+      if(!util::getFileSize(strFilePath, szFile)||(szFile < arSizes[i]))
+      {
+        PSSA_ERROR(this, << "file '" << strFilePath << "' is missing or shorter than "
+          "when the state of trial #" << m_unSampleCurrent << " was saved." << std::endl);
+        return false;
+      }
+      if((szFile > arSizes[i])&&!util::resizeFile(strFilePath, arSizes[i]))
+      {
+        PSSA_ERROR(this, << "could not truncate file '" << strFilePath << "'." << std::endl);
+        return false;
+      }
+    }
+
+    m_bAppendOutput = true;
+    m_twTrajectory.begin(
+      isLoggingOn(ofTrajectory) ? getOutputStream(ofTrajectory).rdbuf() : NULL,
+      isLoggingOn(ofBinaryTrajectory) ? getOutputStream(ofBinaryTrajectory).rdbuf() : NULL);
+    m_bAppendOutput = false;
+
+    // do not include intial time point
+    if(m_unOutputMax > 0) --m_unOutputMax;
+
+    // restore the timing
+    m_unOutputIdx = outputIdx;
+    dTimeSimulation = timeSimulation;
+    dTimeCheckpoint = timeCheckpoint;
+
+#ifdef __linux__
+    clock_gettime(CLOCK_MONOTONIC, &m_trialStart);
+#elif defined(__MACH__)
+    m_trialStart = mach_absolute_time();
+#elif defined(_WIN32)
+    QueryPerformanceCounter(&m_trialStart);
+#endif
+
+    return true;
+  }
+
+  //! Get the trajectory of the current trial, if it is kept in memory
+  const UINTEGER * SimulationInfo::getTrialTrajectory(std::size_t & szValues) const
+  {
+    const UINTEGER * ptrTrajectory = m_arTrialTrajectory;
+    if(isLoggingOn(ofRawTrajectory))
+      ptrTrajectory = ptrarRawPopulations + m_unSampleCurrent * timing::getNumTimePoints(dTimeStart, dTimeEnd, dTimeStep) *
+        m_arSpeciesIdx.size() * m_ptrPSSA->ptrData->getSubvolumesCount();
+
+    // the trial may end before the last time point
+    szValues = ((NULL != ptrTrajectory)&&(NULL != m_ptrRawTrajectory)) ?
+      (m_ptrRawTrajectory - ptrTrajectory) : 0;
+    return ptrTrajectory;
+  }
+
   //! Provides output to file
   void SimulationInfo::doOutput()
   {
@@ -617,12 +941,8 @@ namespace datamodel
       }
     }
 
-    typedef boost::array<STRING::value_type, 32> ConversionBufferType;
-    static ConversionBufferType cBuf;
-    static size_t szSubVolDelim = STRING(PSSALIB_TEXTOUTPUT_SUBVOLUMES_DELIMITER).size(),
-                  szSpeciesDelim = STRING(PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER).size();
-
-    if(isLoggingOn(ofTrajectory)||isLoggingOn(ofRawTrajectory))
+    if(isLoggingOn(ofTrajectory)||isLoggingOn(ofRawTrajectory)||isLoggingOn(ofBinaryTrajectory)||
+       isLoggingOn(ofAvgTrajectory))
     {
 #ifndef PSSALIB_ENGINE_CHECK
       // is it too early to begin the output?
@@ -759,42 +1079,15 @@ PSSA_TRACE(this, << "Total output lines = " << m_unOutputIdx + unTemp << "\n\n\n
       if(unTemp > 0)
       {
 #endif
-        STRING::pointer pCurrOL = m_ptrOutputLine;
         UINTEGER        *pCurrPop = m_ptrCurrPopulation;
         size_t          szPop = m_ptrPSSA->ptrData->getSubvolumesCount()*m_arSpeciesIdx.size();
+        UINTEGER        unLines = 0;
 
-        // Output the population to stream
+        // Copy the population
         for(UINTEGER svi = 0; svi < m_ptrPSSA->ptrData->getSubvolumesCount(); ++svi)
         {
-          if ((NULL != pCurrOL)&&(0 != svi))
-          {
-            strncpy(pCurrOL, PSSALIB_TEXTOUTPUT_SUBVOLUMES_DELIMITER, szSubVolDelim);
-            pCurrOL += szSubVolDelim;
-          }
-
           for(UINTEGER si = 0; si < m_arSpeciesIdx.size(); ++si)
-          {
-            if ((NULL != pCurrOL)&&(0 != si))
-            {
-              strncpy(pCurrOL, PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER, szSpeciesDelim);
-              pCurrOL += szSpeciesDelim;
-            }
-            *pCurrPop = m_ptrPSSA->ptrData->getSubvolume(svi).population(m_arSpeciesIdx[si]);
-            if (NULL != pCurrOL)
-            {
-              cBuf = boost::lexical_cast<ConversionBufferType>(*(pCurrPop++));
-              size_t szSpeciesNum = strlen(cBuf.c_array());
-              strncpy(pCurrOL, cBuf.c_array(), szSpeciesNum);
-              pCurrOL += szSpeciesNum;
-            } else {
-              pCurrPop++;
-            }
-          }
-        }
-        if (NULL != pCurrOL)
-        {
-          *(pCurrOL++) = '\n';
-          *(pCurrOL++) = '\0';
+            *(pCurrPop++) = m_ptrPSSA->ptrData->getSubvolume(svi).population(m_arSpeciesIdx[si]);
         }
 #ifndef PSSALIB_ENGINE_CHECK
         // Output to file
@@ -805,7 +1098,7 @@ PSSA_TRACE(this, << "Total output lines = " << m_unOutputIdx + unTemp << "\n\n\n
 //           dTimeCheckpoint += dTimeStep;
 //           dTemp           -= dTimeStep;
 #endif
-          if(NULL != m_ptrOutputLine) getOutputStream(ofTrajectory) << m_ptrOutputLine;
+          ++unLines;
           if(NULL != m_ptrRawTrajectory)
           {
             memcpy(m_ptrRawTrajectory, m_ptrCurrPopulation, szPop*sizeof(UINTEGER));
@@ -816,6 +1109,14 @@ PSSA_TRACE(this, << "Total output lines = " << m_unOutputIdx + unTemp << "\n\n\n
         if(bFirst) --m_unOutputIdx;
 // std::cout << "m_unOutputIdx = " << m_unOutputIdx << "\n\n";
 //         while(dTemp >= dTimeStep);
+#endif
+        // Format & write the population to the trajectory streams
+        if((unLines > 0)&&(isLoggingOn(ofTrajectory)||isLoggingOn(ofBinaryTrajectory)))
+          m_twTrajectory.write(m_ptrCurrPopulation, unLines);
+        // Accumulate the ensemble statistics
+        if((unLines > 0)&&isLoggingOn(ofAvgTrajectory))
+          m_esTrajectory.add(m_ptrCurrPopulation, unLines);
+#ifndef PSSALIB_ENGINE_CHECK
       }
 #endif
     }
@@ -833,6 +1134,16 @@ PSSA_TRACE(this, << "Total output lines = " << m_unOutputIdx + unTemp << "\n\n\n
     bool bResult = m_ptrPSSA->ptrUpdate->doUpdate(this);
     unFlags &= ~sfDelayedUpdate;
 
+    // Pass the completion on to the reaction events sink
+    if(bResult&&m_ptrPSSA->m_EventStream.isEnabled())
+    {
+#ifdef PSSALIB_ENGINE_CHECK
+      util::AllocationsCountPause pause;
+#endif
+      const DataModel * ptrData = m_ptrPSSA->ptrData;
+      m_ptrPSSA->m_EventStream.push(dTimeSimulation, ptrData->mu, ptrData->nu, ptrData->nu, true);
+    }
+
     return bResult;
   }
 
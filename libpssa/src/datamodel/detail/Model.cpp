@@ -270,7 +270,7 @@ namespace detail
    */
   UINTEGER Model::getSpeciesIndex(const Species * species) const
   {
-    if((species > m_arSpecies)&&(species < (m_arSpecies + m_unSpecies)))
+    if((species >= m_arSpecies)&&(species < (m_arSpecies + m_unSpecies)))
       return species - m_arSpecies;
     else
     {
@@ -319,7 +319,7 @@ namespace detail
           mapUnits.clear();
           mapUnits.insert(SBMLHelper::UNIT_SPEC(LIBSBML_CPP_NAMESPACE::UNIT_KIND_SECOND, timeSpec));
 
-          m_unFlags &= rfDelayed;
+          m_unFlags |= rfDelayed;
           if(!helper.processValue(paValDelay->getValue(), reaction, m_dDelay, mapUnits))
           {
             helper.report(SBMLParserMessage::prtError, paValRev->getLine()) << "could not process delay value.";
@@ -334,7 +334,7 @@ namespace detail
 
           if(!paNonconsuming->isMatchFound())
           {
-            m_unFlags &= rfConsuming;
+            m_unFlags |= rfConsuming;
           }
         }
         else
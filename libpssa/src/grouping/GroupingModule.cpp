@@ -36,6 +36,9 @@ namespace grouping
 
   //! Constructor
   GroupingModule::GroupingModule()
+    : bDataLoaded(false)
+    , bFixedInitialPopulation(false)
+    , ptrRestoredPopulation(NULL)
   {
     // Do nothing
   }
@@ -43,6 +46,8 @@ namespace grouping
   //! Copy constructor
   GroupingModule::GroupingModule(GroupingModule & other)
     : bDataLoaded(other.bDataLoaded)
+    , bFixedInitialPopulation(other.bFixedInitialPopulation)
+    , ptrRestoredPopulation(NULL)
   {
     // Do nothing
   }
@@ -106,23 +111,102 @@ namespace grouping
     return bResult;
   }
 
-  //! Initialize data structures (called before each trial)
-  bool GroupingModule::initialize(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  //! Build static data structures & the initial state (called once per run)
+  bool GroupingModule::compile(pssalib::datamodel::SimulationInfo * ptrSimInfo)
   {
     pssalib::datamodel::DataModel * ptrData = ptrSimInfo->getDataModel();
 
     // clear all data structures
     ptrData->clear();
-    ptrData->vQueuedReactions.clear();
+    ptrData->dqQueuedReactions.clear();
     ptrData->dTotalPropensity = 0.0;
 
-    // setup the initial population
+    // a user-defined initializer may yield a different population in every trial
+    bFixedInitialPopulation = (pssalib::datamodel::detail::IP_UserDefined != ptrSimInfo->eInitialPopulation);
+
+    // allocate the population storage reused by every trial
     if(ptrData->getSpeciesCount() > 0)
     {
-      boost::scoped_array< UINTEGER > arPopulation(new UINTEGER[ptrData->getSubvolumesCount() * ptrData->getSpeciesCount()]);
-      boost::scoped_array< UINTEGER * > arPtrPopulation(new UINTEGER *[ptrData->getSubvolumesCount()]);
+      arPopulation.reset(new UINTEGER[ptrData->getSubvolumesCount() * ptrData->getSpeciesCount()]);
+      arPtrPopulation.reset(new UINTEGER *[ptrData->getSubvolumesCount()]);
       for(UINTEGER svi = 0; svi < ptrData->getSubvolumesCount(); ++svi)
         arPtrPopulation[svi] = arPopulation.get() + svi * ptrData->getSpeciesCount();
+    }
+    else
+    {
+      arPopulation.reset();
+      arPtrPopulation.reset();
+    }
+
+    // size the subvolume bins or firing times, trials only reset them
+    if((0 != ptrData->getDimsCount())&&
+       (pssalib::datamodel::SimulationInfo::vsNextSubvolume == ptrSimInfo->eVolumeSampling))
+      ptrData->ftVolumes.allocate(ptrData->getSubvolumesCount());
+    else
+      ptrData->crsdVolume.bins.resize(ptrData->getSubvolumesCount());
+
+    return setupPopulation(ptrSimInfo);
+  }
+
+  //! Reset data structures (called before each trial)
+  bool GroupingModule::initialize(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    pssalib::datamodel::DataModel * ptrData = ptrSimInfo->getDataModel();
+
+    ptrData->dqQueuedReactions.clear();
+    // subvolume firing times are drawn by the sampling module
+    ptrData->bVolumesScheduled = false;
+
+    // bulk copy the initial state
+    if(bFixedInitialPopulation)
+    {
+      ptrData->restoreInitialState();
+      return true;
+    }
+
+    // propensities are recomputed by the derived classes
+    ptrData->dTotalPropensity = 0.0;
+    return setupPopulation(ptrSimInfo);
+  }
+
+  /**
+   * Rebuild the data structures of a trial for a given population, e.g. when
+   * the trial is restored from a checkpoint. The population is set up in place
+   * of the initial one & the propensities are recomputed the same way as for
+   * a user-defined initial population, so that the method-specific structures
+   * do not need to be saved. Firing times are drawn anew by the sampling module.
+   *
+   * @param ptrSimInfo Simulation information object
+   * @param arPop Population of all species in all subvolumes
+   * @return @true on success, @false otherwise.
+   */
+  bool GroupingModule::restore(pssalib::datamodel::SimulationInfo * ptrSimInfo, const UINTEGER * arPop)
+  {
+    const bool bFixed = bFixedInitialPopulation;
+    bFixedInitialPopulation = false;
+    ptrRestoredPopulation = arPop;
+
+    bool bResult = initialize(ptrSimInfo);
+
+    ptrRestoredPopulation = NULL;
+    bFixedInitialPopulation = bFixed;
+
+    return bResult;
+  }
+
+  //! Setup the initial population
+  bool GroupingModule::setupPopulation(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    pssalib::datamodel::DataModel * ptrData = ptrSimInfo->getDataModel();
+
+    if((ptrData->getSpeciesCount() > 0)&&(NULL != ptrRestoredPopulation))
+    {
+      memcpy(arPopulation.get(), ptrRestoredPopulation,
+        sizeof(UINTEGER) * ptrData->getSubvolumesCount() * ptrData->getSpeciesCount());
+      ptrData->setupPopulation(arPtrPopulation.get());
+    }
+    else if(ptrData->getSpeciesCount() > 0)
+    {
       memset(arPopulation.get(), 0, sizeof(UINTEGER) * ptrData->getSubvolumesCount() * ptrData->getSpeciesCount());
 
       switch(ptrSimInfo->eInitialPopulation)
@@ -191,16 +275,20 @@ namespace grouping
   {
     pssalib::datamodel::DataModel * ptrData = ptrSimInfo->getDataModel();
 
+    // the Next Subvolume Method does not use the bins
+    if(0 != ptrData->ftVolumes.size())
+      return;
+
     ptrData->crsdVolume.bins.resize(ptrData->getSubvolumesCount());
     // Distribute the subvolume propensities into the bins.
     for(UINTEGER svi = 0; svi < ptrData->getSubvolumesCount(); ++svi)
     {
       const pssalib::datamodel::detail::Subvolume & sv = ptrData->getSubvolume(svi);
-      UINTEGER k = (UINTEGER)std::floor(fabs(LOG2(sv.dTotalPropensity /
+      UINTEGER k = (UINTEGER)std::floor(fabs(LOG2(sv.totalPropensity() /
                                                  ptrData->crsdVolume.minValue))) + 1;
       PSSA_TRACE(ptrSimInfo, << "Subvol #" << svi << " : tot_prop="
-        << sv.dTotalPropensity << "; k=" << k << std::endl);
-      ptrData->crsdVolume.updateValue(k, svi, sv.dTotalPropensity);
+        << sv.totalPropensity() << "; k=" << k << std::endl);
+      ptrData->crsdVolume.updateValue(k, svi, sv.totalPropensity());
     }
   }
 
@@ -17,8 +17,6 @@
 #include "../../include/datamodel/DataModel_DM.h"
 #include "../../include/grouping/GroupingModule_DM.h"
 
-#include "../../include/util/Combinations.h"
-
 namespace pssalib
 {
 namespace grouping
@@ -48,11 +46,11 @@ namespace grouping
   ////////////////////////////////
   // Methods
 
-  //! Initialize data structures (called before each trial)
-  bool GroupingModule_DM::initialize(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  //! Calculate propensities & the initial state (called once per run)
+  bool GroupingModule_DM::compile(pssalib::datamodel::SimulationInfo * ptrSimInfo)
   {
     // Call the baseclass method
-    if(!GroupingModule::initialize(ptrSimInfo))
+    if(!GroupingModule::compile(ptrSimInfo))
       return false;
 
     // Cast the data model to a suitable type
@@ -60,50 +58,101 @@ namespace grouping
       static_cast<pssalib::datamodel::DataModel_DM * >
         (ptrSimInfo->getDataModel());
 
-    for(UINTEGER svi = 0; svi < ptrDMData->getSubvolumesCount(); ++svi)
+    // Build the dependency graph
+    if(ptrDMData->getSpeciesCount() > 0)
     {
-      pssalib::datamodel::detail::Subvolume_DM & DMSubVol = ptrDMData->getSubvolume(svi);
-
-      DMSubVol.dTotalPropensity = 0.0;
+      UINTEGER l = ptrDMData->getReactionWrappersCount() / ptrDMData->getSpeciesCount();
+      ptrDMData->arDependencies.reserve(ptrDMData->getSpeciesCount(), l);
 
-      // Fill the propensities array
-      // Normal reactions
-      for(UINTEGER rwi = 0; rwi < ptrDMData->getReactionWrappersCount(); rwi++)
+      for(UINTEGER rwi = 0; rwi < ptrDMData->getReactionWrappersCount(); ++rwi)
       {
         pssalib::datamodel::detail::ReactionWrapper & rw = ptrDMData->getReactionWrapper(rwi);
 
-        DMSubVol.propensity(rwi) = 0.0;
-
-        // compute reaction propensity
-        REAL temp = rw.getRate();
         if(rw.isDiffusive())
-        {
-          const pssalib::datamodel::detail::Species * sp = rw.getSpecies();
-          temp *= (REAL)DMSubVol.population(sp->getIndex()) * 2.0 * (REAL)ptrDMData->getDimsCount();
-        }
+          ptrDMData->arDependencies.push_back(rw.getSpecies()->getIndex(), rwi);
         else
         {
           for(UINTEGER ri = 0; ri < rw.getReactantsCount(); ++ri)
           {
             const pssalib::datamodel::detail::SpeciesReference * sr = rw.getReactantsListAt(ri);
-            if(!sr->isReservoir())
-              temp *= pssalib::util::getPartialCombinationsHeteroreactions(DMSubVol.population(sr->getIndex()), sr->getStoichiometryAbs());
+            if(sr->isReservoir())
+              continue;
+
+            // skip repeated references to the same species : reactions are
+            // visited in ascending order, hence every row of the dependency
+            // graph is sorted & a repeat can only match the last entry
+            UINTEGER si = sr->getIndex(), unDeps = ptrDMData->arDependencies.get_cols(si);
+            if(unDeps > 0)
+            {
+              const UINTEGER rwiLast = ptrDMData->arDependencies(si, unDeps - 1);
+              if(rwi == rwiLast)
+                continue;
+#ifndef PSSALIB_NO_BOUNDS_CHECKS
+              else if(rwi < rwiLast)
+                throw std::runtime_error("GroupingModule_DM::compile() - dependency graph rows must be sorted.");
+#endif
+            }
+
+            ptrDMData->arDependencies.push_back(si, rwi);
           }
         }
+      }
+
+      PSSA_TRACE(ptrSimInfo, << "Dependency graph ready.\narDependencies : \n" << ptrDMData->arDependencies << std::endl);
+    }
+
+    computePropensities(ptrSimInfo);
+
+    ptrSimInfo->getDataModel()->storeInitialState();
+
+    return true;
+  }
+
+  //! Reset propensities (called before each trial)
+  bool GroupingModule_DM::initialize(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    // Call the baseclass method
+    if(!GroupingModule::initialize(ptrSimInfo))
+      return false;
+
+    if(!bFixedInitialPopulation)
+      computePropensities(ptrSimInfo);
+
+    return true;
+  }
+
+  //! Calculate propensities from the current population
+  void GroupingModule_DM::computePropensities(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    // Cast the data model to a suitable type
+    pssalib::datamodel::DataModel_DM* ptrDMData = 
+      static_cast<pssalib::datamodel::DataModel_DM * >
+        (ptrSimInfo->getDataModel());
+
+    ptrDMData->dTotalPropensity = 0.0;
+
+    for(UINTEGER svi = 0; svi < ptrDMData->getSubvolumesCount(); ++svi)
+    {
+      pssalib::datamodel::detail::Subvolume_DM & DMSubVol = ptrDMData->getSubvolume(svi);
+
+      // Fill the propensities array
+      // Normal reactions
+      for(UINTEGER rwi = 0; rwi < ptrDMData->getReactionWrappersCount(); rwi++)
+      {
+        // compute reaction propensity
+        REAL temp = ptrDMData->computePropensity(rwi, DMSubVol);
 
         // store propensity on the subvolume scale
         DMSubVol.propensity(rwi) = temp;
         PSSA_TRACE(ptrSimInfo, << "propensity_" << rwi << " = " << temp  << "; from array = " << DMSubVol.propensity(rwi) << std::endl);
-        DMSubVol.dTotalPropensity += temp;
       }
+      DMSubVol.sumPropensities();
 
-      PSSA_TRACE(ptrSimInfo, << "totalPropensity=" << DMSubVol.dTotalPropensity << std::endl);
+      PSSA_TRACE(ptrSimInfo, << "totalPropensity=" << DMSubVol.totalPropensity() << std::endl);
 
       // update global structures
-      ptrDMData->dTotalPropensity += DMSubVol.dTotalPropensity;
+      ptrDMData->dTotalPropensity += DMSubVol.totalPropensity();
     }
-
-    return true;
   }
 }
 }
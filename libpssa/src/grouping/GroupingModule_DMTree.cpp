@@ -0,0 +1,71 @@
+/**
+ * @file GroupingModule_DMTree.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ * 
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Grouping module implementation for the Direct Method with a sum tree
+ */
+
+#include "../../include/datamodel/DataModel_DMTree.h"
+#include "../../include/grouping/GroupingModule_DMTree.h"
+
+namespace pssalib
+{
+namespace grouping
+{
+  ////////////////////////////////
+  // Constructors
+
+  //! Default constructor
+  GroupingModule_DMTree::GroupingModule_DMTree()
+  {
+    // Do nothing
+  }
+
+  //! Copy constructor
+  GroupingModule_DMTree::GroupingModule_DMTree(GroupingModule &g)
+    : GroupingModule_DM(g)
+  {
+    // Do nothing
+  }
+
+  //! Destructor
+  GroupingModule_DMTree::~GroupingModule_DMTree()
+  {
+    // Do nothing
+  }
+
+  ////////////////////////////////
+  // Methods
+
+  //! Calculate propensities from the current population & build the sum trees
+  void GroupingModule_DMTree::computePropensities(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    // Call the baseclass method
+    GroupingModule_DM::computePropensities(ptrSimInfo);
+
+    // Cast the data model to a suitable type
+    pssalib::datamodel::DataModel_DMTree* ptrDMTreeData = 
+      static_cast<pssalib::datamodel::DataModel_DMTree * >
+        (ptrSimInfo->getDataModel());
+
+    // Subvolume totals are taken from the tree roots
+    ptrDMTreeData->dTotalPropensity = 0.0;
+    for(UINTEGER svi = 0; svi < ptrDMTreeData->getSubvolumesCount(); ++svi)
+    {
+      pssalib::datamodel::detail::Subvolume_DMTree & DMTreeSubVol = ptrDMTreeData->getSubvolume(svi);
+
+      DMTreeSubVol.buildTree(ptrDMTreeData->getReactionWrappersCount());
+      ptrDMTreeData->dTotalPropensity += DMTreeSubVol.totalPropensity();
+    }
+  }
+}
+}
@@ -0,0 +1,89 @@
+/**
+ * @file GroupingModule_NRM.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ * 
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Grouping module implementation for the Next Reaction Method
+ */
+
+#include "../../include/datamodel/DataModel_NRM.h"
+#include "../../include/grouping/GroupingModule_NRM.h"
+
+namespace pssalib
+{
+namespace grouping
+{
+  ////////////////////////////////
+  // Constructors
+
+  //! Default constructor
+  GroupingModule_NRM::GroupingModule_NRM()
+  {
+    // Do nothing
+  }
+
+  //! Copy constructor
+  GroupingModule_NRM::GroupingModule_NRM(GroupingModule &g)
+    : GroupingModule_DM(g)
+  {
+    // Do nothing
+  }
+
+  //! Destructor
+  GroupingModule_NRM::~GroupingModule_NRM()
+  {
+    // Do nothing
+  }
+
+  ////////////////////////////////
+  // Methods
+
+  //! Calculate propensities & allocate the firing times (called once per run)
+  bool GroupingModule_NRM::compile(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    // Call the baseclass method
+    if(!GroupingModule_DM::compile(ptrSimInfo))
+      return false;
+
+    // Cast the data model to a suitable type
+    pssalib::datamodel::DataModel_NRM* ptrNRMData = 
+      static_cast<pssalib::datamodel::DataModel_NRM * >
+        (ptrSimInfo->getDataModel());
+
+    ptrNRMData->ftReactions.allocate(ptrNRMData->getSubvolumesCount() * ptrNRMData->getReactionWrappersCount());
+
+    // subvolumes are not sampled separately
+    if(0 != ptrNRMData->ftVolumes.size())
+    {
+      PSSA_INFO(ptrSimInfo, << "the Next Reaction Method schedules all reaction channels, "
+        "ignoring the Next Subvolume Method.\n");
+      ptrNRMData->ftVolumes.free();
+      ptrNRMData->crsdVolume.bins.resize(ptrNRMData->getSubvolumesCount());
+    }
+
+    return true;
+  }
+
+  //! Reset propensities & firing times (called before each trial)
+  bool GroupingModule_NRM::initialize(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    // Call the baseclass method
+    if(!GroupingModule_DM::initialize(ptrSimInfo))
+      return false;
+
+    // Firing times are drawn by the sampling module
+    static_cast<pssalib::datamodel::DataModel_NRM * >
+      (ptrSimInfo->getDataModel())->bScheduled = false;
+
+    return true;
+  }
+}
+}
@@ -49,11 +49,11 @@ namespace grouping
   ////////////////////////////////
   // Methods
 
-  //! Initialize data structures (called before each trial)
-  bool GroupingModule_PDM::initialize(pssalib::datamodel::SimulationInfo *ptrSimInfo)
+  //! Build the partial propensity structures (called once per run)
+  bool GroupingModule_PDM::compile(pssalib::datamodel::SimulationInfo *ptrSimInfo)
   {
     // Call the baseclass method
-    if(!GroupingModule::initialize(ptrSimInfo))
+    if(!GroupingModule::compile(ptrSimInfo))
       return false;
 
     // Cast the data model to a suitable type
@@ -117,8 +117,10 @@ namespace grouping
     // Preallocate memory
     UINTEGER l = ptrPDMData->getReactionsCount() / ptrPDMData->getSpeciesCount();
     if(0 == l) l = 1;
-    ptrPDMData->arU3.reserve(ptrPDMData->getSpeciesCount() + 1, l);
-    ptrPDMData->aruL.reserve(ptrPDMData->getSpeciesCount() + 1, l);
+    pssalib::datamodel::detail::JaggedMatrix<pssalib::datamodel::DataModel_PDM::PropensityIndex> arU3;
+    arU3.reserve(ptrPDMData->getSpeciesCount() + 1, l);
+    pssalib::datamodel::detail::JaggedMatrix<pssalib::datamodel::detail::ReactionWrapper *> aruL;
+    aruL.reserve(ptrPDMData->getSpeciesCount() + 1, l);
 
     pssalib::datamodel::detail::JaggedMatrix<UINTEGER> aruLL;
     aruLL.reserve(ptrPDMData->getSpeciesCount() + 1, l);
@@ -126,8 +128,6 @@ namespace grouping
     ///////////////////////////////////////////////////////
     // Initialize PDM data structures
     pssalib::datamodel::DataModel_PDM::PropensityIndex idxPi;
-    boost::scoped_array<REAL> partialPropensity(
-      new REAL[ptrPDMData->getSubvolumesCount()]);
 
     // fill in the mapping data structures
     for(UINTEGER rwi = 0; rwi < ptrPDMData->getReactionWrappersCount(); ++rwi)
@@ -139,18 +139,11 @@ namespace grouping
 
       PSSA_TRACE(ptrSimInfo, << "= reaction : " << rw.toString() << std::endl);
 
-      // specific probability rate
-      std::fill_n(partialPropensity.get(), ptrPDMData->getSubvolumesCount(), rw.getRate());
-
       bool selfDep = false;
       if(rw.isDiffusive())
       {
         idxPi.i = rw.getSpecies()->getIndex() + 1;
 
-        // compute partial propensities
-        for(UINTEGER svi = 0; svi < ptrPDMData->getSubvolumesCount(); ++svi)
-          partialPropensity[svi] *= 2.0 * (REAL)ptrPDMData->getDimsCount();
-
 //         PSSA_TRACE(ptrSimInfo, << "== diffusion assigned to species #" << idxPi.i
 //           << " : D=" << rw.getSpecies()->getDiffusionConstant() << std::endl);
       }
@@ -169,19 +162,15 @@ namespace grouping
             PSSA_TRACE(ptrSimInfo, << "== swapping species in reaction #" << rwi << std::endl);
           }
 
-          // compute partial propensities
-          for(UINTEGER svi = 0; svi < ptrPDMData->getSubvolumesCount(); ++svi)
-            partialPropensity[svi] *= pssalib::util::getPartialCombinationsHeteroreactions(ptrPDMData->getSubvolume(svi).population(sr1->getIndex()), sr1->getStoichiometryAbs());
-
           // row index in PI for this reaction
           idxPi.i = sr2->getIndex() + 1;
           // column index in PI for this reaction
-          idxPi.j = ptrPDMData->aruL.get_cols(idxPi.i);
+          idxPi.j = aruL.get_cols(idxPi.i);
           // dependent species stoichiometry
           idxPi.stoichiometry = sr1->getStoichiometryAbs();
 
           // store dependency
-          ptrPDMData->arU3.push_back(sr1->getIndex() + 1, idxPi);
+          arU3.push_back(sr1->getIndex() + 1, idxPi);
         }
         else // involves a single species
         {
@@ -194,77 +183,121 @@ namespace grouping
             // row index in PI for this reaction
             idxPi.i = sr1->getIndex() + 1;
 
-            // compute partial propensities
-            for(UINTEGER svi = 0; svi < ptrPDMData->getSubvolumesCount(); ++svi)
-              partialPropensity[svi] *= pssalib::util::getPartialCombinationsHomoreactions(ptrPDMData->getSubvolume(svi).population(sr1->getIndex()), sr1->getStoichiometryAbs());
-
             // Account for self dependency
             if(sr1->getStoichiometryAbs() > 1)
             {
               selfDep = true;
               // column index in PI for this reaction
-              idxPi.j = ptrPDMData->aruL.get_cols(idxPi.i);
+              idxPi.j = aruL.get_cols(idxPi.i);
               // dependent species stoichiometry
               idxPi.stoichiometry = sr1->getStoichiometryAbs();
 
-              ptrPDMData->arU3.push_back(idxPi.i, idxPi);
+              arU3.push_back(idxPi.i, idxPi);
             }
           }
         }
       }
 
-      PSSA_TRACE(ptrSimInfo, << "== " << ((rw.getReactantsCount() > 0) ? (((selfDep)||(rw.getReactantsCount() > 1)) ? "bimolecular" : "unimolecular") : "diffusion") << ((idxPi.i > 0) ? " assigned to species #" : " assigned to reservoir species ") << ((idxPi.i > 0) ? idxPi.i-1 : 0) << " with partial propensity = " << partialPropensity[0] << std::endl);
+      PSSA_TRACE(ptrSimInfo, << "== " << ((rw.getReactantsCount() > 0) ? (((selfDep)||(rw.getReactantsCount() > 1)) ? "bimolecular" : "unimolecular") : "diffusion") << ((idxPi.i > 0) ? " assigned to species #" : " assigned to reservoir species ") << ((idxPi.i > 0) ? idxPi.i-1 : 0) << std::endl);
 
       // position in PI --> reaction number
       pssalib::datamodel::detail::ReactionWrapper * ptrRW = &ptrPDMData->getReactionWrapper(rwi);
-      ptrPDMData->aruL.push_back(idxPi.i, ptrRW);
+      aruL.push_back(idxPi.i, ptrRW);
       UINTEGER rwi1 = rwi + 1;
       aruLL.push_back(idxPi.i, rwi1);
-
-      // assign partial propensities
-      for(UINTEGER svi = 0; svi < ptrPDMData->getSubvolumesCount(); ++svi)
-      {
-        ptrPDMData->getSubvolume(svi).arPi.push_back(idxPi.i, partialPropensity[svi]);
-        ptrPDMData->getSubvolume(svi).lambda(idxPi.i) += partialPropensity[svi];
-      }
     }
 
-    PSSA_TRACE(ptrSimInfo, << "Mapping variables ready.\naruL : " << aruLL << "\narU3 : \n" << ptrPDMData->arU3 << "\nSample arPi : \n" << ptrPDMData->getSubvolume(0).arPi << std::endl);
+    // the shape is final, store the mapping in contiguous arrays
+    // and allocate the partial propensities of all subvolumes
+    ptrPDMData->freeze(arU3, aruL);
+
+    PSSA_TRACE(ptrSimInfo, << "Mapping variables ready.\naruL : " << aruLL << "\narU3 : \n" << ptrPDMData->arU3 << std::endl);
+
+    computePropensities(ptrSimInfo);
+
+    ptrPDMData->storeInitialState();
+
+    return true;
+  }
+
+  //! Reset partial propensities (called before each trial)
+  bool GroupingModule_PDM::initialize(pssalib::datamodel::SimulationInfo *ptrSimInfo)
+  {
+    // Call the baseclass method
+    if(!GroupingModule::initialize(ptrSimInfo))
+      return false;
+
+    if(!bFixedInitialPopulation)
+      computePropensities(ptrSimInfo);
+
+    return true;
+  }
+
+  //! Calculate partial propensities from the current population
+  void GroupingModule_PDM::computePropensities(pssalib::datamodel::SimulationInfo *ptrSimInfo)
+  {
+    // Cast the data model to a suitable type
+    pssalib::datamodel::DataModel_PDM* ptrPDMData = 
+      static_cast<pssalib::datamodel::DataModel_PDM*>
+        (ptrSimInfo->getDataModel());
 
     ptrPDMData->dTotalPropensity = 0.0;
     for(UINTEGER svi = 0; svi < ptrPDMData->getSubvolumesCount(); ++svi)
     {
-      ptrPDMData->getSubvolume(svi).dTotalPropensity = 0.0;
+      pssalib::datamodel::detail::Subvolume_PDM & PDMSubVol = ptrPDMData->getSubvolume(svi);
+
+      PDMSubVol.totalPropensity() = 0.0;
       for(UINTEGER si = 0; si < ptrPDMData->getSpeciesCount() + 1; ++si)
       {
+        PDMSubVol.lambda(si) = 0.0;
+        for(UINTEGER sj = 0; sj < ptrPDMData->aruL.get_cols(si); ++sj)
+        {
+          const pssalib::datamodel::detail::ReactionWrapper * rw = ptrPDMData->aruL(si, sj);
+
+          // specific probability rate
+          REAL temp = rw->getRate();
+          if(rw->isDiffusive())
+            temp *= 2.0 * (REAL)ptrPDMData->getDimsCount();
+          else
+          {
+            const pssalib::datamodel::detail::SpeciesReference * sr1 = rw->getReactantsListAt(0);
+            if(rw->getReactantsCount() > 1)
+              temp *= pssalib::util::getPartialCombinationsHeteroreactions(PDMSubVol.population(sr1->getIndex()), sr1->getStoichiometryAbs());
+            else if(!sr1->isReservoir())
+              temp *= pssalib::util::getPartialCombinationsHomoreactions(PDMSubVol.population(sr1->getIndex()), sr1->getStoichiometryAbs());
+          }
+
+          PDMSubVol.arPi(si, sj) = temp;
+          PDMSubVol.lambda(si) += temp;
+        }
+
         if(0 == si) // reservoir species
         {
-          ptrPDMData->getSubvolume(svi).sigma(si) = ptrPDMData->getSubvolume(svi).lambda(si);
+          PDMSubVol.sigma(si) = PDMSubVol.lambda(si);
 
           PSSA_TRACE(ptrSimInfo, << "== Reservoir species : Lambda  = "
-            << ptrPDMData->getSubvolume(svi).lambda(si) << "; Sigma = "
-            << ptrPDMData->getSubvolume(svi).sigma(si) << std::endl);
+            << PDMSubVol.lambda(si) << "; Sigma = "
+            << PDMSubVol.sigma(si) << std::endl);
         }
         else
         {
-          ptrPDMData->getSubvolume(svi).sigma(si) = ptrPDMData->getSubvolume(svi).population(si-1) * ptrPDMData->getSubvolume(svi).lambda(si);
+          PDMSubVol.sigma(si) = PDMSubVol.population(si-1) * PDMSubVol.lambda(si);
 
           PSSA_TRACE(ptrSimInfo, << "== Species #" << si-1 << " '" 
             << ptrPDMData->getSpecies(si-1)->toString() << "' : Lambda  = "
-            << ptrPDMData->getSubvolume(svi).lambda(si) << "; Sigma = "
-            << ptrPDMData->getSubvolume(svi).sigma(si) << std::endl);
+            << PDMSubVol.lambda(si) << "; Sigma = "
+            << PDMSubVol.sigma(si) << std::endl);
         }
 
-        ptrPDMData->getSubvolume(svi).dTotalPropensity += ptrPDMData->getSubvolume(svi).sigma(si);
+        PDMSubVol.totalPropensity() += PDMSubVol.sigma(si);
       }
       PSSA_TRACE(ptrSimInfo, << "= total propensity = " 
-        << ptrPDMData->getSubvolume(svi).dTotalPropensity << std::endl);
-      ptrPDMData->dTotalPropensity += ptrPDMData->getSubvolume(svi).dTotalPropensity;
+        << PDMSubVol.totalPropensity() << std::endl);
+      ptrPDMData->dTotalPropensity += PDMSubVol.totalPropensity();
     }
 
+    PSSA_TRACE(ptrSimInfo, << "Sample arPi : \n" << ptrPDMData->getSubvolume(0).arPi << std::endl);
     PSSA_TRACE(ptrSimInfo, << "global total propensity = " << ptrPDMData->dTotalPropensity << std::endl);
-
-    return true;
   }
 
 }  } // close namespaces pssalib and grouping
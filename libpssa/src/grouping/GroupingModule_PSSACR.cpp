@@ -51,11 +51,11 @@ namespace grouping
   ////////////////////////////////
   // Methods
 
-  //! Initialize data structures (called before each trial)
-  bool GroupingModule_PSSACR::initialize(pssalib::datamodel::SimulationInfo *ptrSimInfo)
+  //! Calculate minimal partial propensities (called once per run)
+  bool GroupingModule_PSSACR::compile(pssalib::datamodel::SimulationInfo *ptrSimInfo)
   {
     // Call the base class method
-    if(!GroupingModule_PDM::initialize(ptrSimInfo))
+    if(!GroupingModule_PDM::compile(ptrSimInfo))
       return false;
 
     // Cast the data model to a suitable type
@@ -84,15 +84,21 @@ namespace grouping
         pssalib::datamodel::detail::ReactionWrapper * rw = ptrPSRDCRData->aruL(si,sj);
         
         REAL temp = rw->getRate();
-        const pssalib::datamodel::detail::SpeciesReference * sr = rw->getReactantsListAt(0);
-        const UINTEGER adjusted_index = sr->getIndex() + 1;
-        if(adjusted_index == si)
-        {
-          temp *= pssalib::util::getPartialCombinationsHomoreactions(sr->getStoichiometryAbs(), sr->getStoichiometryAbs());
-        }
-        else
+        // diffusion is a unimolecular reaction of species si
+        UINTEGER unSelfStoichiometry = 1;
+        if(!rw->isDiffusive())
         {
-          temp *= pssalib::util::getPartialCombinationsHeteroreactions(sr->getStoichiometryAbs(), sr->getStoichiometryAbs());
+          const pssalib::datamodel::detail::SpeciesReference * sr = rw->getReactantsListAt(0);
+          if(sr->getIndex() + 1 == si)
+          {
+            temp *= pssalib::util::getPartialCombinationsHomoreactions(sr->getStoichiometryAbs(), sr->getStoichiometryAbs());
+            unSelfStoichiometry = sr->getStoichiometryAbs();
+          }
+          else
+          {
+            temp *= pssalib::util::getPartialCombinationsHeteroreactions(sr->getStoichiometryAbs(), sr->getStoichiometryAbs());
+            unSelfStoichiometry = 0;
+          }
         }
 
         if(minPi[si] > temp)
@@ -102,8 +108,8 @@ namespace grouping
         {
           bSetSigma = true;
 
-          if((adjusted_index == si)&&(sr->getStoichiometryAbs() > 0))
-            temp *= (REAL)sr->getStoichiometryAbs();
+          if(unSelfStoichiometry > 0)
+            temp *= (REAL)unSelfStoichiometry;
 
           if(minSigma > temp)
             minSigma = temp;
@@ -113,20 +119,40 @@ namespace grouping
     
     if(!bSetSigma) minSigma = 0.0;
 
+    for(UINTEGER svi = 0; svi < ptrPSRDCRData->getSubvolumesCount(); ++svi)
+    {
+      pssalib::datamodel::detail::Subvolume_PSSACR & PSSACRSubVol = ptrPSRDCRData->getSubvolume(svi);
+
+      PSSACRSubVol.crsdSigma.minValue = minSigma;
+      for(UINTEGER si = 0; si < ptrPSRDCRData->getSpeciesCount() + 1; ++si)
+        PSSACRSubVol.crsdPi(si).minValue = minPi[si];
+    }
+
+    return true;
+  }
+
+  //! Distribute partial propensities into bins (called before each trial)
+  bool GroupingModule_PSSACR::initialize(pssalib::datamodel::SimulationInfo *ptrSimInfo)
+  {
+    // Call the base class method
+    if(!GroupingModule_PDM::initialize(ptrSimInfo))
+      return false;
+
+    // Cast the data model to a suitable type
+    pssalib::datamodel::DataModel_PSSACR* ptrPSRDCRData = 
+      static_cast<pssalib::datamodel::DataModel_PSSACR *>
+        (ptrSimInfo->getDataModel());
+
     ////////////////////////////////////////////////
     // Compute distribution
     for(UINTEGER svi = 0; svi < ptrPSRDCRData->getSubvolumesCount(); ++svi)
     {
       pssalib::datamodel::detail::Subvolume_PSSACR & PSSACRSubVol = ptrPSRDCRData->getSubvolume(svi);
-      
-      PSSACRSubVol.crsdSigma.minValue = minSigma;
-      PSSACRSubVol.crsdSigma.bins.clear();
+
       PSSACRSubVol.crsdSigma.bins.resize(ptrPSRDCRData->getSpeciesCount() + 1);
 
       for(UINTEGER si = 0, unPi, k; si < ptrPSRDCRData->getSpeciesCount() + 1; ++si)
       {
-        PSSACRSubVol.crsdPi(si).minValue = minPi[si];
-        
         // Sigma's
         if(0 != PSSACRSubVol.sigma(si))
         {
@@ -47,6 +47,25 @@ namespace grouping
   ////////////////////////////////
   // Methods
 
+  //! Build static data structures & size the indexing (called once per run)
+  bool GroupingModule_SPDM::compile(pssalib::datamodel::SimulationInfo *ptrSimInfo)
+  {
+    // Call the baseclass method
+    if(!GroupingModule_PDM::compile(ptrSimInfo))
+      return false;
+
+    // Cast the data model to a suitable type
+    pssalib::datamodel::DataModel_SPDM * ptrSPDMData = 
+      static_cast<pssalib::datamodel::DataModel_SPDM *>
+        (ptrSimInfo->getDataModel());
+
+    // Allocate the indexing once, trials only reset it
+    for(UINTEGER svi = 0; svi < ptrSPDMData->getSubvolumesCount(); ++svi)
+      ptrSPDMData->getSubvolume(svi).resetIndexing();
+
+    return true;
+  }
+
   //! Initialize data structures (called before each trial)
   bool GroupingModule_SPDM::initialize(pssalib::datamodel::SimulationInfo *ptrSimInfo)
   {
@@ -22,45 +22,44 @@ namespace pssalib
 namespace sampling
 {
   bool CompositionRejectionSampler::Sample(const pssalib::datamodel::CompositionRejectionSamplerData * ptrData, 
-                                           gsl_rng* ptrRNG, const REAL scale, UINTEGER& outI, REAL& outR)
+                                           gsl_rng* ptrRNG, UINTEGER& outI, REAL& outR)
   {
+    const pssalib::datamodel::PSSACR_Bins & bins = ptrData->bins;
+
+    // Nothing to sample from
+    if(bins.getTotal() <= 0.0)
+      return false;
+
     for(UINTEGER k = 0; k < PSSA_CR_MAX_ITER; ++k)
     {
-      REAL r = gsl_rng_uniform (ptrRNG) * scale;
-
-      pssalib::datamodel::PSSACR_Bins::CONST_PAIR_BINS_ITER itB;
-      int c = 0;
-      ptrData->bins.getBins(itB);
+      REAL r = gsl_rng_uniform (ptrRNG) * bins.getTotal();
 
-      // Linear search step to find the bin
+      // Linear search step to find the bin, starting from the largest values
+      UINTEGER bin_no = bins.getPrevOccupied(bins.getBinsCount()), bin_last = 0;
       REAL temp = 0.0;
-      for(; itB.first != itB.second; ++itB.first)
+      for(; 0 != bin_no; bin_no = bins.getPrevOccupied(bin_no))
       {
-        c++;
+        bin_last = bin_no;
 
-        temp += itB.first->second.dBinSum;
+        temp += bins.getBin(bin_no).dBinSum;
         if(r < temp)
           break;
       }
 
-      // FIXME no particular order is guaranteed when traversing std::unordered_map
-      // When r =~ scale, In some cases the sum can fail for small value and reach the
-      // end without finding a bin. In this case take the last bin.
-      if (itB.first == itB.second)
+      // The total is updated incrementally and may slightly exceed the sum
+      // over the bins. In this case take the last non-empty bin.
+      if(0 == bin_no)
       {
-        // It seem that unordered_map does not support --:
-        // so reiterate till c - 1
-
-        ptrData->bins.getBins(itB);
-
-        for(int s = 0; s <  c - 1 ; s++) ++itB.first;
+        if(0 == bin_last)
+          return false;
+        bin_no = bin_last;
       }
 
-      if (itB.first->first <= 30)
-        temp = ptrData->minValue * (1 << itB.first->first);
+      if (bin_no <= 30)
+        temp = ptrData->minValue * (1 << bin_no);
       else
-        temp = ldexp(ptrData->minValue, itB.first->first);
-      const pssalib::datamodel::PSSACR_Bin *pBin = &(itB.first->second);
+        temp = ldexp(ptrData->minValue, bin_no);
+      const pssalib::datamodel::PSSACR_Bin *pBin = &bins.getBin(bin_no);
       UINTEGER unBins = pBin->size();
 
       // Rejection step to sample within the bin
@@ -72,7 +71,7 @@ namespace sampling
 
         sI = pBin->get_at(sI);
 
-        if(r < ptrData->bins.getValue(sI)) {
+        if(r < bins.getValue(sI)) {
           outI = sI;
           outR = r;
           return true;
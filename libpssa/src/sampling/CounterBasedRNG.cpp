@@ -0,0 +1,128 @@
+/**
+ * @file CounterBasedRNG.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Implementation of the Philox4x32-10 generator after
+ * J. K. Salmon et al., "Parallel random numbers: as easy as 1, 2, 3",
+ * Proceedings of SC'11 (2011).
+ *
+ * The 128 bit counter is laid out as follows:
+ *   - words 0 & 1 : position within the stream (in blocks of 4 numbers);
+ *   - word 2      : sample index;
+ *   - word 3      : stream id.
+ * The 64 bit key holds the global seed.
+ */
+
+#include <stdint.h>
+
+#include "../../include/sampling/CounterBasedRNG.h"
+
+namespace pssalib
+{
+namespace sampling
+{
+  //! Generator state
+  typedef struct tagPhiloxState
+  {
+    uint32_t key[2];   //!< Key (global seed)
+    uint32_t ctr[4];   //!< Counter of the next block
+    uint32_t block[4]; //!< Current block of random numbers
+    UINTEGER idx;      //!< Index of the next number in the block
+  } PhiloxState;
+
+  static inline uint32_t mulhilo(uint32_t a, uint32_t b, uint32_t & hi)
+  {
+    uint64_t product = (uint64_t)a * (uint64_t)b;
+    hi = (uint32_t)(product >> 32);
+    return (uint32_t)product;
+  }
+
+  //! Encrypt the current counter to produce a new block
+  static void philox_generate(PhiloxState * state)
+  {
+    uint32_t c0 = state->ctr[0], c1 = state->ctr[1],
+             c2 = state->ctr[2], c3 = state->ctr[3],
+             k0 = state->key[0], k1 = state->key[1];
+
+    for(UINTEGER round = 0; round < 10; ++round)
+    {
+      uint32_t hi0, hi1;
+      uint32_t lo0 = mulhilo(0xD2511F53, c0, hi0);
+      uint32_t lo1 = mulhilo(0xCD9E8D57, c2, hi1);
+
+      c0 = hi1 ^ c1 ^ k0;
+      c1 = lo1;
+      c2 = hi0 ^ c3 ^ k1;
+      c3 = lo0;
+
+      k0 += 0x9E3779B9;
+      k1 += 0xBB67AE85;
+    }
+
+    state->block[0] = c0; state->block[1] = c1;
+    state->block[2] = c2; state->block[3] = c3;
+    state->idx = 0;
+
+    // advance the position within the stream
+    if(0 == ++state->ctr[0])
+      ++state->ctr[1];
+  }
+
+  static void philox_set(void * vstate, unsigned long int seed)
+  {
+    PhiloxState * state = (PhiloxState *)vstate;
+
+    state->key[0] = (uint32_t)seed;
+    state->key[1] = (uint32_t)(((uint64_t)seed) >> 32);
+    memset(state->ctr, 0, sizeof(state->ctr));
+    state->idx = 4;
+  }
+
+  static unsigned long int philox_get(void * vstate)
+  {
+    PhiloxState * state = (PhiloxState *)vstate;
+
+    if(state->idx > 3)
+      philox_generate(state);
+
+    return state->block[state->idx++];
+  }
+
+  static double philox_get_double(void * vstate)
+  {
+    return philox_get(vstate) / 4294967296.0;
+  }
+
+  static const gsl_rng_type philox4x32_type =
+  {
+    "philox4x32-10",      // name
+    0xffffffffUL,         // RAND_MAX
+    0,                    // RAND_MIN
+    sizeof(PhiloxState),
+    &philox_set,
+    &philox_get,
+    &philox_get_double
+  };
+
+  const gsl_rng_type * gsl_rng_philox4x32 = &philox4x32_type;
+
+  void rng_select_stream(gsl_rng * ptrRNG, UINTEGER sample, UINTEGER stream)
+  {
+    PhiloxState * state = (PhiloxState *)ptrRNG->state;
+
+    state->ctr[0] = state->ctr[1] = 0;
+    state->ctr[2] = sample;
+    state->ctr[3] = stream;
+    state->idx = 4;
+  }
+
+}  } // close namespaces pssalib and sampling
@@ -20,6 +20,7 @@
 #include "../../include/datamodel/DataModel.h"
 #include "../../include/datamodel/SimulationInfo.h"
 #include "../../include/sampling/SamplingModule.h"
+#include "../../include/sampling/CounterBasedRNG.h"
 
 namespace pssalib
 {
@@ -31,6 +32,7 @@ namespace sampling
   //! Default constructor
   SamplingModule::SamplingModule() 
     : m_ptrRNG(NULL)
+    , m_unRNGSeed(0)
   {
     gsl_rng_env_setup();
     const gsl_rng_type * ptrRNGtype = gsl_rng_default;
@@ -41,9 +43,7 @@ namespace sampling
     {
       unsigned long seed = 1;
 #ifdef HAVE_MPI
-      int rank = 0;
-      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
-      seed *= std::hash<int>()(++rank);
+      seed *= std::hash<int>()(PSSALIB_MPI_RANK + 1);
 #endif
       seed *= std::hash<std::clock_t>()(std::clock());
 
@@ -68,39 +68,14 @@ namespace sampling
   //! Fill in the datastructure with random samples
   bool SamplingModule::getSample(pssalib::datamodel::SimulationInfo* ptrSimInfo)
   {
-    pssalib::datamodel::DataModel* ptrData = ptrSimInfo->getDataModel();
-
-    // Sample time
-    if(!sampleTime(ptrSimInfo))
-    {
-      PSSA_ERROR(ptrSimInfo, << "could not sample next reaction time!\n");
-      return false;
-    }
-
-    // Sample volume
-    if(0 != ptrData->getDimsCount())
-    {
-      if(!sampleVolume(ptrSimInfo))
-      {
-        PSSA_ERROR(ptrSimInfo, << "could not sample next reaction volume!\n");
-        return false;
-      }
-    }
+    return getSample<SamplingModule, true, true>(ptrSimInfo);
+  }
 
-    // Sample reaction
-    if(!sampleReaction(ptrSimInfo))
-    {
-      PSSA_ERROR(ptrSimInfo, << "could not sample next reaction index!\n");
-      return false;
-    }
-    else
-    {
-      PSSA_TRACE(ptrSimInfo, << "sampled reaction #" << ptrData->mu 
-        << " : " << ptrData->getReactionWrapper(ptrData->mu).toString()
-        << std::endl);
-    }
+  //! Sample the destination subvolume if the sampled reaction is a diffusion event
+  void SamplingModule::sampleDestination(pssalib::datamodel::SimulationInfo* ptrSimInfo)
+  {
+    pssalib::datamodel::DataModel* ptrData = ptrSimInfo->getDataModel();
 
-    // Sample diffusion destination if necessary.
     if(ptrData->getReactionWrapper(ptrData->mu).isDiffusive())
     {
       // With isotropic diffusion we don't need a linear search.
@@ -110,8 +85,6 @@ namespace sampling
       PSSA_TRACE(ptrSimInfo, << "sampled destination volume : source = " << ptrData->nu
         << "; destination = " << ptrData->nu_D << std::endl);
     }
-
-    return true;
   }
 
   //! Sample the time interval till next reaction
@@ -127,7 +100,7 @@ namespace sampling
       r = gsl_rng_uniform (m_ptrRNG);
     } while (r == 0);
 
-    if(ptrData->vQueuedReactions.empty())
+    if(ptrData->dqQueuedReactions.empty())
     {
       // check if we have reached an absorbing state
       if(ptrData->dTotalPropensity <= 0.0)
@@ -144,19 +117,22 @@ namespace sampling
     else
     {
       REAL T1, T2, at, F;
-      std::vector<pssalib::datamodel::DataModel::DelayedReaction>::iterator 
-        curReaction = ptrData->vQueuedReactions.begin();
 
       // Initialize
       T1 = ptrSimInfo->dTimeSimulation;
-      T2 = curReaction->time;
+      T2 = ptrData->dqQueuedReactions.top().time;
       at = ptrData->dTotalPropensity * (T2 - T1);
       F  = 1.0 - exp(-at);
 
       while(F < r)
       {
+        // Check if we're still within simulation timespan
+        if(T2 > ptrSimInfo->dTimeEnd)
+          break;
+
         // Reached the end of the simulation
-        ptrData->mu = curReaction->index;
+        ptrData->mu = ptrData->dqQueuedReactions.top().index;
+        ptrData->nu = ptrData->dqQueuedReactions.top().subvolume;
         ptrSimInfo->dTimeSimulation = T2;
         // Write to file & update
         if(!ptrSimInfo->UpdateCallback()) 
@@ -165,27 +141,38 @@ namespace sampling
           return false;
         }
 
-        // Check if we're still within simulation timespan
-        if(T2 > ptrSimInfo->dTimeEnd)
-          return false;
-
         // Remove the delayed reaction we just fired
-        ptrData->vQueuedReactions.erase(curReaction);
+        ptrData->dqQueuedReactions.pop();
 
         T1 = T2;
         // If all delayed reaction have already been fired
         // just calculate the time-step and exit.
-        if(ptrData->vQueuedReactions.empty())
+        if(ptrData->dqQueuedReactions.empty())
         {
+          // check if the last delayed reaction led to an absorbing state
+          if(ptrData->dTotalPropensity <= 0.0)
+          {
+            ptrSimInfo->dTimeSimulation = std::numeric_limits<REAL>::infinity();
+            PSSA_WARNING(ptrSimInfo, << "zero or negative propensity ==> simulation reached an absorbing state.\n");
+            return false;
+          }
+
           ptrSimInfo->dTimeSimulation = T1 - (gsl_log1p(-r) + at) / ptrData->dTotalPropensity;
           return true;
         }
 
-        curReaction =  ptrData->vQueuedReactions.begin();
-        T2          =  curReaction->time;
+        T2          =  ptrData->dqQueuedReactions.top().time;
         at          += ptrData->dTotalPropensity * (T2 - T1);
         F           =  1.0 - exp(-at);
       }
+
+      // the remaining delayed reactions complete after the end of the simulation
+      if(ptrData->dTotalPropensity <= 0.0)
+      {
+        ptrSimInfo->dTimeSimulation = std::numeric_limits<REAL>::infinity();
+        PSSA_WARNING(ptrSimInfo, << "zero or negative propensity ==> simulation reached an absorbing state.\n");
+        return false;
+      }
       ptrSimInfo->dTimeSimulation = T2 - (gsl_log1p(-r) + at) / ptrData->dTotalPropensity;
 
       PSSA_TRACE(ptrSimInfo, << "sampled time (with delays) = "
@@ -209,8 +196,7 @@ namespace sampling
 //     } else {
       UINTEGER i;
       REAL r;
-      success = crVolumeSampler.Sample(&ptrData->crsdVolume, m_ptrRNG, 
-                                       ptrData->dTotalPropensity, i, r);
+      success = crVolumeSampler.Sample(&ptrData->crsdVolume, m_ptrRNG, i, r);
       PSSA_TRACE(ptrSimInfo, << "sampled reactor subvolume = [ i=" << i << "; r=" << r << "]\n");
       if (!success) {
         ptrData->nu = 0;
@@ -226,14 +212,211 @@ namespace sampling
     return success;
   }
 
+  //! Draw the firing times of all subvolumes for the Next Subvolume Method
+  void SamplingModule::scheduleVolumes(pssalib::datamodel::SimulationInfo* ptrSimInfo)
+  {
+    // Cast the data model to a suitable type
+    pssalib::datamodel::DataModel * ptrData = ptrSimInfo->getDataModel();
+
+    for(UINTEGER svi = 0; svi < ptrData->getSubvolumesCount(); ++svi)
+      ptrData->ftVolumes.set(svi, ptrData->getSubvolume(svi).totalPropensity(),
+        -log(gsl_rng_uniform_pos(m_ptrRNG)), ptrSimInfo->dTimeSimulation);
+    ptrData->ftVolumes.build();
+    ptrData->bVolumesScheduled = true;
+  }
+
+  //! Sample the time till next reaction & its subvolume using the Next Subvolume Method
+  bool SamplingModule::sampleNextSubvolume(pssalib::datamodel::SimulationInfo* ptrSimInfo)
+  {
+    // Cast the data model to a suitable type
+    pssalib::datamodel::DataModel * ptrData = ptrSimInfo->getDataModel();
+
+    // check if we have reached an absorbing state
+    if(std::isinf(ptrData->ftVolumes.top_key()))
+    {
+      ptrSimInfo->dTimeSimulation = std::numeric_limits<REAL>::infinity();
+      PSSA_WARNING(ptrSimInfo, << "zero or negative propensity ==> simulation reached an absorbing state.\n");
+      return false; // We have reached an absorbing state - exit
+    }
+
+    ptrSimInfo->dTimeSimulation = ptrData->ftVolumes.top_key();
+    ptrData->nu = ptrData->ftVolumes.top();
+
+    // The subvolume that fires gets a new waiting time with respect to its
+    // current propensity, which is rescaled by the update module afterwards
+    ptrData->ftVolumes.schedule(ptrData->nu, ptrData->getSubvolume(ptrData->nu).totalPropensity(),
+      -log(gsl_rng_uniform_pos(m_ptrRNG)), ptrSimInfo->dTimeSimulation);
+
+    PSSA_TRACE(ptrSimInfo, << "sampled time = " << ptrSimInfo->dTimeSimulation
+      << "; reactor subvolume = " << ptrData->nu << std::endl);
+
+    return true;
+  }
+
+  /**
+   * Fire the queued delayed reactions that complete before the earliest
+   * firing time in a queue or before the end of the simulation, whichever
+   * comes first. A delayed update reschedules the firing times, so the
+   * earliest one is looked up again after each delayed reaction.
+   * 
+   * @param ptrSimInfo Simulation information object
+   * @param ftNext Firing times of the reactions or subvolumes
+   * @return @true on success, @false otherwise.
+   */
+  bool SamplingModule::fireDelayedReactions(pssalib::datamodel::SimulationInfo* ptrSimInfo, const pssalib::datamodel::detail::FiringTimes & ftNext)
+  {
+    // Cast the data model to a suitable type
+    pssalib::datamodel::DataModel * ptrData = ptrSimInfo->getDataModel();
+
+    while(!ptrData->dqQueuedReactions.empty())
+    {
+      const pssalib::datamodel::DataModel::DelayedReaction &
+        curReaction = ptrData->dqQueuedReactions.top();
+
+      if((curReaction.time > ftNext.top_key())||(curReaction.time > ptrSimInfo->dTimeEnd))
+        break;
+
+      ptrData->mu = curReaction.index;
+      ptrData->nu = curReaction.subvolume;
+      ptrSimInfo->dTimeSimulation = curReaction.time;
+      // Write to file & update
+      if(!ptrSimInfo->UpdateCallback()) 
+      {
+        PSSA_WARNING(ptrSimInfo, << "sampling failed: could not perform a delayed update!\n");
+        return false;
+      }
+
+      // Remove the delayed reaction we just fired
+      ptrData->dqQueuedReactions.pop();
+    }
+
+    return true;
+  }
+
   /**
-   * Set the seed of the random number generator
+   * Set the seed of the random number generator, from which the streams of
+   * the samples are derived
    * @param seed New seed value
    * 
    */
-  void SamplingModule::set_rng_seed(UINTEGER seed)
+  void SamplingModule::set_rng_seed(ULINTEGER seed)
+  {
+    m_unRNGSeed = seed;
+    gsl_rng_set(m_ptrRNG, m_unRNGSeed);
+  }
+
+  /**
+   * Draw a seed for another random number generator from this one,
+   * e.g., to initialise the generators of concurrent sampling threads.
+   * 
+   * @return New seed value
+   */
+  UINTEGER SamplingModule::draw_rng_seed()
+  {
+    return (UINTEGER)gsl_rng_get(m_ptrRNG);
+  }
+
+  /**
+   * Allocate the random number generator requested by the user and seed it.
+   * If no seed is given, it is drawn from the generator seeded upon
+   * construction and reported, so that the run can be repeated. The setting
+   * in @p ptrSimInfo is left unchanged, hence another run draws a new seed.
+   * 
+   * @param ptrSimInfo Simulation information object
+   * @return @true on success, @false otherwise.
+   */
+  bool SamplingModule::setup_rng(pssalib::datamodel::SimulationInfo* ptrSimInfo)
   {
-    gsl_rng_set(m_ptrRNG, seed);
+    const gsl_rng_type * ptrRNGtype = gsl_rng_default;
+    if(pssalib::datamodel::SimulationInfo::rngPhilox == ptrSimInfo->eRNGType)
+      ptrRNGtype = gsl_rng_philox4x32;
+
+    ULINTEGER seed = ptrSimInfo->unRNGSeed;
+    while(0 == seed)
+      seed = draw_rng_seed();
+#ifdef HAVE_MPI
+    // all processes share the seed of the master
+    MPI_Bcast(&seed, sizeof(seed), MPI_BYTE, 0, MPI_COMM_WORLD);
+#endif
+
+    if(ptrRNGtype != m_ptrRNG->type)
+    {
+      gsl_rng * ptrRNG = gsl_rng_alloc(ptrRNGtype);
+      if(NULL == ptrRNG)
+      {
+        PSSA_ERROR(ptrSimInfo, << "failed to allocate random number generator '"
+          << ptrRNGtype->name << "'.\n");
+        return false;
+      }
+      gsl_rng_free(m_ptrRNG);
+      m_ptrRNG = ptrRNG;
+    }
+
+    set_rng_seed(seed);
+
+    PSSA_INFO(ptrSimInfo, << "random number generator '" << gsl_rng_name(m_ptrRNG)
+      << "' seeded with " << m_unRNGSeed << ".\n");
+
+    return true;
+  }
+
+  /**
+   * Position the random number generator at the beginning of the stream
+   * that belongs to a given sample, so that the sample does not depend on
+   * any other sample, nor on the thread or the process drawing it.
+   * Counter-based generators select the stream by their counter, sequential
+   * ones are reseeded with a hash of the seed & the stream.
+   * 
+   * @param sample Sample index
+   * @param stream Stream id
+   */
+  void SamplingModule::select_rng_stream(UINTEGER sample, UINTEGER stream)
+  {
+    if(rng_is_counter_based(m_ptrRNG))
+      rng_select_stream(m_ptrRNG, sample, stream);
+    else
+    {
+      // SplitMix64 finalizer decorrelates the seeds of adjacent samples
+      std::uint64_t seed = m_unRNGSeed + 0x9E3779B97F4A7C15ULL *
+        ((std::uint64_t(stream) << 32) + sample + 1);
+      seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+      seed ^= seed >> 31;
+      gsl_rng_set(m_ptrRNG, (unsigned long)seed);
+    }
+  }
+
+  /**
+   * Get the state of the random number generator, e.g. to save it
+   * along with the state of a trial.
+   * 
+   * @param name Name of the generator [OUT]
+   * @param size Size of the state in bytes [OUT]
+   * @return Pointer to the state
+   */
+  const void * SamplingModule::get_rng_state(STRING & name, std::size_t & size) const
+  {
+    name = gsl_rng_name(m_ptrRNG);
+    size = gsl_rng_size(m_ptrRNG);
+    return gsl_rng_state(m_ptrRNG);
+  }
+
+  /**
+   * Restore a state of the random number generator obtained by
+   * @ref get_rng_state(), so that the random numbers continue the sequence.
+   * 
+   * @param name Name of the generator
+   * @param state State of the generator
+   * @param size Size of the state in bytes
+   * @return @true on success, @false if the state belongs to another generator.
+   */
+  bool SamplingModule::set_rng_state(const STRING & name, const void * state, std::size_t size)
+  {
+    if((name != gsl_rng_name(m_ptrRNG))||(size != gsl_rng_size(m_ptrRNG)))
+      return false;
+
+    memcpy(gsl_rng_state(m_ptrRNG), state, size);
+    return true;
   }
 
 }  } // close namespaces pssalib and sampling
@@ -53,7 +53,7 @@ namespace sampling
              M = ptrDMData->getReactionWrappersCount();
 
     // Sample reaction
-    REAL temp1 = gsl_rng_uniform_pos (m_ptrRNG) * DMSubVol.dTotalPropensity;
+    REAL temp1 = gsl_rng_uniform_pos (m_ptrRNG) * DMSubVol.totalPropensity();
     REAL temp2 = 0.0;
     for(mu = 0; mu < M; ++mu)
     {
@@ -63,6 +63,22 @@ namespace sampling
         break;
     }
 
+    // The total propensity is updated incrementally and may slightly
+    // exceed the sum of propensities, take the last possible reaction
+    if(mu == M)
+    {
+      while((mu > 0)&&(DMSubVol.propensity(mu - 1) <= 0.0))
+        --mu;
+
+      if(0 == mu)
+      {
+        // all propensities vanished : absorbing state
+        ptrSimInfo->dTimeSimulation = std::numeric_limits<REAL>::infinity();
+        return false;
+      }
+      --mu;
+    }
+
     ptrDMData->mu = mu;
 
     return true;
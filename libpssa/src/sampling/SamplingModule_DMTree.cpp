@@ -0,0 +1,59 @@
+/**
+ * @file SamplingModule_DMTree.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ * 
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Sampling module implementation for the Direct Method with a sum tree
+ */
+
+#include "../../include/datamodel/DataModel_DMTree.h"
+#include "../../include/datamodel/SimulationInfo.h"
+#include "../../include/sampling/SamplingModule_DMTree.h"
+
+namespace pssalib
+{
+namespace sampling
+{
+  ////////////////////////////////
+  // Constructors
+
+  //! Default constructor
+  SamplingModule_DMTree::SamplingModule_DMTree()
+  {
+    // Do nothing
+  }
+
+  //! Destructor
+  SamplingModule_DMTree::~SamplingModule_DMTree()
+  {
+    // Do nothing
+  }
+
+  ////////////////////////////////
+  // Methods
+
+  //! Sample reaction index
+  bool SamplingModule_DMTree::sampleReaction(pssalib::datamodel::SimulationInfo* ptrSimInfo)
+  {
+    // Cast the data model to a suitable type
+    pssalib::datamodel::DataModel_DMTree * ptrDMTreeData = static_cast<pssalib::datamodel::DataModel_DMTree*>(
+      ptrSimInfo->getDataModel());
+    const pssalib::datamodel::detail::Subvolume_DMTree & DMTreeSubVol =
+      ptrDMTreeData->getSubvolume(ptrDMTreeData->nu);
+
+    // Sample reaction by descending the sum tree
+    ptrDMTreeData->mu = DMTreeSubVol.sampleReaction(
+      gsl_rng_uniform (m_ptrRNG) * DMTreeSubVol.totalPropensity());
+
+    return true;
+  }
+
+}  } // close namespaces pssalib and sampling
@@ -0,0 +1,92 @@
+/**
+ * @file SamplingModule_NRM.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ * 
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Sampling module implementation for the Next Reaction Method
+ */
+
+#include "../../include/datamodel/DataModel_NRM.h"
+#include "../../include/datamodel/SimulationInfo.h"
+#include "../../include/sampling/SamplingModule_NRM.h"
+
+namespace pssalib
+{
+namespace sampling
+{
+  ////////////////////////////////
+  // Constructors
+
+  //! Default constructor
+  SamplingModule_NRM::SamplingModule_NRM()
+  {
+    // Do nothing
+  }
+
+  //! Destructor
+  SamplingModule_NRM::~SamplingModule_NRM()
+  {
+    // Do nothing
+  }
+
+  ////////////////////////////////
+  // Methods
+
+  //! Draw the firing times of all reaction channels
+  void SamplingModule_NRM::scheduleReactions(pssalib::datamodel::SimulationInfo* ptrSimInfo)
+  {
+    // Cast the data model to a suitable type
+    pssalib::datamodel::DataModel_NRM * ptrNRMData = static_cast<pssalib::datamodel::DataModel_NRM*>(
+      ptrSimInfo->getDataModel());
+
+    const UINTEGER M = ptrNRMData->getReactionWrappersCount();
+    for(UINTEGER svi = 0; svi < ptrNRMData->getSubvolumesCount(); ++svi)
+    {
+      pssalib::datamodel::detail::Subvolume_DM & DMSubVol = ptrNRMData->getSubvolume(svi);
+
+      for(UINTEGER rwi = 0; rwi < M; ++rwi)
+      {
+        ptrNRMData->ftReactions.set(svi*M + rwi, DMSubVol.propensity(rwi),
+          -log(gsl_rng_uniform_pos(m_ptrRNG)), ptrSimInfo->dTimeSimulation);
+      }
+    }
+    ptrNRMData->ftReactions.build();
+    ptrNRMData->bScheduled = true;
+  }
+
+  //! Sample reaction index
+  bool SamplingModule_NRM::sampleReaction(pssalib::datamodel::SimulationInfo* ptrSimInfo)
+  {
+    // Cast the data model to a suitable type
+    pssalib::datamodel::DataModel_NRM * ptrNRMData = static_cast<pssalib::datamodel::DataModel_NRM*>(
+      ptrSimInfo->getDataModel());
+
+    const UINTEGER M = ptrNRMData->getReactionWrappersCount(),
+                   item = ptrNRMData->ftReactions.top();
+
+    ptrNRMData->nu = item / M;
+    ptrNRMData->mu = item % M;
+
+    // The channel that fires gets a new waiting time with respect to its
+    // current propensity, which is rescaled by the update module afterwards
+    ptrNRMData->ftReactions.schedule(item, ptrNRMData->getSubvolume(ptrNRMData->nu).propensity(ptrNRMData->mu),
+      -log(gsl_rng_uniform_pos(m_ptrRNG)), ptrSimInfo->dTimeSimulation);
+
+    return true;
+  }
+
+  //! Fill in the datastructure with random samples
+  bool SamplingModule_NRM::getSample(pssalib::datamodel::SimulationInfo* ptrSimInfo)
+  {
+    return getSample<SamplingModule_NRM, true, true>(ptrSimInfo);
+  }
+
+}  } // close namespaces pssalib and sampling
@@ -52,11 +52,11 @@ namespace sampling
 
     REAL r = 0.0;
     UINTEGER sI = 0;
-    bool success = crSampler.Sample(&PSSACRSubVol.crsdSigma, m_ptrRNG, PSSACRSubVol.dTotalPropensity, sI, r);
+    bool success = crSampler.Sample(&PSSACRSubVol.crsdSigma, m_ptrRNG, sI, r);
 
     if (success) {
       UINTEGER sJ = 0;
-      success = crSampler.Sample(&PSSACRSubVol.crsdPi(sI), m_ptrRNG, PSSACRSubVol.lambda(sI), sJ, r);
+      success = crSampler.Sample(&PSSACRSubVol.crsdPi(sI), m_ptrRNG, sJ, r);
 
       if (success) {
         ptrPSRDCRData->mu = ptrPSRDCRData->aruL(sI, sJ)->getSerialNumber();
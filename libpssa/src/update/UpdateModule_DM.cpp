@@ -17,8 +17,6 @@
 #include "../../include/datamodel/SimulationInfo.h"
 #include "../../include/update/UpdateModule_DM.h"
 
-#include "../../include/util/Combinations.h"
-
 namespace pssalib
 {
 namespace update
@@ -41,65 +39,14 @@ namespace update
   ////////////////////////////////
   // Methods
 
-  //! Update reaction propensities
-  bool UpdateModule_DM::updateSpeciesStructures(pssalib::datamodel::SimulationInfo * ptrSimInfo,
-                                                pssalib::datamodel::DataModel_DM * ptrDMData,
-                                                pssalib::datamodel::detail::Subvolume_DM & DMSubVol)
-  {
-    DMSubVol.dTotalPropensity = 0.0;
-
-    // Recalculate the propensity array
-    for(UINTEGER rwi = 0; rwi < ptrDMData->getReactionWrappersCount(); ++rwi)
-    {
-      pssalib::datamodel::detail::ReactionWrapper & rw =
-        ptrDMData->getReactionWrapper(rwi);
-
-      DMSubVol.propensity(rwi) = 0.0;
-
-      PSSA_TRACE(ptrSimInfo,  << "updating reaction index " << rwi << std::endl);
-
-      // compute reaction propensity
-      REAL temp = rw.getRate();
-      if(rw.isDiffusive())
-      {
-        const pssalib::datamodel::detail::Species * sp = rw.getSpecies();
-        temp *= DMSubVol.population(sp->getIndex()) * 2.0 * (REAL)ptrDMData->getDimsCount();
-      }
-      else
-      {
-        for(UINTEGER ri = 0; ri < rw.getReactantsCount(); ++ri)
-        {
-          const pssalib::datamodel::detail::SpeciesReference * sr = rw.getReactantsListAt(ri);
-          PSSA_TRACE(ptrSimInfo, << "updating species index " << sr->getIndex() << " with stoichiometry " << sr->getStoichiometryAbs() << std::endl);
-          if(!sr->isReservoir())
-            temp *= pssalib::util::getPartialCombinationsHeteroreactions(DMSubVol.population(sr->getIndex()), sr->getStoichiometryAbs());
-        }
-      }
-
-      // store propensity on the subvolume scale
-      DMSubVol.propensity(rwi) = temp;
-      DMSubVol.dTotalPropensity += temp;
-    }
-
-    return true;
-  }
-
   bool UpdateModule_DM::updateSpeciesStructuresReaction(pssalib::datamodel::SimulationInfo * ptrSimInfo)
   {
-    pssalib::datamodel::DataModel_DM* ptrDMData =
-      static_cast<pssalib::datamodel::DataModel_DM * >
-        (ptrSimInfo->getDataModel());
-
-    return updateSpeciesStructures(ptrSimInfo, ptrDMData, ptrDMData->getSubvolume(ptrDMData->nu));
+    return updateReactionDependencies<UpdateModule_DM>(ptrSimInfo);
   }
 
   bool UpdateModule_DM::updateSpeciesStructuresDiffusion(pssalib::datamodel::SimulationInfo * ptrSimInfo)
   {
-    pssalib::datamodel::DataModel_DM* ptrDMData = 
-      static_cast<pssalib::datamodel::DataModel_DM * >
-        (ptrSimInfo->getDataModel());
-    return updateSpeciesStructures(ptrSimInfo, ptrDMData, ptrDMData->getSubvolume(ptrDMData->nu)) &&
-      updateSpeciesStructures(ptrSimInfo, ptrDMData, ptrDMData->getSubvolume(ptrDMData->nu_D));
+    return updateDiffusionDependencies<UpdateModule_DM>(ptrSimInfo);
   }
 
 }  } // close namespaces pssalib and update
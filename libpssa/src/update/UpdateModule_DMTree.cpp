@@ -0,0 +1,52 @@
+/**
+ * @file UpdateModule_DMTree.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ * 
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Update module implementation for the Direct Method with a sum tree
+ */
+
+#include "../../include/datamodel/SimulationInfo.h"
+#include "../../include/update/UpdateModule_DMTree.h"
+
+namespace pssalib
+{
+namespace update
+{
+  ////////////////////////////////
+  // Constructors
+
+  //! Default constructor
+  UpdateModule_DMTree::UpdateModule_DMTree()
+  {
+    // Do nothing
+  }
+
+  //! Destructor
+  UpdateModule_DMTree::~UpdateModule_DMTree()
+  {
+    // Do nothing
+  }
+
+  ////////////////////////////////
+  // Methods
+
+  bool UpdateModule_DMTree::updateSpeciesStructuresReaction(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    return updateReactionDependencies<UpdateModule_DMTree>(ptrSimInfo);
+  }
+
+  bool UpdateModule_DMTree::updateSpeciesStructuresDiffusion(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    return updateDiffusionDependencies<UpdateModule_DMTree>(ptrSimInfo);
+  }
+
+}  } // close namespaces pssalib and update
@@ -0,0 +1,52 @@
+/**
+ * @file UpdateModule_NRM.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ * 
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Update module implementation for the Next Reaction Method
+ */
+
+#include "../../include/datamodel/SimulationInfo.h"
+#include "../../include/update/UpdateModule_NRM.h"
+
+namespace pssalib
+{
+namespace update
+{
+  ////////////////////////////////
+  // Constructors
+
+  //! Default constructor
+  UpdateModule_NRM::UpdateModule_NRM()
+  {
+    // Do nothing
+  }
+
+  //! Destructor
+  UpdateModule_NRM::~UpdateModule_NRM()
+  {
+    // Do nothing
+  }
+
+  ////////////////////////////////
+  // Methods
+
+  bool UpdateModule_NRM::updateSpeciesStructuresReaction(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    return updateReactionDependencies<UpdateModule_NRM>(ptrSimInfo);
+  }
+
+  bool UpdateModule_NRM::updateSpeciesStructuresDiffusion(pssalib::datamodel::SimulationInfo * ptrSimInfo)
+  {
+    return updateDiffusionDependencies<UpdateModule_NRM>(ptrSimInfo);
+  }
+
+}  } // close namespaces pssalib and update
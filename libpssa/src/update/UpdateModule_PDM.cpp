@@ -109,7 +109,7 @@ namespace update
       PDMSubVol.sigma(index+1) = temp;
     }
 
-    PDMSubVol.dTotalPropensity += dTotalPropensityChange;
+    PDMSubVol.totalPropensity() += dTotalPropensityChange;
 
     return true;
   }
@@ -46,6 +46,10 @@ namespace update
     if(!UpdateModule_PDM::updateSpeciesStructuresReaction(ptrSimInfo))
       return false;
 
+    // sampled row & column do not refer to a delayed reaction
+    if(ptrSimInfo->getDelayedUpdate())
+      return true;
+
     pssalib::datamodel::DataModel_SPDM * ptrSPDMData = 
       static_cast<pssalib::datamodel::DataModel_SPDM * >
         (ptrSimInfo->getDataModel());
@@ -0,0 +1,93 @@
+/**
+ * @file AllocationCounter.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ * 
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Replacements of the global allocation functions that count
+ * heap allocations per thread.
+ */
+
+#include "../../include/util/AllocationCounter.h"
+
+#ifdef PSSALIB_ENGINE_CHECK
+
+#include <cstdlib>
+#include <new>
+
+namespace pssalib
+{
+namespace util
+{
+  // Per-thread counters
+  static thread_local ULINTEGER unAllocations = 0;
+  static thread_local UINTEGER unPauseDepth = 0;
+
+  static inline void countAllocation()
+  {
+    if(0 == unPauseDepth)
+      ++unAllocations;
+  }
+
+  ULINTEGER getAllocationsCount()
+  {
+    return unAllocations;
+  }
+
+  AllocationsCountPause::AllocationsCountPause()
+  {
+    ++unPauseDepth;
+  }
+
+  AllocationsCountPause::~AllocationsCountPause()
+  {
+    --unPauseDepth;
+  }
+} } // close namespaces util and pssalib
+
+////////////////////////////////
+// Global allocation functions
+
+void * operator new(std::size_t size)
+{
+  pssalib::util::countAllocation();
+  void * ptr = std::malloc(size ? size : 1);
+  if(NULL == ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void * operator new[](std::size_t size)
+{
+  return ::operator new(size);
+}
+
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+  pssalib::util::countAllocation();
+  return std::malloc(size ? size : 1);
+}
+
+void * operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+  return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void * ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void * ptr) noexcept
+{
+  std::free(ptr);
+}
+
+#endif /* PSSALIB_ENGINE_CHECK */
@@ -0,0 +1,77 @@
+/**
+ * @file Checkpoint.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Implementation of the checkpoint image
+ */
+
+#include "../../include/util/Checkpoint.h"
+#include "../../include/util/FileSystem.h"
+
+#include <cstdio>
+
+namespace pssalib
+{
+namespace util
+{
+  //! Write the image to a file atomically
+  bool Checkpoint::save(const STRING & filePath) const
+  {
+    STRING strTempPath(filePath);
+    strTempPath.append(".tmp");
+
+    FILE * ptrFile = fopen(strTempPath.c_str(), "wb");
+    if(NULL == ptrFile)
+      return false;
+
+    bool bResult = (arImage.size() == fwrite(arImage.data(), 1, arImage.size(), ptrFile))&&
+                   (0 == fflush(ptrFile));
+#if defined(__linux__) || defined(__MACH__)
+    // the data must reach the disk before the file is replaced
+    bResult = bResult&&(0 == fsync(fileno(ptrFile)));
+#endif
+    bResult = (0 == fclose(ptrFile))&&bResult;
+
+    if(bResult)
+      bResult = replaceFile(strTempPath, filePath);
+    if(!bResult)
+      remove(strTempPath.c_str());
+
+    return bResult;
+  }
+
+  //! Read the image from a file
+  bool Checkpoint::load(const STRING & filePath)
+  {
+    clear();
+
+    std::ifstream ifs(filePath.c_str(), std::ios_base::in | std::ios_base::binary);
+    if(!ifs.is_open())
+      return false;
+
+    ifs.seekg(0, std::ios_base::end);
+    std::streamoff size = ifs.tellg();
+    if(size < 0)
+      return false;
+    ifs.seekg(0, std::ios_base::beg);
+
+    arImage.resize(size);
+    if(!ifs.read(arImage.data(), size))
+    {
+      clear();
+      return false;
+    }
+
+    return true;
+  }
+
+} } // close namespaces util and pssalib
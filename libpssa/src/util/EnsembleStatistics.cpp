@@ -0,0 +1,160 @@
+/**
+ * @file EnsembleStatistics.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Implementation of the ensemble statistics accumulator
+ */
+
+#include "../../include/util/EnsembleStatistics.h"
+
+namespace pssalib
+{
+namespace util
+{
+  //! Default constructor
+  EnsembleStatistics::EnsembleStatistics()
+    : szPopulation(0)
+    , unSubvolumes(0)
+    , unRows(0)
+    , arData(NULL)
+    , unRow(0)
+  {
+    // Do nothing
+  }
+
+  //! Destructor
+  EnsembleStatistics::~EnsembleStatistics()
+  {
+    free();
+  }
+
+  //! Allocate & reset the storage
+  void EnsembleStatistics::allocate(std::size_t szPop, UINTEGER subvolumes, UINTEGER rows)
+  {
+    free();
+
+    szPopulation = szPop;
+    unSubvolumes = subvolumes;
+    arData = new REAL[rows * getRowSize()];
+    unRows = rows;
+    memset(arData, 0, unRows * getRowSize() * sizeof(REAL));
+  }
+
+  //! Free allocated resources
+  void EnsembleStatistics::free()
+  {
+    if(NULL != arData)
+    {
+      delete [] arData;
+      arData = NULL;
+    }
+    unRows = unRow = 0;
+  }
+
+  //! Add a population at a given number of subsequent time points
+  template<typename T>
+  void EnsembleStatistics::update(const T * arPop, UINTEGER unLines)
+  {
+    for(; (unLines > 0)&&(unRow < unRows); --unLines, ++unRow)
+    {
+      REAL * ptrRow = arData + unRow * getRowSize();
+      REAL * ptrMean = ptrRow + 1, * ptrM2 = ptrMean + szPopulation;
+      const REAL n = (ptrRow[0] += 1.0);
+      for(std::size_t i = 0; i < szPopulation; ++i)
+      {
+        const REAL x = REAL(arPop[i]), dlt = x - ptrMean[i];
+        ptrMean[i] += dlt / n;
+        ptrM2[i] += dlt * (x - ptrMean[i]);
+      }
+    }
+  }
+
+  //! Add a population at a given number of subsequent time points
+  void EnsembleStatistics::add(const UINTEGER * arPop, UINTEGER unLines)
+  {
+    update(arPop, unLines);
+  }
+
+  //! Add a population given as real values at a given number of subsequent time points
+  void EnsembleStatistics::add(const REAL * arPop, UINTEGER unLines)
+  {
+    update(arPop, unLines);
+  }
+
+  //! Combine the statistics of another accumulator with this one
+  bool EnsembleStatistics::merge(const EnsembleStatistics & other)
+  {
+    if((szPopulation != other.szPopulation)||(unRows != other.unRows))
+      return false;
+
+    if(NULL != other.arData)
+      merge(other.arData, arData, unRows, szPopulation);
+
+    return true;
+  }
+
+  //! Combine a number of rows with another one
+  void EnsembleStatistics::merge(const REAL * arIn, REAL * arInOut, UINTEGER rows, std::size_t szPop)
+  {
+    const std::size_t szRow = 1 + 2 * szPop;
+    for(UINTEGER r = 0; r < rows; ++r, arIn += szRow, arInOut += szRow)
+    {
+      const REAL nb = arIn[0], na = arInOut[0], n = na + nb;
+      if(0.0 == nb)
+        continue;
+
+      const REAL * ptrMeanB = arIn + 1, * ptrM2B = ptrMeanB + szPop;
+      REAL * ptrMeanA = arInOut + 1, * ptrM2A = ptrMeanA + szPop;
+      for(std::size_t i = 0; i < szPop; ++i)
+      {
+        const REAL dlt = ptrMeanB[i] - ptrMeanA[i];
+        ptrMeanA[i] += dlt * nb / n;
+        ptrM2A[i] += ptrM2B[i] + dlt * dlt * na * nb / n;
+      }
+      arInOut[0] = n;
+    }
+  }
+
+  //! Write the means & the variances of all time points reached by at least one sample
+  bool EnsembleStatistics::write(OSTREAM & os) const
+  {
+    const UINTEGER unSpecies = szPopulation / unSubvolumes;
+    const std::streamsize prevPrecision = os.precision(std::numeric_limits<REAL>::digits10);
+
+    for(UINTEGER r = 0; (r < unRows)&&os.good(); ++r)
+    {
+      const REAL * ptrRow = arData + r * getRowSize();
+      const REAL n = ptrRow[0];
+      // trajectories of interrupted trials are truncated
+      if(0.0 == n)
+        break;
+
+      const REAL * ptrMean = ptrRow + 1, * ptrM2 = ptrMean + szPopulation;
+      for(UINTEGER svi = 0; svi < unSubvolumes; ++svi)
+      {
+        if(0 != svi) os << PSSALIB_TEXTOUTPUT_SUBVOLUMES_DELIMITER;
+        for(UINTEGER si = 0; si < unSpecies; ++si)
+        {
+          if(0 != si) os << PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER;
+          os << ptrMean[svi * unSpecies + si];
+        }
+        for(UINTEGER si = 0; si < unSpecies; ++si)
+          os << PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER << ptrM2[svi * unSpecies + si] / n;
+      }
+      os << '\n';
+    }
+
+    os.precision(prevPrecision);
+    return os.good();
+  }
+
+} } // close namespaces util and pssalib
@@ -139,4 +139,54 @@ namespace util
       outPath.append(1, path_separator);
     outPath.append(fileName);
   }
+
+  //! @internal A cross-platform file size query
+  bool getFileSize(const STRING & filePath, std::uint64_t & size)
+  {
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA fad;
+    if((FALSE == GetFileAttributesEx(filePath.c_str(), GetFileExInfoStandard, &fad))||
+       (0 != (fad.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)))
+      return false;
+    size = (std::uint64_t(fad.nFileSizeHigh) << 32) | fad.nFileSizeLow;
+#else /* *NIX, MACOS */
+    struct stat sb;
+    if((0 != stat(filePath.c_str(), &sb))||!S_ISREG(sb.st_mode))
+      return false;
+    size = sb.st_size;
+#endif
+    return true;
+  }
+
+  //! @internal A cross-platform wrapper for truncate function
+  bool resizeFile(const STRING & filePath, std::uint64_t size)
+  {
+#ifdef _WIN32
+    HANDLE hFile = CreateFile(filePath.c_str(), GENERIC_WRITE, 0, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(INVALID_HANDLE_VALUE == hFile)
+      return false;
+
+    LARGE_INTEGER liSize;
+    liSize.QuadPart = size;
+    bool bResult = (FALSE != SetFilePointerEx(hFile, liSize, NULL, FILE_BEGIN))&&
+                   (FALSE != SetEndOfFile(hFile));
+    CloseHandle(hFile);
+    return bResult;
+#else /* *NIX, MACOS */
+    return (0 == truncate(filePath.c_str(), (off_t)size));
+#endif
+  }
+
+  //! @internal A cross-platform atomic replacement of a file by another one
+  bool replaceFile(const STRING & srcPath, const STRING & dstPath)
+  {
+#ifdef _WIN32
+    return (FALSE != MoveFileEx(srcPath.c_str(), dstPath.c_str(),
+                                MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH));
+#else /* *NIX, MACOS */
+    // rename is atomic within a file system
+    return (0 == rename(srcPath.c_str(), dstPath.c_str()));
+#endif
+  }
 } } // close namespaces util and pssalib
@@ -43,6 +43,26 @@ namespace mpi
     return pssalib::getMPIWrapperInstance().isMaster();
   }
 
+  //! Combine rows of ensemble statistics, each one is a single element of a contiguous type
+  void reduceEnsembleStatistics(void * in, void * inout, int * len, MPI_Datatype * type)
+  {
+    int size = 0;
+    MPI_Type_size(*type, &size);
+    // samples count followed by the means & M2 of each value
+    std::size_t szPop = (size / sizeof(REAL) - 1) / 2;
+    pssalib::util::EnsembleStatistics::merge((const REAL *)in, (REAL *)inout, *len, szPop);
+  }
+
+  //! Combine marginal histograms, each one is a single element of a contiguous type
+  void reduceMarginalHistograms(void * in, void * inout, int * len, MPI_Datatype * type)
+  {
+    int size = 0;
+    MPI_Type_size(*type, &size);
+    // bin width exponent followed by the bin counts
+    UINTEGER unBins = size / sizeof(ULINTEGER) - 1;
+    pssalib::util::PopulationHistogram::merge((const ULINTEGER *)in, (ULINTEGER *)inout, *len, unBins);
+  }
+
   ////////////////////////////////
   // Enumerators
 
@@ -59,6 +79,8 @@ namespace mpi
   MPIWrapper::MPIWrapper()
     : nRank(0)
     , nPoolSize(1)
+    , winSampleCounter(MPI_WIN_NULL)
+    , unSampleCounter(0)
   {
 // std::cerr << "MPIWrapper::MPIWrapper()" << std::endl;
     int flag = 0;
@@ -107,76 +129,61 @@ namespace mpi
 
   /**
    * Prepare the process context for a parallel spread.
+   * The master process exposes a sample counter, which all processes
+   * (including the master) atomically advance to acquire chunks of samples.
    * 
    * @param ptrSimInfo Pointer to the @link SimulationInfo object associated with this run.
-   * @param size Total size of data to be processed.
    * @return @true if context initialisation was successful, or @false otherwise.
    */
   bool MPIWrapper::pre_spread(datamodel::SimulationInfo * ptrSimInfo)
   {
-    if(ptrSimInfo->unFlags & msfChunksDistributed)
+    bool bResult = true;
+    if((ptrSimInfo->unFlags & msfChunksDistributed)||
+       (MPI_WIN_NULL != winSampleCounter))
     {
       PSSA_ERROR(ptrSimInfo, << "invalid state." << std::endl);
-      return false;
+      bResult = false;
     }
+    if(!sync_results(bResult))
+      return false;
 
     // reset flags
     ptrSimInfo->unFlags &= ~(msfChunksCalculated | msfChunksDistributed | msfChunksCompleted);
-
-    if(ptrSimInfo->unSamplesTotal <= nPoolSize)
+    ptrSimInfo->m_nBlockStart = 0;
+    ptrSimInfo->m_nBlockSize = 0;
+    unSampleCounter = 0;
+
+    // allocate the shared counter
+    UINTEGER * ptrCounter = NULL;
+    if(MPI_SUCCESS != MPI_Win_allocate((isMaster() ? sizeof(UINTEGER) : 0), sizeof(UINTEGER),
+      MPI_INFO_NULL, MPI_COMM_WORLD, &ptrCounter, &winSampleCounter))
     {
-      ptrSimInfo->m_nBlockStart = nRank;
-
-      if(ptrSimInfo->unSamplesTotal > nRank)
-        ptrSimInfo->m_nBlockSize = 1;
-      else
-        ptrSimInfo->m_nBlockSize = 0;
+      PSSA_ERROR(ptrSimInfo, << "failed to allocate the shared sample counter." << std::endl);
+      winSampleCounter = MPI_WIN_NULL;
+      return false;
     }
-    else
-    {
-      ptrSimInfo->m_nBlockStart = 0;
-
-      INTEGER block = (INTEGER)(ptrSimInfo->unSamplesTotal / nPoolSize),
-              threshold = ptrSimInfo->unSamplesTotal % nPoolSize;
-      for(INTEGER n = 0; n < nRank; n++)
-      {
-        ptrSimInfo->m_nBlockStart += block;
-        if (n < threshold)
-          ptrSimInfo->m_nBlockStart++;
-      }
 
-      ptrSimInfo->m_nBlockSize = block;
-      if (nRank < threshold)
-        ptrSimInfo->m_nBlockSize++;
+    if(isMaster())
+    {
+      MPI_Win_lock(MPI_LOCK_EXCLUSIVE, 0, 0, winSampleCounter);
+      *ptrCounter = 0;
+      MPI_Win_unlock(0, winSampleCounter);
     }
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, winSampleCounter);
 
     ptrSimInfo->unFlags |= msfChunksCalculated;
 
-    PSSA_INFO(ptrSimInfo, << "BlockStart = " << ptrSimInfo->m_nBlockStart
-      << "; BlockSize = " << ptrSimInfo->m_nBlockSize << std::endl);
-
     return true;
   }
 
-  /**
-   * Allocate a block matching the current process context for a parallel spread.
-   * 
-   * @param ptrSimInfo Pointer to the @link SimulationInfo object associated with this run.
-   * @param sizeType Data type size as returned by a call to <code>sizeof(<data_type>)</code>.
-   */
-  void * MPIWrapper::spread_alloc(datamodel::SimulationInfo * ptrSimInfo, size_t sizeType) const
-  {
-    if((0 == (ptrSimInfo->unFlags & msfChunksCalculated))||
-       (0 == ptrSimInfo->m_nBlockSize))
-      return NULL;
-
-    return new char[sizeType*ptrSimInfo->m_nBlockSize];
-  }
-
   /**
    * Spread in a parallel for fashion.
+   * Once the current chunk is exhausted, the next one is acquired from the
+   * shared counter. Chunk size is proportional to the number of remaining
+   * samples, which balances the load even if run times of trials vary a lot.
    * 
-   * @param counter circular counter (cycle length is set by \b MPIWrapper::pre_spread()) 
+   * @param counter index of the next sample to be processed by this process [OUT]
    * @return @true if there is still work to do, or @false otherwise
    */
   bool MPIWrapper::spread(datamodel::SimulationInfo * ptrSimInfo, UINTEGER &counter)
@@ -188,47 +195,77 @@ namespace mpi
       return false;
     }
 
-//     if(0 == ptrSimInfo->m_nBlockSize)
-//     {
-//       PSSA_INFO(ptrSimInfo, << "skipping par-for." << std::endl);
-//       ptrSimInfo->unFlags &= ~(msfChunksDistributed);
-//       return false;
-//     }
-
     if (0 == (ptrSimInfo->unFlags & msfChunksDistributed))
     {
-      counter = ptrSimInfo->m_nBlockStart;
       ptrSimInfo->unFlags |= msfChunksDistributed;
       PSSA_INFO(ptrSimInfo, << "starting par-for." << std::endl);
     }
-    else
-      ++counter;
+    else if(++counter < (ptrSimInfo->m_nBlockStart + ptrSimInfo->m_nBlockSize))
+      return true;
+
+    // acquire the next chunk
+    UINTEGER unRemaining = 0, unStart = 0;
+    if(unSampleCounter < ptrSimInfo->unSamplesTotal)
+      unRemaining = ptrSimInfo->unSamplesTotal - unSampleCounter;
+    UINTEGER unChunk = std::max(unRemaining / (2 * nPoolSize), (UINTEGER)1);
+
+    if((MPI_SUCCESS != MPI_Fetch_and_op(&unChunk, &unStart, MPI_UNSIGNED, 0, 0, MPI_SUM, winSampleCounter))||
+       (MPI_SUCCESS != MPI_Win_flush(0, winSampleCounter)))
+    {
+      PSSA_ERROR(ptrSimInfo, << "failed to acquire a chunk of samples." << std::endl);
+      unStart = ptrSimInfo->unSamplesTotal;
+    }
+    unSampleCounter = unStart + unChunk;
 
-    if (counter >= (ptrSimInfo->m_nBlockStart + ptrSimInfo->m_nBlockSize))
+    if (unStart >= ptrSimInfo->unSamplesTotal)
     {
       PSSA_INFO(ptrSimInfo, << "terminating par-for." << std::endl);
+      ptrSimInfo->m_nBlockSize = 0;
       ptrSimInfo->unFlags &= ~(msfChunksDistributed);
       return false;
     }
-    else
-      return true;
+
+    ptrSimInfo->m_nBlockStart = unStart;
+    ptrSimInfo->m_nBlockSize = std::min(unChunk, ptrSimInfo->unSamplesTotal - unStart);
+    counter = unStart;
+
+    PSSA_INFO(ptrSimInfo, << "BlockStart = " << ptrSimInfo->m_nBlockStart
+      << "; BlockSize = " << ptrSimInfo->m_nBlockSize << std::endl);
+
+    return true;
   }
 
   /**
-   * Query whether this process has to wait for other processes due to
-   * uneven spreading. Useful if inter=process communication takes place
-   * within the parallel for loop.
+   * Stop handing out samples to all processes in the pool, e.g., after a failure.
    * 
    * @param ptrSimInfo Pointer to the @link SimulationInfo object associated with this run.
-   * @return @true if the process has to wait for other in the pool, @false othewise.
+   */
+  void MPIWrapper::spread_abort(datamodel::SimulationInfo * ptrSimInfo)
+  {
+    if(MPI_WIN_NULL == winSampleCounter)
+      return;
+
+    UINTEGER unEnd = ptrSimInfo->unSamplesTotal, unPrev = 0;
+    MPI_Fetch_and_op(&unEnd, &unPrev, MPI_UNSIGNED, 0, 0, MPI_REPLACE, winSampleCounter);
+    MPI_Win_flush(0, winSampleCounter);
+
+    PSSA_INFO(ptrSimInfo, << "aborting par-for." << std::endl);
+  }
+
+  /**
+   * Release the process context of a parallel spread.
+   * 
+   * @param ptrSimInfo Pointer to the @link SimulationInfo object associated with this run.
+   * @return @true if the context was released successfully, @false othewise.
    */
   bool MPIWrapper::post_spread(datamodel::SimulationInfo * ptrSimInfo)
   {
+    bool bResult = true;
     if((0 == (ptrSimInfo->unFlags & msfChunksCalculated))||
       (ptrSimInfo->unFlags & msfChunksCompleted))
     {
       PSSA_ERROR(ptrSimInfo, << "invalid state." << std::endl);
-      return false;
+      bResult = false;
     }
 
     // check if called before finishing the chunk
@@ -236,115 +273,152 @@ namespace mpi
     {
       PSSA_INFO(ptrSimInfo, << "premature call." << std::endl);
       ptrSimInfo->unFlags &= ~(msfChunksDistributed);
-      return false;
     }
 
     ptrSimInfo->unFlags |= msfChunksCompleted;
 
-//     UINTEGER size = 0;
-//     if(MPI_SUCCESS != MPI_Allreduce(&ptrSimInfo->m_nBlockSize, &size, sizeof(UINTEGER), MPI_CHAR, MPI_SUM, MPI_COMM_WORLD))
-//       return false;
-//     PSSA_INFO(ptrSimInfo, << "TotalSize = " << size << std::endl);
-
-    if(ptrSimInfo->unSamplesTotal <= nPoolSize)
+    // release the shared counter
+    if(MPI_WIN_NULL != winSampleCounter)
     {
-      return (nRank >= ptrSimInfo->unSamplesTotal);
-    }
-    else
-    {
-      return (nRank >= (ptrSimInfo->unSamplesTotal % nPoolSize));
+      MPI_Win_unlock_all(winSampleCounter);
+      if(MPI_SUCCESS != MPI_Win_free(&winSampleCounter))
+        bResult = false;
+      winSampleCounter = MPI_WIN_NULL;
     }
+
+    return bResult;
   }
 
   /**
    * Collect results from all processes into a buffer owned by the master process.
-   * Since block size can be different, MPI_Gather was not suitable for this.
+   * Since each process samples a varying number of trials, the results are
+   * gathered along with their sample indices and reordered by the master.
    *
+   * @param arSamples Indices of the samples held by this process
+   * @param unSamples Number of samples held by this process
    * @param sbuf Buffer to be sent to the master process
    * @param rbuf Pointer to a pointer of the receiving buffer (the pointer itself must be NULL) [OUT]
    * @param sizeType Data type size as returned by a call to <code>sizeof(<data_type>)</code>.
    */
-  bool MPIWrapper::spread_collect(datamodel::SimulationInfo * ptrSimInfo, void * sbuf, void ** rbuf, size_t sizeType)
+  bool MPIWrapper::spread_collect(datamodel::SimulationInfo * ptrSimInfo,
+                                  const UINTEGER * arSamples, UINTEGER unSamples,
+                                  void * sbuf, void ** rbuf, size_t sizeType)
   {
-    if(((sbuf == NULL)&&(0 != ptrSimInfo->m_nBlockSize))||
-      (0 == (ptrSimInfo->unFlags & msfChunksCalculated)))
-      return false;
+    bool bAllOK = true;
 
-    if(0 == nRank)
-    {
-      bool bAllOK = true;
+    // check input arguments
+    if(((NULL == sbuf)||(NULL == arSamples))&&(0 != unSamples))
+      bAllOK = false;
+    if(isMaster()&&((rbuf == NULL)||(NULL != *rbuf)))
+      bAllOK = false;
+    if(0 == (ptrSimInfo->unFlags & msfChunksCalculated))
+      bAllOK = false;
 
-      if((rbuf == NULL)||(NULL != *rbuf))
-        bAllOK = false;
-
-      if(!sync_results(bAllOK))
-        return false;
+    if(!sync_results(bAllOK))
+      return false;
 
-      INTEGER recvSize = 0;
-      boost::scoped_array<INTEGER> arSize;
+    // Report the number of samples to master
+    INTEGER nSamples = (INTEGER)unSamples;
+    boost::scoped_array<INTEGER> arCounts, arDispls, arBytes, arByteDispls;
+    boost::scoped_array<UINTEGER> arAllSamples;
+    boost::scoped_array<char> arAllData;
 
+    if(isMaster())
+    {
       try
       {
-        arSize.reset(new INTEGER[nPoolSize]);
+        arCounts.reset(new INTEGER[nPoolSize]);
+        arDispls.reset(new INTEGER[nPoolSize]);
+        arBytes.reset(new INTEGER[nPoolSize]);
+        arByteDispls.reset(new INTEGER[nPoolSize]);
       }
       catch(std::bad_alloc& e)
       {
         PSSA_ERROR(ptrSimInfo, << e.what() << ": Unable to allocate memory." << std::endl);
         bAllOK = false;
       }
+    }
 
-      if(!sync_results(bAllOK))
-        return false;
+    if(!sync_results(bAllOK))
+      return false;
 
-      if(MPI_SUCCESS != MPI_Gather(&ptrSimInfo->m_nBlockSize, sizeof(INTEGER), MPI_CHAR,
-         arSize.get(), sizeof(INTEGER), MPI_CHAR, 0, MPI_COMM_WORLD))
-        return false;
+    if(MPI_SUCCESS != MPI_Gather(&nSamples, 1, MPI_INT,
+       arCounts.get(), 1, MPI_INT, 0, MPI_COMM_WORLD))
+      return false;
 
+    if(isMaster())
+    {
+      INTEGER nTotal = 0;
       for(INTEGER i = 0; i < nPoolSize; i++)
-        recvSize += arSize[i];
-// PSSA_INFO(ptrSimInfo, << "TotalSize = " << recvSize << std::endl);
-
-      // receving buffer
-      char * tbuf = new char[sizeType*recvSize];
+      {
+        arDispls[i] = nTotal;
+        arBytes[i] = arCounts[i]*sizeType;
+        arByteDispls[i] = nTotal*sizeType;
+        nTotal += arCounts[i];
+      }
 
-      // copy master data
-      memcpy(tbuf, sbuf, ptrSimInfo->m_nBlockSize*sizeType);
+      if(nTotal != (INTEGER)ptrSimInfo->unSamplesTotal)
+      {
+        PSSA_ERROR(ptrSimInfo, << "expected " << ptrSimInfo->unSamplesTotal
+          << " samples, but " << nTotal << " were collected." << std::endl);
+        bAllOK = false;
+      }
+      else
+      {
+        try
+        {
+          arAllSamples.reset(new UINTEGER[nTotal]);
+          arAllData.reset(new char[nTotal*sizeType]);
+          *rbuf = new char[nTotal*sizeType];
+        }
+        catch(std::bad_alloc& e)
+        {
+          PSSA_ERROR(ptrSimInfo, << e.what() << ": Unable to allocate memory." << std::endl);
+          bAllOK = false;
+        }
+      }
+    }
 
-      // Receive all chunks
-      for (UINTEGER i = 1, offs = ptrSimInfo->m_nBlockSize*sizeType;
-           i < nPoolSize; offs += arSize[i]*sizeType, i++)
+    if(!sync_results(bAllOK))
+    {
+      if(isMaster()&&(NULL != *rbuf))
       {
-        if(arSize[i] > 0)
-          MPI_Recv(&((char *)tbuf)[offs],arSize[i]*sizeType,MPI_CHAR,i,0,MPI_COMM_WORLD,NULL);
-//PSSA_INFO(ptrSimInfo, << "Receive buffer size after communication with proc #" << i << " [" << recvSize << "] :" << std::endl);
+        delete [] (char *)*rbuf;
+        *rbuf = NULL;
       }
+      return false;
+    }
 
-      // store result
-      *rbuf = tbuf;
+    // Gather sample indices & respective data
+    if((MPI_SUCCESS != MPI_Gatherv((void *)arSamples, nSamples, MPI_UNSIGNED, arAllSamples.get(),
+         arCounts.get(), arDispls.get(), MPI_UNSIGNED, 0, MPI_COMM_WORLD))||
+       (MPI_SUCCESS != MPI_Gatherv(sbuf, nSamples*sizeType, MPI_CHAR, arAllData.get(),
+         arBytes.get(), arByteDispls.get(), MPI_CHAR, 0, MPI_COMM_WORLD)))
+      bAllOK = false;
+
+    // Order the results by sample index
+    if(isMaster()&&bAllOK)
+    {
+      char * tbuf = (char *)*rbuf;
+      for(UINTEGER i = 0; i < ptrSimInfo->unSamplesTotal; i++)
+      {
+        if(arAllSamples[i] >= ptrSimInfo->unSamplesTotal)
+        {
+          PSSA_ERROR(ptrSimInfo, << "invalid sample index " << arAllSamples[i] << std::endl);
+          bAllOK = false;
+          break;
+        }
+        memcpy(tbuf + arAllSamples[i]*sizeType, arAllData.get() + i*sizeType, sizeType);
+      }
     }
-    else
+
+    if(isMaster()&&!bAllOK)
     {
-      // check input arguments
-      if(!sync_results(true))
-        return false;
-
-      // dynaic allocation status
-      if(!sync_results(true))
-        return false;
-
-      // Report block sizes to master
-      if(MPI_SUCCESS != MPI_Gather(&ptrSimInfo->m_nBlockSize, sizeof(INTEGER), MPI_CHAR,
-         NULL, sizeof(INTEGER), MPI_CHAR, 0, MPI_COMM_WORLD))
-        return false;
-
-//       PSSA_INFO(ptrSimInfo, << "Send buffer size before communication with master [" << ptrSimInfo->m_nBlockSize << "] :" << std::endl);
-      // Send the chunk
-      if(ptrSimInfo->m_nBlockSize > 0)
-        MPI_Send((char *)sbuf,ptrSimInfo->m_nBlockSize*sizeType,MPI_CHAR,0,0,MPI_COMM_WORLD);
+      delete [] (char *)*rbuf;
+      *rbuf = NULL;
     }
 
-//     PSSA_INFO(ptrSimInfo, << "spread_collect - all OK" << std::endl);
-    return true;
+    return bAllOK;
   }
 
   /**
@@ -392,6 +466,149 @@ namespace mpi
     return (MPI_SUCCESS == MPI_Allreduce(sbuf, rbuf, size, MPI_CHAR, op, MPI_COMM_WORLD)); 
   }
 
+  /**
+   * Combine the ensemble statistics of all processes in the statistics of
+   * the master process. Each row is reduced as a single element, such that
+   * the means & M2 are combined pairwise along with the samples count.
+   *
+   * @param ptrSimInfo Pointer to the @link SimulationInfo object associated with this run.
+   * @param es Ensemble statistics of this process, updated on the master process [IN/OUT]
+   * @return @true if successful, @false otherwise.
+   */
+  bool MPIWrapper::reduce_statistics(datamodel::SimulationInfo * ptrSimInfo,
+                                     util::EnsembleStatistics & es) const
+  {
+    if(!sync_results(es.isAllocated()))
+      return false;
+
+    MPI_Datatype typeRow;
+    MPI_Op opMerge;
+    if(MPI_SUCCESS != MPI_Type_contiguous(es.getRowSize(), MPI_DOUBLE, &typeRow))
+      return false;
+    MPI_Type_commit(&typeRow);
+    MPI_Op_create(&reduceEnsembleStatistics, 1, &opMerge);
+
+    bool bAllOK = (MPI_SUCCESS == MPI_Reduce(isMaster() ? MPI_IN_PLACE : es.getData(),
+      es.getData(), es.getRows(), typeRow, opMerge, 0, MPI_COMM_WORLD));
+    if(!bAllOK)
+      PSSA_ERROR(ptrSimInfo, << "failed to combine the ensemble statistics." << std::endl);
+
+    MPI_Op_free(&opMerge);
+    MPI_Type_free(&typeRow);
+
+    return bAllOK;
+  }
+
+  /**
+   * Combine the histograms of all processes in the histograms of the master
+   * process. The marginal histograms are reduced like the ensemble statistics,
+   * while the joint states of each process are gathered by the master process.
+   *
+   * @param ptrSimInfo Pointer to the @link SimulationInfo object associated with this run.
+   * @param ph Histograms of this process, updated on the master process [IN/OUT]
+   * @return @true if successful, @false otherwise.
+   */
+  bool MPIWrapper::reduce_histograms(datamodel::SimulationInfo * ptrSimInfo,
+                                     util::PopulationHistogram & ph) const
+  {
+    if(!sync_results(ph.isAllocated()))
+      return false;
+
+    MPI_Datatype typeRow;
+    MPI_Op opMerge;
+    if(MPI_SUCCESS != MPI_Type_contiguous(ph.getRowSize(), MPI_UNSIGNED_LONG, &typeRow))
+      return false;
+    MPI_Type_commit(&typeRow);
+    MPI_Op_create(&reduceMarginalHistograms, 1, &opMerge);
+
+    bool bAllOK = (MPI_SUCCESS == MPI_Reduce(isMaster() ? MPI_IN_PLACE : ph.getMarginals(),
+      ph.getMarginals(), ph.getRows(), typeRow, opMerge, 0, MPI_COMM_WORLD));
+
+    MPI_Op_free(&opMerge);
+    MPI_Type_free(&typeRow);
+
+    if(!sync_results(bAllOK))
+    {
+      PSSA_ERROR(ptrSimInfo, << "failed to combine the marginal histograms." << std::endl);
+      return false;
+    }
+
+    if(!ph.isStatesOn())
+      return true;
+
+    // Gather the joint states
+    std::vector<ULINTEGER> arStates;
+    ph.serializeStates(arStates);
+
+    INTEGER nSize = (INTEGER)arStates.size();
+    boost::scoped_array<INTEGER> arCounts, arDispls;
+    boost::scoped_array<ULINTEGER> arAllStates;
+
+    if(isMaster())
+    {
+      try
+      {
+        arCounts.reset(new INTEGER[nPoolSize]);
+        arDispls.reset(new INTEGER[nPoolSize]);
+      }
+      catch(std::bad_alloc& e)
+      {
+        PSSA_ERROR(ptrSimInfo, << e.what() << ": Unable to allocate memory." << std::endl);
+        bAllOK = false;
+      }
+    }
+
+    if(!sync_results(bAllOK))
+      return false;
+
+    if(MPI_SUCCESS != MPI_Gather(&nSize, 1, MPI_INT,
+       arCounts.get(), 1, MPI_INT, 0, MPI_COMM_WORLD))
+      return false;
+
+    if(isMaster())
+    {
+      INTEGER nTotal = 0;
+      for(INTEGER i = 0; i < nPoolSize; i++)
+      {
+        arDispls[i] = nTotal;
+        nTotal += arCounts[i];
+      }
+
+      try
+      {
+        arAllStates.reset(new ULINTEGER[nTotal]);
+      }
+      catch(std::bad_alloc& e)
+      {
+        PSSA_ERROR(ptrSimInfo, << e.what() << ": Unable to allocate memory." << std::endl);
+        bAllOK = false;
+      }
+    }
+
+    if(!sync_results(bAllOK))
+      return false;
+
+    if(MPI_SUCCESS != MPI_Gatherv(arStates.data(), nSize, MPI_UNSIGNED_LONG, arAllStates.get(),
+         arCounts.get(), arDispls.get(), MPI_UNSIGNED_LONG, 0, MPI_COMM_WORLD))
+      bAllOK = false;
+
+    // The states of the master process are already counted
+    if(isMaster()&&bAllOK)
+    {
+      for(INTEGER i = 1; i < nPoolSize; i++)
+      {
+        if(!ph.mergeStates(arAllStates.get() + arDispls[i], arCounts[i]))
+        {
+          PSSA_ERROR(ptrSimInfo, << "invalid joint states received from process " << i << std::endl);
+          bAllOK = false;
+          break;
+        }
+      }
+    }
+
+    return bAllOK;
+  }
+
   /**
    * Get the size of sent buffer..
    * 
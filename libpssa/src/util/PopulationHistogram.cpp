@@ -0,0 +1,235 @@
+/**
+ * @file PopulationHistogram.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Implementation of the population histograms
+ */
+
+#include "../../include/util/PopulationHistogram.h"
+
+namespace pssalib
+{
+namespace util
+{
+  //! Default constructor
+  PopulationHistogram::PopulationHistogram()
+    : szPopulation(0)
+    , unSubvolumes(0)
+    , unBins(0)
+    , arMarginals(NULL)
+    , unStatesMax(0)
+  {
+    // Do nothing
+  }
+
+  //! Destructor
+  PopulationHistogram::~PopulationHistogram()
+  {
+    free();
+  }
+
+  //! Allocate & reset the histograms
+  void PopulationHistogram::allocate(std::size_t szPop, UINTEGER subvolumes, UINTEGER bins, UINTEGER states)
+  {
+    free();
+
+    szPopulation = szPop;
+    unSubvolumes = subvolumes;
+    unBins = std::max(bins, UINTEGER(2));
+    arMarginals = new ULINTEGER[szPopulation * getRowSize()];
+    memset(arMarginals, 0, szPopulation * getRowSize() * sizeof(ULINTEGER));
+    unStatesMax = states;
+    arState.resize(szPopulation);
+  }
+
+  //! Free allocated resources
+  void PopulationHistogram::free()
+  {
+    if(NULL != arMarginals)
+    {
+      delete [] arMarginals;
+      arMarginals = NULL;
+    }
+    mapStates.clear();
+  }
+
+  //! Double the bin width of a marginal histogram
+  void PopulationHistogram::coarsen(ULINTEGER * arRow, UINTEGER bins)
+  {
+    ULINTEGER * arCounts = arRow + 1;
+    for(UINTEGER b = 0; b < bins; b += 2)
+      arCounts[b / 2] = arCounts[b] + ((b + 1 < bins) ? arCounts[b + 1] : 0);
+    for(UINTEGER b = (bins + 1) / 2; b < bins; ++b)
+      arCounts[b] = 0;
+    ++arRow[0];
+  }
+
+  //! Add the population stored in the state buffer
+  void PopulationHistogram::add()
+  {
+    for(std::size_t i = 0; i < szPopulation; ++i)
+    {
+      ULINTEGER * arRow = arMarginals + i * getRowSize();
+      while((ULINTEGER(arState[i]) >> arRow[0]) >= unBins)
+        coarsen(arRow, unBins);
+      ++arRow[1 + (ULINTEGER(arState[i]) >> arRow[0])];
+    }
+
+    if(isStatesOn())
+      addState(arState, 1);
+  }
+
+  //! Count samples in a joint state
+  void PopulationHistogram::addState(const std::vector<UINTEGER> & state, ULINTEGER count)
+  {
+    StatesMap::iterator it = mapStates.find(state);
+    if(mapStates.end() != it)
+      it->second += count;
+    else
+      mapStates.insert(StatesMap::value_type(state, count));
+  }
+
+  //! Combine the counts of another histogram with this one
+  bool PopulationHistogram::merge(const PopulationHistogram & other)
+  {
+    if((szPopulation != other.szPopulation)||(unBins != other.unBins)||
+       (unStatesMax != other.unStatesMax))
+      return false;
+
+    if(NULL != other.arMarginals)
+      merge(other.arMarginals, arMarginals, szPopulation, unBins);
+
+    for(StatesMap::const_iterator it = other.mapStates.begin(); it != other.mapStates.end(); ++it)
+      addState(it->first, it->second);
+
+    return true;
+  }
+
+  //! Combine a number of marginal histograms with another one
+  void PopulationHistogram::merge(const ULINTEGER * arIn, ULINTEGER * arInOut, std::size_t rows, UINTEGER bins)
+  {
+    std::vector<ULINTEGER> arRow(1 + bins);
+    for(std::size_t r = 0; r < rows; ++r, arIn += 1 + bins, arInOut += 1 + bins)
+    {
+      // bring both histograms to the same bin width
+      std::copy(arIn, arIn + 1 + bins, arRow.begin());
+      while(arInOut[0] < arRow[0])
+        coarsen(arInOut, bins);
+      while(arRow[0] < arInOut[0])
+        coarsen(arRow.data(), bins);
+
+      for(UINTEGER b = 1; b <= bins; ++b)
+        arInOut[b] += arRow[b];
+    }
+  }
+
+  //! Store the joint states in a flat array
+  void PopulationHistogram::serializeStates(std::vector<ULINTEGER> & arStates) const
+  {
+    arStates.clear();
+    arStates.reserve(mapStates.size() * (szPopulation + 1));
+    for(StatesMap::const_iterator it = mapStates.begin(); it != mapStates.end(); ++it)
+    {
+      arStates.insert(arStates.end(), it->first.begin(), it->first.end());
+      arStates.push_back(it->second);
+    }
+  }
+
+  //! Add the joint states stored in a flat array
+  bool PopulationHistogram::mergeStates(const ULINTEGER * arStates, std::size_t size)
+  {
+    if(0 != size % (szPopulation + 1))
+      return false;
+
+    std::vector<UINTEGER> state(szPopulation);
+    for(std::size_t i = 0; i < size; i += szPopulation + 1)
+    {
+      std::copy(arStates + i, arStates + i + szPopulation, state.begin());
+      addState(state, arStates[i + szPopulation]);
+    }
+
+    return true;
+  }
+
+  //! Order joint states by descending samples count
+  static bool moreSamples(const PopulationHistogram::StatesMap::const_iterator & a,
+                          const PopulationHistogram::StatesMap::const_iterator & b)
+  {
+    return a->second > b->second;
+  }
+
+  //! Order joint states by population
+  static bool lessState(const PopulationHistogram::StatesMap::const_iterator & a,
+                        const PopulationHistogram::StatesMap::const_iterator & b)
+  {
+    return a->first < b->first;
+  }
+
+  //! Write the histograms
+  bool PopulationHistogram::write(OSTREAM & os) const
+  {
+    for(std::size_t i = 0; (i < szPopulation)&&os.good(); ++i)
+    {
+      const ULINTEGER * arRow = arMarginals + i * getRowSize();
+      UINTEGER unLast = unBins;
+      while((unLast > 1)&&(0 == arRow[unLast]))
+        --unLast;
+
+      os << (ULINTEGER(1) << arRow[0]);
+      for(UINTEGER b = 1; b <= unLast; ++b)
+        os << PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER << arRow[b];
+      os << '\n';
+    }
+
+    if(isStatesOn())
+    {
+      const UINTEGER unSpecies = szPopulation / unSubvolumes;
+
+      // select the most frequent states, ties keep the order of the map
+      std::vector<StatesMap::const_iterator> arStates;
+      arStates.reserve(mapStates.size());
+      for(StatesMap::const_iterator it = mapStates.begin(); it != mapStates.end(); ++it)
+        arStates.push_back(it);
+
+      ULINTEGER ulOverflow = 0;
+      if(arStates.size() > unStatesMax)
+      {
+        std::stable_sort(arStates.begin(), arStates.end(), &moreSamples);
+        for(std::size_t i = unStatesMax; i < arStates.size(); ++i)
+          ulOverflow += arStates[i]->second;
+        arStates.resize(unStatesMax);
+        std::sort(arStates.begin(), arStates.end(), &lessState);
+      }
+
+      os << '\n';
+      for(std::size_t i = 0; (i < arStates.size())&&os.good(); ++i)
+      {
+        StatesMap::const_iterator it = arStates[i];
+        os << it->second;
+        for(UINTEGER svi = 0; svi < unSubvolumes; ++svi)
+        {
+          os << PSSALIB_TEXTOUTPUT_SUBVOLUMES_DELIMITER;
+          for(UINTEGER si = 0; si < unSpecies; ++si)
+          {
+            if(0 != si) os << PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER;
+            os << it->first[svi * unSpecies + si];
+          }
+        }
+        os << '\n';
+      }
+      os << ulOverflow << '\n';
+    }
+
+    return os.good();
+  }
+
+} } // close namespaces util and pssalib
@@ -0,0 +1,263 @@
+/**
+ * @file TrajectoryWriter.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Feb 2017
+ * @section LICENSE
+ *
+ * The GNU LGPL v3 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Implementation of the trajectory writer
+ */
+
+#include "../../include/util/TrajectoryWriter.h"
+
+#include <boost/array.hpp>
+
+namespace pssalib
+{
+namespace util
+{
+  //! Default constructor
+  TrajectoryWriter::TrajectoryWriter()
+    : szPopulation(0)
+    , unSubvolumes(0)
+    , ptrLine(NULL)
+    , ptrText(NULL)
+    , ptrBinary(NULL)
+    , bFailed(false)
+#ifdef HAVE_THREADS
+    , arBuffers(NULL)
+    , arLines(NULL)
+    , unBuffers(0)
+    , unHead(0)
+    , unCount(0)
+    , bStop(false)
+#endif
+  {
+    // Do nothing
+  }
+
+  //! Destructor
+  TrajectoryWriter::~TrajectoryWriter()
+  {
+    free();
+  }
+
+  //! Allocate the buffers & start the writer thread
+  void TrajectoryWriter::allocate(std::size_t szPop, UINTEGER subvolumes, bool bText, UINTEGER buffers)
+  {
+    free();
+
+    szPopulation = szPop;
+    unSubvolumes = subvolumes;
+
+    if(bText)
+    {
+      // delimiters, values, line break & the terminating zero
+      std::size_t sz = (STRING(PSSALIB_TEXTOUTPUT_SUBVOLUMES_DELIMITER).size() * unSubvolumes +
+                        (STRING(PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER).size() +
+                        boost::lexical_cast<STRING>(std::numeric_limits<UINTEGER>::max()).size()) *
+                        szPopulation) + 2;
+      ptrLine = new typename STRING::value_type[sz];
+    }
+
+#ifdef HAVE_THREADS
+    if(buffers > 0)
+    {
+      arBuffers = new UINTEGER[buffers * szPopulation];
+      arLines = new UINTEGER[buffers];
+      unBuffers = buffers;
+      unHead = unCount = 0;
+      bStop = false;
+
+      try
+      {
+        thWriter = std::thread(&TrajectoryWriter::run, this);
+      }
+      catch(std::system_error &)
+      {
+        // write synchronously
+        delete [] arBuffers;
+        arBuffers = NULL;
+        delete [] arLines;
+        arLines = NULL;
+        unBuffers = 0;
+      }
+    }
+#endif
+  }
+
+  //! Stop the writer thread & free allocated resources
+  void TrajectoryWriter::free()
+  {
+#ifdef HAVE_THREADS
+    if(thWriter.joinable())
+    {
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        bStop = true;
+      }
+      cvNotEmpty.notify_one();
+      thWriter.join();
+    }
+    if(NULL != arBuffers)
+    {
+      delete [] arBuffers;
+      arBuffers = NULL;
+    }
+    if(NULL != arLines)
+    {
+      delete [] arLines;
+      arLines = NULL;
+    }
+    unBuffers = unHead = unCount = 0;
+#endif
+    if(NULL != ptrLine)
+    {
+      delete [] ptrLine;
+      ptrLine = NULL;
+    }
+    ptrText = ptrBinary = NULL;
+  }
+
+  //! Check whether the populations are written by a separate thread
+  bool TrajectoryWriter::isAsync() const
+  {
+#ifdef HAVE_THREADS
+    return (0 != unBuffers);
+#else
+    return false;
+#endif
+  }
+
+  //! Begin the trajectory of a new trial
+  void TrajectoryWriter::begin(STREAMBUFFER * sbText, STREAMBUFFER * sbBinary)
+  {
+    flush();
+
+    ptrText = (NULL != ptrLine) ? sbText : NULL;
+    ptrBinary = sbBinary;
+    bFailed = false;
+  }
+
+  //! Write a population a given number of times
+  void TrajectoryWriter::write(const UINTEGER * arPop, UINTEGER unLines)
+  {
+#ifdef HAVE_THREADS
+    if(0 != unBuffers)
+    {
+      UINTEGER unSlot;
+      {
+        // wait for a free buffer
+        std::unique_lock<std::mutex> lock(mtx);
+        cvNotFull.wait(lock, [this] { return (unCount < unBuffers); });
+        unSlot = (unHead + unCount) % unBuffers;
+      }
+
+      // the slot is not accessed by the writer until it is queued
+      memcpy(arBuffers + unSlot * szPopulation, arPop, szPopulation * sizeof(UINTEGER));
+      arLines[unSlot] = unLines;
+
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        ++unCount;
+      }
+      cvNotEmpty.notify_one();
+      return;
+    }
+#endif
+    output(arPop, unLines);
+  }
+
+  //! Wait until the pending output is written
+  bool TrajectoryWriter::flush()
+  {
+#ifdef HAVE_THREADS
+    if(0 != unBuffers)
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      cvNotFull.wait(lock, [this] { return (0 == unCount); });
+    }
+#endif
+    return !bFailed;
+  }
+
+  //! Format & write a population
+  void TrajectoryWriter::output(const UINTEGER * arPop, UINTEGER unLines)
+  {
+    if(NULL != ptrText)
+    {
+      typedef boost::array<STRING::value_type, 32> ConversionBufferType;
+      ConversionBufferType cBuf;
+      static size_t szSubVolDelim = STRING(PSSALIB_TEXTOUTPUT_SUBVOLUMES_DELIMITER).size(),
+                    szSpeciesDelim = STRING(PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER).size();
+
+      const UINTEGER unSpecies = szPopulation / unSubvolumes;
+      STRING::pointer pCurrOL = ptrLine;
+      for(UINTEGER svi = 0; svi < unSubvolumes; ++svi)
+      {
+        if(0 != svi)
+        {
+          strncpy(pCurrOL, PSSALIB_TEXTOUTPUT_SUBVOLUMES_DELIMITER, szSubVolDelim);
+          pCurrOL += szSubVolDelim;
+        }
+
+        for(UINTEGER si = 0; si < unSpecies; ++si)
+        {
+          if(0 != si)
+          {
+            strncpy(pCurrOL, PSSALIB_TEXTOUTPUT_SPECIES_DELIMITER, szSpeciesDelim);
+            pCurrOL += szSpeciesDelim;
+          }
+          cBuf = boost::lexical_cast<ConversionBufferType>(*(arPop++));
+          size_t szSpeciesNum = strlen(cBuf.c_array());
+          strncpy(pCurrOL, cBuf.c_array(), szSpeciesNum);
+          pCurrOL += szSpeciesNum;
+        }
+      }
+      *(pCurrOL++) = '\n';
+      arPop -= szPopulation;
+
+      const std::streamsize szLine = pCurrOL - ptrLine;
+      for(UINTEGER l = 0; l < unLines; ++l)
+        bFailed |= (szLine != ptrText->sputn(ptrLine, szLine));
+    }
+
+    if(NULL != ptrBinary)
+    {
+      const std::streamsize szRow = szPopulation * sizeof(UINTEGER);
+      for(UINTEGER l = 0; l < unLines; ++l)
+        bFailed |= (szRow != ptrBinary->sputn(reinterpret_cast<const char *>(arPop), szRow));
+    }
+  }
+
+#ifdef HAVE_THREADS
+  //! Writer thread routine
+  void TrajectoryWriter::run()
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    while(true)
+    {
+      cvNotEmpty.wait(lock, [this] { return bStop||(unCount > 0); });
+      if(0 == unCount)
+        break; // stop requested & nothing left to write
+
+      // format & write the oldest buffer without holding the lock
+      const UINTEGER unSlot = unHead;
+      lock.unlock();
+      output(arBuffers + unSlot * szPopulation, arLines[unSlot]);
+      lock.lock();
+
+      unHead = (unHead + 1) % unBuffers;
+      --unCount;
+      cvNotFull.notify_all();
+    }
+  }
+#endif
+
+} } // close namespaces util and pssalib
@@ -149,7 +149,9 @@ protected:
                                                                                     "\n0,dm - Gillespie's Direct Method"
                                                                                     "\n1,pdm - Partial Propensity Direct Method"
                                                                                     "\n2,pssacr - pSSA with Composition-Rejection Sampling"
-                                                                                    "\n3,spdm - Sorting Partial Propensity Direct Method")
+                                                                                    "\n3,spdm - Sorting Partial Propensity Direct Method"
+                                                                                    "\n4,dmtree - Direct Method with a sum tree"
+                                                                                    "\n5,nrm - Next Reaction Method")
         ("verbose,v",                                                               "Output additional information about the simulation")
         ("quiet,q",         prog_opt::value<CLIOptionCounter>()->zero_tokens(),     "Output only essential information about the simulation, "
                                                                                     "may be specified multiple times for a cumulative effect")
@@ -241,6 +243,10 @@ public:
         mapping[STRING("pssacr")] = pssalib::PSSA::M_PSSACR;
         mapping[STRING("3")] = pssalib::PSSA::M_SPDM;
         mapping[STRING("spdm")] = pssalib::PSSA::M_SPDM;
+        mapping[STRING("4")] = pssalib::PSSA::M_DMTree;
+        mapping[STRING("dmtree")] = pssalib::PSSA::M_DMTree;
+        mapping[STRING("5")] = pssalib::PSSA::M_NRM;
+        mapping[STRING("nrm")] = pssalib::PSSA::M_NRM;
 
         CLIOptionCommaSeparatedList methods = vm["methods"].as< CLIOptionCommaSeparatedList >();
         methods.parse(mapping, result, true, false, false);
@@ -384,7 +390,10 @@ public:
     srTrajectory       = 0x01,
     srFinalPopulations = 0x02,
     srTimePoints       = 0x04,
-    srTiming           = 0x08
+    srTiming           = 0x08,
+    srBinaryTrajectory = 0x10,
+    srAvgTrajectory    = 0x20,
+    srHistogram        = 0x40
   } SimulatorResults;
 
 //////////////////////////////
@@ -396,6 +405,28 @@ protected:
   //! Is this a benchmark run?
   bool m_bBenchmark;
 
+  //! Number of sampling threads
+  UINTEGER m_unThreads;
+
+  //! Number of bins in each histogram & maximum number of joint states
+  UINTEGER m_unHistogramBins,
+           m_unHistogramStates;
+
+  //! Random number generator & its seed
+  pssalib::datamodel::SimulationInfo::RNGType
+    m_RNGType;
+  ULINTEGER m_unRNGSeed;
+
+  //! Wall-clock time between checkpoints of the sampling loop in seconds
+  UINTEGER m_unCheckpointInterval;
+
+  //! Skip the samples completed by a previous run
+  bool m_bResume;
+
+  //! Subvolume sampling scheme
+  pssalib::datamodel::SimulationInfo::VolumeSamplingType
+    m_VolumeSampling;
+
   //! Input SBML file
   STRING m_strInputFile;
 
@@ -463,7 +494,10 @@ protected:
                                                                                     "\n0,trajectory - Trajectory of species population"
                                                                                     "\n1,finalVals - Populations at final time (used to compute pdfs)"
                                                                                     "\n2,timePoints - Output the time points to a separate file"
-                                                                                    "\n3,timing - Output timing info (only useful if benchmarking is on)")
+                                                                                    "\n3,timing - Output timing info (only useful if benchmarking is on)"
+                                                                                    "\n4,binaryTrajectories - Trajectory of species population in binary format"
+                                                                                    "\n5,averageTrajectory - Mean & variance of species population over all samples"
+                                                                                    "\n6,histograms - Histograms of populations at final time accumulated over all samples")
         ("total-volume",    prog_opt::value<REAL>()->default_value(1.0),            "Size of the total volume")
         ("bndcond",         prog_opt::value< CLIOptionCommaSeparatedList >(),       "Boundary conditions, can be either:"
                                                                                     "\n0,\"periodic\""
@@ -478,6 +512,20 @@ protected:
                                                                                     "\n2,\"multiply\" - the population is multiplied, i.e. each subvolume gets the total population")
         ("log,l",                                                                   "Log simulation engine output to a file in the output subdir")
         ("benchmark,b",                                                             "Benchmark the algorithm (suppresses most outputs and produces timing data)")
+        ("threads,j",       prog_opt::value<UINTEGER>()->default_value(1),          "Number of threads used to sample the ensemble")
+        ("histogram-bins",  prog_opt::value<UINTEGER>()->default_value(256),        "Number of bins in the histogram of each species in each subvolume")
+        ("histogram-states",prog_opt::value<UINTEGER>()->default_value(0),          "Maximum number of the most frequent joint states written in the histograms (0 - disabled)")
+        ("rng",             prog_opt::value< CLIOptionCommaSeparatedList >(),       "Random number generator, can be either:"
+                                                                                    "\n0,\"gsl\" - generator selected by GSL_RNG_TYPE"
+                                                                                    "\n1,\"philox\" - counter-based generator, each sample is reproducible on its own")
+        ("seed",            prog_opt::value<ULINTEGER>()->default_value(0),         "Seed of the random number generator (0 - automatic)")
+        ("checkpoint-interval", prog_opt::value<UINTEGER>()->default_value(0),      "Save the state of the sampling loop every given number of seconds & resume "
+                                                                                    "from the checkpoint found in the output directory (0 - disabled)")
+        ("resume",                                                                  "Record completed samples & skip those recorded by a previous run with the same "
+                                                                                    "settings, raise --num-samples to extend the ensemble")
+        ("volume-sampling", prog_opt::value< CLIOptionCommaSeparatedList >(),       "Subvolume sampling scheme for spatial simulations, can be either:"
+                                                                                    "\n0,\"cr\" - composition-rejection sampling of subvolume propensities"
+                                                                                    "\n1,\"nsm\" - Next Subvolume Method, subvolume firing times in a priority queue")
         ;
 
       return true;
@@ -508,6 +556,12 @@ public:
       os << "'Time Points'" << delim;
     if(m_unResults & srTiming)
       os << "'Timing'" << delim;
+    if(m_unResults & srBinaryTrajectory)
+      os << "'Binary Population Trajectories'" << delim;
+    if(m_unResults & srAvgTrajectory)
+      os << "'Average Population Trajectory'" << delim;
+    if(m_unResults & srHistogram)
+      os << "'Histograms of Populations at Final Timepoints'" << delim;
   }
 
   /**
@@ -521,6 +575,19 @@ public:
 
     m_bLog = m_bBenchmark = false;
 
+    m_unThreads = 1;
+
+    m_unHistogramBins = 256;
+    m_unHistogramStates = 0;
+
+    m_RNGType = pssalib::datamodel::SimulationInfo::rngGSL;
+    m_unRNGSeed = 0;
+
+    m_unCheckpointInterval = 0;
+    m_bResume = false;
+
+    m_VolumeSampling = pssalib::datamodel::SimulationInfo::vsCompositionRejection;
+
     m_dTotalVolume = std::numeric_limits<REAL>::min(); // < 0 => not set
 
     m_InitPop = pssalib::datamodel::detail::IP_Invalid;
@@ -565,6 +632,12 @@ public:
         mapping[STRING("timePoints")] = srTimePoints;//pssalib::datamodel::SimulationInfo::ofTimePoints;
         mapping[STRING("3")] = srTiming;//pssalib::datamodel::SimulationInfo::ofTiming;
         mapping[STRING("timing")] = srTiming;//pssalib::datamodel::SimulationInfo::ofTiming;
+        mapping[STRING("4")] = srBinaryTrajectory;//pssalib::datamodel::SimulationInfo::ofBinaryTrajectory;
+        mapping[STRING("binaryTrajectories")] = srBinaryTrajectory;//pssalib::datamodel::SimulationInfo::ofBinaryTrajectory;
+        mapping[STRING("5")] = srAvgTrajectory;//pssalib::datamodel::SimulationInfo::ofAvgTrajectory;
+        mapping[STRING("averageTrajectory")] = srAvgTrajectory;//pssalib::datamodel::SimulationInfo::ofAvgTrajectory;
+        mapping[STRING("6")] = srHistogram;//pssalib::datamodel::SimulationInfo::ofHistogram;
+        mapping[STRING("histograms")] = srHistogram;//pssalib::datamodel::SimulationInfo::ofHistogram;
 
         CLIOptionCommaSeparatedList results = vm["results"].as< CLIOptionCommaSeparatedList >();
         results.parse(mapping, result, true, true, false);
@@ -694,6 +767,81 @@ public:
       m_bLog = (vm.count("log") > 0);
       m_bBenchmark = (vm.count("benchmark") > 0);
 
+      if(vm.count("threads") > 0)
+        m_unThreads = std::max(vm["threads"].as<UINTEGER>(), (UINTEGER)1);
+
+      if(vm.count("histogram-bins") > 0)
+        m_unHistogramBins = std::max(vm["histogram-bins"].as<UINTEGER>(), (UINTEGER)2);
+
+      if(vm.count("histogram-states") > 0)
+        m_unHistogramStates = vm["histogram-states"].as<UINTEGER>();
+
+      if(vm.count("rng") > 0)
+      {
+        mapping.clear();
+        result.clear();
+
+        mapping[STRING("0")] = pssalib::datamodel::SimulationInfo::rngGSL;
+        mapping[STRING("gsl")] = pssalib::datamodel::SimulationInfo::rngGSL;
+        mapping[STRING("1")] = pssalib::datamodel::SimulationInfo::rngPhilox;
+        mapping[STRING("philox")] = pssalib::datamodel::SimulationInfo::rngPhilox;
+
+        CLIOptionCommaSeparatedList rng = vm["rng"].as< CLIOptionCommaSeparatedList >();
+        rng.parse(mapping, result, false, true, true);
+
+        if(0 == result.size())
+        {
+          PSSALIB_MPI_CERR_OR_NULL << "Error: invalid random number generator. Valid values are:\n\n";
+          std::for_each(mapping.begin(), mapping.end(),
+                        printPairFirst<MAPPING_TYPE::value_type>(PSSALIB_MPI_CERR_OR_NULL, "\t"));
+          PSSALIB_MPI_CERR_OR_NULL << "\n\n";
+          return false;
+        }
+        else
+        {
+          m_RNGType = (pssalib::datamodel::SimulationInfo::RNGType)(*(result.begin()));
+        }
+      }
+      else // default
+        m_RNGType = pssalib::datamodel::SimulationInfo::rngGSL;
+
+      if(vm.count("seed") > 0)
+        m_unRNGSeed = vm["seed"].as<ULINTEGER>();
+
+      if(vm.count("checkpoint-interval") > 0)
+        m_unCheckpointInterval = vm["checkpoint-interval"].as<UINTEGER>();
+
+      m_bResume = (vm.count("resume") > 0);
+
+      if(vm.count("volume-sampling") > 0)
+      {
+        mapping.clear();
+        result.clear();
+
+        mapping[STRING("0")] = pssalib::datamodel::SimulationInfo::vsCompositionRejection;
+        mapping[STRING("cr")] = pssalib::datamodel::SimulationInfo::vsCompositionRejection;
+        mapping[STRING("1")] = pssalib::datamodel::SimulationInfo::vsNextSubvolume;
+        mapping[STRING("nsm")] = pssalib::datamodel::SimulationInfo::vsNextSubvolume;
+
+        CLIOptionCommaSeparatedList vs = vm["volume-sampling"].as< CLIOptionCommaSeparatedList >();
+        vs.parse(mapping, result, false, true, true);
+
+        if(0 == result.size())
+        {
+          PSSALIB_MPI_CERR_OR_NULL << "Error: invalid subvolume sampling scheme. Valid values are:\n\n";
+          std::for_each(mapping.begin(), mapping.end(),
+                        printPairFirst<MAPPING_TYPE::value_type>(PSSALIB_MPI_CERR_OR_NULL, "\t"));
+          PSSALIB_MPI_CERR_OR_NULL << "\n\n";
+          return false;
+        }
+        else
+        {
+          m_VolumeSampling = (pssalib::datamodel::SimulationInfo::VolumeSamplingType)(*(result.begin()));
+        }
+      }
+      else // default
+        m_VolumeSampling = pssalib::datamodel::SimulationInfo::vsCompositionRejection;
+
       m_dTimeStep = vm["dt"].as<REAL>();
 
       if(vm.count("total-volume"))
@@ -726,6 +874,46 @@ public:
   {
     return m_bBenchmark;
   }
+
+  UINTEGER getNumThreads() const
+  {
+    return m_unThreads;
+  }
+
+  UINTEGER getHistogramBins() const
+  {
+    return m_unHistogramBins;
+  }
+
+  UINTEGER getHistogramStates() const
+  {
+    return m_unHistogramStates;
+  }
+
+  pssalib::datamodel::SimulationInfo::RNGType getRNGType() const
+  {
+    return m_RNGType;
+  }
+
+  ULINTEGER getRNGSeed() const
+  {
+    return m_unRNGSeed;
+  }
+
+  UINTEGER getCheckpointInterval() const
+  {
+    return m_unCheckpointInterval;
+  }
+
+  bool isResumeSet() const
+  {
+    return m_bResume;
+  }
+
+  pssalib::datamodel::SimulationInfo::VolumeSamplingType getVolumeSampling() const
+  {
+    return m_VolumeSampling;
+  }
   
   const STRING & getInputFile() const
   {
@@ -809,6 +997,9 @@ protected:
   //! Output format
   AnalyzerFormats m_Format;
 
+  //! Number of threads used to process the data set
+  UINTEGER m_unThreads;
+
 //////////////////////////////
 // Constructors
 public:
@@ -849,6 +1040,7 @@ protected:
                                                                                    "\n2,pdf - Compute the PDF using populations at final time"
                                                                                    "\n3,timing - Analyze timing information obtained from benchmarking")
         ("format,f",       prog_opt::value<STRING>()->default_value(STRING("csv")),"Output format, one of \"csv\", \"gnuplot\" or \"vtk\".")
+        ("threads,j",      prog_opt::value<UINTEGER>()->default_value(1),          "Number of threads used to process the data set")
 //         ("log,l",                                                                  "Log simulation engine output to a file in the output subdir")
         ;
 
@@ -892,6 +1084,8 @@ public:
     m_bLog = false;
 
     m_unResults = 0;
+
+    m_unThreads = 1;
   }
 
   virtual bool parseVariableMap(prog_opt::variables_map & vm)
@@ -970,6 +1164,9 @@ public:
       else // default
         m_Format = afCSV;
 
+      if(vm.count("threads") > 0)
+        m_unThreads = std::max(vm["threads"].as<UINTEGER>(), (UINTEGER)1);
+
       return true;
     }
     catch (prog_opt::error &e)
@@ -1007,6 +1204,11 @@ public:
   {
     return m_unResults;
   }
+
+  UINTEGER getNumThreads() const
+  {
+    return m_unThreads;
+  }
 };
 
 void printVariableMap(prog_opt::variables_map & vm, std::ostream & os)
@@ -25,12 +25,11 @@
 #include "util/Timing.h"
 #include "util/IO.hpp"
 #include "util/SimulationDataSource.hpp"
+#include "util/EnsembleStatistics.h"
 
 #include "CmdLineOptions.hpp"
 using namespace pssalib::program_options;
 
-#include <boost/uuid/detail/sha1.hpp>
-
 // null stream
 pssalib::io::null_streambuf< STRING::value_type > nullBuffer;
 OSTREAM nullStream(&nullBuffer);
@@ -79,7 +78,8 @@ protected:
                         m_dTimeEnd,
                         m_dTimeStep;
 
-  UINTEGER              m_unSamples;
+  UINTEGER              m_unSamples,
+                        m_unThreads;
 
   bool                  m_bQuiet,
                         m_bVerbose;
@@ -170,6 +170,13 @@ public:
     // Format
     m_Format = poAnalyzer.getFormat();
 
+    // Threads
+#ifdef HAVE_THREADS
+    m_unThreads = poAnalyzer.getNumThreads();
+#else
+    m_unThreads = 1;
+#endif
+
     // check if number of trials does not exceed that in the simulation dataset
     m_unSamples = poSimulator.getNumSamples();
     if(poAnalyzer.isNumSamplesSet())
@@ -275,6 +282,11 @@ public:
     return m_unSamples;
   }
 
+  UINTEGER getNumThreads() const
+  {
+    return m_unThreads;
+  }
+
   REAL getTimeInitial() const
   {
     return m_dTimeInitial;
@@ -333,6 +345,40 @@ const char *arGnuPlotHeaderTrajectories = \
   "set xlabel '%s'\n" \
   "set grid\n";
 
+/**
+ * Construct the path to the trajectory of a given sample, the binary
+ * trajectory is preferred over the text one if both are present
+ * 
+ * @param strInputPath Path to the input data set
+ * @param n Sample index
+ * @param strFilePath Path to the trajectory file [OUT]
+ */
+void makeTrajectoryFilePath(const STRING & strInputPath, UINTEGER n, STRING & strFilePath)
+{
+  STRING strFileName((BOOSTFORMAT
+    (pssalib::datamodel::SimulationInfo::arFileNames[
+      pssalib::datamodel::SimulationInfo::outputFlagToStreamIndex(
+        pssalib::datamodel::SimulationInfo::ofBinaryTrajectory)
+    ]) % n).str());
+
+  pssalib::util::makeFilePath(strInputPath,
+                              strFileName,
+                              strFilePath);
+
+  if(std::ifstream(strFilePath.c_str(), std::ios_base::in | std::ios_base::binary).good())
+    return;
+
+  strFileName = (BOOSTFORMAT
+    (pssalib::datamodel::SimulationInfo::arFileNames[
+      pssalib::datamodel::SimulationInfo::outputFlagToStreamIndex(
+        pssalib::datamodel::SimulationInfo::ofTrajectory)
+    ]) % n).str();
+
+  pssalib::util::makeFilePath(strInputPath,
+                              strFileName,
+                              strFilePath);
+}
+
 /**
  * Generate trajectories form an input data set
  * 
@@ -418,16 +464,8 @@ bool generateTrajectories(const STRING & strInputPath,
   SimulationDataSource sds;
   for(UINTEGER n = 0; n < analyzerData.getNumSamples(); ++n)
   {
-    STRING strFileName((BOOSTFORMAT
-      (pssalib::datamodel::SimulationInfo::arFileNames[
-        pssalib::datamodel::SimulationInfo::outputFlagToStreamIndex(
-          pssalib::datamodel::SimulationInfo::ofTrajectory)
-      ]) % n).str()),
-           strFilePath;
-
-    pssalib::util::makeFilePath(strInputPath,
-                                strFileName,
-                                strFilePath);
+    STRING strFileName, strFilePath;
+    makeTrajectoryFilePath(strInputPath, n, strFilePath);
 
     if(!sds.load(strFilePath, rangeTime, rangeSpecies, rangeSubvolumes))
     {
@@ -470,6 +508,60 @@ bool generateTrajectories(const STRING & strInputPath,
   return true;
 }
 
+/**
+ * Accumulate the means & M2 of the trajectories in a range of samples
+ * 
+ * @param strInputPath Path to the input data set
+ * @param unBegin First sample of the range
+ * @param unEnd Past the last sample of the range
+ * @param rangeTime Initial and final time points to be processed
+ * @param rangeSpecies Pointer to an array containing species indexes
+ * @param rangeSubvolumes Pointer to an array containing subvolume indexes
+ * @param unParseThreads Maximum number of threads used to parse a trajectory
+ * @param esTrajectories Accumulator of the range [OUT]
+ * @param bFailed Flag raised once any range fails [IN/OUT]
+ */
+void accumulateTrajectories(const STRING & strInputPath, UINTEGER unBegin, UINTEGER unEnd,
+                            const std::pair<UINTEGER, UINTEGER> & rangeTime,
+                            const std::pair< const UINTEGER *, const UINTEGER * > & rangeSpecies,
+                            const std::pair< const UINTEGER *, const UINTEGER * > & rangeSubvolumes,
+                            UINTEGER unParseThreads,
+                            pssalib::util::EnsembleStatistics & esTrajectories,
+                            std::atomic<bool> & bFailed)
+{
+  SimulationDataSource sdsInput;
+  sdsInput.setNumThreads(unParseThreads);
+  std::vector<REAL> arRow;
+  for(UINTEGER n = unBegin; (n < unEnd)&&!bFailed; ++n)
+  {
+    STRING strFilePath;
+    makeTrajectoryFilePath(strInputPath, n, strFilePath);
+
+    if(!sdsInput.load(strFilePath, rangeTime, rangeSpecies, rangeSubvolumes))
+    {
+      PSSALIB_MPI_CERR_OR_NULL << "failed to process file '" << strFilePath  << "'.\n";
+      bFailed = true;
+      return;
+    }
+
+    const UINTEGER unSpecies = sdsInput.getSpecies(), unSubvolumes = sdsInput.getSubvolumes();
+    if(!esTrajectories.isAllocated())
+    {
+      esTrajectories.allocate(unSpecies * unSubvolumes, unSubvolumes, sdsInput.getTimePoints());
+      arRow.resize(unSpecies * unSubvolumes);
+    }
+
+    esTrajectories.begin();
+    for(UINTEGER t = 0; t < sdsInput.getTimePoints(); ++t)
+    {
+      for(UINTEGER sv = 0; sv < unSubvolumes; ++sv)
+        for(UINTEGER sp = 0; sp < unSpecies; ++sp)
+          arRow[sv * unSpecies + sp] = sdsInput.at(t, sp, sv);
+      esTrajectories.add(arRow.data(), 1);
+    }
+  }
+}
+
 //! GNU Plot output header for an averaged trajectory
 const char *arGnuPlotHeaderAverageTrajectories = \
   "set title '%s'\n" \
@@ -550,43 +642,56 @@ bool computeAvgTrajectories(const STRING & strInputPath,
     }
   }
  
-  // Result
-  SimulationDataSource sdsInput, sdsResult(unTimePoints, 2 * analyzerData.getSpeciesIdx().size(), analyzerData.getSubvolumesIdx().size());
-  const REAL dInvSamples = REAL(analyzerData.getNumSamples());
-  for(UINTEGER n = 0; n < analyzerData.getNumSamples(); ++n)
-  {
-    STRING strFileName((BOOSTFORMAT
-      (pssalib::datamodel::SimulationInfo::arFileNames[
-        pssalib::datamodel::SimulationInfo::outputFlagToStreamIndex(
-          pssalib::datamodel::SimulationInfo::ofTrajectory)
-      ]) % n).str()),
-           strFilePath;
-
-    pssalib::util::makeFilePath(strInputPath,
-                                strFileName,
-                                strFilePath);
+  // Accumulate the trajectories, split into ranges of consecutive samples
+  const UINTEGER unSamples = analyzerData.getNumSamples();
+  const UINTEGER unRanges = std::max(1u, std::min(analyzerData.getNumThreads(), unSamples));
+  boost::scoped_array<pssalib::util::EnsembleStatistics> arStatistics(new pssalib::util::EnsembleStatistics[unRanges]);
+  std::atomic<bool> bFailed(false);
+
+  // each range is parsed by a single thread, so that reading the files of
+  // some ranges overlaps with parsing those of the others
+  const UINTEGER unParseThreads = (unRanges > 1) ? 1 : 0;
+#ifdef HAVE_THREADS
+  std::vector<std::thread> arThreads;
+  for(UINTEGER ri = 1; ri < unRanges; ++ri)
+    arThreads.push_back(std::thread(accumulateTrajectories, std::cref(strInputPath),
+      UINTEGER((std::uint64_t(unSamples) * ri) / unRanges), UINTEGER((std::uint64_t(unSamples) * (ri + 1)) / unRanges),
+      std::cref(rangeTime), std::cref(rangeSpecies), std::cref(rangeSubvolumes), unParseThreads,
+      std::ref(arStatistics[ri]), std::ref(bFailed)));
+#endif
+  accumulateTrajectories(strInputPath, 0, unSamples / unRanges, rangeTime, rangeSpecies, rangeSubvolumes,
+                         unParseThreads, arStatistics[0], bFailed);
+#ifdef HAVE_THREADS
+  for(std::size_t ti = 0; ti < arThreads.size(); ++ti)
+    arThreads[ti].join();
+#endif
+  if(bFailed)
+    return false;
 
-    if(!sdsInput.load(strFilePath, rangeTime, rangeSpecies, rangeSubvolumes))
+  // Combine the ranges
+  pssalib::util::EnsembleStatistics & esTrajectories = arStatistics[0];
+  for(UINTEGER ri = 1; ri < unRanges; ++ri)
+  {
+    if(!esTrajectories.merge(arStatistics[ri]))
     {
-      PSSALIB_MPI_CERR_OR_NULL << "failed to process file '" << strFilePath  << "'.\n";
+      PSSALIB_MPI_CERR_OR_NULL << "Error : inconsistent dimensions of the trajectories in '" << strInputPath  << "'.\n";
       return false;
     }
+  }
 
-    for(UINTEGER t = 0; t < sdsInput.getTimePoints(); ++t)
+  // Result
+  SimulationDataSource sdsResult(unTimePoints, 2 * analyzerData.getSpeciesIdx().size(), analyzerData.getSubvolumesIdx().size());
+  const UINTEGER nsp = analyzerData.getSpeciesIdx().size(), nsv = analyzerData.getSubvolumesIdx().size();
+  for(UINTEGER t = 0; t < esTrajectories.getRows(); ++t)
+  {
+    const REAL * ptrRow = esTrajectories.getData() + t * esTrajectories.getRowSize();
+    const REAL * ptrMean = ptrRow + 1, * ptrM2 = ptrMean + nsp * nsv;
+    for(UINTEGER sv = 0; sv < nsv; ++sv)
     {
-      for(UINTEGER sp = 0, nsp = sdsInput.getSpecies(); sp < sdsInput.getSpecies(); ++sp)
+      for(UINTEGER sp = 0; sp < nsp; ++sp)
       {
-        for(UINTEGER sv = 0; sv < sdsInput.getSubvolumes(); ++sv)
-        {
-          REAL x = sdsInput.at(t, sp, sv),
-               x_mean = sdsResult.at(t, sp, sv);
-          REAL dlt = x - x_mean;
-          x_mean += dlt / REAL(n + 1);
-          REAL dlt2 = x - x_mean;
-
-          sdsResult.at(t, sp, sv) = x_mean;
-          sdsResult.at(t, sp + nsp, sv) += dlt * dlt2 * dInvSamples;
-        }
+        sdsResult.at(t, sp, sv) = ptrMean[sv * nsp + sp];
+        sdsResult.at(t, sp + nsp, sv) = ptrM2[sv * nsp + sp] / ptrRow[0];
       }
     }
   }
@@ -626,23 +731,158 @@ bool computeAvgTrajectories(const STRING & strInputPath,
 
 typedef struct tagPDFInfo
 {
+  std::uint64_t hash;
   UINTEGER idx, cnt;
 
   tagPDFInfo()
-    : idx(0)
+    : hash(0)
+    , idx(0)
     , cnt(0)
   {
     // Do nothing
   }
 
-  tagPDFInfo(UINTEGER i, UINTEGER c)
-    : idx(i)
+  tagPDFInfo(std::uint64_t h, UINTEGER i, UINTEGER c)
+    : hash(h)
+    , idx(i)
     , cnt(c)
   {
     // Do nothing
   }
 } PDFInfo;
 
+/**
+ * @class PDFTable
+ * @brief Counts the samples in each distinct state using an open-addressing
+ * hash table. Each entry refers to the first sample found in a state, states
+ * with equal hashes are told apart by comparing the populations.
+ */
+class PDFTable
+{
+protected:
+  const UINTEGER        *m_arStates; //!< populations of all samples
+  std::size_t           m_szState;   //!< number of values in a population
+  std::vector<PDFInfo>  m_arSlots;   //!< slots, empty ones have zero count
+  std::size_t           m_szEntries; //!< number of occupied slots
+
+public:
+  PDFTable(const UINTEGER * arStates, std::size_t szState)
+    : m_arStates(arStates)
+    , m_szState(szState)
+    , m_arSlots(64)
+    , m_szEntries(0)
+  {
+    // Do nothing
+  }
+
+  //! Hash the population of a sample
+  std::uint64_t hash(UINTEGER idx) const
+  {
+    const UINTEGER * arState = m_arStates + std::size_t(idx) * m_szState;
+    std::uint64_t h = 0x9E3779B97F4A7C15ull ^ m_szState;
+    for(std::size_t i = 0; i < m_szState; ++i)
+    {
+      h = (h ^ arState[i]) * 0xFF51AFD7ED558CCDull;
+      h ^= h >> 32;
+    }
+    h *= 0xC4CEB9FE1A85EC53ull;
+    return h ^ (h >> 29);
+  }
+
+  //! Count samples in the state of a given sample
+  void add(const PDFInfo & info)
+  {
+    if(2 * (m_szEntries + 1) > m_arSlots.size())
+      grow();
+
+    const std::size_t mask = m_arSlots.size() - 1;
+    const UINTEGER * arState = m_arStates + std::size_t(info.idx) * m_szState;
+    for(std::size_t s = info.hash & mask; ; s = (s + 1) & mask)
+    {
+      PDFInfo & slot = m_arSlots[s];
+      if(0 == slot.cnt)
+      {
+        slot = info;
+        ++m_szEntries;
+        return;
+      }
+      else if((info.hash == slot.hash)&&std::equal(arState, arState + m_szState,
+                m_arStates + std::size_t(slot.idx) * m_szState))
+      {
+        slot.idx = std::min(slot.idx, info.idx);
+        slot.cnt += info.cnt;
+        return;
+      }
+    }
+  }
+
+  //! Combine the counts of another table with this one
+  void merge(const PDFTable & other)
+  {
+    for(std::vector<PDFInfo>::const_iterator it = other.m_arSlots.begin(); it != other.m_arSlots.end(); ++it)
+      if(0 != it->cnt)
+        add(*it);
+  }
+
+  //! Get the distinct states in the order of their first occurrence
+  void getEntries(std::vector<PDFInfo> & arEntries) const
+  {
+    arEntries.clear();
+    arEntries.reserve(m_szEntries);
+    for(std::vector<PDFInfo>::const_iterator it = m_arSlots.begin(); it != m_arSlots.end(); ++it)
+      if(0 != it->cnt)
+        arEntries.push_back(*it);
+    std::sort(arEntries.begin(), arEntries.end(),
+              [](const PDFInfo & a, const PDFInfo & b) { return a.idx < b.idx; });
+  }
+
+protected:
+  //! Double the number of slots
+  void grow()
+  {
+    std::vector<PDFInfo> arSlots(2 * m_arSlots.size());
+    arSlots.swap(m_arSlots);
+    m_szEntries = 0;
+    for(std::vector<PDFInfo>::const_iterator it = arSlots.begin(); it != arSlots.end(); ++it)
+      if(0 != it->cnt)
+        add(*it);
+  }
+};
+
+/**
+ * Count the samples in each distinct state for a range of samples
+ * 
+ * @param sdsInput Populations of all samples
+ * @param arStates Integer populations of all samples [OUT]
+ * @param table Table to count the samples in [IN/OUT]
+ * @param unBegin First sample of the range
+ * @param unEnd Past the last sample of the range
+ * @param bResult @c false if a population is not a non-negative integer [OUT]
+ */
+void countPDFStates(SimulationDataSource & sdsInput, UINTEGER * arStates, PDFTable & table,
+                    UINTEGER unBegin, UINTEGER unEnd, bool & bResult)
+{
+  const UINTEGER unSpecies = sdsInput.getSpecies(), unSubvolumes = sdsInput.getSubvolumes();
+  bResult = true;
+  for(UINTEGER i = unBegin; i < unEnd; ++i)
+  {
+    UINTEGER * arState = arStates + std::size_t(i) * unSpecies * unSubvolumes;
+    for(UINTEGER k = 0; k < unSubvolumes; ++k)
+      for(UINTEGER j = 0; j < unSpecies; ++j)
+      {
+        const REAL x = sdsInput.at(i, j, k);
+        if(!(x >= 0.0)||(x > REAL(std::numeric_limits<UINTEGER>::max()))||(x != std::floor(x)))
+        {
+          bResult = false;
+          return;
+        }
+        arState[k * unSpecies + j] = UINTEGER(x);
+      }
+
+    table.add(PDFInfo(table.hash(i), i, 1));
+  }
+}
+
 /**
  * Generate trajectories form an input data set
  * 
@@ -715,62 +955,58 @@ bool computePDF(const STRING & strInputPath,
     return false;
   }
 
-//   SHA1 sha1Hasher;
-  boost::uuids::detail::sha1 sha1Hasher;
-  unsigned int sha1Hash[5] = {0};
-  std::array<unsigned int, 5> sha1HashArray;
-  std::map<std::array<unsigned int, 5>, PDFInfo> mapPDFInfo;
-  boost::scoped_array<REAL> arInputRow(new REAL[sdsInput.getSpecies() * sdsInput.getSubvolumes()]);
-
-  for(UINTEGER i = 0; i < analyzerData.getNumSamples(); ++i)
-  {
-    for(UINTEGER j = 0; j < sdsInput.getSpecies(); ++j)
-      for(UINTEGER k = 0, kj = j * sdsInput.getSubvolumes(); k < sdsInput.getSubvolumes(); ++k)
-        arInputRow[k + kj] = sdsInput.at(i, j, k);
-
-    sha1Hasher.reset();
-    sha1Hasher.process_bytes(arInputRow.get(), sizeof(REAL) * sdsInput.getSpecies() * sdsInput.getSubvolumes());
-    sha1Hasher.get_digest(sha1Hash);
-//     unsigned int hash[5] = {0};
-//     std::array<unsigned int, 5> sha1HashArray;
-    std::copy(std::begin(sha1Hash), std::end(sha1Hash), sha1HashArray.begin());
-//     const char * sha1Hash = (const char *)sha1Hasher.getDigest();
-//     STRING strTemp(sha1Hash);
-//     delete [] sha1Hash;
-//     // Back to string
-//     char buf[41] = {0};
-// 
-//     for (int i = 0; i < 5; i++)
-//     {
-//         std::sprintf(buf + (i << 3), "%08x", hash[i]);
-//     }
+  if(sdsInput.getTimePoints() < analyzerData.getNumSamples())
+  {
+    PSSALIB_MPI_CERR_OR_NULL << "Error: file '" << strFilePath  << "' contains only "
+      << sdsInput.getTimePoints() << " samples.\n";
+    return false;
+  }
 
-    std::map<std::array<unsigned int, 5>, PDFInfo>::iterator
-      itMap = mapPDFInfo.find(sha1HashArray);
+  // Count the samples in each state, split into shards of consecutive samples
+  const std::size_t szState = std::size_t(sdsInput.getSpecies()) * sdsInput.getSubvolumes();
+  const UINTEGER unSamples = analyzerData.getNumSamples();
+  const UINTEGER unShards = std::max(1u, std::min(analyzerData.getNumThreads(), unSamples / 1024));
+  std::vector<UINTEGER> arStates(std::size_t(unSamples) * szState);
+  std::vector<PDFTable> arTables(unShards, PDFTable(arStates.data(), szState));
+  boost::scoped_array<bool> arResults(new bool[unShards]);
+
+#ifdef HAVE_THREADS
+  std::vector<std::thread> arThreads;
+  for(UINTEGER si = 1; si < unShards; ++si)
+    arThreads.push_back(std::thread(countPDFStates, std::ref(sdsInput), arStates.data(), std::ref(arTables[si]),
+      UINTEGER((std::uint64_t(unSamples) * si) / unShards), UINTEGER((std::uint64_t(unSamples) * (si + 1)) / unShards),
+      std::ref(arResults[si])));
+#endif
+  countPDFStates(sdsInput, arStates.data(), arTables[0], 0, unSamples / unShards, arResults[0]);
+#ifdef HAVE_THREADS
+  for(std::size_t ti = 0; ti < arThreads.size(); ++ti)
+    arThreads[ti].join();
+#endif
 
-    if(mapPDFInfo.end() == itMap)
-    {
-      mapPDFInfo[sha1HashArray] = PDFInfo(i, 1);
-    }
-    else
+  for(UINTEGER si = 0; si < unShards; ++si)
+  {
+    if(!arResults[si])
     {
-      itMap->second.cnt++;
+      PSSALIB_MPI_CERR_OR_NULL << "Error: file '" << strFilePath  << "' contains populations that are not non-negative integers.\n";
+      return false;
     }
+    if(si > 0)
+      arTables[0].merge(arTables[si]);
   }
 
+  std::vector<PDFInfo> arPDFInfo;
+  arTables[0].getEntries(arPDFInfo);
+
   // Result
-  SimulationDataSource sdsResult(mapPDFInfo.size(), 1 + sdsInput.getSpecies() * sdsInput.getSubvolumes());
+  SimulationDataSource sdsResult(arPDFInfo.size(), 1 + szState);
 
-  REAL dInvN = 1.0 / (REAL)analyzerData.getNumSamples(); UINTEGER n = 0;
-  for(std::map<std::array<unsigned int, 5>, PDFInfo>::iterator itMap = mapPDFInfo.begin();
-      mapPDFInfo.end() != itMap; itMap++, n++)
+  REAL dInvN = 1.0 / (REAL)unSamples;
+  for(UINTEGER n = 0; n < arPDFInfo.size(); n++)
   {
-    sdsResult.at(n, 0) = ((REAL)itMap->second.cnt) * dInvN;
-    for(UINTEGER k = 0, i = itMap->second.idx; k < sdsInput.getSubvolumes(); k++)
-      for(UINTEGER j = 0, jk = k * sdsInput.getSpecies(); j < sdsInput.getSpecies(); ++j)
-      {
-        sdsResult.at(n, j+jk+1) = sdsInput.at(i, j, k);
-      }
+    sdsResult.at(n, 0) = ((REAL)arPDFInfo[n].cnt) * dInvN;
+    const UINTEGER * arState = arStates.data() + std::size_t(arPDFInfo[n].idx) * szState;
+    for(std::size_t i = 0; i < szState; ++i)
+      sdsResult.at(n, i + 1) = REAL(arState[i]);
   }
 
   pssalib::util::makeFilePath(strOutputPath,
@@ -951,7 +1187,7 @@ int main(int argc, char** argv)
 
     if(ProgramOptionsAnalyzer::arTrajectory & poAnalyzer.getResultOutputFlags())
     {
-      if(ProgramOptionsSimulator::srTrajectory & poSimulator.getResultOutputFlags())
+      if((ProgramOptionsSimulator::srTrajectory | ProgramOptionsSimulator::srBinaryTrajectory) & poSimulator.getResultOutputFlags())
       {
         if(!generateTrajectories(inputPathCurr, outputPathCurr, analyzerData))
         {
@@ -970,7 +1206,7 @@ int main(int argc, char** argv)
 
     if(ProgramOptionsAnalyzer::arAverageTrajectory & poAnalyzer.getResultOutputFlags())
     {
-      if(ProgramOptionsSimulator::srTrajectory & poSimulator.getResultOutputFlags())
+      if((ProgramOptionsSimulator::srTrajectory | ProgramOptionsSimulator::srBinaryTrajectory) & poSimulator.getResultOutputFlags())
       {
         if(!computeAvgTrajectories(inputPathCurr, outputPathCurr, analyzerData))
         {
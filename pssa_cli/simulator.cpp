@@ -47,6 +47,18 @@ void handler(int sig)
 }
 #endif
 
+// Interruption of the sampling loop
+#include <csignal>
+
+static pssalib::datamodel::SimulationInfo * ptrInterruptSimInfo = NULL;
+
+void interrupt(int sig)
+{
+  // the sampling loop saves a checkpoint, if enabled, and exits
+  if(NULL != ptrInterruptSimInfo)
+    ptrInterruptSimInfo->bInterruptRequested = true;
+}
+
 // Auxiliary struct
 struct convertResults : public std::unary_function<UINTEGER, UINTEGER>
 {
@@ -61,6 +73,12 @@ struct convertResults : public std::unary_function<UINTEGER, UINTEGER>
       result |= pssalib::datamodel::SimulationInfo::ofTimePoints;
     if(sr & ProgramOptionsSimulator::srTiming)
       result |= pssalib::datamodel::SimulationInfo::ofTiming;
+    if(sr & ProgramOptionsSimulator::srBinaryTrajectory)
+      result |= pssalib::datamodel::SimulationInfo::ofBinaryTrajectory;
+    if(sr & ProgramOptionsSimulator::srAvgTrajectory)
+      result |= pssalib::datamodel::SimulationInfo::ofAvgTrajectory;
+    if(sr & ProgramOptionsSimulator::srHistogram)
+      result |= pssalib::datamodel::SimulationInfo::ofHistogram;
     return result;
   }
 };
@@ -95,6 +113,14 @@ int main(int argc, char** argv)
   }
 
   simInfo.unSamplesTotal = poSimulator.getNumSamples();
+  simInfo.unThreads = poSimulator.getNumThreads();
+  simInfo.unHistogramBins = poSimulator.getHistogramBins();
+  simInfo.unHistogramStates = poSimulator.getHistogramStates();
+  simInfo.eRNGType = poSimulator.getRNGType();
+  simInfo.unRNGSeed = poSimulator.getRNGSeed();
+  simInfo.unCheckpointInterval = poSimulator.getCheckpointInterval();
+  simInfo.bResumeEnsemble = poSimulator.isResumeSet();
+  simInfo.eVolumeSampling = poSimulator.getVolumeSampling();
   simInfo.dTimeStart = poSimulator.getTimeBegin();
   simInfo.dTimeStep = poSimulator.getTimeStep();
   simInfo.dTimeEnd = poSimulator.getTimeEnd();
@@ -154,10 +180,14 @@ int main(int argc, char** argv)
   {
       simInfo.unOutputFlags = ~(
         pssalib::datamodel::SimulationInfo::ofTrace      |
+        pssalib::datamodel::SimulationInfo::eofEvents    |
         pssalib::datamodel::SimulationInfo::ofInfo       |
         pssalib::datamodel::SimulationInfo::ofWarning    |
         pssalib::datamodel::SimulationInfo::ofError      |
         pssalib::datamodel::SimulationInfo::ofTrajectory |
+        pssalib::datamodel::SimulationInfo::ofBinaryTrajectory |
+        pssalib::datamodel::SimulationInfo::ofAvgTrajectory |
+        pssalib::datamodel::SimulationInfo::ofHistogram  |
         pssalib::datamodel::SimulationInfo::ofFinalPops  |
         pssalib::datamodel::SimulationInfo::ofTimePoints);
       simInfo.unOutputFlags |= pssalib::datamodel::SimulationInfo::ofTiming;
@@ -259,11 +289,16 @@ int main(int argc, char** argv)
     simInfo.setOutputStreamBuf(pssalib::datamodel::SimulationInfo::ofSpeciesIDs, &fsbSpecies);
   }
 
+  // Stop sampling gracefully when terminated
+  ptrInterruptSimInfo = &simInfo;
+  signal(SIGINT, interrupt);
+  signal(SIGTERM, interrupt);
+
   ///////////////////////////////////////////
   // Run the simulations looping through SSAs
   bool bResult = true;
   for(std::vector<pssalib::PSSA::EMethod>::const_iterator mi = poSimulator.getMethods().begin();
-      mi != poSimulator.getMethods().end(); mi++)
+      (mi != poSimulator.getMethods().end())&&!simInfo.bInterruptRequested; mi++)
   {
     if(!ptrPSSA->setMethod((*mi)))
     {
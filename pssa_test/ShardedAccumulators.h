@@ -0,0 +1,92 @@
+/**
+ * @file ShardedAccumulators.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Aug 2015
+ * @section LICENSE
+ *
+ * The GPLv2 or any later version is applied to this software, see the LICENSE.txt file.
+ *
+ * @section DESCRIPTION
+ *
+ * Helper for testing accumulators that are filled by several threads or
+ * processes and combined afterwards against a single-pass accumulator
+ */
+
+#pragma once
+
+#include "typedefs.h"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+template<class TAccumulator, UINTEGER N = 3>
+class ShardedAccumulators
+{
+public:
+	//! Accumulator that receives every trial
+	TAccumulator single;
+	//! Shards combined with merge(), in order & in reverse order
+	TAccumulator merged, reversed;
+	//! Shards combined through the raw data, as the processes do
+	TAccumulator flat;
+	//! Accumulators the trials are distributed among
+	TAccumulator shards[N];
+	//! Random numbers of the test
+	std::mt19937 rng;
+
+	ShardedAccumulators()
+		: rng(1234)
+	{
+		// Trials are distributed unevenly
+		std::vector<REAL> weights;
+		for (UINTEGER k = 0; k < N; ++k)
+			weights.push_back(REAL(N - k));
+		shard = std::discrete_distribution<UINTEGER>(weights.begin(), weights.end());
+	}
+
+	//! Allocate all accumulators with the same layout
+	template<typename... Args>
+	void allocate(Args... args)
+	{
+		single.allocate(args...);
+		merged.allocate(args...);
+		reversed.allocate(args...);
+		flat.allocate(args...);
+		for (UINTEGER k = 0; k < N; ++k)
+			shards[k].allocate(args...);
+	}
+
+	//! Pick the shard that receives the next trial
+	TAccumulator & next()
+	{
+		return shards[shard(rng)];
+	}
+
+	//! Check whether an accumulator is the last shard
+	bool isLast(const TAccumulator & target) const
+	{
+		return &target == &shards[N - 1];
+	}
+
+	//! Combine the shards as the threads do, in either order
+	bool merge()
+	{
+		for (UINTEGER k = 0; k < N; ++k)
+		{
+			if (!merged.merge(shards[k]) || !reversed.merge(shards[N - 1 - k]))
+			{
+				std::cerr << "Failed to merge the accumulator of shard " << k << "." << std::endl;
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+private:
+	std::discrete_distribution<UINTEGER> shard;
+};
@@ -66,8 +66,12 @@ bool TestBase::Setup()
   m_SimInfo.pArSpeciesIds = new std::vector<STRING>();
   m_SimInfo.unOutputFlags = ~(
     pssalib::datamodel::SimulationInfo::ofTrace      |
+    pssalib::datamodel::SimulationInfo::eofEvents    |
     pssalib::datamodel::SimulationInfo::ofFinalPops  |
     pssalib::datamodel::SimulationInfo::ofTrajectory |
+    pssalib::datamodel::SimulationInfo::ofBinaryTrajectory |
+    pssalib::datamodel::SimulationInfo::ofAvgTrajectory |
+    pssalib::datamodel::SimulationInfo::ofHistogram |
     pssalib::datamodel::SimulationInfo::ofTiming     |
     pssalib::datamodel::SimulationInfo::ofTimePoints |
     pssalib::datamodel::SimulationInfo::ofStatus);
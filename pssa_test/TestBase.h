@@ -25,7 +25,7 @@ public:
 	TestBase();
 	virtual ~TestBase();
 
-	bool Test();
+	virtual bool Test();
 
 protected:
 	virtual bool Setup();
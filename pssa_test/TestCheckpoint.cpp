@@ -0,0 +1,201 @@
+/**
+ * @file TestCheckpoint.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Aug 2015
+ * @section LICENSE
+ * 
+ * The GPLv2 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Implementation of the test interrupting a run, resuming it from the saved
+ * checkpoint & comparing the output with the one of an uninterrupted run
+ */
+
+#include "TestCheckpoint.h"
+
+#include "util/FileSystem.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+// Number of samples drawn by each run
+static const UINTEGER unSamples = 3;
+
+extern void reaction_callback_wrapper(pssalib::datamodel::DataModel* dm, REAL t, void* user);
+
+// Read a whole output file
+static bool ReadFile(const STRING & path, STRING & contents)
+{
+  std::ifstream ifs(path.c_str(), std::ios_base::in | std::ios_base::binary);
+  if (!ifs.is_open())
+    return false;
+
+  std::ostringstream oss;
+  oss << ifs.rdbuf();
+  contents = oss.str();
+  return true;
+}
+
+TestCheckpoint::TestCheckpoint()
+  : m_ptrSimInfo(NULL)
+  , m_unReactions(0)
+  , m_unStopAt(0)
+{
+}
+
+TestCheckpoint::~TestCheckpoint()
+{
+}
+
+void TestCheckpoint::ReactionCallback(pssalib::datamodel::DataModel* dm, REAL t)
+{
+  // Interrupt the run as if it was killed in the middle of a trial
+  if (++m_unReactions == m_unStopAt)
+    m_ptrSimInfo->bInterruptRequested = true;
+}
+
+bool TestCheckpoint::Sample(const STRING & path, UINTEGER stopAt, bool & completed, REAL rateFactor)
+{
+  pssalib::datamodel::SimulationInfo simInfo;
+
+  std::string inputFile = "sbml/Multimerization.sbml";
+  if (!simInfo.readSBMLFile(inputFile))
+  {
+    std::cerr << "Failed to load model file '" << inputFile << "'." << std::endl;
+    return false;
+  }
+
+  // A different model must not continue the trials of the saved one
+  pssalib::datamodel::detail::Reaction * reaction = simInfo.getModel().getReaction(0);
+  reaction->setForwardRate(reaction->getForwardRate() * rateFactor);
+
+  // Trials restored from a checkpoint continue the same random stream
+  simInfo.eInitialPopulation = pssalib::datamodel::detail::IP_Concentrate;
+  simInfo.eRNGType = pssalib::datamodel::SimulationInfo::rngPhilox;
+  simInfo.unRNGSeed = 1234;
+  simInfo.dTimeStart = 0.0;
+  simInfo.dTimeStep = 0.5;
+  simInfo.dTimeEnd = 10.0;
+  simInfo.unSamplesTotal = unSamples;
+  // Checkpoints are only saved when the run is interrupted
+  simInfo.unCheckpointInterval = 3600;
+  simInfo.strOutput = path;
+  simInfo.unOutputFlags = pssalib::datamodel::SimulationInfo::ofLog
+    | pssalib::datamodel::SimulationInfo::ofError
+    | pssalib::datamodel::SimulationInfo::ofTrajectory
+    | pssalib::datamodel::SimulationInfo::ofFinalPops;
+  simInfo.setOutputStreamBuf(pssalib::datamodel::SimulationInfo::ofLog, std::cerr.rdbuf());
+
+  pssalib::PSSA engine;
+  if (!engine.setMethod(pssalib::PSSA::M_DM))
+  {
+    std::cerr << "Failed to set simulation method." << std::endl;
+    return false;
+  }
+  engine.SetReactionCallback(&reaction_callback_wrapper, this);
+
+  m_ptrSimInfo = &simInfo;
+  m_unReactions = 0;
+  m_unStopAt = stopAt;
+
+  completed = engine.run(&simInfo);
+
+  m_ptrSimInfo = NULL;
+  m_unStopAt = 0;
+  return true;
+}
+
+bool TestCheckpoint::Test()
+{
+#ifdef HAVE_MPI
+  // The state of the sampling loop is not saved by the MPI builds
+  return true;
+#else
+  STRING pathReference = "checkpoint/reference", pathResumed = "checkpoint/resumed";
+  if (!pssalib::util::makeDir(pathReference) || !pssalib::util::makeDir(pathResumed))
+  {
+    std::cerr << "Failed to create the output directories." << std::endl;
+    return false;
+  }
+
+  bool completed = false;
+  if (!Sample(pathReference, 0, completed) || !completed)
+  {
+    std::cerr << "Failed to sample the reference ensemble." << std::endl;
+    return false;
+  }
+
+  // Stop in the middle of the second trial
+  const UINTEGER unStopAt = m_unReactions / 2 + 1;
+
+  STRING pathCheckpoint, contents;
+  pssalib::util::makeFilePath(pathResumed, PSSALIB_FILENAME_CHECKPOINT, pathCheckpoint);
+
+  if (!Sample(pathResumed, unStopAt, completed) || completed || !ReadFile(pathCheckpoint, contents))
+  {
+    std::cerr << "Failed to save a checkpoint after " << unStopAt << " reactions." << std::endl;
+    return false;
+  }
+
+  if (!Sample(pathResumed, 0, completed, 2.0) || completed || !ReadFile(pathCheckpoint, contents))
+  {
+    std::cerr << "The checkpoint is resumed or discarded by a run with a different rate constant." << std::endl;
+    return false;
+  }
+
+  if (!Sample(pathResumed, 0, completed) || !completed)
+  {
+    std::cerr << "Failed to resume the sampling from the checkpoint." << std::endl;
+    return false;
+  }
+
+  bool result = true;
+  if (ReadFile(pathCheckpoint, contents))
+  {
+    std::cerr << "The checkpoint is not removed after all samples are done." << std::endl;
+    result = false;
+  }
+
+  // The output of the resumed run is identical to the one of the uninterrupted run
+  std::vector<STRING> files;
+  files.push_back(PSSALIB_FILENAME_FINAL_TIME_POINT_POPULATIONS);
+  for (UINTEGER n = 0; n < unSamples; ++n)
+  {
+    char fileName[32];
+    sprintf(fileName, PSSALIB_FILENAME_TRAJECTORY, n);
+    files.push_back(fileName);
+  }
+
+  for (std::size_t fi = 0; fi < files.size(); ++fi)
+  {
+    STRING pathFileReference, pathFileResumed, contentsReference, contentsResumed;
+    pssalib::util::makeFilePath(pathReference, files[fi], pathFileReference);
+    pssalib::util::makeFilePath(pathResumed, files[fi], pathFileResumed);
+
+    if (!ReadFile(pathFileReference, contentsReference) || !ReadFile(pathFileResumed, contentsResumed))
+    {
+      std::cerr << "Failed to read output file '" << files[fi] << "'." << std::endl;
+      result = false;
+    }
+    else if (contentsReference != contentsResumed)
+    {
+      std::cerr << "Output file '" << files[fi] << "' of the resumed run differs from the uninterrupted one." << std::endl;
+      result = false;
+    }
+
+    std::remove(pathFileReference.c_str());
+    std::remove(pathFileResumed.c_str());
+  }
+
+  std::remove(pathReference.c_str());
+  std::remove(pathResumed.c_str());
+  std::remove("checkpoint");
+
+  return result;
+#endif
+}
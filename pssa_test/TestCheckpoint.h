@@ -0,0 +1,37 @@
+/**
+ * @file TestCheckpoint.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Aug 2015
+ * @section LICENSE
+ * 
+ * The GPLv2 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Resuming the sampling loop from a checkpoint
+ */
+
+#pragma once
+
+#include "TestBase.h"
+
+class TestCheckpoint : public TestBase
+{
+public:
+	TestCheckpoint();
+	virtual ~TestCheckpoint();
+
+	virtual bool Test();
+
+private:
+	virtual void ReactionCallback(pssalib::datamodel::DataModel* dm, REAL t);
+
+	bool Sample(const STRING & path, UINTEGER stopAt, bool & completed, REAL rateFactor = 1.0);
+
+	pssalib::datamodel::SimulationInfo* m_ptrSimInfo;
+	UINTEGER m_unReactions;
+	UINTEGER m_unStopAt;
+};
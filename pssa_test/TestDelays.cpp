@@ -0,0 +1,300 @@
+/**
+ * @file TestDelays.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Aug 2015
+ * @section LICENSE
+ * 
+ * The GPLv2 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Implementation of the test checking that delayed reactions are read from
+ * the model & complete exactly one delay after they were initiated
+ */
+
+#include "TestDelays.h"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+// Number of samples drawn for each model
+static const UINTEGER unSamples = 100;
+
+extern void reaction_callback_wrapper(pssalib::datamodel::DataModel* dm, REAL t, void* user);
+
+static void events_sink_wrapper(UINTEGER sample, const pssalib::ReactionEvent * arEvents, UINTEGER count, void* user)
+{
+  TestDelays* test = reinterpret_cast<TestDelays*>(user);
+  test->EventsSink(sample, arEvents, count);
+}
+
+TestDelays::TestDelays()
+  : m_dDelay(0.0)
+  , m_bConsuming(false)
+  , m_unInitial(0)
+  , m_unDegradations(0)
+  , m_dTimeLast(0.0)
+  , m_dTimeEnd(0.0)
+  , m_unErrors(0)
+  , m_unSampleLast(0)
+  , m_dTimeEvent(0.0)
+  , m_unDisorders(0)
+{
+}
+
+TestDelays::~TestDelays()
+{
+}
+
+bool TestDelays::CheckModel(const std::string & inputFile, bool consuming)
+{
+  pssalib::datamodel::SimulationInfo simInfo;
+  if (!simInfo.readSBMLFile(inputFile))
+  {
+    std::cerr << "Failed to load model file '" << inputFile << "'." << std::endl;
+    return false;
+  }
+
+  // Only the first reaction of the model is delayed
+  pssalib::datamodel::detail::Model & model = simInfo.getModel();
+  for (UINTEGER ri = 0; ri < model.getReactionsCount(); ++ri)
+  {
+    const pssalib::datamodel::detail::Reaction * reaction = model.getReaction(ri);
+    if (reaction->isSetDelay() != (0 == ri))
+    {
+      std::cerr << "Reaction " << ri << " of '" << inputFile << "' is " << (reaction->isSetDelay() ? "" : "not ") << "delayed." << std::endl;
+      return false;
+    }
+  }
+
+  const pssalib::datamodel::detail::Reaction * reaction = model.getReaction(0);
+  if (reaction->isSetDelayConsuming() != consuming)
+  {
+    std::cerr << "Delayed reaction of '" << inputFile << "' is " << (consuming ? "not " : "") << "consuming." << std::endl;
+    return false;
+  }
+
+  if (0.5 != reaction->getDelay())
+  {
+    std::cerr << "Delay of '" << inputFile << "' is " << reaction->getDelay() << " instead of 0.5." << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+void TestDelays::ReactionCallback(pssalib::datamodel::DataModel* dm, REAL t)
+{
+  // A new trial begins
+  if (t < m_dTimeLast)
+  {
+    m_arInitiations.clear();
+    m_unDegradations = 0;
+  }
+  m_dTimeLast = t;
+
+  // Delayed reactions are not completed past the end of a trial
+  if (t > m_dTimeEnd)
+    return;
+
+  // Reactions initiated one delay ago have completed by now
+  UINTEGER completed = 0;
+  while ((completed < m_arInitiations.size()) && (m_arInitiations[completed] + m_dDelay < t))
+    ++completed;
+
+  UINTEGER reactant = 0, product = 0;
+  for (UINTEGER svi = 0; svi < dm->getSubvolumesCount(); ++svi)
+  {
+    pssalib::datamodel::detail::Subvolume & subVol = dm->getSubvolume(svi);
+    reactant += subVol.population(0);
+    product += subVol.population(1);
+
+    // The product does not diffuse & is only released where the reactant is
+    if (!m_bConsuming && (0 == subVol.population(0)) && (0 != subVol.population(1)))
+    {
+      if (0 == m_unErrors++)
+        std::cerr << "TestDelays::ReactionCallback: product released in subvolume " << svi << " at t=" << t << std::endl;
+      return;
+    }
+  }
+
+  // Diffusion does not change the totals
+  if (dm->getReactionWrapper(dm->mu).isDiffusive())
+    return;
+
+  bool match = true;
+  if (0 != dm->mu)
+  {
+    // Degradation of the product
+    ++m_unDegradations;
+    match = (product + m_unDegradations == completed);
+  }
+  else
+  {
+    // Initiation of the delayed reaction
+    m_arInitiations.push_back(t);
+    if (m_bConsuming)
+      match = (reactant + m_arInitiations.size() == m_unInitial) && (product == completed);
+    else
+      match = (product + m_unDegradations == completed);
+  }
+
+  if (!match && (0 == m_unErrors++))
+    std::cerr << "TestDelays::ReactionCallback: " << product << " products & " << reactant
+              << " reactants after " << completed << " completions at t=" << t << std::endl;
+}
+
+void TestDelays::EventsSink(UINTEGER sample, const pssalib::ReactionEvent * arEvents, UINTEGER count)
+{
+  // A new trial begins
+  if (sample != m_unSampleLast)
+  {
+    m_unSampleLast = sample;
+    m_dTimeEvent = 0.0;
+  }
+
+  // Completions of delayed reactions are interleaved with the other events
+  for (UINTEGER i = 0; i < count; ++i)
+  {
+    if ((arEvents[i].time < m_dTimeEvent) && (0 == m_unDisorders++))
+      std::cerr << "TestDelays::EventsSink: " << (arEvents[i].delayed ? "delayed " : "") << "event at t=" << arEvents[i].time
+                << " follows an event at t=" << m_dTimeEvent << std::endl;
+    m_dTimeEvent = std::max(m_dTimeEvent, arEvents[i].time);
+  }
+}
+
+bool TestDelays::Sample(const std::string & inputFile, pssalib::PSSA::EMethod method, bool spatial, REAL timeEnd,
+  pssalib::datamodel::SimulationInfo::VolumeSamplingType volumeSampling)
+{
+  pssalib::datamodel::SimulationInfo simInfo;
+  if (!simInfo.readSBMLFile(inputFile))
+  {
+    std::cerr << "Failed to load model file '" << inputFile << "'." << std::endl;
+    return false;
+  }
+
+  if (spatial)
+  {
+    simInfo.setDims(2, 3, 3);
+    simInfo.eBoundaryConditions = pssalib::datamodel::detail::BC_Periodic;
+    simInfo.eVolumeSampling = volumeSampling;
+  }
+  simInfo.eInitialPopulation = pssalib::datamodel::detail::IP_Concentrate;
+  simInfo.eRNGType = pssalib::datamodel::SimulationInfo::rngPhilox;
+  simInfo.unRNGSeed = 1234;
+  simInfo.dTimeStart = 0.0;
+  simInfo.dTimeStep = timeEnd;
+  simInfo.dTimeEnd = timeEnd;
+  simInfo.unSamplesTotal = unSamples;
+  simInfo.unOutputFlags = pssalib::datamodel::SimulationInfo::ofLog
+    | pssalib::datamodel::SimulationInfo::ofError
+    | pssalib::datamodel::SimulationInfo::ofFinalPops;
+  simInfo.setOutputStreamBuf(pssalib::datamodel::SimulationInfo::ofLog, std::cerr.rdbuf());
+
+  std::stringbuf sbFinalPops;
+  simInfo.setOutputStreamBuf(pssalib::datamodel::SimulationInfo::ofFinalPops, &sbFinalPops);
+
+  const pssalib::datamodel::detail::Reaction * reaction = simInfo.getModel().getReaction(0);
+  m_dDelay = reaction->getDelay();
+  m_bConsuming = reaction->isSetDelayConsuming();
+  m_unInitial = simInfo.getModel().getSpecies(0)->getInitialAmount();
+  m_arInitiations.clear();
+  m_unDegradations = 0;
+  m_dTimeLast = 0.0;
+  m_dTimeEnd = timeEnd;
+  m_unErrors = 0;
+  m_unSampleLast = std::numeric_limits<UINTEGER>::max();
+  m_dTimeEvent = 0.0;
+  m_unDisorders = 0;
+
+  pssalib::PSSA engine;
+  if (!engine.setMethod(method))
+  {
+    std::cerr << "Failed to set simulation method." << std::endl;
+    return false;
+  }
+  engine.SetReactionCallback(&reaction_callback_wrapper, this);
+  engine.SetReactionEventsSink(&events_sink_wrapper, this);
+
+  if (!engine.run(&simInfo))
+  {
+    std::cerr << "Failed to sample '" << inputFile << "' with " << pssalib::PSSA::getMethodName(method) << "." << std::endl;
+    return false;
+  }
+
+  if (0 != m_unErrors)
+  {
+    std::cerr << m_unErrors << " reactions of '" << inputFile << "' sampled with " << pssalib::PSSA::getMethodName(method)
+              << (spatial ? " in space" : "")
+              << ((pssalib::datamodel::SimulationInfo::vsNextSubvolume == volumeSampling) ? " with NSM" : "") << " do not match the delay." << std::endl;
+    return false;
+  }
+
+  if (0 != m_unDisorders)
+  {
+    std::cerr << m_unDisorders << " events of '" << inputFile << "' sampled with " << pssalib::PSSA::getMethodName(method)
+              << (spatial ? " in space" : "")
+              << ((pssalib::datamodel::SimulationInfo::vsNextSubvolume == volumeSampling) ? " with NSM" : "") << " go back in time." << std::endl;
+    return false;
+  }
+
+  // Every delayed conversion completes before the end
+  if (m_bConsuming && PSSALIB_MPI_IS_MASTER)
+  {
+    const UINTEGER unSpecies = simInfo.getModel().getSpeciesCount();
+    std::istringstream issFinalPops(sbFinalPops.str());
+    std::string line;
+    while (std::getline(issFinalPops, line))
+    {
+      for (std::string::iterator it = line.begin(); it != line.end(); ++it)
+        if (!isdigit(*it)) *it = ' ';
+
+      std::istringstream issLine(line);
+      UINTEGER value, product = 0;
+      for (UINTEGER i = 0; issLine >> value; ++i)
+        if (1 == i % unSpecies)
+          product += value;
+
+      if (product != m_unInitial)
+      {
+        std::cerr << "Only " << product << " of " << m_unInitial << " delayed conversions completed." << std::endl;
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool TestDelays::Test()
+{
+  // Delays are read from the annotations of the reactions
+  if (!CheckModel("sbml/DelayedProduction.sbml", false) || !CheckModel("sbml/DelayedConversion.sbml", true))
+    return false;
+
+  const pssalib::PSSA::EMethod methods[] = {
+    pssalib::PSSA::M_DM,
+    pssalib::PSSA::M_SPDM,
+    pssalib::PSSA::M_NRM
+  };
+
+  bool result = true;
+  for (UINTEGER mi = 0; mi < sizeof(methods) / sizeof(methods[0]); ++mi)
+  {
+    // Converted molecules are released after the delay & diffuse into empty subvolumes
+    result = Sample("sbml/DelayedConversion.sbml", methods[mi], false, 10.0) && result;
+    result = Sample("sbml/DelayedConversion.sbml", methods[mi], true, 10.0,
+      pssalib::datamodel::SimulationInfo::vsNextSubvolume) && result;
+    // Transcripts are released after the delay, in the subvolume of the gene
+    result = Sample("sbml/DelayedProduction.sbml", methods[mi], false, 2.0) && result;
+    result = Sample("sbml/DelayedProduction.sbml", methods[mi], true, 2.0) && result;
+    result = Sample("sbml/DelayedProduction.sbml", methods[mi], true, 2.0,
+      pssalib::datamodel::SimulationInfo::vsNextSubvolume) && result;
+  }
+
+  return result;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file TestDelays.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Aug 2015
+ * @section LICENSE
+ * 
+ * The GPLv2 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Delayed reactions test
+ */
+
+#pragma once
+
+#include "TestBase.h"
+
+class TestDelays : public TestBase
+{
+public:
+	TestDelays();
+	virtual ~TestDelays();
+
+	virtual bool Test();
+
+private:
+	virtual void ReactionCallback(pssalib::datamodel::DataModel* dm, REAL t);
+
+public:
+	void EventsSink(UINTEGER sample, const pssalib::ReactionEvent * arEvents, UINTEGER count);
+
+private:
+
+	bool CheckModel(const std::string & inputFile, bool consuming);
+	bool Sample(const std::string & inputFile, pssalib::PSSA::EMethod method, bool spatial, REAL timeEnd,
+		pssalib::datamodel::SimulationInfo::VolumeSamplingType volumeSampling = pssalib::datamodel::SimulationInfo::vsCompositionRejection);
+
+	REAL m_dDelay;
+	bool m_bConsuming;
+	UINTEGER m_unInitial;
+	std::vector<REAL> m_arInitiations;
+	UINTEGER m_unDegradations;
+	REAL m_dTimeLast;
+	REAL m_dTimeEnd;
+	UINTEGER m_unErrors;
+	UINTEGER m_unSampleLast;
+	REAL m_dTimeEvent;
+	UINTEGER m_unDisorders;
+};
@@ -0,0 +1,114 @@
+/**
+ * @file TestHistogram.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Aug 2015
+ * @section LICENSE
+ * 
+ * The GPLv2 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Implementation of the test comparing the population histograms merged
+ * from several histograms with the ones accumulated in a single pass
+ */
+
+#include "TestHistogram.h"
+#include "ShardedAccumulators.h"
+
+#include "util/PopulationHistogram.h"
+
+#include <sstream>
+
+// Layout of the accumulated populations
+static const UINTEGER unSpecies = 2;
+static const UINTEGER unSubvolumes = 2;
+static const UINTEGER unBins = 8;
+// Fewer joint states are written than the samples take
+static const UINTEGER unStates = 6;
+static const UINTEGER unTrials = 2000;
+
+TestHistogram::TestHistogram()
+{
+}
+
+TestHistogram::~TestHistogram()
+{
+}
+
+bool TestHistogram::Test()
+{
+  const std::size_t szPop = unSpecies * unSubvolumes;
+
+  ShardedAccumulators<pssalib::util::PopulationHistogram> acc;
+  acc.allocate(szPop, unSubvolumes, unBins, unStates);
+
+  std::binomial_distribution<UINTEGER> population(4, 0.3);
+
+  for (UINTEGER n = 0; n < unTrials; ++n)
+  {
+    pssalib::util::PopulationHistogram & target = acc.next();
+
+    UINTEGER * arSingle = acc.single.getStateBuffer(), * arTarget = target.getStateBuffer();
+    for (std::size_t i = 0; i < szPop; ++i)
+      arSingle[i] = arTarget[i] = population(acc.rng);
+    // The bins of the last value get wider in some histograms only
+    arSingle[szPop - 1] = arTarget[szPop - 1] *= acc.isLast(target) ? 25 : 1;
+
+    acc.single.add();
+    target.add();
+  }
+
+  // Combine the histograms as the threads do, in either order, & as the processes do
+  if (!acc.merge())
+    return false;
+
+  std::vector<ULINTEGER> arStates;
+  for (UINTEGER k = 0; k < sizeof(acc.shards) / sizeof(acc.shards[0]); ++k)
+  {
+    pssalib::util::PopulationHistogram::merge(acc.shards[k].getMarginals(), acc.flat.getMarginals(), szPop, unBins);
+    acc.shards[k].serializeStates(arStates);
+    if (!acc.flat.mergeStates(arStates.data(), arStates.size()))
+    {
+      std::cerr << "Failed to merge the serialized joint states." << std::endl;
+      return false;
+    }
+  }
+
+  std::ostringstream ossSingle;
+  acc.single.write(ossSingle);
+
+  // Every value of every sample is counted in its marginal histogram
+  bool result = true;
+  for (std::size_t i = 0; i < szPop; ++i)
+  {
+    const ULINTEGER * arRow = acc.single.getMarginals() + i * acc.single.getRowSize();
+    ULINTEGER ulTotal = 0;
+    for (UINTEGER b = 1; b <= unBins; ++b)
+      ulTotal += arRow[b];
+    if (unTrials != ulTotal)
+    {
+      std::cerr << "Marginal histogram of value " << i << " holds " << ulTotal << " samples instead of " << unTrials << "." << std::endl;
+      result = false;
+    }
+  }
+
+  pssalib::util::PopulationHistogram * results[] = { &acc.merged, &acc.reversed, &acc.flat };
+  const char * names[] = { "merged", "reversely merged", "serialized" };
+
+  for (UINTEGER ri = 0; ri < sizeof(results) / sizeof(results[0]); ++ri)
+  {
+    std::ostringstream ossMerged;
+    results[ri]->write(ossMerged);
+    if (ossMerged.str() != ossSingle.str())
+    {
+      std::cerr << "The " << names[ri] << " histograms differ from the single pass:" << std::endl
+                << ossMerged.str() << "instead of" << std::endl << ossSingle.str();
+      result = false;
+    }
+  }
+
+  return result;
+}
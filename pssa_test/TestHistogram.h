@@ -0,0 +1,28 @@
+/**
+ * @file TestHistogram.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Aug 2015
+ * @section LICENSE
+ * 
+ * The GPLv2 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Combination of the population histograms
+ */
+
+#pragma once
+
+#include "TestBase.h"
+
+class TestHistogram : public TestBase
+{
+public:
+	TestHistogram();
+	virtual ~TestHistogram();
+
+	virtual bool Test();
+};
@@ -0,0 +1,142 @@
+/**
+ * @file TestMethods.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Aug 2015
+ * @section LICENSE
+ * 
+ * The GPLv2 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Implementation of the test comparing the moments sampled by different
+ * methods with the ones of the Direct Method
+ */
+
+#include "TestMethods.h"
+
+#include <sstream>
+
+// Number of samples drawn by each method
+static const UINTEGER unSamples = 400;
+
+TestMethods::TestMethods()
+{
+}
+
+TestMethods::~TestMethods()
+{
+}
+
+bool TestMethods::SampleMoments(pssalib::PSSA::EMethod method, std::vector<REAL> & means, std::vector<REAL> & variances)
+{
+  pssalib::datamodel::SimulationInfo simInfo;
+
+  std::string inputFile = "sbml/Multimerization.sbml";
+  if (!simInfo.readSBMLFile(inputFile))
+  {
+    std::cerr << "Failed to load model file '" << inputFile << "'." << std::endl;
+    return false;
+  }
+
+  simInfo.eInitialPopulation = pssalib::datamodel::detail::IP_Concentrate;
+  simInfo.eRNGType = pssalib::datamodel::SimulationInfo::rngPhilox;
+  simInfo.unRNGSeed = 1234;
+  simInfo.dTimeStart = 0.0;
+  simInfo.dTimeStep = 1.0;
+  simInfo.dTimeEnd = 10.0;
+  simInfo.unSamplesTotal = unSamples;
+  simInfo.unOutputFlags = pssalib::datamodel::SimulationInfo::ofLog
+    | pssalib::datamodel::SimulationInfo::ofError
+    | pssalib::datamodel::SimulationInfo::ofAvgTrajectory;
+  simInfo.setOutputStreamBuf(pssalib::datamodel::SimulationInfo::ofLog, std::cerr.rdbuf());
+
+  std::stringbuf sbAverage;
+  simInfo.setOutputStreamBuf(pssalib::datamodel::SimulationInfo::ofAvgTrajectory, &sbAverage);
+
+  pssalib::PSSA engine;
+  if (!engine.setMethod(method))
+  {
+    std::cerr << "Failed to set simulation method." << std::endl;
+    return false;
+  }
+
+  if (!engine.run_avg(&simInfo))
+  {
+    std::cerr << "Failed to sample with " << pssalib::PSSA::getMethodName(method) << "." << std::endl;
+    return false;
+  }
+
+  // The moments are collected by the master process
+  if (!PSSALIB_MPI_IS_MASTER)
+  {
+    means.clear();
+    variances.clear();
+    return true;
+  }
+
+  // The last line holds the means & the variances at the final time point
+  std::istringstream issAverage(sbAverage.str());
+  std::string line, last;
+  while (std::getline(issAverage, line))
+    if (!line.empty())
+      last = line;
+
+  std::vector<REAL> values;
+  std::istringstream issLast(last);
+  std::string value;
+  while (std::getline(issLast, value, ','))
+    values.push_back(atof(value.c_str()));
+
+  if ((values.size() < 2) || (0 != values.size() % 2))
+  {
+    std::cerr << "Malformed average trajectory of " << pssalib::PSSA::getMethodName(method) << "." << std::endl;
+    return false;
+  }
+
+  means.assign(values.begin(), values.begin() + values.size() / 2);
+  variances.assign(values.begin() + values.size() / 2, values.end());
+
+  return true;
+}
+
+bool TestMethods::Test()
+{
+  std::vector<REAL> meansDM, variancesDM;
+  if (!SampleMoments(pssalib::PSSA::M_DM, meansDM, variancesDM))
+    return false;
+
+  const pssalib::PSSA::EMethod methods[] = {
+    pssalib::PSSA::M_DMTree,
+    pssalib::PSSA::M_NRM,
+    pssalib::PSSA::M_PSSACR
+  };
+
+  bool result = true;
+  for (UINTEGER mi = 0; mi < sizeof(methods) / sizeof(methods[0]); ++mi)
+  {
+    std::vector<REAL> means, variances;
+    if (!SampleMoments(methods[mi], means, variances) || (means.size() != meansDM.size()))
+    {
+      result = false;
+      continue;
+    }
+
+    for (UINTEGER si = 0; si < means.size(); ++si)
+    {
+      // The means must agree within five standard errors of their difference
+      REAL tolerance = 5.0 * sqrt((variances[si] + variancesDM[si]) / unSamples) + 1e-12;
+      if (fabs(means[si] - meansDM[si]) > tolerance)
+      {
+        std::cerr << "TestMethods::Test: " << pssalib::PSSA::getMethodName(methods[mi])
+          << " mean of species " << si << " is " << means[si] << ", the Direct Method yields "
+          << meansDM[si] << " (tolerance " << tolerance << ")" << std::endl;
+        result = false;
+      }
+    }
+  }
+
+  return result;
+}
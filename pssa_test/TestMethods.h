@@ -0,0 +1,31 @@
+/**
+ * @file TestMethods.h
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Aug 2015
+ * @section LICENSE
+ * 
+ * The GPLv2 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Agreement of the simulation methods
+ */
+
+#pragma once
+
+#include "TestBase.h"
+
+class TestMethods : public TestBase
+{
+public:
+	TestMethods();
+	virtual ~TestMethods();
+
+	virtual bool Test();
+
+private:
+	bool SampleMoments(pssalib::PSSA::EMethod method, std::vector<REAL> & means, std::vector<REAL> & variances);
+};
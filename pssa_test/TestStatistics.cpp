@@ -0,0 +1,111 @@
+/**
+ * @file TestStatistics.cpp
+ * @author Oleksandr Ostrenko <oleksandr.ostrenko@tu-dresden.de>
+ * @author Pietro Incardona <incardon@mpi-cbg.de>
+ * @author Rajesh Ramaswamy <rrajesh@pks.mpg.de>
+ * @version 1.0.0
+ * @date Mon, 10 Aug 2015
+ * @section LICENSE
+ * 
+ * The GPLv2 or any later version is applied to this software, see the LICENSE.txt file.
+ * 
+ * @section DESCRIPTION
+ *
+ * Implementation of the test comparing the ensemble statistics merged from
+ * several accumulators with the ones accumulated in a single pass
+ */
+
+#include "TestStatistics.h"
+#include "ShardedAccumulators.h"
+
+#include "util/EnsembleStatistics.h"
+
+// Layout of the accumulated populations
+static const UINTEGER unSpecies = 3;
+static const UINTEGER unSubvolumes = 2;
+static const UINTEGER unRows = 5;
+static const UINTEGER unTrials = 1000;
+
+TestStatistics::TestStatistics()
+{
+}
+
+TestStatistics::~TestStatistics()
+{
+}
+
+bool TestStatistics::Test()
+{
+  const std::size_t szPop = unSpecies * unSubvolumes;
+
+  ShardedAccumulators<pssalib::util::EnsembleStatistics> acc;
+  acc.allocate(szPop, unSubvolumes, unRows);
+
+  // Reference moments computed from the sums of the populations
+  std::vector<REAL> sums(unRows * szPop, 0.0), sumsSq(unRows * szPop, 0.0), counts(unRows, 0.0);
+
+  std::poisson_distribution<UINTEGER> population(500.0);
+  std::uniform_int_distribution<UINTEGER> lines(1, unRows);
+  std::vector<UINTEGER> arPop(szPop);
+
+  for (UINTEGER n = 0; n < unTrials; ++n)
+  {
+    // Some of the trials are interrupted
+    pssalib::util::EnsembleStatistics & target = acc.next();
+    const UINTEGER unLines = (0 == n % 7) ? lines(acc.rng) : unRows;
+
+    acc.single.begin();
+    target.begin();
+    for (UINTEGER r = 0; r < unLines; ++r)
+    {
+      for (std::size_t i = 0; i < szPop; ++i)
+      {
+        arPop[i] = population(acc.rng) + r * i;
+        sums[r * szPop + i] += REAL(arPop[i]);
+        sumsSq[r * szPop + i] += REAL(arPop[i]) * REAL(arPop[i]);
+      }
+      counts[r] += 1.0;
+
+      acc.single.add(arPop.data(), 1);
+      target.add(arPop.data(), 1);
+    }
+  }
+
+  // Combine the accumulators as the threads do & as the processes do
+  if (!acc.merge())
+    return false;
+  for (UINTEGER k = 0; k < sizeof(acc.shards) / sizeof(acc.shards[0]); ++k)
+    pssalib::util::EnsembleStatistics::merge(acc.shards[k].getData(), acc.flat.getData(), unRows, szPop);
+
+  pssalib::util::EnsembleStatistics * results[] = { &acc.single, &acc.merged, &acc.reversed, &acc.flat };
+
+  bool result = true;
+  for (UINTEGER ri = 0; ri < sizeof(results) / sizeof(results[0]); ++ri)
+  {
+    for (UINTEGER r = 0; r < unRows; ++r)
+    {
+      const REAL * ptrRow = results[ri]->getData() + r * results[ri]->getRowSize();
+      if (ptrRow[0] != counts[r])
+      {
+        std::cerr << "Samples count at time point " << r << " is " << ptrRow[0] << " instead of " << counts[r] << "." << std::endl;
+        result = false;
+        continue;
+      }
+
+      for (std::size_t i = 0; i < szPop; ++i)
+      {
+        const REAL mean = sums[r * szPop + i] / counts[r];
+        const REAL m2 = sumsSq[r * szPop + i] - counts[r] * mean * mean;
+        const REAL meanAcc = ptrRow[1 + i], m2Acc = ptrRow[1 + szPop + i];
+        if ((fabs(meanAcc - mean) > 1e-9 * mean) || (fabs(m2Acc - m2) > 1e-6 * m2))
+        {
+          std::cerr << "Moments of value " << i << " at time point " << r << " are " << meanAcc << ", " << m2Acc
+                    << " instead of " << mean << ", " << m2 << "." << std::endl;
+          result = false;
+        }
+      }
+    }
+  }
+
+  return result;
+}
@@ -19,9 +19,14 @@ LIBSBML_CPP_NAMESPACE_USE
 
 #include "PSSA.h"
 
+#include "TestCheckpoint.h"
+#include "TestDelays.h"
 #include "TestDiffusion.h"
+#include "TestHistogram.h"
+#include "TestMethods.h"
 #include "TestReaction.h"
 #include "TestReactionDiffusion.h"
+#include "TestStatistics.h"
 
 int main(int argc, char** argv)
 {
@@ -45,5 +50,35 @@ int main(int argc, char** argv)
   if (!test_reactiondiffusion->Test())
     PSSALIB_MPI_CERR_OR_NULL << "Reaction-diffusion test failed!" << std::endl;
 
+  PSSALIB_MPI_COUT_OR_NULL << "Running delayed reactions test..." << std::endl;
+
+  TestBase* test_delays = new TestDelays;
+  if (!test_delays->Test())
+    PSSALIB_MPI_CERR_OR_NULL << "Delayed reactions test failed!" << std::endl;
+
+  PSSALIB_MPI_COUT_OR_NULL << "Running methods agreement test..." << std::endl;
+
+  TestBase* test_methods = new TestMethods;
+  if (!test_methods->Test())
+    PSSALIB_MPI_CERR_OR_NULL << "Methods agreement test failed!" << std::endl;
+
+  PSSALIB_MPI_COUT_OR_NULL << "Running ensemble statistics test..." << std::endl;
+
+  TestBase* test_statistics = new TestStatistics;
+  if (!test_statistics->Test())
+    PSSALIB_MPI_CERR_OR_NULL << "Ensemble statistics test failed!" << std::endl;
+
+  PSSALIB_MPI_COUT_OR_NULL << "Running population histogram test..." << std::endl;
+
+  TestBase* test_histogram = new TestHistogram;
+  if (!test_histogram->Test())
+    PSSALIB_MPI_CERR_OR_NULL << "Population histogram test failed!" << std::endl;
+
+  PSSALIB_MPI_COUT_OR_NULL << "Running checkpoint test..." << std::endl;
+
+  TestBase* test_checkpoint = new TestCheckpoint;
+  if (!test_checkpoint->Test())
+    PSSALIB_MPI_CERR_OR_NULL << "Checkpoint test failed!" << std::endl;
+
   return 0;
 }